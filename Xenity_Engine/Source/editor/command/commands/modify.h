@@ -364,60 +364,60 @@ inline void InspectorItemSetActiveCommand<T>::Undo()
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
-//template<typename T>
-//class InspectorItemSetStaticCommand : public Command
-//{
-//public:
-//	InspectorItemSetStaticCommand() = delete;
-//	InspectorItemSetStaticCommand(const T& target, bool newValue);
-//	void Execute() override;
-//	void Undo() override;
-//private:
-//	void ApplyValue(bool valueToSet);
-//	uint64_t targetId = 0;
-//	bool newValue;
-//};
-//
-//template<typename T>
-//inline void InspectorItemSetStaticCommand<T>::ApplyValue(bool valueToSet)
-//{
-//	if constexpr (std::is_base_of<T, GameObject>())
-//	{
-//		std::shared_ptr<GameObject> foundGameObject = FindGameObjectById(targetId);
-//		if (foundGameObject)
-//		{
-//			foundGameObject->m_isStatic = valueToSet;
-//			foundGameObject->OnReflectionUpdated();
-//			SceneManager::SetIsSceneDirty(true);
-//		}
-//	}
-//	else
-//	{
-//		Debug::PrintError("Can't do Command!");
-//	}
-//}
-//
-//template<typename T>
-//inline InspectorItemSetStaticCommand<T>::InspectorItemSetStaticCommand(const T& target, bool newValue)
-//{
-//	if constexpr (std::is_base_of<T, GameObject>() || std::is_base_of<T, Component>())
-//	{
-//		this->targetId = target.GetUniqueId();
-//	}
-//	this->newValue = newValue;
-//}
-//
-//template<typename T>
-//inline void InspectorItemSetStaticCommand<T>::Execute()
-//{
-//	ApplyValue(newValue);
-//}
-//
-//template<typename T>
-//inline void InspectorItemSetStaticCommand<T>::Undo()
-//{
-//	ApplyValue(!newValue);
-//}
+template<typename T>
+class InspectorItemSetStaticCommand : public Command
+{
+public:
+	InspectorItemSetStaticCommand() = delete;
+	InspectorItemSetStaticCommand(const T& target, bool newValue);
+	void Execute() override;
+	void Undo() override;
+private:
+	void ApplyValue(bool valueToSet);
+	uint64_t targetId = 0;
+	bool newValue;
+};
+
+template<typename T>
+inline void InspectorItemSetStaticCommand<T>::ApplyValue(bool valueToSet)
+{
+	if constexpr (std::is_base_of<T, GameObject>())
+	{
+		std::shared_ptr<GameObject> foundGameObject = FindGameObjectById(targetId);
+		if (foundGameObject)
+		{
+			foundGameObject->m_isStatic = valueToSet;
+			foundGameObject->OnReflectionUpdated();
+			SceneManager::SetIsSceneDirty(true);
+		}
+	}
+	else
+	{
+		Debug::PrintError("Can't do Command!");
+	}
+}
+
+template<typename T>
+inline InspectorItemSetStaticCommand<T>::InspectorItemSetStaticCommand(const T& target, bool newValue)
+{
+	if constexpr (std::is_base_of<T, GameObject>() || std::is_base_of<T, Component>())
+	{
+		this->targetId = target.GetUniqueId();
+	}
+	this->newValue = newValue;
+}
+
+template<typename T>
+inline void InspectorItemSetStaticCommand<T>::Execute()
+{
+	ApplyValue(newValue);
+}
+
+template<typename T>
+inline void InspectorItemSetStaticCommand<T>::Undo()
+{
+	ApplyValue(!newValue);
+}
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
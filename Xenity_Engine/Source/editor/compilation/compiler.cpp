@@ -149,6 +149,14 @@ CompileResult Compiler::Compile(CompilerParams params)
 		cookSettings.exportPath = params.tempPath + "cooked_assets/";
 		cookSettings.assetPlatform = Application::PlatformToAssetPlatform(params.buildPlatform.platform);
 		cookSettings.platform = params.buildPlatform.platform;
+		const std::shared_ptr<PlatformSettingsWindows> standaloneSettings = std::dynamic_pointer_cast<PlatformSettingsWindows>(params.buildPlatform.settings);
+		if (standaloneSettings)
+		{
+			cookSettings.quantizeMeshes = standaloneSettings->quantizeMeshes;
+			cookSettings.meshPositionTolerance = standaloneSettings->meshPositionTolerance;
+			cookSettings.meshNormalTolerance = standaloneSettings->meshNormalTolerance;
+			cookSettings.compressTextures = standaloneSettings->compressTextures;
+		}
 		if (params.buildType == BuildType::BuildShaders)
 		{
 			cookSettings.exportShadersOnly = true;
@@ -167,12 +167,20 @@ public:
 		//Reflective::AddVariable(reflectedVariables, enableProfiler, "enableProfiler", true);
 		//Reflective::AddVariable(reflectedVariables, enableOnlineProfiler, "enableOnlineProfiler", true);
 		Reflective::AddVariable(reflectedVariables, icon, "icon");
+		Reflective::AddVariable(reflectedVariables, quantizeMeshes, "quantizeMeshes");
+		Reflective::AddVariable(reflectedVariables, meshPositionTolerance, "meshPositionTolerance");
+		Reflective::AddVariable(reflectedVariables, meshNormalTolerance, "meshNormalTolerance");
+		Reflective::AddVariable(reflectedVariables, compressTextures, "compressTextures");
 		return reflectedVariables;
 	}
 
 	[[nodiscard]] int IsValid() override;
 
 	std::shared_ptr<Icon> icon;
+	bool quantizeMeshes = false; // Use 16 bits positions/UVs and octahedral normals when the precision loss is small enough
+	float meshPositionTolerance = 0.001f; // Maximum position error in mesh units
+	float meshNormalTolerance = 1.0f; // Maximum normal error in degrees
+	bool compressTextures = false; // Cook the textures in BC1/BC3/BC5 with their mip levels (see the compression setting of the textures)
 private:
 };
 
@@ -12,6 +12,9 @@
 #include <stb_image_resize.h>
 
 #include <editor/utils/copy_utils.h>
+#include <editor/cooker/mesh_optimizer.h>
+#include <editor/cooker/mesh_quantizer.h>
+#include <editor/cooker/texture_encoder.h>
 
 #include <engine/asset_management/project_manager.h>
 #include <engine/unique_id/unique_id.h>
@@ -237,6 +240,49 @@ void Cooker::CookMesh(const CookSettings& settings, const FileInfo& fileInfo, co
 	loadOptions.onlyLoadData = true;
 	meshData.LoadFileReference(loadOptions);
 
+	// Optimize the indexed triangle submeshes, the other ones are written as they are
+	MeshData optimizedMeshData = MeshData(true);
+	std::vector<MeshData::SubMesh*> subMeshesToWrite;
+	for (std::unique_ptr<MeshData::SubMesh>& subMesh : meshData.m_subMeshes)
+	{
+		if (subMesh->m_index_count == 0 || subMesh->m_isQuad)
+		{
+			subMeshesToWrite.push_back(subMesh.get());
+			continue;
+		}
+
+		const uint32_t optimizedSubMeshCount = optimizedMeshData.m_subMeshCount;
+		const MeshOptimizer::Statistics statistics = MeshOptimizer::OptimizeSubMesh(*subMesh, optimizedMeshData);
+		if (optimizedMeshData.m_subMeshCount == optimizedSubMeshCount)
+		{
+			subMeshesToWrite.push_back(subMesh.get());
+			continue;
+		}
+
+		subMeshesToWrite.push_back(optimizedMeshData.m_subMeshes[optimizedMeshData.m_subMeshCount - 1].get());
+		Debug::Print("[Cooker::CookMesh] " + fileInfo.fileAndId.file->GetFileName() + " submesh " + std::to_string(subMeshesToWrite.size() - 1) +
+			": ACMR " + std::to_string(statistics.acmrBefore) + " -> " + std::to_string(statistics.acmrAfter) +
+			", vertices " + std::to_string(statistics.vertexCountBefore) + " -> " + std::to_string(statistics.vertexCountAfter));
+	}
+
+	// Use smaller vertex types, only the OpenGL renderer reads the quantized formats
+	MeshData quantizedMeshData = MeshData(true);
+	if (settings.quantizeMeshes && settings.assetPlatform == AssetPlatform::AP_Standalone)
+	{
+		for (size_t i = 0; i < subMeshesToWrite.size(); i++)
+		{
+			const uint32_t quantizedSubMeshCount = quantizedMeshData.m_subMeshCount;
+			const MeshQuantizer::Statistics statistics = MeshQuantizer::QuantizeSubMesh(*subMeshesToWrite[i], quantizedMeshData, settings.meshPositionTolerance, settings.meshNormalTolerance);
+			if (quantizedMeshData.m_subMeshCount == quantizedSubMeshCount)
+				continue;
+
+			subMeshesToWrite[i] = quantizedMeshData.m_subMeshes[quantizedMeshData.m_subMeshCount - 1].get();
+			Debug::Print("[Cooker::CookMesh] " + fileInfo.fileAndId.file->GetFileName() + " submesh " + std::to_string(i) +
+				": vertex size " + std::to_string(statistics.vertexSizeBefore) + " -> " + std::to_string(statistics.vertexSizeAfter) +
+				" bytes, position error " + std::to_string(statistics.positionError) + ", normal error " + std::to_string(statistics.normalError) + " degrees");
+		}
+	}
+
 	// REMINDER: NEVER WRITE A SIZE_T TO A FILE, ALWAYS CONVERT IT TO A FIXED SIZE TYPE
 	std::ofstream meshFile = std::ofstream(exportPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
 
@@ -247,7 +293,7 @@ void Cooker::CookMesh(const CookSettings& settings, const FileInfo& fileInfo, co
 
 	// Write submeshes data
 	// REMINDER: NEVER WRITE A SIZE_T TO A FILE, ALWAYS CONVERT IT TO A FIXED SIZE TYPE
-	for (std::unique_ptr<MeshData::SubMesh>& subMesh : meshData.m_subMeshes)
+	for (MeshData::SubMesh* subMesh : subMeshesToWrite)
 	{
 		// Adapt the vertex descriptor for other platforms
 		VertexDescriptor vertexDescriptorToWrite;
@@ -287,6 +333,15 @@ void Cooker::CookMesh(const CookSettings& settings, const FileInfo& fileInfo, co
 		meshFile.write((char*)&newVertexMemSize, sizeof(uint32_t));
 		meshFile.write((char*)&subMesh->m_indexMemSize, sizeof(uint32_t));
 
+		// Write the bounds of the quantized positions
+		if (vertexDescriptorToWrite.GetPositionIndex() != -1 &&
+			vertexDescriptorToWrite.GetElementFromIndex(vertexDescriptorToWrite.GetPositionIndex()) == VertexElement::POSITION_16_BITS)
+		{
+			const float positionBounds[6] = { subMesh->m_positionCenter.x, subMesh->m_positionCenter.y, subMesh->m_positionCenter.z,
+				subMesh->m_positionExtent.x, subMesh->m_positionExtent.y, subMesh->m_positionExtent.z };
+			meshFile.write((char*)positionBounds, sizeof(positionBounds));
+		}
+
 		const VertexDescriptor& sourceVertexDescriptor = subMesh->m_vertexDescriptor;
 
 		// Adapt the vertex data for other platforms
@@ -501,6 +556,61 @@ void Cooker::CookTexture(const CookSettings& settings, const FileInfo& fileInfo,
 		newHeight = textureResolutionInt;
 	}
 
+	// Block compression, only the OpenGL renderer reads the compressed textures
+	TextureCompression compression = TextureCompression::None;
+	if (settings.compressTextures && settings.assetPlatform == AssetPlatform::AP_Standalone)
+	{
+		compression = static_cast<const TextureSettingsStandalone&>(*texture->m_settings[settings.assetPlatform]).compression;
+	}
+
+	// The streamed textures are cooked with all their mip levels (in RGBA8 without compression) to only read the needed levels
+	const bool isStreamed = settings.assetPlatform == AssetPlatform::AP_Standalone && texture->m_settings[settings.assetPlatform]->isStreamed;
+
+	if (compression != TextureCompression::None || isStreamed)
+	{
+		if (!imageData)
+		{
+			imageData = stbi_load(texturePath.c_str(), &width, &height, &channels, 4);
+			if (!imageData)
+			{
+				Debug::PrintError("[Cooker::CookAsset] Failed to load texture: " + texturePath);
+				return;
+			}
+		}
+
+		std::vector<unsigned char> resizedImageData;
+		const unsigned char* pixels = imageData;
+		if (width != newWidth || height != newHeight)
+		{
+			resizedImageData.resize(static_cast<size_t>(newWidth) * newHeight * 4);
+			stbir_resize_uint8(imageData, width, height, 0, resizedImageData.data(), newWidth, newHeight, 0, 4);
+			pixels = resizedImageData.data();
+		}
+
+		CompressedTextureFormat format = CompressedTextureFormat::RGBA8;
+		if (compression == TextureCompression::BC3 || (compression == TextureCompression::Auto && TextureEncoder::HasAlpha(pixels, newWidth, newHeight)))
+		{
+			format = CompressedTextureFormat::BC3;
+		}
+		else if (compression == TextureCompression::BC5)
+		{
+			format = CompressedTextureFormat::BC5;
+		}
+		else if (compression != TextureCompression::None)
+		{
+			format = CompressedTextureFormat::BC1;
+		}
+
+		const std::vector<unsigned char> compressedTexture = TextureEncoder::EncodeTexture(pixels, newWidth, newHeight, format,
+			texture->m_settings[settings.assetPlatform]->useMipMap || isStreamed);
+		std::ofstream textureFile = std::ofstream(exportPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		textureFile.write(reinterpret_cast<const char*>(compressedTexture.data()), compressedTexture.size());
+		textureFile.close();
+
+		free(imageData);
+		return;
+	}
+
 	// Resize the texture if needed
 	if (width != newWidth || height != newHeight)
 	{
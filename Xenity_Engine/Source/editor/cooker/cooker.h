@@ -15,6 +15,14 @@ struct CookSettings
 	AssetPlatform assetPlatform;
 	std::string exportPath;
 	bool exportShadersOnly = false;
+
+	// Mesh quantization (only for the standalone platforms)
+	bool quantizeMeshes = false;
+	float meshPositionTolerance = 0.001f;
+	float meshNormalTolerance = 1.0f;
+
+	// Texture block compression (only for the standalone platforms)
+	bool compressTextures = false;
 };
 
 class Cooker
@@ -0,0 +1,409 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include <engine/assertions/assertions.h>
+
+namespace
+{
+	/**
+	* @brief FIFO post-transform cache simulation
+	*/
+	class VertexCache
+	{
+	public:
+		VertexCache(uint32_t vertexCount, uint32_t cacheSize) : m_timestamps(vertexCount, 0), m_time(cacheSize + 1), m_cacheSize(cacheSize)
+		{
+		}
+
+		/**
+		* @brief Use a vertex
+		* @return True if the vertex was not in the cache
+		*/
+		bool Access(uint32_t vertex)
+		{
+			if (m_time - m_timestamps[vertex] > m_cacheSize)
+			{
+				m_timestamps[vertex] = m_time++;
+				return true;
+			}
+			return false;
+		}
+
+		void Clear()
+		{
+			m_time += m_cacheSize + 1;
+		}
+
+	private:
+		std::vector<uint32_t> m_timestamps;
+		uint32_t m_time;
+		uint32_t m_cacheSize;
+	};
+
+	uint32_t CountCacheMisses(const uint32_t* indices, size_t indexCount, VertexCache& cache)
+	{
+		uint32_t misses = 0;
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			if (cache.Access(indices[i]))
+			{
+				misses++;
+			}
+		}
+		return misses;
+	}
+
+	glm::vec3 GetPosition(const unsigned char* positions, uint32_t positionStride, uint32_t vertex)
+	{
+		float position[3];
+		memcpy(position, positions + static_cast<size_t>(vertex) * positionStride, sizeof(position));
+		return glm::vec3(position[0], position[1], position[2]);
+	}
+}
+
+float MeshOptimizer::ComputeAcmr(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return 0;
+
+	VertexCache cache(vertexCount, cacheSize);
+	return CountCacheMisses(indices.data(), indices.size(), cache) / static_cast<float>(triangleCount);
+}
+
+uint32_t MeshOptimizer::DeduplicateVertices(const unsigned char* vertices, uint32_t vertexCount, uint32_t vertexSize, std::vector<uint32_t>& indices)
+{
+	// Compare the raw bytes, the vertices have to be exactly the same
+	std::unordered_map<std::string_view, uint32_t> firstVertices;
+	firstVertices.reserve(vertexCount);
+	std::vector<uint32_t> remap(vertexCount);
+	uint32_t duplicateCount = 0;
+	for (uint32_t i = 0; i < vertexCount; i++)
+	{
+		const std::string_view vertex(reinterpret_cast<const char*>(vertices) + static_cast<size_t>(i) * vertexSize, vertexSize);
+		const auto result = firstVertices.emplace(vertex, i);
+		remap[i] = result.first->second;
+		if (!result.second)
+		{
+			duplicateCount++;
+		}
+	}
+
+	if (duplicateCount != 0)
+	{
+		for (uint32_t& index : indices)
+		{
+			index = remap[index];
+		}
+	}
+	return duplicateCount;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& clusters, uint32_t cacheSize)
+{
+	XASSERT(indices.size() % 3 == 0, "[MeshOptimizer::OptimizeVertexCache] The indices are not a triangle list");
+
+	clusters.clear();
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0)
+		return;
+
+	// Triangles using each vertex
+	std::vector<uint32_t> liveTriangles(vertexCount, 0);
+	for (const uint32_t index : indices)
+	{
+		liveTriangles[index]++;
+	}
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (uint32_t i = 0; i < vertexCount; i++)
+	{
+		adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+	}
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (uint32_t i = 0; i < indices.size(); i++)
+		{
+			adjacency[fillOffsets[indices[i]]++] = i / 3;
+		}
+	}
+
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	std::vector<bool> isEmitted(triangleCount, false);
+	std::vector<uint32_t> deadEndStack;
+	std::vector<uint32_t> candidates;
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+
+	uint32_t time = cacheSize + 1;
+	uint32_t cursor = 0;
+	int64_t fanningVertex = 0;
+	while (liveTriangles[static_cast<uint32_t>(fanningVertex)] == 0 && fanningVertex + 1 < vertexCount)
+	{
+		fanningVertex++;
+	}
+
+	clusters.push_back(0);
+	while (fanningVertex >= 0)
+	{
+		// Emit all the triangles around the fanning vertex
+		candidates.clear();
+		const uint32_t vertex = static_cast<uint32_t>(fanningVertex);
+		for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; a++)
+		{
+			const uint32_t triangle = adjacency[a];
+			if (isEmitted[triangle])
+				continue;
+
+			for (uint32_t corner = 0; corner < 3; corner++)
+			{
+				const uint32_t triangleVertex = indices[triangle * 3 + corner];
+				newIndices.push_back(triangleVertex);
+				deadEndStack.push_back(triangleVertex);
+				candidates.push_back(triangleVertex);
+				liveTriangles[triangleVertex]--;
+				if (time - timestamps[triangleVertex] > cacheSize)
+				{
+					timestamps[triangleVertex] = time++;
+				}
+			}
+			isEmitted[triangle] = true;
+		}
+
+		// Continue with the candidate that will still be in the cache after emitting its triangles
+		fanningVertex = -1;
+		int64_t bestPriority = -1;
+		for (const uint32_t candidate : candidates)
+		{
+			if (liveTriangles[candidate] == 0)
+				continue;
+
+			int64_t priority = 0;
+			if (time - timestamps[candidate] + 2 * liveTriangles[candidate] <= cacheSize)
+			{
+				priority = time - timestamps[candidate];
+			}
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				fanningVertex = candidate;
+			}
+		}
+
+		if (fanningVertex == -1)
+		{
+			// Dead end, continue with a recently used vertex or the next vertex with triangles
+			while (!deadEndStack.empty() && fanningVertex == -1)
+			{
+				const uint32_t deadEndVertex = deadEndStack.back();
+				deadEndStack.pop_back();
+				if (liveTriangles[deadEndVertex] > 0)
+				{
+					fanningVertex = deadEndVertex;
+				}
+			}
+			while (cursor < vertexCount && fanningVertex == -1)
+			{
+				if (liveTriangles[cursor] > 0)
+				{
+					fanningVertex = cursor;
+				}
+				cursor++;
+			}
+
+			// The cache is cold again, a new group starts here
+			if (fanningVertex != -1)
+			{
+				clusters.push_back(static_cast<uint32_t>(newIndices.size() / 3));
+			}
+		}
+	}
+
+	XASSERT(newIndices.size() == indices.size(), "[MeshOptimizer::OptimizeVertexCache] Some triangles have been lost");
+	indices.swap(newIndices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters, const unsigned char* positions, uint32_t positionStride, uint32_t vertexCount)
+{
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0 || clusters.empty())
+		return;
+
+	// Cut the groups where the vertex cache is still efficient enough if the group is moved
+	std::vector<uint32_t> softClusters;
+	VertexCache cache(vertexCount, s_cacheSize);
+	for (size_t c = 0; c < clusters.size(); c++)
+	{
+		const uint32_t start = clusters[c];
+		const uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+		if (start == end)
+			continue;
+
+		cache.Clear();
+		const float clusterAcmr = CountCacheMisses(&indices[start * 3], (end - start) * 3, cache) / static_cast<float>(end - start);
+		const float threshold = clusterAcmr * s_overdrawThreshold;
+
+		cache.Clear();
+		uint32_t softStart = start;
+		uint32_t misses = 0;
+		softClusters.push_back(start);
+		for (uint32_t triangle = start; triangle < end; triangle++)
+		{
+			misses += CountCacheMisses(&indices[triangle * 3], 3, cache);
+			if (triangle + 1 < end && misses / static_cast<float>(triangle + 1 - softStart) <= threshold)
+			{
+				softStart = triangle + 1;
+				misses = 0;
+				cache.Clear();
+				softClusters.push_back(softStart);
+			}
+		}
+	}
+
+	// Sort the groups by how much they face outside of the mesh
+	glm::vec3 meshCenter = glm::vec3(0);
+	for (const uint32_t index : indices)
+	{
+		meshCenter += GetPosition(positions, positionStride, index);
+	}
+	meshCenter /= static_cast<float>(indices.size());
+
+	struct ClusterInfo
+	{
+		uint32_t start = 0;
+		uint32_t end = 0;
+		float sortKey = 0;
+	};
+
+	std::vector<ClusterInfo> clusterInfos(softClusters.size());
+	for (size_t c = 0; c < softClusters.size(); c++)
+	{
+		ClusterInfo& info = clusterInfos[c];
+		info.start = softClusters[c];
+		info.end = c + 1 < softClusters.size() ? softClusters[c + 1] : triangleCount;
+
+		glm::vec3 center = glm::vec3(0);
+		glm::vec3 normal = glm::vec3(0);
+		float area = 0;
+		for (uint32_t triangle = info.start; triangle < info.end; triangle++)
+		{
+			const glm::vec3 p0 = GetPosition(positions, positionStride, indices[triangle * 3]);
+			const glm::vec3 p1 = GetPosition(positions, positionStride, indices[triangle * 3 + 1]);
+			const glm::vec3 p2 = GetPosition(positions, positionStride, indices[triangle * 3 + 2]);
+			const glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+			const float triangleArea = glm::length(cross);
+			center += (p0 + p1 + p2) * (triangleArea / 3.0f);
+			normal += cross;
+			area += triangleArea;
+		}
+
+		const float normalLength = glm::length(normal);
+		if (area > 0 && normalLength > 0)
+		{
+			center /= area;
+			normal /= normalLength;
+			info.sortKey = glm::dot(center - meshCenter, normal);
+		}
+	}
+
+	std::stable_sort(clusterInfos.begin(), clusterInfos.end(), [](const ClusterInfo& a, const ClusterInfo& b)
+		{
+			return a.sortKey > b.sortKey;
+		});
+
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+	for (const ClusterInfo& info : clusterInfos)
+	{
+		newIndices.insert(newIndices.end(), indices.begin() + info.start * 3, indices.begin() + info.end * 3);
+	}
+	indices.swap(newIndices);
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, uint32_t vertexCount)
+{
+	constexpr uint32_t unusedVertex = UINT32_MAX;
+	std::vector<uint32_t> remap(vertexCount, unusedVertex);
+	std::vector<uint32_t> newToOld;
+	newToOld.reserve(vertexCount);
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == unusedVertex)
+		{
+			remap[index] = static_cast<uint32_t>(newToOld.size());
+			newToOld.push_back(index);
+		}
+		index = remap[index];
+	}
+	return newToOld;
+}
+
+MeshOptimizer::Statistics MeshOptimizer::OptimizeSubMesh(const MeshData::SubMesh& source, MeshData& destination)
+{
+	XASSERT(source.m_index_count != 0, "[MeshOptimizer::OptimizeSubMesh] The submesh has no indices");
+	XASSERT(!source.m_isQuad, "[MeshOptimizer::OptimizeSubMesh] The submesh is not made of triangles");
+
+	const VertexDescriptor& vertexDescriptor = source.m_vertexDescriptor;
+	const uint32_t vertexSize = vertexDescriptor.GetVertexSize();
+	const uint32_t vertexCount = source.m_vertice_count;
+	const unsigned char* vertices = static_cast<const unsigned char*>(source.m_data);
+
+	std::vector<uint32_t> indices(source.m_index_count);
+	for (uint32_t i = 0; i < source.m_index_count; i++)
+	{
+		if (source.usesShortIndices)
+			indices[i] = static_cast<const uint16_t*>(source.GetIndices())[i];
+		else
+			indices[i] = static_cast<const uint32_t*>(source.GetIndices())[i];
+	}
+
+	Statistics statistics;
+	statistics.vertexCountBefore = vertexCount;
+	statistics.acmrBefore = ComputeAcmr(indices, vertexCount);
+
+	DeduplicateVertices(vertices, vertexCount, vertexSize, indices);
+
+	std::vector<uint32_t> clusters;
+	OptimizeVertexCache(indices, vertexCount, clusters);
+
+	if (vertexDescriptor.GetPositionIndex() != static_cast<uint32_t>(-1) &&
+		vertexDescriptor.GetElementFromIndex(vertexDescriptor.GetPositionIndex()) == VertexElement::POSITION_32_BITS)
+	{
+		OptimizeOverdraw(indices, clusters, vertices + vertexDescriptor.GetPositionOffset(), vertexSize, vertexCount);
+	}
+
+	const std::vector<uint32_t> newToOld = OptimizeVertexFetch(indices, vertexCount);
+	const uint32_t newVertexCount = static_cast<uint32_t>(newToOld.size());
+
+	// The index size is chosen from the new vertex count
+	const uint32_t subMeshCount = destination.m_subMeshCount;
+	destination.CreateSubMesh(newVertexCount, static_cast<uint32_t>(indices.size()), vertexDescriptor);
+	if (destination.m_subMeshCount == subMeshCount)
+		return statistics;
+
+	MeshData::SubMesh& newSubMesh = *destination.m_subMeshes[destination.m_subMeshCount - 1];
+	for (uint32_t i = 0; i < newVertexCount; i++)
+	{
+		memcpy(static_cast<unsigned char*>(newSubMesh.m_data) + static_cast<size_t>(i) * vertexSize, vertices + static_cast<size_t>(newToOld[i]) * vertexSize, vertexSize);
+	}
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		newSubMesh.SetIndex(i, indices[i]);
+	}
+
+	statistics.vertexCountAfter = newVertexCount;
+	statistics.acmrAfter = ComputeAcmr(indices, newVertexCount);
+	return statistics;
+}
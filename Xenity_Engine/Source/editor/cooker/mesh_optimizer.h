@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <engine/graphics/3d_graphics/mesh_data.h>
+
+/**
+* @brief Reorder the triangles and the vertices of the cooked meshes to make them faster to draw
+*
+* - Identical and unused vertices are removed
+* - Triangles are reordered for the post-transform vertex cache (Tipsify)
+* - Groups of triangles are reordered to draw the outer ones first (less overdraw)
+* - Vertices are reordered in the order of first use (vertex fetch locality)
+*/
+class MeshOptimizer
+{
+public:
+	/**
+	* @brief Size of the simulated post-transform vertex cache
+	*/
+	static constexpr uint32_t s_cacheSize = 16;
+
+	/**
+	* @brief Maximum ACMR increase allowed when cutting the triangles in groups for the overdraw reordering
+	*/
+	static constexpr float s_overdrawThreshold = 1.05f;
+
+	struct Statistics
+	{
+		float acmrBefore = 0;
+		float acmrAfter = 0;
+		uint32_t vertexCountBefore = 0;
+		uint32_t vertexCountAfter = 0;
+	};
+
+	/**
+	* @brief Create an optimized copy of an indexed triangle submesh in a mesh
+	* @param source Submesh to optimize
+	* @param destination Mesh where the optimized submesh is added (uses 16 bits indices if the new vertex count allows it)
+	* @return The ACMR and the vertex count before and after the optimization (no submesh is added if there is not enough memory)
+	*/
+	static Statistics OptimizeSubMesh(const MeshData::SubMesh& source, MeshData& destination);
+
+	/**
+	* @brief Get the average number of vertices transformed per triangle (ACMR) with a FIFO cache
+	* @param indices Triangle list indices
+	* @param vertexCount Number of vertices used by the indices
+	*/
+	[[nodiscard]] static float ComputeAcmr(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = s_cacheSize);
+
+	/**
+	* @brief Make all the identical vertices use the first copy
+	* @param vertices Vertex data
+	* @param vertexCount Number of vertices
+	* @param vertexSize Size of a vertex in bytes
+	* @param indices Triangle list indices to update
+	* @return The number of removed duplicates
+	*/
+	static uint32_t DeduplicateVertices(const unsigned char* vertices, uint32_t vertexCount, uint32_t vertexSize, std::vector<uint32_t>& indices);
+
+	/**
+	* @brief Reorder the triangles for the vertex cache (Tipsify)
+	* @param indices Triangle list indices to reorder
+	* @param vertexCount Number of vertices used by the indices
+	* @param clusters Filled with the first triangle of each group that starts with a cold cache
+	*/
+	static void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& clusters, uint32_t cacheSize = s_cacheSize);
+
+	/**
+	* @brief Reorder groups of triangles to draw the outer ones first, without losing much vertex cache efficiency
+	* @param indices Triangle list indices ordered by OptimizeVertexCache
+	* @param clusters Groups given by OptimizeVertexCache
+	* @param positions Vertex positions (3 floats)
+	* @param positionStride Number of bytes between two positions
+	* @param vertexCount Number of vertices used by the indices
+	*/
+	static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters, const unsigned char* positions, uint32_t positionStride, uint32_t vertexCount);
+
+	/**
+	* @brief Renumber the vertices in the order of first use and remove the unused ones
+	* @param indices Triangle list indices to update
+	* @param vertexCount Number of vertices used by the indices
+	* @return For each new vertex, the index of the original vertex
+	*/
+	[[nodiscard]] static std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, uint32_t vertexCount);
+};
@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "mesh_quantizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <engine/graphics/3d_graphics/vertex_quantization.h>
+#include <engine/math/math.h>
+
+namespace
+{
+	[[nodiscard]] Vector3 ReadVector3(const unsigned char* data)
+	{
+		const float* values = reinterpret_cast<const float*>(data);
+		return Vector3(values[0], values[1], values[2]);
+	}
+
+	[[nodiscard]] float GetAngle(const Vector3& normal, const Vector3& decodedNormal)
+	{
+		const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		const float dot = (normal.x * decodedNormal.x + normal.y * decodedNormal.y + normal.z * decodedNormal.z) / length;
+		return std::acos(std::clamp(dot, -1.0f, 1.0f)) * 180.0f / Math::PI;
+	}
+}
+
+float MeshQuantizer::ComputeOctahedralError(const unsigned char* normals, uint32_t normalStride, uint32_t vertexCount, int32_t scale)
+{
+	float maxError = 0;
+	for (uint32_t i = 0; i < vertexCount; i++)
+	{
+		const Vector3 normal = ReadVector3(normals + static_cast<size_t>(i) * normalStride);
+
+		// Empty normals can't be encoded, they are not used by the lighting anyway
+		if (normal.x == 0 && normal.y == 0 && normal.z == 0)
+			continue;
+
+		int32_t x;
+		int32_t y;
+		VertexQuantization::QuantizeOctahedral<int32_t>(normal, scale, x, y);
+		const Vector3 decodedNormal = VertexQuantization::DecodeOctahedral(x / static_cast<float>(scale), y / static_cast<float>(scale));
+		maxError = std::max(maxError, GetAngle(normal, decodedNormal));
+	}
+	return maxError;
+}
+
+MeshQuantizer::Statistics MeshQuantizer::QuantizeSubMesh(const MeshData::SubMesh& source, MeshData& destination, float positionTolerance, float normalTolerance)
+{
+	const VertexDescriptor& sourceDescriptor = source.m_vertexDescriptor;
+	const uint32_t sourceVertexSize = sourceDescriptor.GetVertexSize();
+	const uint32_t vertexCount = source.m_vertice_count;
+	const unsigned char* vertices = static_cast<const unsigned char*>(source.m_data);
+
+	Statistics statistics;
+	statistics.vertexSizeBefore = sourceVertexSize;
+	statistics.vertexSizeAfter = sourceVertexSize;
+
+	if (vertexCount == 0)
+		return statistics;
+
+	Vector3 positionCenter;
+	Vector3 positionExtent = Vector3(1);
+	bool hasChanged = false;
+	VertexDescriptor quantizedDescriptor;
+	for (const VertexElementInfo& elementInfo : sourceDescriptor.GetVertexElementList())
+	{
+		VertexElement quantizedElement = elementInfo.vertexElement;
+		const unsigned char* elementData = vertices + elementInfo.offset;
+
+		if (elementInfo.vertexElement == VertexElement::POSITION_32_BITS)
+		{
+			Vector3 min = ReadVector3(elementData);
+			Vector3 max = min;
+			for (uint32_t i = 1; i < vertexCount; i++)
+			{
+				const Vector3 position = ReadVector3(elementData + static_cast<size_t>(i) * sourceVertexSize);
+				min = Vector3(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+				max = Vector3(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+			}
+
+			const Vector3 center = (min + max) / 2.0f;
+			Vector3 extent = (max - min) / 2.0f;
+			// A flat axis is stored as 0, any extent works
+			extent.x = extent.x > 0 ? extent.x : 1;
+			extent.y = extent.y > 0 ? extent.y : 1;
+			extent.z = extent.z > 0 ? extent.z : 1;
+
+			float maxError = 0;
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				const Vector3 position = ReadVector3(elementData + static_cast<size_t>(i) * sourceVertexSize);
+				const Vector3 normalizedPosition = (position - center) / extent;
+				const Vector3 decodedPosition = center + Vector3(VertexQuantization::DequantizeSnorm16(VertexQuantization::QuantizeSnorm16(normalizedPosition.x)),
+					VertexQuantization::DequantizeSnorm16(VertexQuantization::QuantizeSnorm16(normalizedPosition.y)),
+					VertexQuantization::DequantizeSnorm16(VertexQuantization::QuantizeSnorm16(normalizedPosition.z))) * extent;
+				maxError = std::max({ maxError, std::abs(decodedPosition.x - position.x), std::abs(decodedPosition.y - position.y), std::abs(decodedPosition.z - position.z) });
+			}
+
+			if (maxError <= positionTolerance)
+			{
+				quantizedElement = VertexElement::POSITION_16_BITS;
+				positionCenter = center;
+				positionExtent = extent;
+				statistics.positionError = maxError;
+			}
+		}
+		else if (elementInfo.vertexElement == VertexElement::UV_32_BITS)
+		{
+			// Unsigned normalized values can't store tiled UVs
+			bool isInRange = true;
+			for (uint32_t i = 0; i < vertexCount && isInRange; i++)
+			{
+				const float* uv = reinterpret_cast<const float*>(elementData + static_cast<size_t>(i) * sourceVertexSize);
+				isInRange = uv[0] >= 0 && uv[0] <= 1 && uv[1] >= 0 && uv[1] <= 1;
+			}
+
+			if (isInRange)
+			{
+				quantizedElement = VertexElement::UV_16_BITS;
+			}
+		}
+		else if (elementInfo.vertexElement == VertexElement::NORMAL_32_BITS)
+		{
+			const float error8Bits = ComputeOctahedralError(elementData, sourceVertexSize, vertexCount, 127);
+			if (error8Bits <= normalTolerance)
+			{
+				quantizedElement = VertexElement::NORMAL_OCTAHEDRAL_8_BITS;
+				statistics.normalError = error8Bits;
+			}
+			else
+			{
+				const float error16Bits = ComputeOctahedralError(elementData, sourceVertexSize, vertexCount, 32767);
+				if (error16Bits <= normalTolerance)
+				{
+					quantizedElement = VertexElement::NORMAL_OCTAHEDRAL_16_BITS;
+					statistics.normalError = error16Bits;
+				}
+			}
+		}
+
+		hasChanged = hasChanged || quantizedElement != elementInfo.vertexElement;
+		quantizedDescriptor.AddVertexElement(quantizedElement);
+	}
+
+	if (!hasChanged)
+		return statistics;
+
+	const uint32_t subMeshCount = destination.m_subMeshCount;
+	destination.CreateSubMesh(vertexCount, source.m_index_count, quantizedDescriptor);
+	if (destination.m_subMeshCount == subMeshCount)
+		return statistics;
+
+	MeshData::SubMesh& newSubMesh = *destination.m_subMeshes[destination.m_subMeshCount - 1];
+	newSubMesh.m_isQuad = source.m_isQuad;
+	if (quantizedDescriptor.GetPositionIndex() != static_cast<uint32_t>(-1) &&
+		quantizedDescriptor.GetElementFromIndex(quantizedDescriptor.GetPositionIndex()) == VertexElement::POSITION_16_BITS)
+	{
+		newSubMesh.SetPositionBounds(positionCenter, positionExtent);
+	}
+
+	const uint32_t quantizedVertexSize = quantizedDescriptor.GetVertexSize();
+	const std::vector<VertexElementInfo>& sourceElements = sourceDescriptor.GetVertexElementList();
+	const std::vector<VertexElementInfo>& quantizedElements = quantizedDescriptor.GetVertexElementList();
+	for (uint32_t i = 0; i < vertexCount; i++)
+	{
+		const unsigned char* sourceVertex = vertices + static_cast<size_t>(i) * sourceVertexSize;
+		unsigned char* quantizedVertex = static_cast<unsigned char*>(newSubMesh.m_data) + static_cast<size_t>(i) * quantizedVertexSize;
+		for (size_t elementIndex = 0; elementIndex < sourceElements.size(); elementIndex++)
+		{
+			const unsigned char* sourceData = sourceVertex + sourceElements[elementIndex].offset;
+			unsigned char* quantizedData = quantizedVertex + quantizedElements[elementIndex].offset;
+			switch (quantizedElements[elementIndex].vertexElement)
+			{
+			case VertexElement::POSITION_16_BITS:
+			{
+				const Vector3 normalizedPosition = (ReadVector3(sourceData) - positionCenter) / positionExtent;
+				int16_t* position = reinterpret_cast<int16_t*>(quantizedData);
+				position[0] = VertexQuantization::QuantizeSnorm16(normalizedPosition.x);
+				position[1] = VertexQuantization::QuantizeSnorm16(normalizedPosition.y);
+				position[2] = VertexQuantization::QuantizeSnorm16(normalizedPosition.z);
+				break;
+			}
+			case VertexElement::UV_16_BITS:
+			{
+				const float* sourceUv = reinterpret_cast<const float*>(sourceData);
+				uint16_t* uv = reinterpret_cast<uint16_t*>(quantizedData);
+				uv[0] = VertexQuantization::QuantizeUnorm16(sourceUv[0]);
+				uv[1] = VertexQuantization::QuantizeUnorm16(sourceUv[1]);
+				break;
+			}
+			case VertexElement::NORMAL_OCTAHEDRAL_8_BITS:
+			{
+				int8_t* normal = reinterpret_cast<int8_t*>(quantizedData);
+				VertexQuantization::QuantizeOctahedral<int8_t>(ReadVector3(sourceData), 127, normal[0], normal[1]);
+				break;
+			}
+			case VertexElement::NORMAL_OCTAHEDRAL_16_BITS:
+			{
+				int16_t* normal = reinterpret_cast<int16_t*>(quantizedData);
+				VertexQuantization::QuantizeOctahedral<int16_t>(ReadVector3(sourceData), 32767, normal[0], normal[1]);
+				break;
+			}
+			default:
+				memcpy(quantizedData, sourceData, VertexDescriptor::GetVertexElementSize(quantizedElements[elementIndex].vertexElement));
+				break;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < source.m_index_count; i++)
+	{
+		if (source.usesShortIndices)
+			newSubMesh.SetIndex(i, static_cast<const uint16_t*>(source.GetIndices())[i]);
+		else
+			newSubMesh.SetIndex(i, static_cast<const uint32_t*>(source.GetIndices())[i]);
+	}
+
+	statistics.vertexSizeAfter = quantizedVertexSize;
+	return statistics;
+}
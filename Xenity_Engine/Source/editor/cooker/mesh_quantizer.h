@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+
+#include <engine/graphics/3d_graphics/mesh_data.h>
+
+/**
+* @brief Store the vertices of the cooked meshes with smaller types when the precision loss is small enough
+*
+* - Positions: 16 bits normalized in the submesh bounds (POSITION_16_BITS)
+* - UVs: 16 bits unsigned normalized if all the UVs are between 0 and 1 (UV_16_BITS)
+* - Normals: octahedral encoding on 8 bits, or 16 bits if 8 bits are not precise enough
+*/
+class MeshQuantizer
+{
+public:
+	struct Statistics
+	{
+		uint32_t vertexSizeBefore = 0;
+		uint32_t vertexSizeAfter = 0;
+		float positionError = 0; // In mesh units
+		float normalError = 0; // In degrees
+	};
+
+	/**
+	* @brief Create a quantized copy of a submesh in a mesh
+	* @param source Submesh to quantize (float elements)
+	* @param destination Mesh where the quantized submesh is added
+	* @param positionTolerance Maximum position error in mesh units
+	* @param normalTolerance Maximum normal error in degrees
+	* @return The vertex size before and after the quantization (no submesh is added if nothing can be quantized or if there is not enough memory)
+	*/
+	static Statistics QuantizeSubMesh(const MeshData::SubMesh& source, MeshData& destination, float positionTolerance, float normalTolerance);
+
+	/**
+	* @brief Get the biggest angle in degrees between the normals and their quantized octahedral encoding
+	* @param normals Vertex normals (3 floats)
+	* @param normalStride Number of bytes between two normals
+	* @param vertexCount Number of vertices
+	* @param scale Maximum value of the quantized components (127 or 32767)
+	*/
+	[[nodiscard]] static float ComputeOctahedralError(const unsigned char* normals, uint32_t normalStride, uint32_t vertexCount, int32_t scale);
+};
@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "texture_encoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <stb_image_resize.h>
+
+namespace
+{
+	uint16_t PackColor565(const unsigned char* color)
+	{
+		const uint16_t r = static_cast<uint16_t>((color[0] * 31 + 127) / 255);
+		const uint16_t g = static_cast<uint16_t>((color[1] * 63 + 127) / 255);
+		const uint16_t b = static_cast<uint16_t>((color[2] * 31 + 127) / 255);
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	void UnpackColor565(uint16_t packedColor, int* color)
+	{
+		const int r = (packedColor >> 11) & 31;
+		const int g = (packedColor >> 5) & 63;
+		const int b = packedColor & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+}
+
+void TextureEncoder::EncodeBC1Block(const unsigned char* pixels, unsigned char* output)
+{
+	// Principal axis of the colors (power iteration on the covariance matrix)
+	float mean[3] = { 0, 0, 0 };
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			mean[c] += pixels[i * 4 + c];
+		}
+	}
+	for (int c = 0; c < 3; c++)
+	{
+		mean[c] /= 16.0f;
+	}
+
+	float covariance[6] = { 0, 0, 0, 0, 0, 0 }; // rr, rg, rb, gg, gb, bb
+	for (int i = 0; i < 16; i++)
+	{
+		const float r = pixels[i * 4] - mean[0];
+		const float g = pixels[i * 4 + 1] - mean[1];
+		const float b = pixels[i * 4 + 2] - mean[2];
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	float axis[3] = { 1, 1, 1 };
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+		const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+		const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+		const float length = std::max(std::max(std::abs(x), std::abs(y)), std::abs(z));
+		if (length == 0)
+			break;
+
+		axis[0] = x / length;
+		axis[1] = y / length;
+		axis[2] = z / length;
+	}
+
+	// The endpoints are the pixels at the ends of the axis
+	int minIndex = 0;
+	int maxIndex = 0;
+	float minProjection = 0;
+	float maxProjection = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		const float projection = pixels[i * 4] * axis[0] + pixels[i * 4 + 1] * axis[1] + pixels[i * 4 + 2] * axis[2];
+		if (i == 0 || projection < minProjection)
+		{
+			minProjection = projection;
+			minIndex = i;
+		}
+		if (i == 0 || projection > maxProjection)
+		{
+			maxProjection = projection;
+			maxIndex = i;
+		}
+	}
+
+	uint16_t color0 = PackColor565(&pixels[maxIndex * 4]);
+	uint16_t color1 = PackColor565(&pixels[minIndex * 4]);
+	// color0 > color1 selects the 4 colors mode
+	if (color0 < color1)
+	{
+		std::swap(color0, color1);
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1)
+	{
+		int palette[4][3];
+		UnpackColor565(color0, palette[0]);
+		UnpackColor565(color1, palette[1]);
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		for (int i = 0; i < 16; i++)
+		{
+			uint32_t bestIndex = 0;
+			int bestDistance = INT32_MAX;
+			for (uint32_t p = 0; p < 4; p++)
+			{
+				const int r = pixels[i * 4] - palette[p][0];
+				const int g = pixels[i * 4 + 1] - palette[p][1];
+				const int b = pixels[i * 4 + 2] - palette[p][2];
+				const int distance = r * r + g * g + b * b;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 2);
+		}
+	}
+
+	output[0] = static_cast<unsigned char>(color0 & 0xFF);
+	output[1] = static_cast<unsigned char>(color0 >> 8);
+	output[2] = static_cast<unsigned char>(color1 & 0xFF);
+	output[3] = static_cast<unsigned char>(color1 >> 8);
+	for (int i = 0; i < 4; i++)
+	{
+		output[4 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void TextureEncoder::EncodeBC4Block(const unsigned char* pixels, int channel, unsigned char* output)
+{
+	int minValue = 255;
+	int maxValue = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		minValue = std::min(minValue, static_cast<int>(pixels[i * 4 + channel]));
+		maxValue = std::max(maxValue, static_cast<int>(pixels[i * 4 + channel]));
+	}
+
+	// maxValue > minValue selects the 8 values mode: index 0 is the max, 1 the min, 2 to 7 go from the max to the min
+	uint64_t indices = 0;
+	if (maxValue != minValue)
+	{
+		const int range = maxValue - minValue;
+		for (int i = 0; i < 16; i++)
+		{
+			const int step = ((pixels[i * 4 + channel] - minValue) * 7 + range / 2) / range;
+			uint64_t index = 0;
+			if (step == 7)
+			{
+				index = 0;
+			}
+			else if (step == 0)
+			{
+				index = 1;
+			}
+			else
+			{
+				index = 8 - step;
+			}
+			indices |= index << (i * 3);
+		}
+	}
+
+	output[0] = static_cast<unsigned char>(maxValue);
+	output[1] = static_cast<unsigned char>(minValue);
+	for (int i = 0; i < 6; i++)
+	{
+		output[2 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void TextureEncoder::EncodeImage(const unsigned char* pixels, int width, int height, CompressedTextureFormat format, std::vector<unsigned char>& output)
+{
+	size_t outputIndex = output.size();
+	output.resize(outputIndex + CompressedTextureHeader::GetImageSize(format, width, height));
+
+	if (format == CompressedTextureFormat::RGBA8)
+	{
+		memcpy(&output[outputIndex], pixels, static_cast<size_t>(width) * height * 4);
+		return;
+	}
+
+	const size_t blockSize = CompressedTextureHeader::GetBlockSize(format);
+	unsigned char block[16 * 4];
+	for (int blockY = 0; blockY < height; blockY += 4)
+	{
+		for (int blockX = 0; blockX < width; blockX += 4)
+		{
+			for (int y = 0; y < 4; y++)
+			{
+				const int pixelY = std::min(blockY + y, height - 1);
+				for (int x = 0; x < 4; x++)
+				{
+					const int pixelX = std::min(blockX + x, width - 1);
+					memcpy(&block[(y * 4 + x) * 4], &pixels[(static_cast<size_t>(pixelY) * width + pixelX) * 4], 4);
+				}
+			}
+
+			unsigned char* blockOutput = &output[outputIndex];
+			switch (format)
+			{
+			case CompressedTextureFormat::BC1:
+				EncodeBC1Block(block, blockOutput);
+				break;
+			case CompressedTextureFormat::BC3:
+				EncodeBC4Block(block, 3, blockOutput);
+				EncodeBC1Block(block, blockOutput + 8);
+				break;
+			case CompressedTextureFormat::BC5:
+				EncodeBC4Block(block, 0, blockOutput);
+				EncodeBC4Block(block, 1, blockOutput + 8);
+				break;
+			case CompressedTextureFormat::RGBA8:
+				break;
+			}
+			outputIndex += blockSize;
+		}
+	}
+}
+
+bool TextureEncoder::HasAlpha(const unsigned char* pixels, int width, int height)
+{
+	const size_t pixelCount = static_cast<size_t>(width) * height;
+	for (size_t i = 0; i < pixelCount; i++)
+	{
+		if (pixels[i * 4 + 3] != 255)
+			return true;
+	}
+	return false;
+}
+
+std::vector<unsigned char> TextureEncoder::EncodeTexture(const unsigned char* pixels, int width, int height, CompressedTextureFormat format, bool generateMipmaps)
+{
+	CompressedTextureHeader header;
+	header.format = format;
+	header.width = static_cast<uint32_t>(width);
+	header.height = static_cast<uint32_t>(height);
+	header.mipCount = 1;
+	if (generateMipmaps)
+	{
+		int maxSize = std::max(width, height);
+		while (maxSize > 1)
+		{
+			maxSize >>= 1;
+			header.mipCount++;
+		}
+	}
+
+	std::vector<unsigned char> output(sizeof(CompressedTextureHeader));
+	memcpy(output.data(), &header, sizeof(CompressedTextureHeader));
+
+	// Each level is resized from the previous one
+	std::vector<unsigned char> levelPixels;
+	std::vector<unsigned char> nextLevelPixels;
+	const unsigned char* source = pixels;
+	int levelWidth = width;
+	int levelHeight = height;
+	for (uint32_t level = 0; level < header.mipCount; level++)
+	{
+		if (level != 0)
+		{
+			const int nextWidth = std::max(1, levelWidth / 2);
+			const int nextHeight = std::max(1, levelHeight / 2);
+			nextLevelPixels.resize(static_cast<size_t>(nextWidth) * nextHeight * 4);
+			stbir_resize_uint8(source, levelWidth, levelHeight, 0, nextLevelPixels.data(), nextWidth, nextHeight, 0, 4);
+			levelPixels.swap(nextLevelPixels);
+			source = levelPixels.data();
+			levelWidth = nextWidth;
+			levelHeight = nextHeight;
+		}
+
+		const uint32_t levelSize = static_cast<uint32_t>(CompressedTextureHeader::GetImageSize(format, levelWidth, levelHeight));
+		const size_t sizeIndex = output.size();
+		output.resize(sizeIndex + sizeof(uint32_t));
+		memcpy(&output[sizeIndex], &levelSize, sizeof(uint32_t));
+		EncodeImage(source, levelWidth, levelHeight, format, output);
+	}
+
+	return output;
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <engine/graphics/texture/compressed_texture.h>
+
+/**
+* @brief Encode the cooked textures in block compression formats (BC1, BC3, BC5) or in RGBA8 with their mip levels
+*
+* The endpoints of a color block are the two pixels at the ends of the principal axis of the block colors.
+* The single channel blocks (BC3 alpha, BC5 red and green) use the minimum and the maximum of the block.
+*/
+class TextureEncoder
+{
+public:
+	/**
+	* @brief Encode the RGB of a 4x4 block in BC1
+	* @param pixels 16 RGBA pixels (row by row)
+	* @param output 8 bytes
+	*/
+	static void EncodeBC1Block(const unsigned char* pixels, unsigned char* output);
+
+	/**
+	* @brief Encode one channel of a 4x4 block in BC4 (BC3 alpha and BC5 channels)
+	* @param pixels 16 RGBA pixels (row by row)
+	* @param channel Channel to encode (0 to 3)
+	* @param output 8 bytes
+	*/
+	static void EncodeBC4Block(const unsigned char* pixels, int channel, unsigned char* output);
+
+	/**
+	* @brief Encode a RGBA image, the pixels outside the image repeat the last row and column (RGBA8 copies the pixels)
+	* @param output The blocks are added at the end
+	*/
+	static void EncodeImage(const unsigned char* pixels, int width, int height, CompressedTextureFormat format, std::vector<unsigned char>& output);
+
+	/**
+	* @brief Get if an RGBA image has a pixel that is not fully opaque
+	*/
+	[[nodiscard]] static bool HasAlpha(const unsigned char* pixels, int width, int height);
+
+	/**
+	* @brief Create a compressed texture file (see CompressedTextureHeader)
+	* @param pixels RGBA image
+	* @param generateMipmaps If true, all the levels down to 1x1 are added
+	*/
+	[[nodiscard]] static std::vector<unsigned char> EncodeTexture(const unsigned char* pixels, int width, int height, CompressedTextureFormat format, bool generateMipmaps);
+};
@@ -13,6 +13,7 @@
 #include <engine/graphics/2d_graphics/sprite_manager.h>
 #include <engine/graphics/graphics.h>
 #include <engine/graphics/camera.h>
+#include <engine/graphics/debug_draw.h>
 
 #include <engine/engine.h>
 #include <engine/game_elements/transform.h>
@@ -34,25 +35,8 @@ void Gizmo::DrawLine(const Vector3& a, const Vector3& b)
 {
 	STACK_DEBUG_OBJECT(STACK_LOW_PRIORITY);
 
-	Vector3 aCopy = a;
-	Vector3 bCopy = b;
-	aCopy.x = -aCopy.x;
-	bCopy.x = -bCopy.x;
-
-	// Currently lines do not support shaders
-	if constexpr (!s_UseOpenGLFixedFunctions)
-	{
-		Engine::GetRenderer().UseShaderProgram(0);
-		Graphics::s_currentShader = nullptr;
-		Graphics::s_currentMaterial = nullptr;
-	}
-
-	RenderingSettings renderSettings = RenderingSettings();
-	renderSettings.renderingMode = MaterialRenderingMode::Transparent;
-	renderSettings.useDepth = false;
-	renderSettings.useLighting = false;
-	renderSettings.useTexture = false;
-	Engine::GetRenderer().DrawLine(aCopy, bCopy, s_color, renderSettings);
+	// Drawn with the other lines of the camera
+	DebugDraw::DrawLine(a, b, s_color, false);
 }
 
 void Gizmo::DrawBillboard(const Vector3& position, const Vector2& scale, const std::shared_ptr<Texture>& texture, const Color& color)
@@ -80,7 +80,10 @@ void GameMenu::Draw()
 				camera->ChangeFrameBufferSize(Vector2Int(static_cast<int>(m_startAvailableSize.x), static_cast<int>(m_startAvailableSize.y)));
 				lastSize = m_startAvailableSize;
 			}
-			ImGui::Image((ImTextureID)camera->m_secondFramebufferTexture, ImVec2(m_startAvailableSize.x, m_startAvailableSize.y), ImVec2(0, 1), ImVec2(1, 0));
+			// Only show the rendered part of the frame buffer (dynamic resolution)
+			const float renderedWidth = static_cast<float>(camera->GetRenderWidth()) / camera->GetWidth();
+			const float renderedHeight = static_cast<float>(camera->GetRenderHeight()) / camera->GetHeight();
+			ImGui::Image((ImTextureID)camera->m_secondFramebufferTexture, ImVec2(m_startAvailableSize.x, m_startAvailableSize.y), ImVec2(0, renderedHeight), ImVec2(renderedWidth, 0));
 		}
 		else
 		{
@@ -16,6 +16,7 @@
 #include <engine/debug/performance.h>
 #include <engine/debug/memory_tracker.h>
 #include <engine/asset_management/asset_manager.h>
+#include <engine/asset_management/residency_manager.h>
 #include <engine/file_system/file.h>
 #include <engine/debug/memory_info.h>
 #include <editor/ui/editor_ui.h>
@@ -41,7 +42,8 @@ void ProfilerMenu::Draw()
 
 		ImGui::Text("DrawCalls Count: %d", Performance::GetDrawCallCount());
 		ImGui::Text("Triangles Count: %d", Performance::GetDrawTrianglesCount());
-		ImGui::Text("Materials update count: %d", Performance::GetUpdatedMaterialCount());
+		ImGui::Text("Materials update count: %d (skipped: %d)", Performance::GetUpdatedMaterialCount(), Performance::GetSkippedMaterialUpdateCount());
+		ImGui::Text("GL state changes: %d issued, %d filtered", Performance::GetIssuedStateChangeCount(), Performance::GetFilteredStateChangeCount());
 
 		DrawMemoryStats();
 
@@ -141,6 +143,12 @@ void ProfilerMenu::DrawMemoryStats()
 		ImGui::Text("Current allocation: %zu Bytes, Total: %zu Bytes", textureMem->m_allocatedMemory - textureMem->m_deallocatedMemory, textureMem->m_allocatedMemory);
 		ImGui::Text("Current allocation: %f MegaBytes, Total: %f MegaBytes,", (textureMem->m_allocatedMemory - textureMem->m_deallocatedMemory) / 1000000.0f, textureMem->m_allocatedMemory / 1000000.0f);
 		ImGui::Text("Alloc count: %zu, Delete count: %zu", textureMem->m_allocCount, textureMem->m_deallocCount);
+
+		const MemoryTracker* residentMem = Performance::s_residentAssetMemoryTracker;
+		ImGui::Separator();
+		ImGui::Text("%s:", residentMem->m_name.c_str());
+		ImGui::Text("Current allocation: %f MegaBytes, Budget: %f MegaBytes", (residentMem->m_allocatedMemory - residentMem->m_deallocatedMemory) / 1000000.0f, ResidencyManager::GetBudget() / 1000000.0f);
+		ImGui::Text("Track count: %zu, Untrack count: %zu", residentMem->m_allocCount, residentMem->m_deallocCount);
 #endif
 	}
 }
@@ -46,6 +46,7 @@ std::shared_ptr<Shader> AssetManager::standardShader = nullptr;
 std::shared_ptr<Shader> AssetManager::standardShaderNoPointLight = nullptr;
 #endif
 std::shared_ptr<Shader> AssetManager::unlitShader = nullptr;
+std::shared_ptr<Shader> AssetManager::skyboxShader = nullptr;
 std::shared_ptr<Material> AssetManager::standardMaterial = nullptr;
 std::shared_ptr<Material> AssetManager::unlitMaterial = nullptr;
 
@@ -74,6 +75,7 @@ void AssetManager::Clear()
 	standardShaderNoPointLight.reset();
 #endif
 	unlitShader.reset();
+	skyboxShader.reset();
 
 	standardMaterial.reset();
 	unlitMaterial.reset();
@@ -107,6 +109,10 @@ void AssetManager::OnProjectLoaded()
 		unlitShader = AssetManager::LoadEngineAsset<Shader>("public_engine_assets/shaders/unlit.shader");
 		XCHECK(unlitShader != nullptr, "[AssetManager::OnProjectLoaded] Unlit Shader is null");
 		unlitShader->LoadFileReference(loadOptions);
+
+		skyboxShader = AssetManager::LoadEngineAsset<Shader>("public_engine_assets/shaders/skybox.shader");
+		XCHECK(skyboxShader != nullptr, "[AssetManager::OnProjectLoaded] Skybox Shader is null");
+		skyboxShader->LoadFileReference(loadOptions);
 	}
 
 	// Load materials
@@ -477,7 +483,7 @@ void AssetManager::RemoveUnusedFiles()
 		std::shared_ptr<FileReference> fileRef = GetFileReference(i);
 		const int refCount = fileRef.use_count();
 		// If the reference count is 2 (fileRef variable and the reference in the asset manager)
-#if defined(EDITOR) // Do not unload files in the editor to avoid freezes TODO: Make a cache system to reduce memory usage
+#if defined(EDITOR) // Do not unload files in the editor to avoid freezes, the ResidencyManager frees the unused textures and meshes
 		if (refCount == 1)
 #else
 		if (refCount == 2)
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "residency_manager.h"
+
+#include <algorithm>
+
+#include <engine/engine.h>
+#include <engine/application.h>
+#include <engine/asset_management/asset_manager.h>
+#include <engine/graphics/graphics.h>
+#include <engine/graphics/texture/texture.h>
+#include <engine/graphics/3d_graphics/mesh_data.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/memory_tracker.h>
+#include <engine/debug/performance.h>
+#include <engine/debug/stack_debug_object.h>
+#include <engine/tools/scope_benchmark.h>
+
+#if defined(__PSP__)
+size_t ResidencyManager::s_budget = 16 * 1024 * 1024;
+#elif defined(_EE)
+size_t ResidencyManager::s_budget = 16 * 1024 * 1024;
+#elif defined(__vita__)
+size_t ResidencyManager::s_budget = 128 * 1024 * 1024;
+#elif defined(__PS3__)
+size_t ResidencyManager::s_budget = 128 * 1024 * 1024;
+#else
+size_t ResidencyManager::s_budget = static_cast<size_t>(1024) * 1024 * 1024;
+#endif
+size_t ResidencyManager::s_residentSize = 0;
+uint64_t ResidencyManager::s_currentFrame = 1;
+std::vector<FileReference*> ResidencyManager::s_residentFiles;
+std::vector<FileReference*> ResidencyManager::s_reloadRequests;
+
+std::vector<size_t> ResidencyManager::SelectEvictions(const std::vector<Candidate>& candidates, size_t residentSize, size_t budget, uint64_t currentFrame)
+{
+	std::vector<size_t> evictions;
+	if (residentSize <= budget)
+		return evictions;
+
+	std::vector<size_t> order;
+	order.reserve(candidates.size());
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		if (currentFrame - candidates[i].lastUsedFrame >= s_minUnusedFrameCount)
+		{
+			order.push_back(i);
+		}
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&candidates](size_t a, size_t b)
+		{
+			return candidates[a].lastUsedFrame < candidates[b].lastUsedFrame;
+		});
+
+	for (size_t index : order)
+	{
+		if (residentSize <= budget)
+			break;
+
+		evictions.push_back(index);
+		residentSize -= std::min(residentSize, candidates[index].size);
+	}
+	return evictions;
+}
+
+void ResidencyManager::OnUsedWhileNotResident(FileReference& fileReference)
+{
+	switch (fileReference.m_residencyState)
+	{
+	case ResidencyState::Untracked:
+	{
+		const FileType fileType = fileReference.GetFileType();
+		// The assets without file can't be reloaded, the default texture is drawn instead of the textures that are not loaded
+		if (!fileReference.m_file || (fileType != FileType::File_Texture && fileType != FileType::File_Mesh) ||
+			&fileReference == AssetManager::defaultTexture.get())
+		{
+			fileReference.m_residencyState = ResidencyState::Ignored;
+		}
+		else if (fileReference.GetFileStatus() == FileStatus::FileStatus_Loaded)
+		{
+			fileReference.m_residentSize = ComputeSize(fileReference);
+			fileReference.m_residencyState = ResidencyState::Resident;
+			s_residentSize += fileReference.m_residentSize;
+			s_residentFiles.push_back(&fileReference);
+#if defined(DEBUG)
+			Performance::s_residentAssetMemoryTracker->Allocate(fileReference.m_residentSize);
+#endif
+		}
+		break;
+	}
+	case ResidencyState::Evicted:
+		fileReference.m_residencyState = ResidencyState::ReloadRequested;
+		s_reloadRequests.push_back(&fileReference);
+		break;
+	default:
+		break;
+	}
+}
+
+void ResidencyManager::Forget(FileReference& fileReference)
+{
+	// The lists may already be destroyed when the engine stops
+	if (!Engine::IsRunning(false))
+		return;
+
+	if (fileReference.m_residencyState == ResidencyState::Resident)
+	{
+		s_residentFiles.erase(std::find(s_residentFiles.begin(), s_residentFiles.end(), &fileReference));
+		s_residentSize -= fileReference.m_residentSize;
+#if defined(DEBUG)
+		Performance::s_residentAssetMemoryTracker->Deallocate(fileReference.m_residentSize);
+#endif
+	}
+	else if (fileReference.m_residencyState == ResidencyState::ReloadRequested)
+	{
+		s_reloadRequests.erase(std::find(s_reloadRequests.begin(), s_reloadRequests.end(), &fileReference));
+	}
+
+	if (fileReference.m_residencyState != ResidencyState::Ignored)
+	{
+		fileReference.m_residencyState = ResidencyState::Untracked;
+	}
+	fileReference.m_residentSize = 0;
+}
+
+size_t ResidencyManager::ComputeSize(FileReference& fileReference)
+{
+	size_t size = 0;
+	if (fileReference.GetFileType() == FileType::File_Texture)
+	{
+		const Texture& texture = static_cast<const Texture&>(fileReference);
+		if (texture.m_isCompressed)
+		{
+			// Size of the uploaded levels
+			size = texture.m_compressedHeader.GetLevelsSize(0);
+		}
+		else
+		{
+			// Approximation with 4 bytes per pixel, the mipmaps add a third
+			size = static_cast<size_t>(texture.GetWidth()) * texture.GetHeight() * 4;
+			if (texture.GetUseMipmap())
+			{
+				size += size / 3;
+			}
+		}
+	}
+	else
+	{
+		const MeshData& meshData = static_cast<const MeshData&>(fileReference);
+		for (uint32_t i = 0; i < meshData.m_subMeshCount; i++)
+		{
+			size += static_cast<size_t>(meshData.m_subMeshes[i]->m_vertexMemSize) + meshData.m_subMeshes[i]->m_indexMemSize;
+		}
+	}
+	return size;
+}
+
+bool ResidencyManager::CanEvict(FileReference& fileReference)
+{
+	// The sprite selections are lost when a texture is unloaded
+	if (fileReference.GetFileType() == FileType::File_Texture)
+	{
+		return static_cast<Texture&>(fileReference).spriteSelections.empty();
+	}
+	return true;
+}
+
+void ResidencyManager::Evict(FileReference& fileReference)
+{
+	Forget(fileReference);
+
+	if (fileReference.GetFileType() == FileType::File_Texture)
+	{
+		static_cast<Texture&>(fileReference).UnloadFileReference();
+	}
+	else
+	{
+		// Only free the data, the render commands still use the submeshes
+		MeshData& meshData = static_cast<MeshData&>(fileReference);
+		for (uint32_t i = 0; i < meshData.m_subMeshCount; i++)
+		{
+			meshData.m_subMeshes[i]->FreeData();
+		}
+	}
+	fileReference.m_residencyState = ResidencyState::Evicted;
+}
+
+void ResidencyManager::Reload(FileReference& fileReference)
+{
+	fileReference.m_residencyState = ResidencyState::Untracked;
+
+	FileReference::LoadOptions loadOptions;
+	loadOptions.platform = Application::GetPlatform();
+	loadOptions.threaded = false;
+	loadOptions.forceDisableAsync = true;
+
+	if (fileReference.GetFileType() == FileType::File_Texture)
+	{
+		fileReference.LoadFileReference(loadOptions);
+	}
+	else
+	{
+		// The submeshes are created again, the render commands of the drawables using the mesh have to be recreated
+		MeshData& meshData = static_cast<MeshData&>(fileReference);
+		meshData.Unload();
+		meshData.SetFileStatus(FileStatus::FileStatus_Not_Loaded);
+		meshData.LoadFileReference(loadOptions);
+		Graphics::SetDrawablesDirty(meshData);
+	}
+}
+
+void ResidencyManager::Update()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	SCOPED_PROFILER("ResidencyManager::Update", scopeBenchmark);
+
+	// Reload may add reload requests, swap the list first
+	std::vector<FileReference*> reloadRequests;
+	reloadRequests.swap(s_reloadRequests);
+	for (FileReference* fileReference : reloadRequests)
+	{
+		Reload(*fileReference);
+	}
+
+	if (s_residentSize > s_budget)
+	{
+		std::vector<FileReference*> evictableFiles;
+		std::vector<Candidate> candidates;
+		evictableFiles.reserve(s_residentFiles.size());
+		candidates.reserve(s_residentFiles.size());
+		for (FileReference* fileReference : s_residentFiles)
+		{
+			if (CanEvict(*fileReference))
+			{
+				evictableFiles.push_back(fileReference);
+				candidates.push_back({ fileReference->m_lastUsedFrame, fileReference->m_residentSize });
+			}
+		}
+
+		const std::vector<size_t> evictions = SelectEvictions(candidates, s_residentSize, s_budget, s_currentFrame);
+		for (size_t index : evictions)
+		{
+			Evict(*evictableFiles[index]);
+		}
+	}
+
+	s_currentFrame++;
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <engine/api.h>
+#include <engine/file_system/file_reference.h>
+
+/**
+* @brief Keep the memory used by the textures and the meshes under a budget
+*
+* The textures and meshes drawn with Graphics::DrawSubMesh are tracked with the frame of their last draw.
+* When the budget is exceeded, the least recently used ones are evicted (GPU and CPU copies) even if they are still referenced.
+* An evicted asset is reloaded at the end of the frame where something tries to draw it again.
+* Evicted meshes keep their submeshes (without data) so the render commands stay valid until the reload.
+*/
+class API ResidencyManager
+{
+public:
+	struct Candidate
+	{
+		uint64_t lastUsedFrame = 0;
+		size_t size = 0;
+	};
+
+	/**
+	* @brief Set the memory budget of the textures and meshes
+	* @param budget Size in bytes
+	*/
+	static void SetBudget(size_t budget)
+	{
+		s_budget = budget;
+	}
+
+	/**
+	* @brief Get the memory budget of the textures and meshes in bytes
+	*/
+	[[nodiscard]] static size_t GetBudget()
+	{
+		return s_budget;
+	}
+
+	/**
+	* @brief Get the memory used by the tracked textures and meshes in bytes
+	*/
+	[[nodiscard]] static size_t GetResidentSize()
+	{
+		return s_residentSize;
+	}
+
+	/**
+	* @brief Get the assets to evict to go under the budget, the least recently used first
+	* @param candidates Assets that can be evicted
+	* @param residentSize Memory used by all the tracked assets
+	* @param budget Memory budget
+	* @param currentFrame Current frame, the assets used in the last s_minUnusedFrameCount frames are kept
+	* @return Indices of the candidates to evict
+	*/
+	[[nodiscard]] static std::vector<size_t> SelectEvictions(const std::vector<Candidate>& candidates, size_t residentSize, size_t budget, uint64_t currentFrame);
+
+	/**
+	* @brief Number of frames without draw before an asset can be evicted (avoids reloading the assets of the cameras that do not render every frame)
+	*/
+	static constexpr uint64_t s_minUnusedFrameCount = 120;
+
+private:
+	friend class Engine;
+	friend class Graphics;
+	friend class FileReference;
+	friend class Texture;
+	friend class MeshData;
+
+	/**
+	* @brief [Internal] Mark a texture or a mesh as drawn this frame
+	*/
+	static void MarkUsed(FileReference& fileReference)
+	{
+		fileReference.m_lastUsedFrame = s_currentFrame;
+		if (fileReference.m_residencyState != ResidencyState::Resident)
+		{
+			OnUsedWhileNotResident(fileReference);
+		}
+	}
+
+	/**
+	* @brief [Internal] Stop tracking an asset (unloaded or destroyed by something else)
+	*/
+	static void Forget(FileReference& fileReference);
+
+	/**
+	* @brief [Internal] Reload the evicted assets drawn this frame and evict the least recently used assets if the budget is exceeded
+	*/
+	static void Update();
+
+	static void OnUsedWhileNotResident(FileReference& fileReference);
+	[[nodiscard]] static size_t ComputeSize(FileReference& fileReference);
+	[[nodiscard]] static bool CanEvict(FileReference& fileReference);
+	static void Evict(FileReference& fileReference);
+	static void Reload(FileReference& fileReference);
+
+	static size_t s_budget;
+	static size_t s_residentSize;
+	static uint64_t s_currentFrame;
+	static std::vector<FileReference*> s_residentFiles;
+	static std::vector<FileReference*> s_reloadRequests;
+};
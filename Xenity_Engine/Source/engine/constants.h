@@ -9,6 +9,18 @@
 //#define ENABLE_EXPERIMENTAL_FEATURES // Enable features that are not fully tested or implemented
 //#define ENABLE_OVERDRAW_OPTIMIZATION // Enable overdraw optimization (currently not great)
 //#define ENABLE_SHADER_VARIANT_OPTIMIZATION // Enable shader variant optimization (currently effective only on PS3, WIP)
+#define ENABLE_HARDWARE_INSTANCING // Draw the opaque meshes sharing the same submesh and material with one instanced draw call (when supported by the renderer)
+#define ENABLE_SPRITE_BATCHING // Draw the consecutive sprites and images sharing the same texture with one draw call (when supported by the renderer)
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+#define ENABLE_JOB_SYSTEM // Use worker threads for the parallel loops and the background jobs (see JobSystem)
+#define ENABLE_MULTITHREADED_CULLING // Split the frustum culling of large mesh renderer lists between several threads
+#define ENABLE_MULTITHREADED_PARTICLES // Simulate the particle systems on several threads
+#endif
+
+#if !defined(__PSP__) && !defined(_EE)
+#define ENABLE_OCCLUSION_CULLING // Cull the mesh renderers hidden behind the occluders (mesh renderers with isOccluder enabled) with a CPU depth buffer
+#endif
 
 #if defined(__PS3__)
 //#define ENABLE_OVERDRAW_OPTIMIZATION
@@ -24,6 +24,9 @@
 int Performance::s_drawCallCount = 0;
 int Performance::s_drawTriangleCount = 0;
 int Performance::s_updatedMaterialCount = 0;
+int Performance::s_skippedMaterialUpdateCount = 0;
+int Performance::s_issuedStateChangeCount = 0;
+int Performance::s_filteredStateChangeCount = 0;
 uint32_t Performance::s_currentProfilerFrame = 0;
 uint32_t Performance::s_currentFrame = 0;
 bool Performance::s_isPaused = false;
@@ -35,10 +38,13 @@ int Performance::s_tickCount = 0;
 float Performance::s_averageCoolDown = 0;
 int Performance::s_lastDrawCallCount = 0;
 int Performance::s_lastDrawTriangleCount = 0;
+int Performance::s_lastIssuedStateChangeCount = 0;
+int Performance::s_lastFilteredStateChangeCount = 0;
 std::string Performance::nextProfilerFileName = "";
 MemoryTracker* Performance::s_gameObjectMemoryTracker = nullptr;
 MemoryTracker* Performance::s_meshDataMemoryTracker = nullptr;
 MemoryTracker* Performance::s_textureMemoryTracker = nullptr;
+MemoryTracker* Performance::s_residentAssetMemoryTracker = nullptr;
 uint32_t Performance::s_benchmarkScopeLevel = 0;
 
 #pragma region Update values
@@ -55,6 +61,7 @@ void Performance::Init()
 	s_gameObjectMemoryTracker = new MemoryTracker("GameObjects");
 	s_meshDataMemoryTracker = new MemoryTracker("Mesh Data");
 	s_textureMemoryTracker = new MemoryTracker("Textures");
+	s_residentAssetMemoryTracker = new MemoryTracker("Resident Textures and Meshes");
 #endif
 }
 
@@ -65,8 +72,13 @@ void Performance::ResetCounters()
 	s_drawCallCount = 0;
 	s_lastDrawTriangleCount = s_drawTriangleCount;
 	s_drawTriangleCount = 0;
+	s_lastIssuedStateChangeCount = s_issuedStateChangeCount;
+	s_issuedStateChangeCount = 0;
+	s_lastFilteredStateChangeCount = s_filteredStateChangeCount;
+	s_filteredStateChangeCount = 0;
 
 	s_updatedMaterialCount = 0;
+	s_skippedMaterialUpdateCount = 0;
 	ResetProfiler();
 }
 
@@ -88,6 +100,24 @@ void Performance::AddMaterialUpdate()
 	s_updatedMaterialCount++;
 }
 
+void Performance::AddSkippedMaterialUpdate()
+{
+	STACK_DEBUG_OBJECT(STACK_VERY_LOW_PRIORITY);
+	s_skippedMaterialUpdateCount++;
+}
+
+void Performance::AddIssuedStateChange()
+{
+	STACK_DEBUG_OBJECT(STACK_VERY_LOW_PRIORITY);
+	s_issuedStateChangeCount++;
+}
+
+void Performance::AddFilteredStateChange()
+{
+	STACK_DEBUG_OBJECT(STACK_VERY_LOW_PRIORITY);
+	s_filteredStateChangeCount++;
+}
+
 #pragma endregion
 
 #pragma region Getters
@@ -110,6 +140,24 @@ int Performance::GetUpdatedMaterialCount()
 	return s_updatedMaterialCount;
 }
 
+int Performance::GetSkippedMaterialUpdateCount()
+{
+	STACK_DEBUG_OBJECT(STACK_VERY_LOW_PRIORITY);
+	return s_skippedMaterialUpdateCount;
+}
+
+int Performance::GetIssuedStateChangeCount()
+{
+	STACK_DEBUG_OBJECT(STACK_VERY_LOW_PRIORITY);
+	return s_lastIssuedStateChangeCount;
+}
+
+int Performance::GetFilteredStateChangeCount()
+{
+	STACK_DEBUG_OBJECT(STACK_VERY_LOW_PRIORITY);
+	return s_lastFilteredStateChangeCount;
+}
+
 void Performance::Update()
 {
 	STACK_DEBUG_OBJECT(STACK_LOW_PRIORITY);
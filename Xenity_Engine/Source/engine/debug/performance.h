@@ -133,6 +133,21 @@ public:
 	*/
 	static void AddMaterialUpdate();
 
+	/**
+	* @brief Add one to the skipped material update counter (the uniforms were already in the shader)
+	*/
+	static void AddSkippedMaterialUpdate();
+
+	/**
+	* @brief Add one to the counter of OpenGL state changes sent to the driver
+	*/
+	static void AddIssuedStateChange();
+
+	/**
+	* @brief Add one to the counter of OpenGL state changes filtered by the state cache (the state was already set)
+	*/
+	static void AddFilteredStateChange();
+
 	/**
 	* @brief Get draw call count
 	*/
@@ -148,6 +163,21 @@ public:
 	*/
 	[[nodiscard]] static int GetUpdatedMaterialCount();
 
+	/**
+	* @brief Get skipped material update count
+	*/
+	[[nodiscard]] static int GetSkippedMaterialUpdateCount();
+
+	/**
+	* @brief Get the number of OpenGL state changes sent to the driver during the last frame
+	*/
+	[[nodiscard]] static int GetIssuedStateChangeCount();
+
+	/**
+	* @brief Get the number of OpenGL state changes filtered by the state cache during the last frame
+	*/
+	[[nodiscard]] static int GetFilteredStateChangeCount();
+
 	/**
 	* @brief Update the profiler (To call every frame)
 	*/
@@ -171,6 +201,7 @@ public:
 	static MemoryTracker* s_gameObjectMemoryTracker;
 	static MemoryTracker* s_meshDataMemoryTracker;
 	static MemoryTracker* s_textureMemoryTracker;
+	static MemoryTracker* s_residentAssetMemoryTracker;
 	static uint32_t s_benchmarkScopeLevel;
 
 	static void CheckIfSavingIsNeeded();
@@ -191,6 +222,11 @@ private:
 	static int s_lastDrawCallCount;
 	static int s_lastDrawTriangleCount;
 	static int s_updatedMaterialCount;
+	static int s_skippedMaterialUpdateCount;
+	static int s_issuedStateChangeCount;
+	static int s_filteredStateChangeCount;
+	static int s_lastIssuedStateChangeCount;
+	static int s_lastFilteredStateChangeCount;
 
 	static int s_tickCount;
 	static float s_averageCoolDown;
@@ -42,6 +42,7 @@
 #include <engine/graphics/renderer/renderer_vu1.h>
 #include <engine/graphics/renderer/renderer_gu.h>
 #include <engine/graphics/renderer/renderer_rsx.h>
+#include <engine/graphics/renderer/renderer_null.h>
 
 // Audio
 #include <engine/audio/audio_manager.h>
@@ -63,6 +64,8 @@
 #include <engine/file_system/file_system.h>
 #include <engine/asset_management/asset_manager.h>
 #include <engine/asset_management/project_manager.h>
+#include <engine/asset_management/residency_manager.h>
+#include <engine/graphics/texture/texture_streaming.h>
 #include <engine/file_system/async_file_loading.h>
 
 // Debug, Tests & Profiling
@@ -71,6 +74,8 @@
 #include <unit_tests/unit_test_manager.h>
 #include <engine/tools/profiler_benchmark.h>
 #include <engine/tools/scope_benchmark.h>
+#include <engine/tools/benchmark.h>
+#include <engine/tools/job_system.h>
 #include <engine/debug/stack_debug_object.h>
 #include <engine/debug/crash_handler.h>
 
@@ -84,6 +89,7 @@
 #include <engine/graphics/graphics.h>
 #include <engine/graphics/2d_graphics/sprite_manager.h>
 #include <engine/graphics/frame_limiter/frame_limiter.h>
+#include <engine/graphics/dynamic_resolution.h>
 #include <engine/ui/screen.h>
 
 // Time
@@ -169,18 +175,25 @@ int Engine::Init(int argc, char* argv[])
 	Performance::Init();
 
 	//------------------------------------------ Init renderer
+	if (s_engineArgs.useNullRenderer)
+	{
+		s_renderer = std::make_unique<RendererNull>();
+	}
+	else
+	{
 #if defined(_EE)
-	// renderer = std::make_unique<RendererGsKit>();
-	s_renderer = std::make_unique<RendererVU1>();
+		// renderer = std::make_unique<RendererGsKit>();
+		s_renderer = std::make_unique<RendererVU1>();
 #elif defined(__PSP__)
-	s_renderer = std::make_unique<RendererGU>();
+		s_renderer = std::make_unique<RendererGU>();
 #elif defined(_WIN32) | defined(_WIN64) || defined(__vita__) || defined(__LINUX__)
-	s_renderer = std::make_unique<RendererOpengl>();
+		s_renderer = std::make_unique<RendererOpengl>();
 #elif defined(__PS3__)
-	s_renderer = std::make_unique<RendererRSX>();
+		s_renderer = std::make_unique<RendererRSX>();
 #else
 #error "No renderer defined for this platform" 
 #endif
+	}
 
 	if (s_renderer)
 	{
@@ -359,6 +372,8 @@ void Engine::Loop()
 #endif
 	Time::Reset();
 	s_canUpdateAudio = true;
+	// CPU time of the frame without the waits (frame limiter and vsync), used by the dynamic resolution
+	Benchmark cpuFrameBenchmark;
 	while (s_isRunning)
 	{
 		{
@@ -366,6 +381,7 @@ void Engine::Loop()
 
 			// Update time, inputs and network
 			Time::UpdateTime();
+			cpuFrameBenchmark.Start();
 			InputSystem::ClearInputs();
 			NetworkManager::Update();
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
@@ -445,7 +461,15 @@ void Engine::Loop()
 				s_canUpdateAudio = true;
 
 				// Draw
+				s_renderer->BeginGpuTimer();
 				Graphics::Draw();
+				s_renderer->EndGpuTimer();
+
+				// Reload the evicted assets drawn this frame and free the memory of the least recently used ones
+				ResidencyManager::Update();
+
+				// Upload the decoded mip levels and start the decoding of the newly requested ones
+				TextureStreaming::Update();
 
 				if (!Screen::nextScreenshotFileName.empty())
 				{
@@ -478,6 +502,10 @@ void Engine::Loop()
 			}
 
 			InputSystem::s_blockGameInput = false;
+
+			cpuFrameBenchmark.Stop();
+			DynamicResolution::Update(cpuFrameBenchmark.GetMicroSeconds() / 1000.0f, s_renderer->GetGpuFrameTime());
+
 			FrameLimiter::Wait();
 		}
 
@@ -514,6 +542,7 @@ void Engine::Stop()
 	SpriteManager::Close();
 	PhysicsManager::Stop();
 	Graphics::Stop();
+	JobSystem::Stop();
 	if (s_renderer)
 	{
 		s_renderer->Stop();
@@ -589,6 +618,19 @@ void Engine::ParseEngineArguments(int argc, char* argv[])
 					s_engineArgs.runningOnDevKit = false;
 				}
 			}
+			else if (paramName == "renderer")
+			{
+				if (value == "null")
+				{
+#if defined(EDITOR)
+					// The editor UI needs a real OpenGL context
+					Debug::PrintWarning("-------- The null renderer is not available in the editor --------", true);
+#else
+					s_engineArgs.useNullRenderer = true;
+					Debug::Print("-------- Using null renderer --------", true);
+#endif
+				}
+			}
 		}
 		else
 		{
@@ -22,4 +22,6 @@ class EngineArgs
 public:
 	std::string executableLocation;
 	bool runningOnDevKit = false;
+	// Use the null renderer and null shaders (no GPU and no window needed), set with "renderer=null"
+	bool useNullRenderer = false;
 };
\ No newline at end of file
@@ -25,8 +25,8 @@ void AsyncFileLoading::FinishThreadedFileLoading()
 		if (s_threadLoadedFiles[i]->GetFileStatus() != FileStatus::FileStatus_Loading)
 		{
 			s_threadLoadedFiles[i]->OnLoadFileReferenceFinished();
+			Graphics::SetDrawablesDirty(*s_threadLoadedFiles[i]);
 			s_threadLoadedFiles.erase(s_threadLoadedFiles.begin() + i);
-			Graphics::s_isRenderingBatchDirty = true; // Move this in a better location ???
 			threadFileCount--;
 			i--;
 		}
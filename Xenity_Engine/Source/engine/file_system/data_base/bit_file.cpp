@@ -80,8 +80,7 @@ unsigned char* BitFile::ReadBinary(const FileReference& fileReference)
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
-	unsigned char* data = m_file->ReadBinary(fileReference.m_filePosition, fileReference.m_fileSize);
-	return data;
+	return ReadBinary(fileReference.m_filePosition, fileReference.m_fileSize);
 }
 
 
@@ -89,6 +88,7 @@ unsigned char* BitFile::ReadBinary(size_t offset, size_t size)
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
+	std::lock_guard<std::mutex> lock(m_readMutex);
 	unsigned char* data = m_file->ReadBinary(offset, size);
 	return data;
 }
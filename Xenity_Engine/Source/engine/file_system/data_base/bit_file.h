@@ -4,6 +4,7 @@
 #include <vector>
 #include <stdint.h>
 #include <memory>
+#include <mutex>
 
 class File;
 class FileReference;
@@ -43,7 +44,7 @@ public:
 	[[nodiscard]] size_t AddData(const unsigned char* data, size_t size);
 
 	/**
-	* @brief Read binary data
+	* @brief Read binary data (can be called from any thread)
 	*/
 	[[nodiscard]] unsigned char* ReadBinary(size_t offset, size_t size);
 
@@ -57,5 +58,6 @@ public:
 private:
 	std::shared_ptr<File> m_file;
 	size_t m_fileSize = 0;
+	std::mutex m_readMutex; // The reads move the position of the file, the textures are read from the worker threads
 };
 
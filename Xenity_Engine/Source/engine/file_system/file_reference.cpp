@@ -9,7 +9,9 @@
 #include <engine/file_system/data_base/file_data_base.h>
 #include <engine/asset_management/project_manager.h>
 #include <engine/asset_management/asset_manager.h>
+#include <engine/asset_management/residency_manager.h>
 #include <engine/debug/debug.h>
+#include <engine/assertions/assertions.h>
 
 FileReference::FileReference(bool isForCooking)
 {
@@ -22,6 +24,7 @@ FileReference::FileReference(bool isForCooking)
 
 FileReference::~FileReference()
 {
+	ResidencyManager::Forget(*this);
 	if (!m_isForCooking)
 	{
 		AssetManager::RemoveReflection(this);
@@ -66,3 +69,21 @@ unsigned char* FileReference::ReadBinary(size_t& size) const
 
 	return fileData;
 }
+
+unsigned char* FileReference::ReadBinary(size_t offset, size_t size) const
+{
+	unsigned char* fileData = nullptr;
+#if defined(EDITOR)
+	const bool openResult = m_file->Open(FileMode::ReadOnly);
+	if (openResult)
+	{
+		fileData = m_file->ReadBinary(offset, size);
+		m_file->Close();
+	}
+#else
+	XASSERT(offset + size <= m_fileSize, "[FileReference::ReadBinary] The range is outside of the file");
+	fileData = ProjectManager::s_fileDataBase.GetBitFile().ReadBinary(m_filePosition + offset, size);
+#endif
+
+	return fileData;
+}
@@ -27,6 +27,18 @@ enum class FileStatus
 	FileStatus_Failed
 };
 
+/**
+* @brief Residency of a texture or a mesh in the ResidencyManager
+*/
+enum class ResidencyState : uint8_t
+{
+	Untracked, // Not seen by a draw yet, or unloaded by something else
+	Ignored, // Can't be reloaded (no file), never evicted
+	Resident,
+	Evicted,
+	ReloadRequested
+};
+
 /**
 * @brief Class implemented by asset classes (Texture, Audio Clip...)
 * @brief Used to implement Load/Unload function and to store file infos (type, size...)
@@ -119,6 +131,7 @@ protected:
 	friend class SceneManager;
 	friend class EngineDebugMenu;
 	friend class BitFile;
+	friend class ResidencyManager;
 
 	std::shared_ptr<File> m_file = nullptr;
 	uint64_t m_filePosition = 0;
@@ -132,9 +145,21 @@ protected:
 
 	bool m_isMetaDirty = false;
 
+	// Only used by the textures and the meshes
+	uint64_t m_lastUsedFrame = 0;
+	size_t m_residentSize = 0;
+	ResidencyState m_residencyState = ResidencyState::Untracked;
+
 	std::string ReadString() const;
 	unsigned char* ReadBinary(size_t& size) const;
 
+	/**
+	* @brief Read a part of the file
+	* @param offset Position in the file
+	* @param size Size in bytes to read
+	*/
+	unsigned char* ReadBinary(size_t offset, size_t size) const;
+
 private:
 	bool m_isForCooking = false;
 };
\ No newline at end of file
@@ -23,6 +23,7 @@
 * index_count - 4 bytes
 * vertexMemSize - 4 bytes
 * indexMemSize - 4 bytes
+* position center and extent - 24 bytes (only with 16 bits positions)
 * vertice data - vertexMemSize bytes
 * indices data - indexMemSize bytes
 * ------
@@ -93,9 +94,31 @@ bool BinaryMeshLoader::LoadMesh(MeshData& mesh)
 		indexMemSize = EndianUtils::SwapEndian(indexMemSize);
 #endif // defined(__PS3__)
 
+		// Bounds of the quantized positions
+		const bool hasQuantizedPositions = vertexDescriptorList.GetPositionIndex() != -1 &&
+			vertexDescriptorList.GetElementFromIndex(vertexDescriptorList.GetPositionIndex()) == VertexElement::POSITION_16_BITS;
+		float positionBounds[6];
+		if (hasQuantizedPositions)
+		{
+			memcpy(positionBounds, fileData, sizeof(positionBounds));
+			fileData += sizeof(positionBounds);
+
+#if defined(__PS3__)
+			for (float& value : positionBounds)
+			{
+				value = EndianUtils::SwapEndian(value);
+			}
+#endif // defined(__PS3__)
+		}
+
 		mesh.CreateSubMesh(vertice_count, index_count, vertexDescriptorList);
 		const std::unique_ptr<MeshData::SubMesh>& subMesh = mesh.m_subMeshes[mesh.m_subMeshCount - 1];
 
+		if (hasQuantizedPositions)
+		{
+			subMesh->SetPositionBounds(Vector3(positionBounds[0], positionBounds[1], positionBounds[2]), Vector3(positionBounds[3], positionBounds[4], positionBounds[5]));
+		}
+
 		// Copy vertices data
 		memcpy(subMesh->m_data, fileData, vertexMemSize);
 		fileData += vertexMemSize;
@@ -137,6 +160,13 @@ bool BinaryMeshLoader::LoadMesh(MeshData& mesh)
 		// Copy indices data
 		if(index_count != 0)
 		{
+			if (indexMemSize != subMesh->m_indexMemSize)
+			{
+				Debug::PrintError("[BinaryMeshLoader::LoadMesh] Wrong index data size, the mesh has to be cooked again", true);
+				delete[] fileDataOriginalPtr;
+				return false;
+			}
+
 			memcpy(subMesh->GetIndices(), fileData, indexMemSize);
 			
 #if defined(__PS3__)
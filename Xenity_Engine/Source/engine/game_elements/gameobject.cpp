@@ -78,7 +78,7 @@ ReflectiveData GameObject::GetReflectiveData()
 	ReflectiveData reflectedVariables;
 	Reflective::AddVariable(reflectedVariables, m_name, "name");
 	Reflective::AddVariable(reflectedVariables, m_active, "active");
-	//Reflective::AddVariable(reflectedVariables, m_isStatic, "isStatic");
+	Reflective::AddVariable(reflectedVariables, m_isStatic, "isStatic");
 	return reflectedVariables;
 }
 
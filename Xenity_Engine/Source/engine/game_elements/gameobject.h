@@ -183,10 +183,13 @@ public:
 	*/
 	void SetActive(const bool active);
 
-	//[[nodiscard]] bool IsStatic() const
-	//{
-	//	return m_isStatic;
-	//}
+	/**
+	* @brief Get if the GameObject is static (its mesh renderers are merged with the other static mesh renderers when the game starts)
+	*/
+	[[nodiscard]] bool IsStatic() const
+	{
+		return m_isStatic;
+	}
 
 	/**
 	* @brief Get children count
@@ -309,5 +312,5 @@ private:
 
 	bool m_active = true;
 	bool m_localActive = true;
-	//bool m_isStatic = false;
+	bool m_isStatic = false;
 };
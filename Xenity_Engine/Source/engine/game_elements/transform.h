@@ -239,6 +239,7 @@ private:
 	friend class InspectorMenu;
 	friend class MeshManager;
 	friend class SpriteManager;
+	friend class MeshRenderer;
 
 	/**
 	* @brief [Internal] Update children world positions
@@ -30,7 +30,7 @@ void BillboardRenderer::OnReflectionUpdated()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 //void BillboardRenderer::SetOrderInLayer(int orderInLayer)
@@ -51,24 +51,23 @@ void BillboardRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransformRaw();
 	command.isEnabled = IsEnabled() && GetGameObjectRaw()->IsLocalActive();
 
-	renderBatch.spriteCommands.push_back(command);
-	renderBatch.spriteCommandIndex++;
+	renderBatch.AddCommand(RenderPass::Sprite, command);
 }
 
 void BillboardRenderer::SetTexture(const std::shared_ptr<Texture>& texture)
 {
 	m_texture = texture;
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void BillboardRenderer::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void BillboardRenderer::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void BillboardRenderer::DrawCommand([[maybe_unused]] const RenderCommand& renderCommand)
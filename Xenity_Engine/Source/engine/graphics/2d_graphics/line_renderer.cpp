@@ -21,7 +21,18 @@
 
 #pragma region Constructors / Destructor
 
-LineRenderer::LineRenderer()
+namespace
+{
+	VertexDescriptor CreateLineVertexDescriptor()
+	{
+		VertexDescriptor vertexDescriptor;
+		vertexDescriptor.AddVertexElement(VertexElement::UV_32_BITS);
+		vertexDescriptor.AddVertexElement(VertexElement::POSITION_32_BITS);
+		return vertexDescriptor;
+	}
+}
+
+LineRenderer::LineRenderer() : m_mesh(CreateLineVertexDescriptor())
 {
 }
 
@@ -41,7 +52,7 @@ void LineRenderer::OnReflectionUpdated()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 LineRenderer::~LineRenderer()
@@ -56,6 +67,11 @@ void LineRenderer::SetOrderInLayer(int orderInLayer)
 	Graphics::SetDrawOrderListAsDirty();
 }
 
+bool LineRenderer::UsesFileReference(const FileReference& fileReference) const
+{
+	return m_material.get() == &fileReference;
+}
+
 void LineRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 {
 	if (m_material == nullptr)
@@ -69,25 +85,22 @@ void LineRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 
 	if (m_material->GetRenderingMode() == MaterialRenderingMode::Opaque || m_material->GetRenderingMode() == MaterialRenderingMode::Cutout)
 	{
-		RenderQueue& renderQueue = renderBatch.renderQueues[m_material->GetFileId()];
-		renderQueue.commands.push_back(command);
-		renderQueue.commandIndex++;
+		renderBatch.AddCommand(RenderPass::Opaque, command);
 	}
 	else
 	{
-		renderBatch.transparentMeshCommands.push_back(command);
-		renderBatch.transparentMeshCommandIndex++;
+		renderBatch.AddCommand(RenderPass::Transparent, command);
 	}
 }
 
 void LineRenderer::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void LineRenderer::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 /// <summary>
@@ -95,9 +108,6 @@ void LineRenderer::OnEnabled()
 /// </summary>
 void LineRenderer::DrawCommand(const RenderCommand& renderCommand)
 {
-	if (m_meshData)
-		m_meshData.reset();
-
 	//float sizeFixer = 0.1f;
 	const float sizeFixer = 1.0f;
 
@@ -113,21 +123,22 @@ void LineRenderer::DrawCommand(const RenderCommand& renderCommand)
 	const float fixedXWidth = width2 / 2.0f * dir.y;
 	const float fixedYWidth = width2 / 2.0f * dir.x;
 
-	m_meshData = MeshData::CreateMeshData(4, 6, false, false, true);
-	m_meshData->SetVertex(1.0f, 1.0f, start.x - fixedXWidth, start.y - fixedYWidth, 0.0f, 0, 0);
-	m_meshData->SetVertex(0.0f, 0.0f, end.x - fixedXWidth, end.y - fixedYWidth, 0.0f, 1, 0);
-	m_meshData->SetVertex(1.0f, 0.0f, end.x + fixedXWidth, end.y + fixedYWidth, 0.0f, 2, 0);
-	m_meshData->SetVertex(0.0f, 1.0f, start.x + fixedXWidth, start.y + fixedYWidth, 0.0f, 3, 0);
+	// The line is rewritten in the same mesh each frame
+	m_mesh.Begin(4, 6);
+	MeshData::SubMesh& subMesh = m_mesh.GetSubMesh();
+	subMesh.SetVertex(1.0f, 1.0f, start.x - fixedXWidth, start.y - fixedYWidth, 0.0f, 0);
+	subMesh.SetVertex(0.0f, 0.0f, end.x - fixedXWidth, end.y - fixedYWidth, 0.0f, 1);
+	subMesh.SetVertex(1.0f, 0.0f, end.x + fixedXWidth, end.y + fixedYWidth, 0.0f, 2);
+	subMesh.SetVertex(0.0f, 1.0f, start.x + fixedXWidth, start.y + fixedYWidth, 0.0f, 3);
 
-	std::unique_ptr<MeshData::SubMesh>& subMesh = m_meshData->m_subMeshes[0];
-	subMesh->indices[0] = 0;
-	subMesh->indices[1] = 2;
-	subMesh->indices[2] = 1;
-	subMesh->indices[3] = 2;
-	subMesh->indices[4] = 0;
-	subMesh->indices[5] = 3;
+	subMesh.SetIndex(0, 0);
+	subMesh.SetIndex(1, 2);
+	subMesh.SetIndex(2, 1);
+	subMesh.SetIndex(3, 2);
+	subMesh.SetIndex(4, 0);
+	subMesh.SetIndex(5, 3);
 
-	m_meshData->OnLoadFileReferenceFinished();
+	m_mesh.End(4, 6);
 
 #if defined(__PSP__)
 	sceKernelDcacheWritebackInvalidateAll(); // Very important
@@ -138,7 +149,7 @@ void LineRenderer::DrawCommand(const RenderCommand& renderCommand)
 	renderSettings.useTexture = true;
 	renderSettings.useLighting = m_material->GetUseLighting();
 	renderSettings.renderingMode = renderCommand.material->GetRenderingMode();
-	MeshManager::DrawMesh(*GetTransformRaw(), *subMesh, *m_material, renderSettings);
+	MeshManager::DrawMesh(*GetTransformRaw(), subMesh, *m_material, renderSettings);
 }
 
 #endif // ENABLE_EXPERIMENTAL_FEATURES
\ No newline at end of file
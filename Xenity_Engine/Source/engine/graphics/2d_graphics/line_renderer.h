@@ -12,10 +12,10 @@
 #include <engine/graphics/iDrawable.h>
 #include <engine/math/vector3.h>
 #include <engine/graphics/color/color.h>
+#include <engine/graphics/3d_graphics/dynamic_mesh.h>
 
 class Texture;
 class Material;
-class MeshData;
 
 class API LineRenderer : public IDrawable
 {
@@ -85,13 +85,18 @@ protected:
 	*/
 	void CreateRenderCommands(RenderBatch& renderBatch) override;
 
+	/**
+	* @brief Get if the material is this file
+	*/
+	[[nodiscard]] bool UsesFileReference(const FileReference& fileReference) const override;
+
 	/**
 	* @brief Draw the command
 	*/
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
 	Color m_color = Color();
-	std::shared_ptr <MeshData> m_meshData = nullptr;
+	DynamicMesh m_mesh;
 	std::shared_ptr <Material> m_material = nullptr;
 
 public:
@@ -6,6 +6,7 @@
 
 #include "sprite_manager.h"
 
+#include <cstring>
 #include <glm/ext/matrix_transform.hpp>
 #if defined(__PSP__)
 #include <pspkernel.h>
@@ -24,9 +25,42 @@
 #include <engine/tools/profiler_benchmark.h>
 #include <engine/math/quaternion.h>
 #include <engine/tools/internal_math.h>
+#include <engine/math/vector4.h>
 
 std::shared_ptr <MeshData> SpriteManager::s_spriteMeshData = nullptr;
 std::shared_ptr <MeshData> SpriteManager::s_spriteMeshDataWithNormals = nullptr;
+std::shared_ptr <MeshData> SpriteManager::s_spriteBatchMeshData = nullptr;
+Material* SpriteManager::s_batchMaterial = nullptr;
+Texture* SpriteManager::s_batchTexture = nullptr;
+size_t SpriteManager::s_batchSpriteCount = 0;
+float SpriteManager::s_batchSpriteWidth = 0;
+float SpriteManager::s_batchSpriteHeight = 0;
+bool SpriteManager::s_batchForCanvas = false;
+bool SpriteManager::s_batchInvertFaces = false;
+
+namespace
+{
+	// Layout of the vertices of the sprite batch mesh (uv, color, position)
+	struct SpriteBatchVertex
+	{
+		float u, v;
+		float r, g, b, a;
+		float x, y, z;
+	};
+
+	void SetBatchVertex(SpriteBatchVertex& vertex, float u, float v, const Vector4& color, const glm::vec3& position)
+	{
+		vertex.u = u;
+		vertex.v = v;
+		vertex.r = color.x;
+		vertex.g = color.y;
+		vertex.b = color.z;
+		vertex.a = color.w;
+		vertex.x = position.x;
+		vertex.y = position.y;
+		vertex.z = position.z;
+	}
+}
 
 /**
  * @brief Init the Sprite Manager
@@ -96,6 +130,33 @@ void SpriteManager::Init()
 	subMeshWithNormals->SetIndex(5, 3);
 	s_spriteMeshDataWithNormals->OnLoadFileReferenceFinished();
 
+	// Create the mesh of the sprite batches, the indices are written once and the vertices for each batch
+	if (Engine::GetRenderer().IsVertexStreamingSupported())
+	{
+		s_spriteBatchMeshData = MeshData::MakeMeshDataForFile();
+		VertexDescriptor batchDescriptor;
+		batchDescriptor.AddVertexElement(VertexElement::UV_32_BITS);
+		batchDescriptor.AddVertexElement(VertexElement::COLOR_4_FLOATS);
+		batchDescriptor.AddVertexElement(VertexElement::POSITION_32_BITS);
+		XASSERT(batchDescriptor.GetVertexSize() == sizeof(SpriteBatchVertex), "[SpriteManager::Init] Wrong sprite batch vertex size");
+		s_spriteBatchMeshData->CreateSubMesh(static_cast<uint32_t>(s_maxBatchSpriteCount * 4), static_cast<uint32_t>(s_maxBatchSpriteCount * 6), batchDescriptor);
+
+		const std::unique_ptr<MeshData::SubMesh>& batchSubMesh = s_spriteBatchMeshData->m_subMeshes[0];
+		memset(batchSubMesh->m_data, 0, batchSubMesh->m_vertexMemSize);
+		for (uint32_t i = 0; i < s_maxBatchSpriteCount; i++)
+		{
+			// Same triangles as the sprite mesh
+			const uint32_t firstVertex = i * 4;
+			batchSubMesh->SetIndex(i * 6, firstVertex);
+			batchSubMesh->SetIndex(i * 6 + 1, firstVertex + 2);
+			batchSubMesh->SetIndex(i * 6 + 2, firstVertex + 1);
+			batchSubMesh->SetIndex(i * 6 + 3, firstVertex + 2);
+			batchSubMesh->SetIndex(i * 6 + 4, firstVertex);
+			batchSubMesh->SetIndex(i * 6 + 5, firstVertex + 3);
+		}
+		s_spriteBatchMeshData->OnLoadFileReferenceFinished();
+	}
+
 #if defined(__PSP__)
 	sceKernelDcacheWritebackInvalidateAll(); // Very important
 #endif
@@ -107,6 +168,18 @@ void SpriteManager::Close()
 {
 	s_spriteMeshData.reset();
 	s_spriteMeshDataWithNormals.reset();
+	s_spriteBatchMeshData.reset();
+}
+
+glm::mat4 SpriteManager::GetViewProjection(bool forCanvas)
+{
+	if (Graphics::usedCamera->IsEditor() || !forCanvas)
+	{
+		return Graphics::usedCamera->m_viewProjectionMatrix;
+	}
+
+	static const glm::mat4 canvasCameraViewMatrix = glm::lookAt(glm::vec3(0, 0, 0), glm::vec3(0, 0, 1), glm::vec3(0, 1, 0));
+	return Graphics::usedCamera->m_canvasProjection * canvasCameraViewMatrix;
 }
 
 /**
@@ -142,20 +215,91 @@ void SpriteManager::DrawSprite(Transform& transform, const Color& color, Materia
 	glm::mat4 mvp;
 	if constexpr (!s_UseOpenGLFixedFunctions)
 	{
-		if (Graphics::usedCamera->IsEditor() || !forCanvas)
-		{
-			mvp = Graphics::usedCamera->m_viewProjectionMatrix * matCopy;
-		}
-		else 
-		{
-			static const glm::mat4 canvasCameraViewMatrix = glm::lookAt(glm::vec3(0, 0, 0), glm::vec3(0, 0, 1), glm::vec3(0, 1, 0));
-			mvp = (Graphics::usedCamera->m_canvasProjection * canvasCameraViewMatrix) * matCopy;
-		}
+		mvp = GetViewProjection(forCanvas) * matCopy;
 	}
 
 	Graphics::DrawSubMesh(*s_spriteMeshData->m_subMeshes[0], material, texture, renderSettings, matCopy, transform.GetInverseNormalMatrix(), mvp, forCanvas);
 }
 
+bool SpriteManager::BeginSpriteBatch(Material& material, Texture* texture, bool forCanvas, bool invertFaces)
+{
+	XASSERT(texture != nullptr, "[SpriteManager::BeginSpriteBatch] texture is nullptr");
+	XASSERT(s_batchSpriteCount == 0, "[SpriteManager::BeginSpriteBatch] The previous batch is not ended");
+
+	if (!s_spriteBatchMeshData)
+	{
+		return false;
+	}
+
+	s_batchMaterial = &material;
+	s_batchTexture = texture;
+	s_batchForCanvas = forCanvas;
+	s_batchInvertFaces = invertFaces;
+
+	const float scaleCoef = (1.0f / texture->GetPixelPerUnit());
+	s_batchSpriteWidth = texture->GetWidth() * scaleCoef;
+	s_batchSpriteHeight = texture->GetHeight() * scaleCoef;
+	return true;
+}
+
+void SpriteManager::AddSpriteToBatch(Transform& transform, const Color& color)
+{
+	XASSERT(s_batchMaterial != nullptr, "[SpriteManager::AddSpriteToBatch] No batch started");
+
+	if (s_batchSpriteCount == s_maxBatchSpriteCount)
+	{
+		FlushSpriteBatch();
+	}
+
+	// Corners of the sprite quad (see DrawSprite) transformed on the CPU
+	const glm::mat4& matrix = transform.GetTransformationMatrix();
+	const glm::vec3 center = glm::vec3(matrix[3]);
+	const glm::vec3 halfRight = glm::vec3(matrix[0]) * (s_batchSpriteWidth * 0.5f);
+	const glm::vec3 halfUp = glm::vec3(matrix[1]) * (s_batchSpriteHeight * 0.5f);
+	const Vector4 vertexColor = color.GetRGBA().ToVector4();
+
+	SpriteBatchVertex* vertices = static_cast<SpriteBatchVertex*>(s_spriteBatchMeshData->m_subMeshes[0]->m_data) + s_batchSpriteCount * 4;
+	SetBatchVertex(vertices[0], 1.0f, 1.0f, vertexColor, center - halfRight - halfUp);
+	SetBatchVertex(vertices[1], 0.0f, 1.0f, vertexColor, center + halfRight - halfUp);
+	SetBatchVertex(vertices[2], 0.0f, 0.0f, vertexColor, center + halfRight + halfUp);
+	SetBatchVertex(vertices[3], 1.0f, 0.0f, vertexColor, center - halfRight + halfUp);
+	s_batchSpriteCount++;
+}
+
+void SpriteManager::EndSpriteBatch()
+{
+	FlushSpriteBatch();
+	s_batchMaterial = nullptr;
+	s_batchTexture = nullptr;
+}
+
+void SpriteManager::FlushSpriteBatch()
+{
+	if (s_batchSpriteCount == 0)
+	{
+		return;
+	}
+
+	MeshData::SubMesh& subMesh = *s_spriteBatchMeshData->m_subMeshes[0];
+	Engine::GetRenderer().UpdateSubMeshVertices(subMesh, static_cast<uint32_t>(s_batchSpriteCount * 4));
+
+	RenderingSettings renderSettings = RenderingSettings();
+	renderSettings.invertFaces = s_batchInvertFaces;
+	renderSettings.renderingMode = MaterialRenderingMode::Transparent;
+	renderSettings.useDepth = false;
+	renderSettings.useTexture = true;
+	renderSettings.useLighting = false;
+
+	// The vertices are already in world space, only draw the indices of the written sprites
+	static const glm::mat4 identityMatrix = glm::mat4(1);
+	static const glm::mat3 identityNormalMatrix = glm::mat3(1);
+	subMesh.m_index_count = static_cast<uint32_t>(s_batchSpriteCount * 6);
+	Graphics::DrawSubMesh(subMesh, *s_batchMaterial, s_batchTexture, renderSettings, identityMatrix, identityNormalMatrix, GetViewProjection(s_batchForCanvas), s_batchForCanvas);
+	subMesh.m_index_count = static_cast<uint32_t>(s_maxBatchSpriteCount * 6);
+
+	s_batchSpriteCount = 0;
+}
+
 void SpriteManager::DrawSprite(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Color& color, Material& material, Texture* texture)
 {
 	s_spriteMeshData->unifiedColor = color;
@@ -11,6 +11,9 @@
  */
 
 #include <memory>
+#include <cstddef>
+
+#include <glm/fwd.hpp>
 
 #include <engine/api.h>
 
@@ -53,6 +56,28 @@ public:
 	*/
 	static void DrawSprite(Transform& transform, const Color& color, Material& material, Texture* texture, bool forCanvas);
 
+	/**
+	* @brief Start a batch of sprites drawn with one draw call, the vertices are transformed on the CPU
+	* @param material Material of all the sprites
+	* @param texture Texture of all the sprites
+	* @param forCanvas True if the sprites are drawn in the canvas
+	* @param invertFaces True if the sprites are mirrored (negative scale on one axis)
+	* @return False if batching is not supported by the renderer, the sprites have to be drawn with DrawSprite
+	*/
+	[[nodiscard]] static bool BeginSpriteBatch(Material& material, Texture* texture, bool forCanvas, bool invertFaces);
+
+	/**
+	* @brief Add a sprite to the current batch (the batch is drawn when it is full)
+	* @param transform Sprite's transform
+	* @param color Sprite's color
+	*/
+	static void AddSpriteToBatch(Transform& transform, const Color& color);
+
+	/**
+	* @brief Draw the remaining sprites of the current batch
+	*/
+	static void EndSpriteBatch();
+
 	/**
 	* @brief Render a 2D line
 	* @param meshData Mesh data
@@ -70,6 +95,28 @@ public:
 	}
 
 private:
+	/**
+	* @brief Get the view projection matrix used to draw sprites with the current camera
+	*/
+	[[nodiscard]] static glm::mat4 GetViewProjection(bool forCanvas);
+
+	/**
+	* @brief Send the vertices of the batched sprites and draw them
+	*/
+	static void FlushSpriteBatch();
+
+	// Maximum number of sprites in one batch draw call (4 vertices and 6 indices per sprite, the indices have to fit in 16 bits)
+	static constexpr size_t s_maxBatchSpriteCount = 4096;
+
 	static std::shared_ptr <MeshData> s_spriteMeshData;
 	static std::shared_ptr <MeshData> s_spriteMeshDataWithNormals;
+	static std::shared_ptr <MeshData> s_spriteBatchMeshData;
+
+	static Material* s_batchMaterial;
+	static Texture* s_batchTexture;
+	static size_t s_batchSpriteCount;
+	static float s_batchSpriteWidth;
+	static float s_batchSpriteHeight;
+	static bool s_batchForCanvas;
+	static bool s_batchInvertFaces;
 };
\ No newline at end of file
@@ -11,12 +11,18 @@
 #include <engine/graphics/texture/texture.h>
 #include <engine/asset_management/asset_manager.h>
 #include <engine/game_elements/gameobject.h>
+#include <engine/game_elements/transform.h>
 #include <engine/debug/stack_debug_object.h>
 
 #include "sprite_manager.h"
 
 #pragma region Constructors / Destructor
 
+SpriteRenderer::SpriteRenderer()
+{
+	m_drawableType = DrawableType::SpriteRenderer;
+}
+
 ReflectiveData SpriteRenderer::GetReflectiveData()
 {
 	ReflectiveData reflectedVariables;
@@ -29,7 +35,7 @@ void SpriteRenderer::OnReflectionUpdated()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 //void SpriteRenderer::SetOrderInLayer(int orderInLayer)
@@ -50,27 +56,60 @@ void SpriteRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransformRaw();
 	command.isEnabled = IsEnabled() && GetGameObjectRaw()->IsLocalActive();
 
-	renderBatch.spriteCommands.push_back(command);
-	renderBatch.spriteCommandIndex++;
+	renderBatch.AddCommand(RenderPass::Sprite, command);
 }
 
 void SpriteRenderer::SetTexture(const std::shared_ptr<Texture>& texture)
 {
 	m_texture = texture;
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void SpriteRenderer::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void SpriteRenderer::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void SpriteRenderer::DrawCommand([[maybe_unused]] const RenderCommand& renderCommand)
 {
 	SpriteManager::DrawSprite(*GetTransformRaw(), m_color, *AssetManager::unlitMaterial.get(), m_texture.get(), false);
 }
+
+bool SpriteRenderer::IsInstanceCompatible([[maybe_unused]] const RenderCommand& renderCommand, [[maybe_unused]] const RenderCommand& otherCommand) const
+{
+#if defined(ENABLE_SPRITE_BATCHING)
+	if (otherCommand.drawable->GetDrawableType() != DrawableType::SpriteRenderer)
+		return false;
+
+	const SpriteRenderer* otherRenderer = static_cast<const SpriteRenderer*>(otherCommand.drawable);
+	if (otherRenderer->m_texture != m_texture)
+		return false;
+
+	// The face order is shared by all the sprites of a batch
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	const Vector3& otherScale = otherRenderer->GetTransformRaw()->GetScale();
+	return (scale.x * scale.y < 0) == (otherScale.x * otherScale.y < 0);
+#else
+	return false;
+#endif
+}
+
+bool SpriteRenderer::DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount)
+{
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	if (!SpriteManager::BeginSpriteBatch(*AssetManager::unlitMaterial, m_texture.get(), false, scale.x * scale.y < 0))
+		return false;
+
+	for (size_t i = 0; i < commandCount; i++)
+	{
+		const SpriteRenderer& spriteRenderer = static_cast<const SpriteRenderer&>(*renderCommands[i]->drawable);
+		SpriteManager::AddSpriteToBatch(*spriteRenderer.GetTransformRaw(), spriteRenderer.m_color);
+	}
+	SpriteManager::EndSpriteBatch();
+	return true;
+}
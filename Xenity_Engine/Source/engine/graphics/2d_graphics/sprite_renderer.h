@@ -20,6 +20,7 @@ class Texture;
 class API SpriteRenderer : public IDrawable
 {
 public:
+	SpriteRenderer();
 
 	///**
 	//* @brief Get the order in layer of the sprite
@@ -87,6 +88,16 @@ protected:
 	*/
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
+	/**
+	* @brief Get if the other command is a sprite renderer with the same texture and face order
+	*/
+	[[nodiscard]] bool IsInstanceCompatible(const RenderCommand& renderCommand, const RenderCommand& otherCommand) const override;
+
+	/**
+	* @brief Draw the sprites of the commands with one draw call (see SpriteManager::BeginSpriteBatch)
+	*/
+	[[nodiscard]] bool DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount) override;
+
 	Color m_color = Color();
 	std::shared_ptr <Texture> m_texture = nullptr;
 };
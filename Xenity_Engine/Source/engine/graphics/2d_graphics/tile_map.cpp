@@ -15,6 +15,7 @@
 #include <engine/graphics/camera.h>
 #include <engine/graphics/3d_graphics/mesh_manager.h>
 #include <engine/graphics/3d_graphics/mesh_data.h>
+#include <engine/graphics/3d_graphics/dynamic_mesh.h>
 #include <engine/asset_management/asset_manager.h>
 #include <engine/game_elements/gameobject.h>
 #include <engine/game_elements/transform.h>
@@ -126,57 +127,79 @@ void Tilemap::SetTile(int x, int y, int textureId)
 
 void Tilemap::FillChunks()
 {
-	// Fill meshes
-	for (int x = 0; x < width; x++)
+	// Set vertices and indices per tile
+	int verticesPerTile = 4;
+	int indicesPerTile = 6;
+	if (!useIndices)
+	{
+		verticesPerTile = 6;
+		indicesPerTile = 0;
+	}
+
+	// Rewrite the meshes of each chunk, the meshes memory is reused
+	for (int xChunk = 0; xChunk < chunkCount; xChunk++)
 	{
-		int xChunk = (int)floor(x / (float)chunkSize);
-		for (int y = 0; y < height; y++)
+		const int xEnd = std::min((xChunk + 1) * chunkSize, width);
+		for (int yChunk = 0; yChunk < chunkCount; yChunk++)
 		{
-			Tile* tile = GetTile(x, y);
-			if (tile->textureId != 0)
+			const int yEnd = std::min((yChunk + 1) * chunkSize, height);
+			TilemapChunk* chunk = chunks[(size_t)xChunk + (size_t)yChunk * chunkCount];
+			for (int textureI = 0; textureI < textureSize; textureI++)
 			{
-				int yChunk = (int)floor(y / (float)chunkSize);
-				MeshData* mesh = chunks[(size_t)xChunk + (size_t)yChunk * chunkCount]->meshes[(size_t)tile->textureId - 1];
-				std::unique_ptr<MeshData::SubMesh>& subMesh = mesh->m_subMeshes[0];
-
-				int indiceOff = subMesh->m_index_count;
-				int verticeOff = subMesh->m_vertice_count;
-
-				float unitCoef = 100.0f / textures[tile->textureId]->GetPixelPerUnit();
-				float w = textures[tile->textureId]->GetWidth() * unitCoef;
-				float h = textures[tile->textureId]->GetHeight() * unitCoef;
-				Vector2 spriteSize = Vector2(0.5f * w / 100.0f, 0.5f * h / 100.0f);
-
-				if (!useIndices)
+				DynamicMesh& mesh = *chunk->meshes[textureI];
+				mesh.Begin(verticesPerTile * chunkSize * chunkSize, indicesPerTile * chunkSize * chunkSize);
+				MeshData::SubMesh& subMesh = mesh.GetSubMesh();
+
+				const int textureId = textureI + 1;
+				const float unitCoef = 100.0f / textures[textureId]->GetPixelPerUnit();
+				const float w = textures[textureId]->GetWidth() * unitCoef;
+				const float h = textures[textureId]->GetHeight() * unitCoef;
+				const Vector2 spriteSize = Vector2(0.5f * w / 100.0f, 0.5f * h / 100.0f);
+
+				uint32_t verticeOff = 0;
+				uint32_t indiceOff = 0;
+				for (int x = xChunk * chunkSize; x < xEnd; x++)
 				{
-					// Create tile with vertices only
-					subMesh->SetVertex(1.0f, 1.0f, -spriteSize.x - x, -spriteSize.y + y, 0.0f, 0 + verticeOff);
-					subMesh->SetVertex(0.0f, 0.0f, spriteSize.x - x, spriteSize.y + y, 0.0f, 1 + verticeOff);
-					subMesh->SetVertex(0.0f, 1.0f, spriteSize.x - x, -spriteSize.y + y, 0.0f, 2 + verticeOff);
+					for (int y = yChunk * chunkSize; y < yEnd; y++)
+					{
+						Tile* tile = GetTile(x, y);
+						if (tile->textureId != textureId)
+							continue;
 
-					subMesh->SetVertex(0.0f, 0.0f, spriteSize.x - x, spriteSize.y + y, 0.0f, 3 + verticeOff);
-					subMesh->SetVertex(1.0f, 1.0f, -spriteSize.x - x, -spriteSize.y + y, 0.0f, 4 + verticeOff);
-					subMesh->SetVertex(1.0f, 0.0f, -spriteSize.x - x, spriteSize.y + y, 0.0f, 5 + verticeOff);
+						if (!useIndices)
+						{
+							// Create tile with vertices only
+							subMesh.SetVertex(1.0f, 1.0f, -spriteSize.x - x, -spriteSize.y + y, 0.0f, 0 + verticeOff);
+							subMesh.SetVertex(0.0f, 0.0f, spriteSize.x - x, spriteSize.y + y, 0.0f, 1 + verticeOff);
+							subMesh.SetVertex(0.0f, 1.0f, spriteSize.x - x, -spriteSize.y + y, 0.0f, 2 + verticeOff);
 
-					subMesh->m_vertice_count += 6;
-				}
-				else
-				{
-					// Create tile with vertices and indices
-					mesh->GetSubMesh(0)->SetVertex(1.0f, 1.0f, -spriteSize.x - x, -spriteSize.y + y, 0.0f, 0 + verticeOff);
-					mesh->GetSubMesh(0)->SetVertex(0.0f, 1.0f, spriteSize.x - x, -spriteSize.y + y, 0.0f, 1 + verticeOff);
-					mesh->GetSubMesh(0)->SetVertex(0.0f, 0.0f, spriteSize.x - x, spriteSize.y + y, 0.0f, 2 + verticeOff);
-					mesh->GetSubMesh(0)->SetVertex(1.0f, 0.0f, -spriteSize.x - x, spriteSize.y + y, 0.0f, 3 + verticeOff);
-
-					subMesh->SetIndex(0 + indiceOff, 0 + verticeOff);
-					subMesh->SetIndex(1 + indiceOff, 2 + verticeOff);
-					subMesh->SetIndex(2 + indiceOff, 1 + verticeOff);
-					subMesh->SetIndex(3 + indiceOff, 2 + verticeOff);
-					subMesh->SetIndex(4 + indiceOff, 0 + verticeOff);
-					subMesh->SetIndex(5 + indiceOff, 3 + verticeOff);
-					subMesh->m_index_count += 6;
-					subMesh->m_vertice_count += 4;
+							subMesh.SetVertex(0.0f, 0.0f, spriteSize.x - x, spriteSize.y + y, 0.0f, 3 + verticeOff);
+							subMesh.SetVertex(1.0f, 1.0f, -spriteSize.x - x, -spriteSize.y + y, 0.0f, 4 + verticeOff);
+							subMesh.SetVertex(1.0f, 0.0f, -spriteSize.x - x, spriteSize.y + y, 0.0f, 5 + verticeOff);
+
+							verticeOff += 6;
+						}
+						else
+						{
+							// Create tile with vertices and indices
+							subMesh.SetVertex(1.0f, 1.0f, -spriteSize.x - x, -spriteSize.y + y, 0.0f, 0 + verticeOff);
+							subMesh.SetVertex(0.0f, 1.0f, spriteSize.x - x, -spriteSize.y + y, 0.0f, 1 + verticeOff);
+							subMesh.SetVertex(0.0f, 0.0f, spriteSize.x - x, spriteSize.y + y, 0.0f, 2 + verticeOff);
+							subMesh.SetVertex(1.0f, 0.0f, -spriteSize.x - x, spriteSize.y + y, 0.0f, 3 + verticeOff);
+
+							subMesh.SetIndex(0 + indiceOff, 0 + verticeOff);
+							subMesh.SetIndex(1 + indiceOff, 2 + verticeOff);
+							subMesh.SetIndex(2 + indiceOff, 1 + verticeOff);
+							subMesh.SetIndex(3 + indiceOff, 2 + verticeOff);
+							subMesh.SetIndex(4 + indiceOff, 0 + verticeOff);
+							subMesh.SetIndex(5 + indiceOff, 3 + verticeOff);
+							indiceOff += 6;
+							verticeOff += 4;
+						}
+					}
 				}
+
+				mesh.End(verticeOff, indiceOff);
 			}
 		}
 	}
@@ -201,7 +224,7 @@ void Tilemap::SetColor(const Color& color)
 			int meshSize = (int)chunk->meshes.size();
 			for (int i = 0; i < meshSize; i++)
 			{
-				chunk->meshes[i]->unifiedColor = this->color;
+				chunk->meshes[i]->GetMeshData().unifiedColor = this->color;
 			}
 		}
 	}
@@ -209,14 +232,9 @@ void Tilemap::SetColor(const Color& color)
 
 void Tilemap::CreateChunksMeshes()
 {
-	// Set vertices and indices per tile
-	int verticesPerTile = 4;
-	int indicesPerTile = 6;
-	if (!useIndices)
-	{
-		verticesPerTile = 6;
-		indicesPerTile = 0;
-	}
+	VertexDescriptor vertexDescriptor = VertexDescriptor();
+	vertexDescriptor.AddVertexElement(VertexElement::POSITION_32_BITS);
+	vertexDescriptor.AddVertexElement(VertexElement::UV_32_BITS);
 
 	for (int x = 0; x < chunkCount; x++)
 	{
@@ -224,6 +242,10 @@ void Tilemap::CreateChunksMeshes()
 		{
 			TilemapChunk* chunk = chunks[(size_t)x + (size_t)y * chunkCount];
 
+			// Keep the meshes if the texture count has not changed
+			if ((int)chunk->meshes.size() == textureSize)
+				continue;
+
 			// Delete chunk meshes
 			int meshSize = (int)chunk->meshes.size();
 			for (int i = 0; i < meshSize; i++)
@@ -235,16 +257,8 @@ void Tilemap::CreateChunksMeshes()
 			// Create new meshes
 			for (int i = 0; i < textureSize; i++)
 			{
-				MeshData* mesh = new MeshData();
-				VertexDescriptor vertexDescriptor = VertexDescriptor();
-				vertexDescriptor.AddVertexElement(VertexElement::POSITION_32_BITS);
-				vertexDescriptor.AddVertexElement(VertexElement::UV_32_BITS);
-
-				mesh->CreateSubMesh(verticesPerTile * chunkSize * chunkSize, indicesPerTile * chunkSize * chunkSize, vertexDescriptor);
-				mesh->m_subMeshes[0]->m_index_count = 0;
-				mesh->m_subMeshes[0]->m_vertice_count = 0;
-
-				mesh->unifiedColor = color;
+				DynamicMesh* mesh = new DynamicMesh(vertexDescriptor);
+				mesh->GetMeshData().unifiedColor = color;
 				chunk->meshes.push_back(mesh);
 			}
 		}
@@ -263,18 +277,17 @@ void Tilemap::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransform();
 	command.isEnabled = IsEnabled() && GetGameObject()->IsLocalActive();
 
-	renderBatch.spriteCommands.push_back(command);
-	renderBatch.spriteCommandIndex++;*/
+	renderBatch.AddCommand(RenderPass::Sprite, command);*/
 }
 
 void Tilemap::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void Tilemap::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void Tilemap::DrawCommand(const RenderCommand& renderCommand)
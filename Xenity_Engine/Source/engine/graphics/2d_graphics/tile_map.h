@@ -16,7 +16,7 @@
 #include <engine/game_elements/gameplay_manager.h>
 
 class Texture;
-class MeshData;
+class DynamicMesh;
 
 class API Tilemap : public IDrawable
 {
@@ -126,7 +126,7 @@ protected:
 	class TilemapChunk
 	{
 	public:
-		std::vector<MeshData*> meshes;
+		std::vector<DynamicMesh*> meshes;
 	};
 	int chunkSize = 0;
 	bool dirtyMeshes = false;
@@ -140,7 +140,7 @@ protected:
 	void FillChunks();
 
 	/**
-	* @brief Delete and create new meshes for each chunk
+	* @brief Create the meshes of each chunk (one per texture), the meshes are kept while the texture count does not change
 	*
 	*/
 	void CreateChunksMeshes();
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "dynamic_mesh.h"
+
+#include <algorithm>
+
+#include <engine/engine.h>
+#include <engine/graphics/renderer/renderer.h>
+
+DynamicMesh::DynamicMesh(const VertexDescriptor& vertexDescriptor) : m_meshData(MeshData::CreateMeshData()), m_vertexDescriptor(vertexDescriptor)
+{
+}
+
+void DynamicMesh::Begin(uint32_t maxVertexCount, uint32_t maxIndexCount)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	if (maxVertexCount > m_vertexCapacity || maxIndexCount > m_indexCapacity)
+	{
+		// Double the capacity to not reallocate each time the mesh gets a bit bigger (a counter, a timer...)
+		m_vertexCapacity = std::max(maxVertexCount, m_vertexCapacity * 2);
+		m_indexCapacity = std::max(maxIndexCount, m_indexCapacity * 2);
+
+		m_meshData->FreeMeshData(true);
+		m_meshData->CreateSubMesh(m_vertexCapacity, m_indexCapacity, m_vertexDescriptor);
+		m_isSentToGpu = false;
+
+		if (m_meshData->m_subMeshCount == 0)
+		{
+			m_vertexCapacity = 0;
+			m_indexCapacity = 0;
+		}
+	}
+
+	m_vertexCount = 0;
+
+	if (m_meshData->m_subMeshCount != 0)
+	{
+		// The counts are used for the bound checks while writing, the real counts are set in End()
+		MeshData::SubMesh& subMesh = *m_meshData->m_subMeshes[0];
+		subMesh.m_vertice_count = m_vertexCapacity;
+		subMesh.m_index_count = m_indexCapacity;
+	}
+}
+
+void DynamicMesh::End(uint32_t vertexCount, uint32_t indexCount)
+{
+	XASSERT(vertexCount <= m_vertexCapacity, "[DynamicMesh::End] vertexCount is larger than the capacity");
+	XASSERT(indexCount <= m_indexCapacity, "[DynamicMesh::End] indexCount is larger than the capacity");
+
+	if (m_meshData->m_subMeshCount == 0)
+		return;
+
+	m_vertexCount = vertexCount;
+
+	MeshData::SubMesh& subMesh = *m_meshData->m_subMeshes[0];
+	subMesh.m_vertice_count = vertexCount;
+	subMesh.m_index_count = indexCount;
+
+	if (vertexCount == 0)
+		return;
+
+	Renderer& renderer = Engine::GetRenderer();
+	if (!m_isSentToGpu)
+	{
+		// First upload, creates the GPU buffers
+		m_meshData->OnLoadFileReferenceFinished();
+		m_isSentToGpu = true;
+	}
+	else if (renderer.IsVertexStreamingSupported())
+	{
+		renderer.UpdateSubMeshVertices(subMesh, vertexCount);
+		if (indexCount != 0)
+		{
+			renderer.UpdateSubMeshIndices(subMesh, indexCount);
+		}
+		m_meshData->ComputeBoundingBox();
+		m_meshData->ComputeBoundingSphere();
+	}
+	else
+	{
+		// Send the data again in the existing buffers
+		m_meshData->Update();
+	}
+}
+
+void DynamicMesh::Clear()
+{
+	m_vertexCount = 0;
+
+	if (m_meshData->m_subMeshCount != 0)
+	{
+		MeshData::SubMesh& subMesh = *m_meshData->m_subMeshes[0];
+		subMesh.m_vertice_count = 0;
+		subMesh.m_index_count = 0;
+	}
+}
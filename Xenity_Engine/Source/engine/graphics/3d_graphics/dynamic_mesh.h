@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstdint>
+#include <memory>
+
+#include <engine/api.h>
+#include "mesh_data.h"
+
+/**
+* @brief Mesh with one submesh rewritten at runtime (texts, lines, tilemaps...)
+*
+* The memory and the GPU buffers are kept between two updates and only reallocated when the mesh needs more space,
+* so rewriting the mesh does not allocate memory or create GPU objects.
+* When the renderer supports it, the data is streamed into the existing buffers (orphaned to not wait for the previous draw calls).
+*/
+class API DynamicMesh
+{
+public:
+	explicit DynamicMesh(const VertexDescriptor& vertexDescriptor);
+	DynamicMesh(const DynamicMesh& other) = delete;
+	DynamicMesh& operator=(const DynamicMesh&) = delete;
+
+	/**
+	* @brief Prepare the submesh to be written, grow the memory if needed
+	* @param maxVertexCount Maximum number of vertices that will be written
+	* @param maxIndexCount Maximum number of indices that will be written
+	*/
+	void Begin(uint32_t maxVertexCount, uint32_t maxIndexCount);
+
+	/**
+	* @brief Set the number of written vertices and indices and send the data to the GPU
+	* @param vertexCount Number of written vertices (less or equal to the max count given to Begin)
+	* @param indexCount Number of written indices (less or equal to the max count given to Begin)
+	*/
+	void End(uint32_t vertexCount, uint32_t indexCount);
+
+	/**
+	* @brief Empty the mesh without freeing the memory
+	*/
+	void Clear();
+
+	/**
+	* @brief Get if the mesh has nothing to draw
+	*/
+	[[nodiscard]] bool IsEmpty() const
+	{
+		return m_vertexCount == 0;
+	}
+
+	/**
+	* @brief Get the submesh to write (between Begin and End) or to draw (not empty)
+	*/
+	[[nodiscard]] MeshData::SubMesh& GetSubMesh() const
+	{
+		XASSERT(m_meshData->m_subMeshCount != 0, "[DynamicMesh::GetSubMesh] The mesh has no memory");
+		return *m_meshData->m_subMeshes[0];
+	}
+
+	/**
+	* @brief Get the mesh data
+	*/
+	[[nodiscard]] MeshData& GetMeshData() const
+	{
+		return *m_meshData;
+	}
+
+private:
+	std::shared_ptr<MeshData> m_meshData;
+	VertexDescriptor m_vertexDescriptor;
+	uint32_t m_vertexCapacity = 0;
+	uint32_t m_indexCapacity = 0;
+	uint32_t m_vertexCount = 0;
+	bool m_isSentToGpu = false;
+};
@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "frustum_culling.h"
+
+#include <algorithm>
+
+#include <engine/constants.h>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define CULLING_USE_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CULLING_USE_NEON
+#include <arm_neon.h>
+#endif
+
+#include <engine/graphics/camera.h>
+#include <engine/graphics/3d_graphics/sphere.h>
+#include <engine/graphics/3d_graphics/mesh_renderer.h>
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/performance.h>
+#include <engine/tools/job_system.h>
+
+std::vector<float> FrustumCulling::s_centersX;
+std::vector<float> FrustumCulling::s_centersY;
+std::vector<float> FrustumCulling::s_centersZ;
+std::vector<float> FrustumCulling::s_radii;
+std::vector<uint64_t> FrustumCulling::s_activeBits;
+std::vector<uint64_t> FrustumCulling::s_visibilityBits;
+std::vector<MeshRenderer*> FrustumCulling::s_meshRenderers;
+size_t FrustumCulling::s_count = 0;
+
+namespace
+{
+	constexpr size_t s_bitsPerWord = 64;
+
+	void SetBit(std::vector<uint64_t>& bits, size_t index, bool value)
+	{
+		const uint64_t mask = 1ULL << (index & 63);
+		if (value)
+			bits[index >> 6] |= mask;
+		else
+			bits[index >> 6] &= ~mask;
+	}
+
+	[[nodiscard]] bool GetBit(const std::vector<uint64_t>& bits, size_t index)
+	{
+		return (bits[index >> 6] >> (index & 63)) & 1;
+	}
+
+#if defined(ENABLE_MULTITHREADED_CULLING)
+	// Number of words (64 mesh renderers per word) taken by a thread at a time
+	constexpr size_t s_wordsPerJob = 16;
+	// Do not use the worker threads for small lists
+	constexpr size_t s_minWordCountForThreads = s_wordsPerJob * 4;
+#endif
+}
+
+uint32_t FrustumCulling::AddMeshRenderer(MeshRenderer& meshRenderer)
+{
+	const size_t index = s_count;
+
+	// Keep the arrays sized to a multiple of 64 to process full words without bound checks
+	if (index == s_centersX.size())
+	{
+		const size_t newSize = s_centersX.size() + s_bitsPerWord;
+		s_centersX.resize(newSize, 0.0f);
+		s_centersY.resize(newSize, 0.0f);
+		s_centersZ.resize(newSize, 0.0f);
+		s_radii.resize(newSize, 0.0f);
+		s_activeBits.push_back(0);
+		s_visibilityBits.push_back(0);
+	}
+
+	s_meshRenderers.push_back(&meshRenderer);
+	s_count++;
+
+	// Visible until the next culling
+	SetBit(s_visibilityBits, index, true);
+
+	return static_cast<uint32_t>(index);
+}
+
+void FrustumCulling::RemoveMeshRenderer(uint32_t index)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	XASSERT(index < s_count, "[FrustumCulling::RemoveMeshRenderer] index is out of range");
+
+	// Move the last mesh renderer to the free index to keep the arrays contiguous
+	const size_t lastIndex = s_count - 1;
+	if (index != lastIndex)
+	{
+		s_centersX[index] = s_centersX[lastIndex];
+		s_centersY[index] = s_centersY[lastIndex];
+		s_centersZ[index] = s_centersZ[lastIndex];
+		s_radii[index] = s_radii[lastIndex];
+		SetBit(s_activeBits, index, GetBit(s_activeBits, lastIndex));
+		SetBit(s_visibilityBits, index, GetBit(s_visibilityBits, lastIndex));
+		s_meshRenderers[index] = s_meshRenderers[lastIndex];
+		s_meshRenderers[index]->m_cullingIndex = index;
+	}
+
+	s_centersX[lastIndex] = 0;
+	s_centersY[lastIndex] = 0;
+	s_centersZ[lastIndex] = 0;
+	s_radii[lastIndex] = 0;
+	SetBit(s_activeBits, lastIndex, false);
+	SetBit(s_visibilityBits, lastIndex, false);
+	s_meshRenderers.pop_back();
+	s_count--;
+}
+
+void FrustumCulling::SetBoundingSphere(uint32_t index, const Sphere& sphere)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	XASSERT(index < s_count, "[FrustumCulling::SetBoundingSphere] index is out of range");
+
+	s_centersX[index] = sphere.position.x;
+	s_centersY[index] = sphere.position.y;
+	s_centersZ[index] = sphere.position.z;
+	s_radii[index] = sphere.radius;
+}
+
+void FrustumCulling::SetActive(uint32_t index, bool isActive)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	XASSERT(index < s_count, "[FrustumCulling::SetActive] index is out of range");
+
+	SetBit(s_activeBits, index, isActive);
+}
+
+void FrustumCulling::CullSpheres(const Frustum& frustum, const float* centersX, const float* centersY, const float* centersZ, const float* radii,
+	const uint64_t* activeBits, uint64_t* visibilityBits, size_t wordBegin, size_t wordEnd)
+{
+	constexpr size_t planeCount = sizeof(Frustum::planes) / sizeof(Plane);
+
+	// Broadcast the planes once for all the spheres
+#if defined(CULLING_USE_SSE)
+	__m128 planesX[planeCount];
+	__m128 planesY[planeCount];
+	__m128 planesZ[planeCount];
+	__m128 planesW[planeCount];
+	for (size_t p = 0; p < planeCount; p++)
+	{
+		planesX[p] = _mm_set1_ps(frustum.planes[p].data.x);
+		planesY[p] = _mm_set1_ps(frustum.planes[p].data.y);
+		planesZ[p] = _mm_set1_ps(frustum.planes[p].data.z);
+		planesW[p] = _mm_set1_ps(frustum.planes[p].data.w);
+	}
+#elif defined(CULLING_USE_NEON)
+	float32x4_t planesX[planeCount];
+	float32x4_t planesY[planeCount];
+	float32x4_t planesZ[planeCount];
+	float32x4_t planesW[planeCount];
+	for (size_t p = 0; p < planeCount; p++)
+	{
+		planesX[p] = vdupq_n_f32(frustum.planes[p].data.x);
+		planesY[p] = vdupq_n_f32(frustum.planes[p].data.y);
+		planesZ[p] = vdupq_n_f32(frustum.planes[p].data.z);
+		planesW[p] = vdupq_n_f32(frustum.planes[p].data.w);
+	}
+#endif
+
+	for (size_t word = wordBegin; word < wordEnd; word++)
+	{
+		const uint64_t active = activeBits[word];
+		if (active == 0)
+		{
+			visibilityBits[word] = 0;
+			continue;
+		}
+
+		uint64_t visible = 0;
+		const size_t firstSphere = word * s_bitsPerWord;
+		for (size_t group = 0; group < s_bitsPerWord; group += 4)
+		{
+			if (((active >> group) & 0xF) == 0)
+				continue;
+
+			const size_t i = firstSphere + group;
+			// A sphere is out of the frustum if its distance to a plane is less than -radius
+#if defined(CULLING_USE_SSE)
+			const __m128 x = _mm_loadu_ps(centersX + i);
+			const __m128 y = _mm_loadu_ps(centersY + i);
+			const __m128 z = _mm_loadu_ps(centersZ + i);
+			const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+			__m128 outside = _mm_setzero_ps();
+			for (size_t p = 0; p < planeCount; p++)
+			{
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planesX[p], x), _mm_mul_ps(planesY[p], y)), _mm_add_ps(_mm_mul_ps(planesZ[p], z), planesW[p]));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+			}
+			const uint64_t inside = static_cast<uint64_t>(~_mm_movemask_ps(outside) & 0xF);
+#elif defined(CULLING_USE_NEON)
+			const float32x4_t x = vld1q_f32(centersX + i);
+			const float32x4_t y = vld1q_f32(centersY + i);
+			const float32x4_t z = vld1q_f32(centersZ + i);
+			const float32x4_t negativeRadius = vnegq_f32(vld1q_f32(radii + i));
+			uint32x4_t outside = vdupq_n_u32(0);
+			for (size_t p = 0; p < planeCount; p++)
+			{
+				const float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(planesX[p], x), vmulq_f32(planesY[p], y)), vaddq_f32(vmulq_f32(planesZ[p], z), planesW[p]));
+				outside = vorrq_u32(outside, vcltq_f32(distance, negativeRadius));
+			}
+			const uint32_t outsideMask = (vgetq_lane_u32(outside, 0) & 1) | (vgetq_lane_u32(outside, 1) & 2) |
+				(vgetq_lane_u32(outside, 2) & 4) | (vgetq_lane_u32(outside, 3) & 8);
+			const uint64_t inside = static_cast<uint64_t>(~outsideMask & 0xF);
+#else
+			uint64_t inside = 0;
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				bool isOutside = false;
+				for (size_t p = 0; p < planeCount; p++)
+				{
+					const glm::vec4& plane = frustum.planes[p].data;
+					const float distance = plane.x * centersX[i + lane] + plane.y * centersY[i + lane] + plane.z * centersZ[i + lane] + plane.w;
+					if (distance < -radii[i + lane])
+					{
+						isOutside = true;
+						break;
+					}
+				}
+				if (!isOutside)
+				{
+					inside |= 1ULL << lane;
+				}
+			}
+#endif
+			visible |= inside << group;
+		}
+		visibilityBits[word] = visible & active;
+	}
+}
+
+void FrustumCulling::Cull(const Frustum& frustum)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	SCOPED_PROFILER("FrustumCulling::Cull", scopeBenchmark);
+
+	const size_t wordCount = s_activeBits.size();
+	if (wordCount == 0)
+		return;
+
+#if defined(ENABLE_MULTITHREADED_CULLING)
+	if (wordCount >= s_minWordCountForThreads)
+	{
+		JobSystem::ParallelFor(wordCount, s_wordsPerJob, [&frustum](size_t wordBegin, size_t wordEnd)
+		{
+			CullSpheres(frustum, s_centersX.data(), s_centersY.data(), s_centersZ.data(), s_radii.data(), s_activeBits.data(), s_visibilityBits.data(), wordBegin, wordEnd);
+		});
+		return;
+	}
+#endif
+
+	CullSpheres(frustum, s_centersX.data(), s_centersY.data(), s_centersZ.data(), s_radii.data(), s_activeBits.data(), s_visibilityBits.data(), 0, wordCount);
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <engine/api.h>
+
+struct Frustum;
+struct Sphere;
+class MeshRenderer;
+
+/**
+* @brief Frustum culling of the mesh renderers
+*
+* The bounding spheres and the active state of the mesh renderers are stored in contiguous arrays (structure of arrays).
+* The spheres are tested 4 at a time (SSE or NEON when available) and the result is written in a visibility bitset (64 mesh renderers per word).
+* With ENABLE_MULTITHREADED_CULLING, large lists are split between the workers of the JobSystem.
+*/
+class API FrustumCulling
+{
+public:
+	static constexpr uint32_t s_invalidIndex = UINT32_MAX;
+
+	/**
+	* @brief Add a mesh renderer to the culling lists (inactive with an empty sphere)
+	* @return Index of the mesh renderer in the lists
+	*/
+	[[nodiscard]] static uint32_t AddMeshRenderer(MeshRenderer& meshRenderer);
+
+	/**
+	* @brief Remove a mesh renderer from the culling lists, the last mesh renderer takes its index
+	* @param index Index of the mesh renderer (ignored if invalid)
+	*/
+	static void RemoveMeshRenderer(uint32_t index);
+
+	/**
+	* @brief Update the bounding sphere of a mesh renderer
+	* @param index Index of the mesh renderer (ignored if invalid)
+	*/
+	static void SetBoundingSphere(uint32_t index, const Sphere& sphere);
+
+	/**
+	* @brief Set if a mesh renderer is active (inactive mesh renderers are never visible)
+	* @param index Index of the mesh renderer (ignored if invalid)
+	*/
+	static void SetActive(uint32_t index, bool isActive);
+
+	/**
+	* @brief Update the visibility of all the mesh renderers
+	* @param frustum Frustum of the camera
+	*/
+	static void Cull(const Frustum& frustum);
+
+	/**
+	* @brief Get if a mesh renderer was in the frustum during the last culling
+	* @param index Index of the mesh renderer
+	*/
+	[[nodiscard]] static bool IsVisible(uint32_t index)
+	{
+		return (s_visibilityBits[index >> 6] >> (index & 63)) & 1;
+	}
+
+	/**
+	* @brief Get the number of mesh renderers in the lists
+	*/
+	[[nodiscard]] static size_t GetCount()
+	{
+		return s_count;
+	}
+
+	/**
+	* @brief Test spheres against a frustum and write the visibility bits (64 spheres per word)
+	* @param frustum Frustum to use
+	* @param centersX, centersY, centersZ, radii Spheres data, the arrays must contain at least wordEnd * 64 values
+	* @param activeBits Active state of the spheres, inactive spheres are not visible
+	* @param visibilityBits Result
+	* @param wordBegin First word to process
+	* @param wordEnd Last word to process (excluded)
+	*/
+	static void CullSpheres(const Frustum& frustum, const float* centersX, const float* centersY, const float* centersZ, const float* radii,
+		const uint64_t* activeBits, uint64_t* visibilityBits, size_t wordBegin, size_t wordEnd);
+
+private:
+	friend class OcclusionCulling;
+	friend class StaticBatching;
+	friend class TextureStreaming;
+
+	static std::vector<float> s_centersX;
+	static std::vector<float> s_centersY;
+	static std::vector<float> s_centersZ;
+	static std::vector<float> s_radii;
+	static std::vector<uint64_t> s_activeBits;
+	static std::vector<uint64_t> s_visibilityBits;
+	static std::vector<MeshRenderer*> s_meshRenderers;
+	static size_t s_count;
+};
@@ -6,43 +6,113 @@
 
 #include "lod.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include <glm/glm.hpp>
+
 #include <engine/math/vector3.h>
 #include <engine/graphics/3d_graphics/mesh_renderer.h>
+#include <engine/graphics/3d_graphics/mesh_data.h>
 #include <engine/game_elements/transform.h>
 #include <engine/graphics/graphics.h>
-#include <engine/graphics/camera.h>
 
 ReflectiveData Lod::GetReflectiveData()
 {
 	ReflectiveData reflectedVariables;
 	Reflective::AddVariable(reflectedVariables, m_lod0MeshRenderer, "lod0MeshRenderer");
 	Reflective::AddVariable(reflectedVariables, m_lod1MeshRenderer, "lod1MeshRenderer");
-	Reflective::AddVariable(reflectedVariables, m_lod1Distance, "lod1Distance");
+	Reflective::AddVariable(reflectedVariables, m_lod1ScreenSize, "lod1ScreenSize");
 	Reflective::AddVariable(reflectedVariables, m_lod2MeshRenderer, "lod2MeshRenderer");
-	Reflective::AddVariable(reflectedVariables, m_lod2Distance, "lod2Distance");
-	Reflective::AddVariable(reflectedVariables, m_culledDistance, "culledDistance");
+	Reflective::AddVariable(reflectedVariables, m_lod2ScreenSize, "lod2ScreenSize");
+	Reflective::AddVariable(reflectedVariables, m_culledScreenSize, "culledScreenSize");
+	Reflective::AddVariable(reflectedVariables, m_hysteresis, "hysteresis");
+	Reflective::AddVariable(reflectedVariables, m_lod1Distance, "lod1Distance").SetIsPublic(false);
+	Reflective::AddVariable(reflectedVariables, m_lod2Distance, "lod2Distance").SetIsPublic(false);
+	Reflective::AddVariable(reflectedVariables, m_culledDistance, "culledDistance").SetIsPublic(false);
 	return reflectedVariables;
 }
 
-void Lod::CheckLod()
+void Lod::OnReflectionUpdated()
+{
+	LodSelection::SetThresholds(m_selectionIndex, m_lod1ScreenSize, m_lod2ScreenSize, m_culledScreenSize, m_hysteresis);
+
+	// The levels may have changed, show them all until the next selection
+	SetAllLevel(true);
+	m_localSphereRadius = -1;
+	LodSelection::SetBoundingSphere(m_selectionIndex, 0, 0, 0, -1);
+}
+
+void Lod::OnComponentAttached()
 {
-	const float camDis = Vector3::Distance(GetTransformRaw()->GetPosition(), Graphics::usedCamera->GetTransformRaw()->GetPosition());
-	if (camDis >= m_culledDistance) 
+	if (!m_isBoundToTransform)
 	{
-		SetAllLevel(false);
+		GetTransformRaw()->GetOnTransformUpdated().Bind(&Lod::OnTransformUpdated, this);
+		m_isBoundToTransform = true;
 	}
-	else if (camDis >= m_lod2Distance)
+	LodSelection::SetThresholds(m_selectionIndex, m_lod1ScreenSize, m_lod2ScreenSize, m_culledScreenSize, m_hysteresis);
+}
+
+void Lod::UpdateBoundingSphere()
+{
+	const std::shared_ptr<MeshRenderer> lod0 = m_lod0MeshRenderer.lock();
+	if (!lod0 || !lod0->GetMeshData())
+		return;
+
+	// Bounding sphere of the level 0 moved in the space of the lod transform
+	const Sphere& meshSphere = lod0->GetMeshData()->GetBoundingSphere();
+	const glm::vec4 meshCenter = glm::vec4(meshSphere.position.x, meshSphere.position.y, meshSphere.position.z, 1.0f);
+	const glm::mat4 lodToWorld = GetTransformRaw()->GetTransformationMatrix();
+	const glm::mat4 levelToWorld = lod0->GetTransformRaw()->GetTransformationMatrix();
+	m_localSphereCenter = glm::vec3(glm::inverse(lodToWorld) * levelToWorld * meshCenter);
+
+	const Vector3& levelScale = lod0->GetTransformRaw()->GetScale();
+	const Vector3& lodScale = GetTransformRaw()->GetScale();
+	const float levelMaxScale = std::max({ std::abs(levelScale.x), std::abs(levelScale.y), std::abs(levelScale.z) });
+	const float lodMaxScale = std::max({ std::abs(lodScale.x), std::abs(lodScale.y), std::abs(lodScale.z) });
+	m_localSphereRadius = lodMaxScale > 0 ? meshSphere.radius * levelMaxScale / lodMaxScale : 0;
+
+	ConvertOldDistances(meshSphere.radius * levelMaxScale);
+
+	OnTransformUpdated();
+}
+
+void Lod::OnTransformUpdated()
+{
+	if (m_localSphereRadius < 0)
+		return;
+
+	const glm::vec3 center = glm::vec3(GetTransformRaw()->GetTransformationMatrix() * glm::vec4(m_localSphereCenter, 1.0f));
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	const float radius = m_localSphereRadius * std::max({ std::abs(scale.x), std::abs(scale.y), std::abs(scale.z) });
+
+	// The transformation matrix has a flipped x axis
+	LodSelection::SetBoundingSphere(m_selectionIndex, -center.x, center.y, center.z, radius);
+}
+
+void Lod::ConvertOldDistances(float radius)
+{
+	if (m_lod1Distance < 0 && m_lod2Distance < 0 && m_culledDistance < 0)
+		return;
+
+	// The old distances did not depend on the camera, use the field of view of a default camera
+	static constexpr float defaultFov = 60.0f;
+	if (m_lod1Distance >= 0)
 	{
-		UseLevel(m_lod2MeshRenderer, m_lod0MeshRenderer, m_lod1MeshRenderer);
+		m_lod1ScreenSize = LodSelection::DistanceToScreenSize(radius, m_lod1Distance, defaultFov);
+		m_lod1Distance = -1;
 	}
-	else if (camDis >= m_lod1Distance)
+	if (m_lod2Distance >= 0)
 	{
-		UseLevel(m_lod1MeshRenderer, m_lod0MeshRenderer, m_lod2MeshRenderer);
+		m_lod2ScreenSize = LodSelection::DistanceToScreenSize(radius, m_lod2Distance, defaultFov);
+		m_lod2Distance = -1;
 	}
-	else
+	if (m_culledDistance >= 0)
 	{
-		UseLevel(m_lod0MeshRenderer, m_lod1MeshRenderer, m_lod2MeshRenderer);
+		m_culledScreenSize = LodSelection::DistanceToScreenSize(radius, m_culledDistance, defaultFov);
+		m_culledDistance = -1;
 	}
+	LodSelection::SetThresholds(m_selectionIndex, m_lod1ScreenSize, m_lod2ScreenSize, m_culledScreenSize, m_hysteresis);
 }
 
 void Lod::RemoveReferences()
@@ -50,22 +120,16 @@ void Lod::RemoveReferences()
 	Graphics::RemoveLod(std::dynamic_pointer_cast<Lod>(shared_from_this()));
 }
 
-void Lod::UseLevel(const std::weak_ptr<MeshRenderer>& levelToEnable, const std::weak_ptr<MeshRenderer>& levelToDisable0, const std::weak_ptr<MeshRenderer>& levelToDisable1)
+void Lod::UseLevel(uint8_t level)
 {
-	// Set levelToEnable as visible and other as not visible
-	if (levelToEnable.lock())
-	{
-		levelToEnable.lock()->m_culled = false;
-	}
-
-	if (levelToDisable0.lock())
-	{
-		levelToDisable0.lock()->m_culled = true;
-	}
-
-	if (levelToDisable1.lock())
+	// Set the level as visible and the others as not visible
+	const std::shared_ptr<MeshRenderer> levels[LodSelection::s_levelCount] = { m_lod0MeshRenderer.lock(), m_lod1MeshRenderer.lock(), m_lod2MeshRenderer.lock() };
+	for (int i = 0; i < LodSelection::s_levelCount; i++)
 	{
-		levelToDisable1.lock()->m_culled = true;
+		if (levels[i])
+		{
+			levels[i]->m_culled = i != level;
+		}
 	}
 }
 
@@ -89,5 +153,9 @@ void Lod::SetAllLevel(bool visible)
 
 Lod::~Lod()
 {
+	if (m_isBoundToTransform)
+	{
+		GetTransformRaw()->GetOnTransformUpdated().Unbind(&Lod::OnTransformUpdated, this);
+	}
 	SetAllLevel(true);
-}
\ No newline at end of file
+}
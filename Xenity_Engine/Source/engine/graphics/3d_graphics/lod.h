@@ -6,13 +6,18 @@
 
 #pragma once
 
+#include <glm/vec3.hpp>
+
 #include <engine/api.h>
 #include <engine/component.h>
+#include <engine/graphics/3d_graphics/lod_selection.h>
 
 class MeshRenderer;
 
 /**
 * @brief Component to manage Level of Detail (LOD) for a GameObject
+*
+* The level is chosen with the size of the object on the screen (fraction of the screen height covered by the bounding sphere of the level 0)
 */
 class API Lod : public Component
 {
@@ -22,30 +27,62 @@ public:
 protected:
 	ReflectiveData GetReflectiveData() override;
 
+	void OnReflectionUpdated() override;
+
+	void OnComponentAttached() override;
+
 	void RemoveReferences()  override;
 
 	friend class Graphics;
+	friend class LodSelection;
+	friend class StaticBatching;
+
+	/**
+	* @brief [Internal] Compute the local bounding sphere from the level 0 and send the world sphere to the lod selection
+	*/
+	void UpdateBoundingSphere();
 
 	/**
-	* @brief [Internal] Check the lod
+	* @brief [Internal] Send the world bounding sphere to the lod selection when the transform has changed
 	*/
-	void CheckLod();
+	void OnTransformUpdated();
 
 	/**
-	* @brief Use one of the level and disable the others
+	* @brief Use one of the levels and hide the others
+	* @param level Level to use (LodSelection::s_culledLevel to hide all the levels)
 	*/
-	void UseLevel(const std::weak_ptr<MeshRenderer>& levelToEnable, const std::weak_ptr<MeshRenderer>& levelToDisable0, const std::weak_ptr<MeshRenderer>& levelToDisable1);
+	void UseLevel(uint8_t level);
 
 	/**
 	* @brief Set all the level to visible or not
 	*/
 	void SetAllLevel(bool visible);
 
+	/**
+	* @brief Convert the distances of the old versions to screen sizes
+	* @param radius Radius of the bounding sphere of the level 0 in world space
+	*/
+	void ConvertOldDistances(float radius);
+
 	std::weak_ptr<MeshRenderer> m_lod0MeshRenderer;
 	std::weak_ptr<MeshRenderer> m_lod1MeshRenderer;
 	std::weak_ptr<MeshRenderer> m_lod2MeshRenderer;
-	float m_lod1Distance = 7;
-	float m_lod2Distance = 15;
-	float m_culledDistance = 30;
+	float m_lod1ScreenSize = 0.5f;
+	float m_lod2ScreenSize = 0.25f;
+	float m_culledScreenSize = 0.02f;
+	float m_hysteresis = 0.1f;
+
+	// Distances of the old versions (negative if not used), converted to screen sizes when the bounding sphere is known
+	float m_lod1Distance = -1;
+	float m_lod2Distance = -1;
+	float m_culledDistance = -1;
+
+	// Bounding sphere of the level 0 in the space of the lod transform (negative radius if unknown)
+	glm::vec3 m_localSphereCenter = glm::vec3(0);
+	float m_localSphereRadius = -1;
+
+	// Index in the lod selection list
+	uint32_t m_selectionIndex = LodSelection::s_invalidIndex;
+	bool m_isBoundToTransform = false;
 };
 
@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "lod_selection.h"
+
+#include <cmath>
+#include <limits>
+
+#include <engine/math/vector3.h>
+#include <engine/graphics/camera.h>
+#include <engine/graphics/3d_graphics/lod.h>
+#include <engine/game_elements/transform.h>
+#include <engine/assertions/assertions.h>
+
+std::vector<LodSelection::LodData> LodSelection::s_lodData;
+std::vector<Lod*> LodSelection::s_lods;
+std::vector<LodSelection::CameraLevels> LodSelection::s_cameraLevels;
+
+void LodSelection::Stop()
+{
+	s_lodData.clear();
+	s_lods.clear();
+	s_cameraLevels.clear();
+}
+
+uint32_t LodSelection::AddLod(Lod& lod)
+{
+	s_lodData.emplace_back();
+	s_lods.push_back(&lod);
+	for (CameraLevels& cameraLevels : s_cameraLevels)
+	{
+		cameraLevels.levels.push_back(s_unknownLevel);
+	}
+	return static_cast<uint32_t>(s_lods.size() - 1);
+}
+
+void LodSelection::RemoveLod(uint32_t index)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	XASSERT(index < s_lods.size(), "[LodSelection::RemoveLod] index is out of range");
+
+	// Move the last lod to the free index to keep the list contiguous
+	const size_t lastIndex = s_lods.size() - 1;
+	if (index != lastIndex)
+	{
+		s_lodData[index] = s_lodData[lastIndex];
+		s_lods[index] = s_lods[lastIndex];
+		s_lods[index]->m_selectionIndex = index;
+		for (CameraLevels& cameraLevels : s_cameraLevels)
+		{
+			cameraLevels.levels[index] = cameraLevels.levels[lastIndex];
+		}
+	}
+
+	s_lodData.pop_back();
+	s_lods.pop_back();
+	for (CameraLevels& cameraLevels : s_cameraLevels)
+	{
+		cameraLevels.levels.pop_back();
+	}
+}
+
+void LodSelection::RemoveCamera(const Camera& camera)
+{
+	const size_t cameraCount = s_cameraLevels.size();
+	for (size_t i = 0; i < cameraCount; i++)
+	{
+		if (s_cameraLevels[i].camera == &camera)
+		{
+			s_cameraLevels.erase(s_cameraLevels.begin() + i);
+			break;
+		}
+	}
+}
+
+void LodSelection::SetBoundingSphere(uint32_t index, float x, float y, float z, float radius)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	LodData& data = s_lodData[index];
+	data.centerX = x;
+	data.centerY = y;
+	data.centerZ = z;
+	data.radius = radius;
+}
+
+void LodSelection::SetThresholds(uint32_t index, float lod1ScreenSize, float lod2ScreenSize, float culledScreenSize, float hysteresis)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	LodData& data = s_lodData[index];
+	data.thresholds[0] = lod1ScreenSize;
+	data.thresholds[1] = lod2ScreenSize;
+	data.thresholds[2] = culledScreenSize;
+	data.hysteresis = hysteresis;
+	// Select the level again without hysteresis
+	data.appliedLevel = s_unknownLevel;
+	for (CameraLevels& cameraLevels : s_cameraLevels)
+	{
+		cameraLevels.levels[index] = s_unknownLevel;
+	}
+}
+
+uint8_t LodSelection::SelectLevel(float screenSize, uint8_t currentLevel, const float* thresholds, float hysteresis)
+{
+	if (currentLevel == s_unknownLevel)
+	{
+		uint8_t level = 0;
+		while (level < s_culledLevel && screenSize < thresholds[level])
+		{
+			level++;
+		}
+		return level;
+	}
+
+	// Go to a more detailed level only when the size is clearly above the threshold, and to a less detailed one when it is clearly under
+	uint8_t level = currentLevel;
+	while (level > 0 && screenSize >= thresholds[level - 1] * (1 + hysteresis))
+	{
+		level--;
+	}
+	while (level < s_culledLevel && screenSize < thresholds[level] * (1 - hysteresis))
+	{
+		level++;
+	}
+	return level;
+}
+
+float LodSelection::DistanceToScreenSize(float radius, float distance, float fov)
+{
+	if (distance <= radius)
+		return std::numeric_limits<float>::max();
+
+	// Same as LodSelection::Select for a perspective camera
+	return radius / (std::tan(fov * 0.5f * 3.14159265f / 180.0f) * distance);
+}
+
+void LodSelection::Select(const Camera& camera)
+{
+	const size_t lodCount = s_lods.size();
+	if (lodCount == 0)
+		return;
+
+	const Vector3& cameraPosition = camera.GetTransformRaw()->GetPosition();
+
+	// Screen size = radius / half height of the view at the distance of the object
+	const bool isPerspective = camera.GetProjectionType() == ProjectionType::Perspective;
+	float sizeFactor = 0;
+	if (isPerspective)
+	{
+		sizeFactor = 1.0f / std::tan(camera.GetFov() * 0.5f * 3.14159265f / 180.0f);
+	}
+	else
+	{
+		// See Camera::UpdateProjection, the half height is a tenth of the projection size
+		sizeFactor = 10.0f / camera.GetProjectionSize();
+	}
+
+	// Levels selected for this camera the last time
+	CameraLevels* cameraLevels = nullptr;
+	for (CameraLevels& levels : s_cameraLevels)
+	{
+		if (levels.camera == &camera)
+		{
+			cameraLevels = &levels;
+			break;
+		}
+	}
+	if (!cameraLevels)
+	{
+		cameraLevels = &s_cameraLevels.emplace_back();
+		cameraLevels->camera = &camera;
+		cameraLevels->levels.resize(lodCount, s_unknownLevel);
+	}
+	uint8_t* levels = cameraLevels->levels.data();
+
+	LodData* lodData = s_lodData.data();
+	for (size_t i = 0; i < lodCount; i++)
+	{
+		LodData& data = lodData[i];
+		if (data.radius < 0)
+		{
+			// The bounding sphere may be known now (references of the lod resolved after its creation)
+			s_lods[i]->UpdateBoundingSphere();
+			if (data.radius < 0)
+				continue;
+		}
+
+		float screenSize = data.radius * sizeFactor;
+		if (isPerspective)
+		{
+			const float dx = data.centerX - cameraPosition.x;
+			const float dy = data.centerY - cameraPosition.y;
+			const float dz = data.centerZ - cameraPosition.z;
+			const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+			// Inside the sphere: always the most detailed level
+			screenSize = distance > data.radius ? screenSize / distance : std::numeric_limits<float>::max();
+		}
+
+		const uint8_t level = SelectLevel(screenSize, levels[i], data.thresholds, data.hysteresis);
+		levels[i] = level;
+		if (level != data.appliedLevel)
+		{
+			data.appliedLevel = level;
+			s_lods[i]->UseLevel(level);
+		}
+	}
+}
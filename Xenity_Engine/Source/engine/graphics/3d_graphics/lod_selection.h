@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <engine/api.h>
+
+class Camera;
+class Lod;
+
+/**
+* @brief Level selection of the Lod components
+*
+* The bounding sphere and the thresholds of each lod are stored in a contiguous list updated in one pass per camera.
+* The level is chosen with the projected size of the sphere on the screen, with a hysteresis band around each threshold to not switch every frame.
+* Each camera keeps its own levels, so the hysteresis of a camera is not reset by the other cameras.
+* The mesh renderers of a lod are only changed when the level of the rendering camera is not the one already applied.
+*/
+class API LodSelection
+{
+public:
+	static constexpr uint32_t s_invalidIndex = UINT32_MAX;
+	static constexpr int s_levelCount = 3;
+	// Level used when the object is too small to be drawn
+	static constexpr uint8_t s_culledLevel = s_levelCount;
+	// Level of a lod not selected yet, the first selection ignores the hysteresis
+	static constexpr uint8_t s_unknownLevel = UINT8_MAX;
+
+	/**
+	* @brief Clear the list
+	*/
+	static void Stop();
+
+	/**
+	* @brief Add a lod to the list (without bounding sphere, always at the level 0 until the sphere is set)
+	* @return Index of the lod in the list
+	*/
+	[[nodiscard]] static uint32_t AddLod(Lod& lod);
+
+	/**
+	* @brief Remove a lod from the list, the last lod takes its index
+	* @param index Index of the lod (ignored if invalid)
+	*/
+	static void RemoveLod(uint32_t index);
+
+	/**
+	* @brief Forget the levels selected for a camera
+	*/
+	static void RemoveCamera(const Camera& camera);
+
+	/**
+	* @brief Set the bounding sphere of a lod in world space (a negative radius disables the selection)
+	* @param index Index of the lod (ignored if invalid)
+	*/
+	static void SetBoundingSphere(uint32_t index, float x, float y, float z, float radius);
+
+	/**
+	* @brief Set the screen sizes of a lod
+	* @param index Index of the lod (ignored if invalid)
+	* @param lod1ScreenSize, lod2ScreenSize, culledScreenSize Screen size (fraction of the screen height) under which the next level is used
+	* @param hysteresis Fraction of the threshold to cross before changing the level
+	*/
+	static void SetThresholds(uint32_t index, float lod1ScreenSize, float lod2ScreenSize, float culledScreenSize, float hysteresis);
+
+	/**
+	* @brief Select the level of all the lods for a camera and apply the levels that changed
+	*/
+	static void Select(const Camera& camera);
+
+	/**
+	* @brief Choose a level from a screen size
+	* @param screenSize Fraction of the screen height covered by the object
+	* @param currentLevel Level used until now (s_unknownLevel to ignore the hysteresis)
+	* @param thresholds Screen sizes under which the levels 1, 2 and culled are used (in decreasing order)
+	* @param hysteresis Fraction of the threshold to cross before leaving the current level
+	*/
+	[[nodiscard]] static uint8_t SelectLevel(float screenSize, uint8_t currentLevel, const float* thresholds, float hysteresis);
+
+	/**
+	* @brief Get the screen size of a sphere at a distance of a perspective camera
+	* @param radius Radius of the sphere
+	* @param distance Distance between the camera and the center of the sphere
+	* @param fov Vertical field of view of the camera in degrees
+	* @return Fraction of the screen height covered by the sphere
+	*/
+	[[nodiscard]] static float DistanceToScreenSize(float radius, float distance, float fov);
+
+private:
+	friend class StaticBatching;
+
+	struct LodData
+	{
+		float centerX = 0;
+		float centerY = 0;
+		float centerZ = 0;
+		float radius = -1;
+		float thresholds[s_levelCount] = { 0, 0, 0 };
+		float hysteresis = 0;
+		// Level of the mesh renderers
+		uint8_t appliedLevel = s_unknownLevel;
+	};
+
+	struct CameraLevels
+	{
+		const Camera* camera = nullptr;
+		// Level selected for each lod (same indices as s_lodData)
+		std::vector<uint8_t> levels;
+	};
+
+	static std::vector<LodData> s_lodData;
+	static std::vector<Lod*> s_lods;
+	static std::vector<CameraLevels> s_cameraLevels;
+};
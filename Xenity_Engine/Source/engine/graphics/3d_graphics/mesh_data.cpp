@@ -15,7 +15,10 @@
 #include <rsx/rsx.h>
 #endif
 
+#include <glm/ext/matrix_transform.hpp>
+
 #include <engine/graphics/color/color.h>
+#include <engine/graphics/3d_graphics/vertex_quantization.h>
 #include <engine/graphics/graphics.h>
 #include <engine/debug/debug.h>
 #include <engine/engine.h>
@@ -25,6 +28,7 @@
 #endif
 #include <engine/file_system/mesh_loader/binary_mesh_loader.h>
 #include <engine/asset_management/asset_manager.h>
+#include <engine/asset_management/residency_manager.h>
 #include <engine/graphics/renderer/renderer.h>
 #include <engine/file_system/async_file_loading.h>
 #if defined(_EE)
@@ -45,10 +49,8 @@ MeshData::MeshData(bool isForCooking) : FileReference(isForCooking)
 MeshData::~MeshData()
 {
 	Unload();
-	if (m_fileId != -1)
-	{
-		Graphics::s_isRenderingBatchDirty = true;
-	}
+	// Only the commands of the drawables still using this mesh are recreated
+	Graphics::SetDrawablesDirty(*this);
 }
 
 std::shared_ptr<MeshData> MeshData::CreateMeshData()
@@ -177,6 +179,37 @@ void MeshData::SubMesh::SetColor(const Color& color, uint32_t vertexIndex)
 	}
 }
 
+Vector3 MeshData::SubMesh::GetPosition(uint32_t vertexIndex) const
+{
+	XASSERT(vertexIndex < m_vertice_count, "[MeshData::GetPosition] vertexIndex out of bound");
+
+	const char* vertexData = ((const char*)m_data) + (vertexIndex * m_vertexDescriptor.GetVertexSize()) + m_vertexDescriptor.GetPositionOffset();
+	if (m_vertexDescriptor.GetElementFromIndex(m_vertexDescriptor.GetPositionIndex()) == VertexElement::POSITION_16_BITS)
+	{
+		const int16_t* quantizedPosition = reinterpret_cast<const int16_t*>(vertexData);
+		const Vector3 position = Vector3(VertexQuantization::DequantizeSnorm16(quantizedPosition[0]),
+			VertexQuantization::DequantizeSnorm16(quantizedPosition[1]),
+			VertexQuantization::DequantizeSnorm16(quantizedPosition[2]));
+		return m_positionCenter + position * m_positionExtent;
+	}
+
+	const float* position = reinterpret_cast<const float*>(vertexData);
+	return Vector3(position[0], position[1], position[2]);
+}
+
+void MeshData::SubMesh::SetPositionBounds(const Vector3& center, const Vector3& extent)
+{
+	m_positionCenter = center;
+	m_positionExtent = extent;
+	m_hasQuantizedPositions = true;
+}
+
+glm::mat4 MeshData::SubMesh::GetDequantizationMatrix() const
+{
+	glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(m_positionCenter.x, m_positionCenter.y, m_positionCenter.z));
+	return glm::scale(matrix, glm::vec3(m_positionExtent.x, m_positionExtent.y, m_positionExtent.z));
+}
+
 void MeshData::SendDataToGpu()
 {
 	Engine::GetRenderer().UploadMeshData(*this);
@@ -193,11 +226,7 @@ void MeshData::ComputeBoundingBox()
 		const uint32_t verticesCount = subMesh->m_vertice_count;
 		for (uint32_t vertexIndex = 0; vertexIndex < verticesCount; vertexIndex++)
 		{
-			Vector3 vert;
-			float* vertexPtr = (float*)((char*)subMesh->m_data + subMesh->m_vertexDescriptor.GetVertexElementList()[subMesh->m_vertexDescriptor.GetPositionIndex()].offset + vertexIndex * subMesh->m_vertexDescriptor.GetVertexSize());
-			vert.x = vertexPtr[0];
-			vert.y = vertexPtr[1];
-			vert.z = vertexPtr[2];
+			const Vector3 vert = subMesh->GetPosition(vertexIndex);
 
 			if (firstValue)
 			{
@@ -332,6 +361,7 @@ void MeshData::UnloadFileReference()
 {
 	if (Engine::IsRunning(true))
 	{
+		ResidencyManager::Forget(*this);
 		if (m_fileStatus == FileStatus::FileStatus_Loaded)
 		{
 			m_fileStatus = FileStatus::FileStatus_Not_Loaded;
@@ -376,7 +406,8 @@ void MeshData::CreateSubMesh(uint32_t vcount, uint32_t index_count, const Vertex
 	std::unique_ptr<MeshData::SubMesh> newSubMesh = std::make_unique<MeshData::SubMesh>();
 	newSubMesh->m_vertexDescriptor = vertexDescriptorList;
 	newSubMesh->m_meshData = this;
-	if (index_count >= std::numeric_limits<unsigned short>::max())
+	// The indices address the vertices, 16 bits indices are enough if there are not too many vertices
+	if (vcount >= std::numeric_limits<unsigned short>::max())
 	{
 		newSubMesh->usesShortIndices = false;
 	}
@@ -565,6 +596,7 @@ void MeshData::CreateSubMesh(uint32_t vcount, uint32_t index_count, const Vertex
 
 #endif
 
+	newSubMesh->m_subMeshIndex = m_subMeshCount;
 	m_subMeshes.push_back(std::move(newSubMesh));
 	m_subMeshCount++;
 }
@@ -583,6 +615,11 @@ void MeshData::SubMesh::FreeData()
 {
 	//Debug::Print("[MeshData::SubMesh::FreeData] Freeing data");
 
+	// The submeshes evicted by the ResidencyManager are freed before their destruction
+	if (m_isDataFreed)
+		return;
+	m_isDataFreed = true;
+
 #if !defined(_EE)
 	if (m_data)
 	{
@@ -9,6 +9,8 @@
 #include <vector>
 #include <memory>
 
+#include <glm/mat4x4.hpp>
+
 #if defined(_EE)
 #include <draw3d.h>
 #include <packet2.h>
@@ -120,6 +122,42 @@ public:
 		*/
 		void SetColor(const Color& color, uint32_t vertexIndex);
 
+		/**
+		* @brief Get the position of a vertex (16 bits positions are dequantized)
+		*/
+		[[nodiscard]] Vector3 GetPosition(uint32_t vertexIndex) const;
+
+		/**
+		* @brief Set the bounds of the 16 bits positions (position = center + extent * quantized position)
+		*/
+		void SetPositionBounds(const Vector3& center, const Vector3& extent);
+
+		/**
+		* @brief Get if the positions are quantized in the submesh bounds
+		*/
+		[[nodiscard]] bool HasQuantizedPositions() const
+		{
+			return m_hasQuantizedPositions;
+		}
+
+		/**
+		* @brief Get if the normals are octahedral encoded (drawn with the OCTAHEDRAL_NORMALS variant of the shader)
+		*/
+		[[nodiscard]] bool HasOctahedralNormals() const
+		{
+			const int32_t normalIndex = static_cast<int32_t>(m_vertexDescriptor.GetNormalIndex());
+			if (normalIndex < 0)
+				return false;
+
+			const VertexElement normalElement = m_vertexDescriptor.GetElementFromIndex(normalIndex);
+			return normalElement == VertexElement::NORMAL_OCTAHEDRAL_8_BITS || normalElement == VertexElement::NORMAL_OCTAHEDRAL_16_BITS;
+		}
+
+		/**
+		* @brief Get the matrix to apply before the model matrix to dequantize the positions
+		*/
+		[[nodiscard]] glm::mat4 GetDequantizationMatrix() const;
+
 		/**
 		* @brief Set index value
 		* @param (value) The new vertex index
@@ -152,6 +190,7 @@ public:
 		void * m_indices = nullptr;
 	public:
 		MeshData* m_meshData = nullptr;
+		uint32_t m_subMeshIndex = 0; // Index in the submesh list of the mesh data
 		// On PSP, we have to respect a specific order for the data
 		// UV Color (uint32_t ARGB) Normal  Position
 		void * m_data = nullptr;
@@ -163,6 +202,10 @@ public:
 		uint32_t m_index_count = 0;
 		uint32_t m_vertice_count = 0;
 
+		// Bounds of the quantized positions, written in the cooked file
+		Vector3 m_positionCenter;
+		Vector3 m_positionExtent = Vector3(1);
+
 #if defined(_EE)
 		VECTOR *c_verts = nullptr;
 		VECTOR *c_colours = nullptr;
@@ -190,6 +233,8 @@ public:
 #endif
 		bool usesShortIndices = true;
 		bool m_isQuad = false;
+		bool m_hasQuantizedPositions = false;
+		bool m_isDataFreed = false;
 	};
 
 	MeshData() = default;
@@ -249,12 +294,14 @@ protected:
 	friend class RendererGU;
 	friend class RendererGsKit;
 	friend class RendererVU1;
+	friend class RendererNull;
 	friend class WavefrontLoader;
 	friend class SpriteManager;
 	friend class Tilemap;
 	friend class TextManager;
 	friend class InspectorMenu;
 	friend class MeshRenderer;
+	friend class OcclusionCulling;
 	friend class Graphics;
 	friend class LineRenderer;
 	friend class SceneMenu;
@@ -264,6 +311,11 @@ protected:
 	friend class BinaryMeshLoader;
 	friend class AssimpMeshLoader;
 	friend class ProjectManager;
+	friend class DynamicMesh;
+	friend class StaticBatching;
+	friend class MeshOptimizer;
+	friend class MeshQuantizer;
+	friend class ResidencyManager;
 
 	Vector3 m_minBoundingBox;
 	Vector3 m_maxBoundingBox;
@@ -12,6 +12,7 @@
 
 #include <engine/graphics/renderer/renderer.h>
 #include <engine/graphics/3d_graphics/mesh_manager.h>
+#include <engine/graphics/3d_graphics/occlusion_culling.h>
 #include <engine/graphics/material.h>
 #include <engine/game_elements/transform.h>
 #include <engine/asset_management/asset_manager.h>
@@ -26,23 +27,17 @@
 
 using namespace std;
 
+namespace
+{
+	// Instances of the current instanced draw call, reused between draws
+	std::vector<RenderInstanceData> s_instanceData;
+}
+
 // #pragma region MeshRenderer Constructors / Destructor
 
-bool IsSphereInFrustum(const Frustum& frustum, const Sphere& sphere)
+MeshRenderer::MeshRenderer()
 {
-	const glm::vec4 pos = glm::vec4(sphere.position, 1);
-	for (const Plane& plane : frustum.planes)
-	{
-		// Distance between the center of the sphere and the plane
-		const float distance = glm::dot(plane.data, pos);
-
-		// If the distance is less than -radius, the sphere is completely out of the frustum
-		if (distance < -sphere.radius)
-		{
-			return false;
-		}
-	}
-	return true;
+	m_drawableType = DrawableType::MeshRenderer;
 }
 
 void MeshRenderer::OnDrawGizmosSelected()
@@ -114,6 +109,19 @@ void MeshRenderer::SetUseAdvancedLighting(bool value)
 	}
 }
 
+void MeshRenderer::SetIsOccluder(bool value)
+{
+	m_isOccluder = value;
+	if (m_isOccluder)
+	{
+		OcclusionCulling::AddOccluder(*this);
+	}
+	else
+	{
+		OcclusionCulling::RemoveOccluder(*this);
+	}
+}
+
 Sphere MeshRenderer::ProcessBoundingSphere() const
 {
 	Sphere sphere;
@@ -129,17 +137,22 @@ Sphere MeshRenderer::ProcessBoundingSphere() const
 	return sphere;
 }
 
-void MeshRenderer::OnNewRender(int cameraIndex)
+void MeshRenderer::OnComponentAttached()
 {
-	if (GetGameObjectRaw()->IsLocalActive() && IsEnabled())
+	GetTransformRaw()->GetOnTransformUpdated().Bind(&MeshRenderer::OnTransformPositionUpdated, this);
+
+	if (m_cullingIndex == FrustumCulling::s_invalidIndex)
 	{
-		m_outOfFrustum = !IsSphereInFrustum(Graphics::usedCamera->frustum, m_boundingSphere);
+		m_cullingIndex = FrustumCulling::AddMeshRenderer(*this);
 	}
+	m_boundingSphere = ProcessBoundingSphere();
+	FrustumCulling::SetBoundingSphere(m_cullingIndex, m_boundingSphere);
+	UpdateCullingActiveState();
 }
 
-void MeshRenderer::OnComponentAttached()
+void MeshRenderer::UpdateCullingActiveState()
 {
-	GetTransformRaw()->GetOnTransformUpdated().Bind(&MeshRenderer::OnTransformPositionUpdated, this);
+	FrustumCulling::SetActive(m_cullingIndex, IsEnabled() && GetGameObjectRaw()->IsLocalActive());
 }
 
 ReflectiveData MeshRenderer::GetReflectiveData()
@@ -148,6 +161,7 @@ ReflectiveData MeshRenderer::GetReflectiveData()
 	Reflective::AddVariable(reflectedVariables, m_meshData, "meshData");
 	Reflective::AddVariable(reflectedVariables, m_materials, "materials");
 	Reflective::AddVariable(reflectedVariables, m_useAdvancedLighting, "useAdvancedLighting");
+	Reflective::AddVariable(reflectedVariables, m_isOccluder, "isOccluder");
 	return reflectedVariables;
 }
 
@@ -161,9 +175,11 @@ void MeshRenderer::OnReflectionUpdated()
 	}
 
 	m_matCount = static_cast<uint8_t>(m_materials.size());
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 
 	m_boundingSphere = ProcessBoundingSphere();
+	FrustumCulling::SetBoundingSphere(m_cullingIndex, m_boundingSphere);
+	SetIsOccluder(m_isOccluder);
 	if (!m_useAdvancedLighting)
 	{
 		WorldPartitionner::RemoveMeshRenderer(this);
@@ -181,6 +197,8 @@ MeshRenderer::~MeshRenderer()
 {
 	GetTransformRaw()->GetOnTransformUpdated().Unbind(&MeshRenderer::OnTransformPositionUpdated, this);
 	WorldPartitionner::RemoveMeshRenderer(this);
+	FrustumCulling::RemoveMeshRenderer(m_cullingIndex);
+	OcclusionCulling::RemoveMeshRenderer(*this);
 }
 
 void MeshRenderer::CreateRenderCommands(RenderBatch& renderBatch)
@@ -209,23 +227,28 @@ void MeshRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 		command.isEnabled = IsEnabled() && GetGameObjectRaw()->IsLocalActive();
 		if (material->GetRenderingMode() == MaterialRenderingMode::Opaque || material->GetRenderingMode() == MaterialRenderingMode::Cutout)
 		{
-#if defined(ENABLE_OVERDRAW_OPTIMIZATION)
-			renderBatch.opaqueMeshCommands.push_back(command);
-			renderBatch.opaqueMeshCommandIndex++;
-#else
-			RenderQueue& renderQueue = renderBatch.renderQueues[material->GetFileId()];
-			renderQueue.commands.push_back(command);
-			renderQueue.commandIndex++;
-#endif
+			renderBatch.AddCommand(RenderPass::Opaque, command);
 		}
 		else
 		{
-			renderBatch.transparentMeshCommands.push_back(command);
-			renderBatch.transparentMeshCommandIndex++;
+			renderBatch.AddCommand(RenderPass::Transparent, command);
 		}
 	}
 }
 
+bool MeshRenderer::UsesFileReference(const FileReference& fileReference) const
+{
+	if (m_meshData.get() == &fileReference)
+		return true;
+
+	for (const std::shared_ptr<Material>& material : m_materials)
+	{
+		if (material.get() == &fileReference)
+			return true;
+	}
+	return false;
+}
+
 void MeshRenderer::SetMeshData(const std::shared_ptr<MeshData>& meshData)
 {
 	m_meshData = meshData;
@@ -239,7 +262,7 @@ void MeshRenderer::SetMeshData(const std::shared_ptr<MeshData>& meshData)
 
 	}
 	OnTransformPositionUpdated();
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void MeshRenderer::SetMaterial(const std::shared_ptr<Material>& material, int index)
@@ -248,37 +271,34 @@ void MeshRenderer::SetMaterial(const std::shared_ptr<Material>& material, int in
 	if (index < m_materials.size())
 	{
 		m_materials[index] = material;
-		Graphics::s_isRenderingBatchDirty = true;
+		SetRenderCommandsDirty();
 	}
 }
 
 void MeshRenderer::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	UpdateCullingActiveState();
+	SetRenderCommandsDirty();
 }
 
 void MeshRenderer::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	UpdateCullingActiveState();
+	SetRenderCommandsDirty();
 }
 
-void MeshRenderer::DrawCommand(const RenderCommand& renderCommand)
+bool MeshRenderer::PrepareDraw(const RenderCommand& renderCommand)
 {
-	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
-
-	if (m_culled || m_outOfFrustum)
-		return;
-
 	if (renderCommand.material->GetShader() == nullptr)
 	{
-		return;
+		return false;
 	}
 
 	if constexpr (!s_UseOpenGLFixedFunctions)
 	{
 		if (renderCommand.material->GetShader()->GetFileStatus() != FileStatus::FileStatus_Loaded)
 		{
-			return;
+			return false;
 		}
 	}
 
@@ -406,6 +426,19 @@ void MeshRenderer::DrawCommand(const RenderCommand& renderCommand)
 		}
 	}
 
+	return true;
+}
+
+void MeshRenderer::DrawCommand(const RenderCommand& renderCommand)
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	if (m_culled || !FrustumCulling::IsVisible(m_cullingIndex))
+		return;
+
+	if (!PrepareDraw(renderCommand))
+		return;
+
 	RenderingSettings renderSettings = RenderingSettings();
 	renderSettings.invertFaces = false;
 	renderSettings.useDepth = true;
@@ -415,9 +448,99 @@ void MeshRenderer::DrawCommand(const RenderCommand& renderCommand)
 	MeshManager::DrawMesh(*GetTransformRaw(), *renderCommand.subMesh, *renderCommand.material, renderSettings);
 }
 
+bool MeshRenderer::IsInstanceCompatible([[maybe_unused]] const RenderCommand& renderCommand, [[maybe_unused]] const RenderCommand& otherCommand) const
+{
+#if defined(ENABLE_HARDWARE_INSTANCING)
+	if (otherCommand.subMesh != renderCommand.subMesh || otherCommand.material != renderCommand.material)
+		return false;
+
+	// A particle system can use the same submesh and material
+	if (otherCommand.drawable->GetDrawableType() != DrawableType::MeshRenderer)
+		return false;
+
+	const MeshRenderer* otherRenderer = static_cast<const MeshRenderer*>(otherCommand.drawable);
+
+	// The lights are sent once for all the instances
+	if (renderCommand.material->GetUseLighting())
+	{
+		const bool hasLights = m_useAdvancedLighting && !m_affectedByLights.empty();
+		const bool otherHasLights = otherRenderer->m_useAdvancedLighting && !otherRenderer->m_affectedByLights.empty();
+		if (hasLights != otherHasLights || (hasLights && m_affectedByLights != otherRenderer->m_affectedByLights))
+			return false;
+	}
+
+	// The face order is shared by all the instances
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	const Vector3& otherScale = otherRenderer->GetTransformRaw()->GetScale();
+	return (scale.x * scale.y * scale.z < 0) == (otherScale.x * otherScale.y * otherScale.z < 0);
+#else
+	return false;
+#endif
+}
+
+bool MeshRenderer::DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount)
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	if constexpr (s_UseOpenGLFixedFunctions)
+	{
+		return false;
+	}
+
+	if (!Engine::GetRenderer().IsInstancingSupported())
+		return false;
+
+	const RenderCommand& firstCommand = *renderCommands[0];
+	if (!PrepareDraw(firstCommand))
+		return true;
+
+	// Custom shaders may not read the instance attributes
+	if (!firstCommand.material->GetShader()->IsInstancingSupported())
+		return false;
+
+	// Same submesh for all the commands
+	const bool hasQuantizedPositions = firstCommand.subMesh->HasQuantizedPositions();
+	const glm::mat4 dequantizationMatrix = hasQuantizedPositions ? firstCommand.subMesh->GetDequantizationMatrix() : glm::mat4(1.0f);
+
+	s_instanceData.clear();
+	for (size_t i = 0; i < commandCount; i++)
+	{
+		const RenderCommand& renderCommand = *renderCommands[i];
+		const MeshRenderer& meshRenderer = static_cast<const MeshRenderer&>(*renderCommand.drawable);
+		if (meshRenderer.m_culled || !FrustumCulling::IsVisible(meshRenderer.m_cullingIndex))
+			continue;
+
+		Transform& transform = *meshRenderer.GetTransformRaw();
+		RenderInstanceData& data = s_instanceData.emplace_back();
+		data.model = transform.GetTransformationMatrix();
+		data.mvp = transform.GetMVPMatrix(Graphics::s_currentFrame);
+		data.normalMatrix = transform.GetInverseNormalMatrix();
+		if (hasQuantizedPositions)
+		{
+			data.model = data.model * dequantizationMatrix;
+			data.mvp = data.mvp * dequantizationMatrix;
+		}
+	}
+
+	if (s_instanceData.empty())
+		return true;
+
+	const Vector3& scale = GetTransformRaw()->GetScale();
+
+	RenderingSettings renderSettings = RenderingSettings();
+	renderSettings.invertFaces = scale.x * scale.y * scale.z < 0;
+	renderSettings.useDepth = true;
+	renderSettings.useTexture = true;
+	renderSettings.useLighting = firstCommand.material->GetUseLighting();
+	renderSettings.renderingMode = firstCommand.material->GetRenderingMode();
+	Graphics::DrawSubMeshInstanced(*firstCommand.subMesh, *firstCommand.material, renderSettings, s_instanceData.data(), s_instanceData.size());
+	return true;
+}
+
 void MeshRenderer::OnTransformPositionUpdated()
 {
 	m_boundingSphere = ProcessBoundingSphere();
+	FrustumCulling::SetBoundingSphere(m_cullingIndex, m_boundingSphere);
 	if (m_useAdvancedLighting)
 	{
 		WorldPartitionner::ProcessMeshRenderer(this);
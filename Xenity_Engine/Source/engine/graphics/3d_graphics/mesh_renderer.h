@@ -11,6 +11,7 @@
 #include <engine/api.h>
 #include <engine/graphics/iDrawable.h>
 #include <engine/graphics/3d_graphics/sphere.h>
+#include <engine/graphics/3d_graphics/frustum_culling.h>
 #include <engine/world_partitionner/world_partitionner.h>
 
 class MeshData;
@@ -23,6 +24,7 @@ class Light;
 class API MeshRenderer : public IDrawable
 {
 public:
+	MeshRenderer();
 	~MeshRenderer();
 
 	/**
@@ -84,10 +86,26 @@ public:
 	*/
 	void SetUseAdvancedLighting(bool value);
 
+	/**
+	* @brief Get if the mesh is used as an occluder by the occlusion culling
+	*/
+	[[nodiscard]] bool GetIsOccluder() const
+	{
+		return m_isOccluder;
+	}
+
+	/**
+	* @brief Set if the mesh is used as an occluder by the occlusion culling (use simple meshes like walls or big buildings)
+	*/
+	void SetIsOccluder(bool value);
+
 protected:
 	friend class WorldPartitionner;
+	friend class FrustumCulling;
+	friend class OcclusionCulling;
+	friend class StaticBatching;
+	friend class TextureStreaming;
 
-	void OnNewRender(int cameraIndex) override;
 	void OnComponentAttached() override;
 	void OnDrawGizmosSelected() override;
 
@@ -121,13 +139,41 @@ protected:
 	*/
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
+	/**
+	* @brief Get if the mesh data or one of the materials is this file
+	*/
+	[[nodiscard]] bool UsesFileReference(const FileReference& fileReference) const override;
+
+	/**
+	* @brief Get if the other command uses the same submesh, material, lights and face order
+	*/
+	[[nodiscard]] bool IsInstanceCompatible(const RenderCommand& renderCommand, const RenderCommand& otherCommand) const override;
+
+	/**
+	* @brief Draw the visible mesh renderers of the commands with one instanced draw call
+	*/
+	[[nodiscard]] bool DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount) override;
+
+	/**
+	* @brief Check the shader and update the lights of the shader before drawing a command
+	* @return False if the command cannot be drawn
+	*/
+	[[nodiscard]] bool PrepareDraw(const RenderCommand& renderCommand);
+
 	void OnTransformPositionUpdated();
 
+	/**
+	* @brief Send the active state to the frustum culling
+	*/
+	void UpdateCullingActiveState();
+
 	std::shared_ptr <MeshData> m_meshData = nullptr;
 	std::vector<std::shared_ptr <Material>> m_materials;
 	uint8_t m_matCount = 0;
 
+	// Index in the frustum culling lists
+	uint32_t m_cullingIndex = FrustumCulling::s_invalidIndex;
 	bool m_culled = false;
-	bool m_outOfFrustum = false;
 	bool m_useAdvancedLighting = true;
+	bool m_isOccluder = false;
 };
\ No newline at end of file
@@ -0,0 +1,398 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "occlusion_culling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define OCCLUSION_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+#include <engine/graphics/camera.h>
+#include <engine/graphics/3d_graphics/mesh_renderer.h>
+#include <engine/graphics/3d_graphics/mesh_data.h>
+#include <engine/graphics/3d_graphics/vertex_quantization.h>
+#include <engine/graphics/3d_graphics/frustum_culling.h>
+#include <engine/game_elements/transform.h>
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/performance.h>
+
+std::vector<float> OcclusionCulling::s_depthBuffer;
+std::vector<float> OcclusionCulling::s_hierarchicalDepth;
+std::vector<glm::vec4> OcclusionCulling::s_clipPositions;
+std::vector<MeshRenderer*> OcclusionCulling::s_occluders;
+std::vector<MeshRenderer*> OcclusionCulling::s_culledMeshRenderers;
+float OcclusionCulling::s_minW = 0;
+
+static_assert(OcclusionCulling::s_depthBufferWidth % 4 == 0, "The depth buffer width has to be a multiple of 4");
+static_assert(OcclusionCulling::s_depthBufferWidth % OcclusionCulling::s_tileSize == 0, "The depth buffer width has to be a multiple of the tile size");
+static_assert(OcclusionCulling::s_depthBufferHeight % OcclusionCulling::s_tileSize == 0, "The depth buffer height has to be a multiple of the tile size");
+
+namespace
+{
+	// Depth of an empty pixel (far plane)
+	constexpr float s_clearDepth = 1.0f;
+
+	/**
+	* @brief Convert a clip space position to the depth buffer space (pixels and NDC depth)
+	*/
+	glm::vec3 ToDepthBufferSpace(const glm::vec4& clipPosition)
+	{
+		const float inverseW = 1.0f / clipPosition.w;
+		return glm::vec3((clipPosition.x * inverseW * 0.5f + 0.5f) * OcclusionCulling::s_depthBufferWidth,
+			(clipPosition.y * inverseW * 0.5f + 0.5f) * OcclusionCulling::s_depthBufferHeight,
+			clipPosition.z * inverseW);
+	}
+}
+
+void OcclusionCulling::AddOccluder(MeshRenderer& meshRenderer)
+{
+	if (std::find(s_occluders.begin(), s_occluders.end(), &meshRenderer) == s_occluders.end())
+	{
+		s_occluders.push_back(&meshRenderer);
+	}
+}
+
+void OcclusionCulling::RemoveOccluder(MeshRenderer& meshRenderer)
+{
+	const auto it = std::find(s_occluders.begin(), s_occluders.end(), &meshRenderer);
+	if (it != s_occluders.end())
+	{
+		s_occluders.erase(it);
+	}
+}
+
+void OcclusionCulling::RemoveMeshRenderer(MeshRenderer& meshRenderer)
+{
+	RemoveOccluder(meshRenderer);
+
+	// The mesh renderer may be destroyed before the end of the render
+	const auto culledIt = std::find(s_culledMeshRenderers.begin(), s_culledMeshRenderers.end(), &meshRenderer);
+	if (culledIt != s_culledMeshRenderers.end())
+	{
+		s_culledMeshRenderers.erase(culledIt);
+	}
+}
+
+void OcclusionCulling::ClearDepthBuffer(float nearClippingPlane)
+{
+	s_minW = nearClippingPlane;
+	s_depthBuffer.assign(static_cast<size_t>(s_depthBufferWidth) * s_depthBufferHeight, s_clearDepth);
+	s_hierarchicalDepth.assign(static_cast<size_t>(s_tileCountX) * s_tileCountY, s_clearDepth);
+}
+
+void OcclusionCulling::RasterizeTriangle(const glm::vec4& clipA, const glm::vec4& clipB, const glm::vec4& clipC)
+{
+	// Triangles crossing the near plane are ignored, an occluder can only hide less objects
+	if (clipA.w < s_minW || clipB.w < s_minW || clipC.w < s_minW)
+		return;
+
+	const glm::vec3 a = ToDepthBufferSpace(clipA);
+	glm::vec3 b = ToDepthBufferSpace(clipB);
+	glm::vec3 c = ToDepthBufferSpace(clipC);
+
+	// Both faces are rasterized, use the same winding for the edge functions
+	float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	if (std::abs(area) < 1e-6f)
+		return;
+
+	if (area < 0)
+	{
+		std::swap(b, c);
+		area = -area;
+	}
+
+	const int minX = std::max(0, static_cast<int>(std::floor(std::min({ a.x, b.x, c.x }))));
+	const int maxX = std::min(s_depthBufferWidth - 1, static_cast<int>(std::ceil(std::max({ a.x, b.x, c.x }))));
+	const int minY = std::max(0, static_cast<int>(std::floor(std::min({ a.y, b.y, c.y }))));
+	const int maxY = std::min(s_depthBufferHeight - 1, static_cast<int>(std::ceil(std::max({ a.y, b.y, c.y }))));
+	if (minX > maxX || minY > maxY)
+		return;
+
+	// Edge functions: edge(v0, v1, p) = stepX * p.x + stepY * p.y + offset, positive inside the triangle
+	const float edge0StepX = b.y - c.y, edge0StepY = c.x - b.x;
+	const float edge1StepX = c.y - a.y, edge1StepY = a.x - c.x;
+	const float edge2StepX = a.y - b.y, edge2StepY = b.x - a.x;
+	const float edge0Offset = -edge0StepX * b.x - edge0StepY * b.y;
+	const float edge1Offset = -edge1StepX * c.x - edge1StepY * c.y;
+	const float edge2Offset = -edge2StepX * a.x - edge2StepY * a.y;
+
+	// The NDC depth is linear in screen space
+	const float inverseArea = 1.0f / area;
+	const float depthStepX = (edge0StepX * a.z + edge1StepX * b.z + edge2StepX * c.z) * inverseArea;
+	const float depthStepY = (edge0StepY * a.z + edge1StepY * b.z + edge2StepY * c.z) * inverseArea;
+	const float depthOffset = (edge0Offset * a.z + edge1Offset * b.z + edge2Offset * c.z) * inverseArea;
+
+	// Process 4 pixels at a time, the depth buffer width is a multiple of 4
+	const int startX = minX & ~3;
+
+#if defined(OCCLUSION_USE_SSE)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+#endif
+
+	for (int y = minY; y <= maxY; y++)
+	{
+		const float pixelY = y + 0.5f;
+		const float edge0Row = edge0StepY * pixelY + edge0Offset;
+		const float edge1Row = edge1StepY * pixelY + edge1Offset;
+		const float edge2Row = edge2StepY * pixelY + edge2Offset;
+		const float depthRow = depthStepY * pixelY + depthOffset;
+		float* row = s_depthBuffer.data() + static_cast<size_t>(y) * s_depthBufferWidth;
+
+		for (int x = startX; x <= maxX; x += 4)
+		{
+#if defined(OCCLUSION_USE_SSE)
+			const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), pixelOffsets);
+			const __m128 edge0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge0StepX), pixelX), _mm_set1_ps(edge0Row));
+			const __m128 edge1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge1StepX), pixelX), _mm_set1_ps(edge1Row));
+			const __m128 edge2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge2StepX), pixelX), _mm_set1_ps(edge2Row));
+			const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+			if (_mm_movemask_ps(inside) == 0)
+				continue;
+
+			const __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthStepX), pixelX), _mm_set1_ps(depthRow));
+			const __m128 oldDepth = _mm_loadu_ps(row + x);
+			const __m128 newDepth = _mm_min_ps(oldDepth, depth);
+			_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, newDepth), _mm_andnot_ps(inside, oldDepth)));
+#else
+			for (int lane = 0; lane < 4; lane++)
+			{
+				const float pixelX = x + lane + 0.5f;
+				if (edge0StepX * pixelX + edge0Row < 0 || edge1StepX * pixelX + edge1Row < 0 || edge2StepX * pixelX + edge2Row < 0)
+					continue;
+
+				const float depth = depthStepX * pixelX + depthRow;
+				if (depth < row[x + lane])
+				{
+					row[x + lane] = depth;
+				}
+			}
+#endif
+		}
+	}
+}
+
+void OcclusionCulling::BuildHierarchicalDepth()
+{
+	for (int tileY = 0; tileY < s_tileCountY; tileY++)
+	{
+		for (int tileX = 0; tileX < s_tileCountX; tileX++)
+		{
+			float maxDepth = -1.0f;
+			for (int y = 0; y < s_tileSize; y++)
+			{
+				const float* row = s_depthBuffer.data() + static_cast<size_t>(tileY * s_tileSize + y) * s_depthBufferWidth + tileX * s_tileSize;
+#if defined(OCCLUSION_USE_SSE)
+				__m128 rowMax = _mm_loadu_ps(row);
+				for (int x = 4; x < s_tileSize; x += 4)
+				{
+					rowMax = _mm_max_ps(rowMax, _mm_loadu_ps(row + x));
+				}
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, rowMax);
+				maxDepth = std::max({ maxDepth, lanes[0], lanes[1], lanes[2], lanes[3] });
+#else
+				for (int x = 0; x < s_tileSize; x++)
+				{
+					maxDepth = std::max(maxDepth, row[x]);
+				}
+#endif
+			}
+			s_hierarchicalDepth[static_cast<size_t>(tileY) * s_tileCountX + tileX] = maxDepth;
+		}
+	}
+}
+
+bool OcclusionCulling::IsBoxOccluded(const glm::mat4& viewProjection, const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+	float minX = std::numeric_limits<float>::max();
+	float minY = std::numeric_limits<float>::max();
+	float maxX = -std::numeric_limits<float>::max();
+	float maxY = -std::numeric_limits<float>::max();
+	float minDepth = std::numeric_limits<float>::max();
+	for (int i = 0; i < 8; i++)
+	{
+		const glm::vec4 corner = glm::vec4((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z, 1.0f);
+		const glm::vec4 clipPosition = viewProjection * corner;
+
+		// The box is crossing the near plane, consider it visible
+		if (clipPosition.w < s_minW)
+			return false;
+
+		const glm::vec3 position = ToDepthBufferSpace(clipPosition);
+		minX = std::min(minX, position.x);
+		maxX = std::max(maxX, position.x);
+		minY = std::min(minY, position.y);
+		maxY = std::max(maxY, position.y);
+		minDepth = std::min(minDepth, position.z);
+	}
+
+	// Out of the screen, let the frustum culling decide
+	if (maxX < 0 || maxY < 0 || minX >= s_depthBufferWidth || minY >= s_depthBufferHeight)
+		return false;
+
+	const int firstTileX = std::clamp(static_cast<int>(minX), 0, s_depthBufferWidth - 1) / s_tileSize;
+	const int lastTileX = std::clamp(static_cast<int>(maxX), 0, s_depthBufferWidth - 1) / s_tileSize;
+	const int firstTileY = std::clamp(static_cast<int>(minY), 0, s_depthBufferHeight - 1) / s_tileSize;
+	const int lastTileY = std::clamp(static_cast<int>(maxY), 0, s_depthBufferHeight - 1) / s_tileSize;
+
+	// Occluded only if the nearest point of the box is behind the farthest occluder depth of all the covered tiles
+	for (int tileY = firstTileY; tileY <= lastTileY; tileY++)
+	{
+		const float* row = s_hierarchicalDepth.data() + static_cast<size_t>(tileY) * s_tileCountX;
+		for (int tileX = firstTileX; tileX <= lastTileX; tileX++)
+		{
+			if (row[tileX] >= minDepth)
+				return false;
+		}
+	}
+	return true;
+}
+
+void OcclusionCulling::RasterizeOccluder(const MeshRenderer& occluder, const glm::mat4& viewProjection)
+{
+	const std::shared_ptr<MeshData>& meshData = occluder.GetMeshData();
+	if (!meshData)
+		return;
+
+	const glm::mat4 mvp = viewProjection * occluder.GetTransformRaw()->GetTransformationMatrix();
+	for (uint32_t subMeshIndex = 0; subMeshIndex < meshData->m_subMeshCount; subMeshIndex++)
+	{
+		const MeshData::SubMesh& subMesh = *meshData->m_subMeshes[subMeshIndex];
+		if (!subMesh.m_data || subMesh.m_isQuad || subMesh.m_vertice_count == 0)
+			continue;
+
+		// Only the float positions and the quantized positions are supported
+		const int32_t positionIndex = static_cast<int32_t>(subMesh.m_vertexDescriptor.GetPositionIndex());
+		if (positionIndex < 0)
+			continue;
+
+		const VertexElement positionElement = subMesh.m_vertexDescriptor.GetElementFromIndex(positionIndex);
+		if (positionElement != VertexElement::POSITION_32_BITS && !(positionElement == VertexElement::POSITION_16_BITS && subMesh.HasQuantizedPositions()))
+			continue;
+
+		const uint32_t vertexSize = subMesh.m_vertexDescriptor.GetVertexSize();
+		const unsigned char* positions = static_cast<const unsigned char*>(subMesh.m_data) + subMesh.m_vertexDescriptor.GetPositionOffset();
+		s_clipPositions.resize(subMesh.m_vertice_count);
+		if (positionElement == VertexElement::POSITION_16_BITS)
+		{
+			const glm::mat4 subMeshMvp = mvp * subMesh.GetDequantizationMatrix();
+			for (uint32_t i = 0; i < subMesh.m_vertice_count; i++)
+			{
+				const int16_t* position = reinterpret_cast<const int16_t*>(positions + static_cast<size_t>(i) * vertexSize);
+				s_clipPositions[i] = subMeshMvp * glm::vec4(VertexQuantization::DequantizeSnorm16(position[0]), VertexQuantization::DequantizeSnorm16(position[1]), VertexQuantization::DequantizeSnorm16(position[2]), 1.0f);
+			}
+		}
+		else
+		{
+			for (uint32_t i = 0; i < subMesh.m_vertice_count; i++)
+			{
+				const float* position = reinterpret_cast<const float*>(positions + static_cast<size_t>(i) * vertexSize);
+				s_clipPositions[i] = mvp * glm::vec4(position[0], position[1], position[2], 1.0f);
+			}
+		}
+
+		if (subMesh.m_index_count == 0)
+		{
+			for (uint32_t i = 0; i + 2 < subMesh.m_vertice_count; i += 3)
+			{
+				RasterizeTriangle(s_clipPositions[i], s_clipPositions[i + 1], s_clipPositions[i + 2]);
+			}
+		}
+		else if (subMesh.usesShortIndices)
+		{
+			const uint16_t* indices = static_cast<const uint16_t*>(subMesh.GetIndices());
+			for (uint32_t i = 0; i + 2 < subMesh.m_index_count; i += 3)
+			{
+				RasterizeTriangle(s_clipPositions[indices[i]], s_clipPositions[indices[i + 1]], s_clipPositions[indices[i + 2]]);
+			}
+		}
+		else
+		{
+			const uint32_t* indices = static_cast<const uint32_t*>(subMesh.GetIndices());
+			for (uint32_t i = 0; i + 2 < subMesh.m_index_count; i += 3)
+			{
+				RasterizeTriangle(s_clipPositions[indices[i]], s_clipPositions[indices[i + 1]], s_clipPositions[indices[i + 2]]);
+			}
+		}
+	}
+}
+
+void OcclusionCulling::Cull(Camera& camera)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+	XASSERT(s_culledMeshRenderers.empty(), "[OcclusionCulling::Cull] ResetCulledMeshRenderers was not called after the last render");
+
+	if (s_occluders.empty() || camera.GetProjectionType() != ProjectionType::Perspective)
+		return;
+
+	SCOPED_PROFILER("OcclusionCulling::Cull", scopeBenchmark);
+
+	const glm::mat4& viewProjection = camera.m_viewProjectionMatrix;
+	ClearDepthBuffer(camera.GetNearClippingPlane());
+
+	bool hasOccluder = false;
+	for (const MeshRenderer* occluder : s_occluders)
+	{
+		if (occluder->m_cullingIndex == FrustumCulling::s_invalidIndex || !FrustumCulling::IsVisible(occluder->m_cullingIndex))
+			continue;
+
+		RasterizeOccluder(*occluder, viewProjection);
+		hasOccluder = true;
+	}
+
+	if (!hasOccluder)
+		return;
+
+	BuildHierarchicalDepth();
+
+	// Test the mesh renderers that passed the frustum culling
+	const size_t wordCount = FrustumCulling::s_visibilityBits.size();
+	for (size_t word = 0; word < wordCount; word++)
+	{
+		uint64_t visibleBits = FrustumCulling::s_visibilityBits[word];
+		while (visibleBits != 0)
+		{
+			// Index of the lowest set bit
+			size_t bit = 0;
+			while (((visibleBits >> bit) & 1) == 0)
+			{
+				bit++;
+			}
+			visibleBits &= visibleBits - 1;
+
+			const size_t index = word * 64 + bit;
+			MeshRenderer* meshRenderer = FrustumCulling::s_meshRenderers[index];
+			if (meshRenderer->m_culled || meshRenderer->m_isOccluder)
+				continue;
+
+			// The bounding sphere is stored with a flipped x axis (see MeshRenderer::ProcessBoundingSphere)
+			const glm::vec3 center = glm::vec3(-FrustumCulling::s_centersX[index], FrustumCulling::s_centersY[index], FrustumCulling::s_centersZ[index]);
+			const glm::vec3 extent = glm::vec3(FrustumCulling::s_radii[index]);
+			if (IsBoxOccluded(viewProjection, center - extent, center + extent))
+			{
+				meshRenderer->m_culled = true;
+				s_culledMeshRenderers.push_back(meshRenderer);
+			}
+		}
+	}
+}
+
+void OcclusionCulling::ResetCulledMeshRenderers()
+{
+	for (MeshRenderer* meshRenderer : s_culledMeshRenderers)
+	{
+		meshRenderer->m_culled = false;
+	}
+	s_culledMeshRenderers.clear();
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <engine/api.h>
+
+class Camera;
+class MeshRenderer;
+
+/**
+* @brief CPU occlusion culling of the mesh renderers
+*
+* The mesh renderers marked as occluder are rasterized in a low resolution depth buffer,
+* then the bounding box of each mesh renderer in the frustum is tested against a hierarchical version of the buffer (max depth per tile).
+* Hidden mesh renderers are culled (m_culled) until the end of the camera render.
+* Nothing is done if there is no occluder.
+*/
+class API OcclusionCulling
+{
+public:
+	static constexpr int s_depthBufferWidth = 256;
+	static constexpr int s_depthBufferHeight = 128;
+	static constexpr int s_tileSize = 8;
+	static constexpr int s_tileCountX = s_depthBufferWidth / s_tileSize;
+	static constexpr int s_tileCountY = s_depthBufferHeight / s_tileSize;
+
+	/**
+	* @brief Add a mesh renderer to the occluder list
+	*/
+	static void AddOccluder(MeshRenderer& meshRenderer);
+
+	/**
+	* @brief Remove a mesh renderer from the occluder list (if present)
+	*/
+	static void RemoveOccluder(MeshRenderer& meshRenderer);
+
+	/**
+	* @brief Remove all the references to a mesh renderer (called when the mesh renderer is destroyed)
+	*/
+	static void RemoveMeshRenderer(MeshRenderer& meshRenderer);
+
+	/**
+	* @brief Rasterize the occluders and cull the hidden mesh renderers for a camera (call after the frustum culling)
+	*/
+	static void Cull(Camera& camera);
+
+	/**
+	* @brief Uncull the mesh renderers culled by the last Cull call (call at the end of the camera render)
+	*/
+	static void ResetCulledMeshRenderers();
+
+	/**
+	* @brief Get the number of mesh renderers culled by the last Cull call
+	*/
+	[[nodiscard]] static size_t GetCulledCount()
+	{
+		return s_culledMeshRenderers.size();
+	}
+
+	/**
+	* @brief Clear the depth buffer
+	* @param nearClippingPlane Triangles and boxes with a point closer than this w value are not used (they are clipped on the GPU)
+	*/
+	static void ClearDepthBuffer(float nearClippingPlane);
+
+	/**
+	* @brief Rasterize a triangle in the depth buffer (keeps the nearest depth)
+	* @param clipA, clipB, clipC Clip space positions of the triangle
+	*/
+	static void RasterizeTriangle(const glm::vec4& clipA, const glm::vec4& clipB, const glm::vec4& clipC);
+
+	/**
+	* @brief Build the hierarchical depth buffer (farthest depth of each tile) from the depth buffer
+	*/
+	static void BuildHierarchicalDepth();
+
+	/**
+	* @brief Get if a box is fully hidden by the rasterized occluders
+	* @param viewProjection View projection matrix of the camera
+	* @param boxMin, boxMax World space box
+	*/
+	[[nodiscard]] static bool IsBoxOccluded(const glm::mat4& viewProjection, const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+private:
+	/**
+	* @brief Rasterize all the submeshes of an occluder
+	*/
+	static void RasterizeOccluder(const MeshRenderer& occluder, const glm::mat4& viewProjection);
+
+	static std::vector<float> s_depthBuffer;
+	static std::vector<float> s_hierarchicalDepth;
+	static std::vector<glm::vec4> s_clipPositions;
+	static std::vector<MeshRenderer*> s_occluders;
+	static std::vector<MeshRenderer*> s_culledMeshRenderers;
+	static float s_minW;
+};
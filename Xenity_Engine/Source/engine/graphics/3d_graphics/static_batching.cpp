@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "static_batching.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <unordered_set>
+
+#include <glm/glm.hpp>
+
+#include <engine/engine.h>
+#include <engine/game_elements/gameobject.h>
+#include <engine/game_elements/transform.h>
+#include <engine/graphics/material.h>
+#include <engine/graphics/3d_graphics/mesh_renderer.h>
+#include <engine/graphics/3d_graphics/mesh_data.h>
+#include <engine/graphics/3d_graphics/frustum_culling.h>
+#include <engine/graphics/3d_graphics/lod.h>
+#include <engine/graphics/3d_graphics/lod_selection.h>
+#include <engine/debug/debug.h>
+#include <engine/debug/stack_debug_object.h>
+#include <engine/assertions/assertions.h>
+
+namespace
+{
+	/**
+	* @brief Pack the vertex elements of a descriptor in one value to compare layouts (4 elements of 16 bits)
+	*/
+	uint64_t GetVertexLayoutKey(const VertexDescriptor& vertexDescriptor)
+	{
+		uint64_t key = 0;
+		for (const VertexElementInfo& elementInfo : vertexDescriptor.GetVertexElementList())
+		{
+			key = (key << 16) | static_cast<uint64_t>(elementInfo.vertexElement);
+		}
+		return key;
+	}
+
+	int32_t GetCell(float value)
+	{
+		return static_cast<int32_t>(std::floor(value / StaticBatching::s_cellSize));
+	}
+
+	uint32_t GetIndex(const MeshData::SubMesh& subMesh, uint32_t index)
+	{
+		// Submeshes without indices are drawn in vertex order
+		if (subMesh.m_index_count == 0)
+			return index;
+
+		if (subMesh.usesShortIndices)
+			return static_cast<const uint16_t*>(subMesh.GetIndices())[index];
+
+		return static_cast<const uint32_t*>(subMesh.GetIndices())[index];
+	}
+}
+
+bool StaticBatching::HaveSameKey(const BatchEntry& a, const BatchEntry& b)
+{
+	return a.material == b.material && a.vertexLayout == b.vertexLayout && a.color == b.color && a.useAdvancedLighting == b.useAdvancedLighting &&
+		a.cellX == b.cellX && a.cellY == b.cellY && a.cellZ == b.cellZ;
+}
+
+bool StaticBatching::CanBeBatched(const MeshRenderer& meshRenderer)
+{
+	const GameObject* gameObject = meshRenderer.GetGameObjectRaw();
+	if (!gameObject->IsStatic() || !gameObject->IsLocalActive() || !meshRenderer.IsEnabled())
+		return false;
+
+	// Occluders have to stay separated to be rasterized by the occlusion culling
+	if (meshRenderer.GetIsOccluder())
+		return false;
+
+	const std::shared_ptr<MeshData>& meshData = meshRenderer.GetMeshData();
+	return meshData && meshData->GetFileStatus() == FileStatus::FileStatus_Loaded;
+}
+
+void StaticBatching::Build()
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	// The levels of a Lod are enabled and disabled at runtime, they can't be merged
+	std::unordered_set<const MeshRenderer*> lodMeshRenderers;
+	for (const Lod* lod : LodSelection::s_lods)
+	{
+		lodMeshRenderers.insert(lod->m_lod0MeshRenderer.lock().get());
+		lodMeshRenderers.insert(lod->m_lod1MeshRenderer.lock().get());
+		lodMeshRenderers.insert(lod->m_lod2MeshRenderer.lock().get());
+	}
+
+	std::vector<BatchEntry> entries;
+	for (size_t i = 0; i < FrustumCulling::s_count; i++)
+	{
+		MeshRenderer* meshRenderer = FrustumCulling::s_meshRenderers[i];
+		if (!CanBeBatched(*meshRenderer) || lodMeshRenderers.find(meshRenderer) != lodMeshRenderers.end())
+			continue;
+
+		const MeshData& meshData = *meshRenderer->GetMeshData();
+		const Sphere& sphere = meshRenderer->GetBoundingSphere();
+		const uint32_t subMeshCount = std::min<uint32_t>(meshData.m_subMeshCount, static_cast<uint32_t>(meshRenderer->m_materials.size()));
+		for (uint32_t subMeshIndex = 0; subMeshIndex < subMeshCount; subMeshIndex++)
+		{
+			const MeshData::SubMesh& subMesh = *meshData.m_subMeshes[subMeshIndex];
+			const Material* material = meshRenderer->m_materials[subMeshIndex].get();
+			if (!material || !subMesh.m_data || subMesh.m_isQuad || subMesh.m_vertice_count == 0)
+				continue;
+
+			// Only the float positions and normals are transformed
+			const VertexDescriptor& vertexDescriptor = subMesh.m_vertexDescriptor;
+			if (vertexDescriptor.GetPositionIndex() == static_cast<uint32_t>(-1) ||
+				vertexDescriptor.GetElementFromIndex(vertexDescriptor.GetPositionIndex()) != VertexElement::POSITION_32_BITS)
+				continue;
+
+			if (vertexDescriptor.GetNormalIndex() != static_cast<uint32_t>(-1) &&
+				vertexDescriptor.GetElementFromIndex(vertexDescriptor.GetNormalIndex()) != VertexElement::NORMAL_32_BITS)
+				continue;
+
+			const uint32_t indexCount = subMesh.m_index_count != 0 ? subMesh.m_index_count : subMesh.m_vertice_count;
+			if (subMesh.m_vertice_count > s_maxChunkSize || indexCount > s_maxChunkSize)
+				continue;
+
+			BatchEntry entry;
+			entry.meshRenderer = meshRenderer;
+			entry.subMeshIndex = subMeshIndex;
+			entry.material = reinterpret_cast<uintptr_t>(material);
+			entry.vertexLayout = GetVertexLayoutKey(vertexDescriptor);
+			entry.color = meshData.unifiedColor.GetUnsignedIntRGBA();
+			entry.useAdvancedLighting = meshRenderer->GetUseAdvancedLighting();
+			entry.cellX = GetCell(sphere.position.x);
+			entry.cellY = GetCell(sphere.position.y);
+			entry.cellZ = GetCell(sphere.position.z);
+			entries.push_back(entry);
+		}
+	}
+
+	if (entries.empty())
+		return;
+
+	std::sort(entries.begin(), entries.end(), [](const BatchEntry& a, const BatchEntry& b)
+		{
+			if (a.material != b.material) return a.material < b.material;
+			if (a.vertexLayout != b.vertexLayout) return a.vertexLayout < b.vertexLayout;
+			if (a.color != b.color) return a.color < b.color;
+			if (a.useAdvancedLighting != b.useAdvancedLighting) return a.useAdvancedLighting < b.useAdvancedLighting;
+			if (a.cellX != b.cellX) return a.cellX < b.cellX;
+			if (a.cellY != b.cellY) return a.cellY < b.cellY;
+			return a.cellZ < b.cellZ;
+		});
+
+	// Cut the sorted list in chunks of the same key that fit in 16 bits indices
+	std::vector<const BatchEntry*> batchedEntries;
+	size_t chunkStart = 0;
+	uint32_t vertexCount = 0;
+	uint32_t indexCount = 0;
+	const size_t entryCount = entries.size();
+	for (size_t i = 0; i <= entryCount; i++)
+	{
+		uint32_t entryVertexCount = 0;
+		uint32_t entryIndexCount = 0;
+		bool isChunkEnded = i == entryCount;
+		if (!isChunkEnded)
+		{
+			const MeshData::SubMesh& subMesh = *entries[i].meshRenderer->GetMeshData()->m_subMeshes[entries[i].subMeshIndex];
+			entryVertexCount = subMesh.m_vertice_count;
+			entryIndexCount = subMesh.m_index_count != 0 ? subMesh.m_index_count : subMesh.m_vertice_count;
+			isChunkEnded = i != chunkStart && (!HaveSameKey(entries[i], entries[chunkStart]) ||
+				vertexCount + entryVertexCount > s_maxChunkSize || indexCount + entryIndexCount > s_maxChunkSize);
+		}
+
+		if (isChunkEnded)
+		{
+			// A single submesh is already drawn in one call
+			if (i - chunkStart > 1)
+			{
+				if (CreateBatch(&entries[chunkStart], i - chunkStart, vertexCount, indexCount))
+				{
+					for (size_t j = chunkStart; j < i; j++)
+					{
+						batchedEntries.push_back(&entries[j]);
+					}
+				}
+			}
+			chunkStart = i;
+			vertexCount = 0;
+			indexCount = 0;
+		}
+
+		vertexCount += entryVertexCount;
+		indexCount += entryIndexCount;
+	}
+
+	// Remove the merged submeshes from their renderers (a renderer can have submeshes that were not merged)
+	for (const BatchEntry* entry : batchedEntries)
+	{
+		entry->meshRenderer->SetMaterial(nullptr, entry->subMeshIndex);
+	}
+
+	// Disable the renderers that have nothing left to draw to remove them from the culling
+	[[maybe_unused]] size_t disabledCount = 0; // Only printed in debug
+	for (const BatchEntry* entry : batchedEntries)
+	{
+		MeshRenderer& meshRenderer = *entry->meshRenderer;
+		if (!meshRenderer.IsEnabled())
+			continue;
+
+		bool hasMaterial = false;
+		for (const std::shared_ptr<Material>& material : meshRenderer.m_materials)
+		{
+			if (material)
+			{
+				hasMaterial = true;
+				break;
+			}
+		}
+
+		if (!hasMaterial)
+		{
+			meshRenderer.SetIsEnabled(false);
+			disabledCount++;
+		}
+	}
+
+#if defined(DEBUG)
+	Debug::Print("[StaticBatching::Build] " + std::to_string(batchedEntries.size()) + " submeshes merged, " + std::to_string(disabledCount) + " mesh renderers disabled");
+#endif
+}
+
+bool StaticBatching::CreateBatch(const BatchEntry* entries, size_t entryCount, uint32_t vertexCount, uint32_t indexCount)
+{
+	const MeshData::SubMesh& firstSubMesh = *entries[0].meshRenderer->GetMeshData()->m_subMeshes[entries[0].subMeshIndex];
+	const VertexDescriptor& vertexDescriptor = firstSubMesh.m_vertexDescriptor;
+	const uint32_t vertexSize = vertexDescriptor.GetVertexSize();
+	const uint32_t positionOffset = vertexDescriptor.GetPositionOffset();
+	const bool hasNormals = vertexDescriptor.GetNormalIndex() != static_cast<uint32_t>(-1);
+	const uint32_t normalOffset = hasNormals ? vertexDescriptor.GetNormalOffset() : 0;
+
+	std::shared_ptr<MeshData> meshData = MeshData::CreateMeshData();
+	meshData->unifiedColor = entries[0].meshRenderer->GetMeshData()->unifiedColor;
+	meshData->CreateSubMesh(vertexCount, indexCount, vertexDescriptor);
+	if (meshData->m_subMeshCount == 0)
+		return false;
+
+	MeshData::SubMesh& newSubMesh = *meshData->m_subMeshes[0];
+	unsigned char* newVertices = static_cast<unsigned char*>(newSubMesh.m_data);
+	uint32_t vertexStart = 0;
+	uint32_t indexStart = 0;
+	for (size_t i = 0; i < entryCount; i++)
+	{
+		const MeshRenderer& meshRenderer = *entries[i].meshRenderer;
+		const MeshData::SubMesh& subMesh = *meshRenderer.GetMeshData()->m_subMeshes[entries[i].subMeshIndex];
+
+		// The combined mesh is drawn with an identity matrix, so the vertices are moved in the renderer space
+		const glm::mat4& matrix = meshRenderer.GetTransformRaw()->GetTransformationMatrix();
+		const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(matrix)));
+
+		memcpy(newVertices + vertexStart * vertexSize, subMesh.m_data, static_cast<size_t>(subMesh.m_vertice_count) * vertexSize);
+		for (uint32_t v = 0; v < subMesh.m_vertice_count; v++)
+		{
+			unsigned char* vertex = newVertices + (vertexStart + v) * vertexSize;
+
+			float* position = reinterpret_cast<float*>(vertex + positionOffset);
+			const glm::vec4 newPosition = matrix * glm::vec4(position[0], position[1], position[2], 1.0f);
+			position[0] = newPosition.x;
+			position[1] = newPosition.y;
+			position[2] = newPosition.z;
+
+			if (hasNormals)
+			{
+				float* normal = reinterpret_cast<float*>(vertex + normalOffset);
+				glm::vec3 newNormal = normalMatrix * glm::vec3(normal[0], normal[1], normal[2]);
+				const float length = glm::length(newNormal);
+				if (length > 0)
+				{
+					newNormal /= length;
+				}
+				normal[0] = newNormal.x;
+				normal[1] = newNormal.y;
+				normal[2] = newNormal.z;
+			}
+		}
+
+		// A negative scale mirrors the mesh, reverse the triangles to keep the same front faces
+		const bool invertFaces = glm::determinant(glm::mat3(matrix)) < 0;
+		const uint32_t subMeshIndexCount = subMesh.m_index_count != 0 ? subMesh.m_index_count : subMesh.m_vertice_count;
+		for (uint32_t index = 0; index < subMeshIndexCount; index++)
+		{
+			uint32_t sourceIndex = index;
+			if (invertFaces)
+			{
+				const uint32_t corner = index % 3;
+				if (corner == 1)
+					sourceIndex = index + 1;
+				else if (corner == 2)
+					sourceIndex = index - 1;
+			}
+			newSubMesh.SetIndex(indexStart + index, vertexStart + GetIndex(subMesh, sourceIndex));
+		}
+
+		vertexStart += subMesh.m_vertice_count;
+		indexStart += subMeshIndexCount;
+	}
+
+	meshData->OnLoadFileReferenceFinished();
+
+	const BatchEntry& firstEntry = entries[0];
+	// The GameObject is at the origin, its transformation matrix is the identity
+	std::shared_ptr<GameObject> gameObject = CreateGameObject("Static Batch");
+	std::shared_ptr<MeshRenderer> meshRenderer = gameObject->AddComponent<MeshRenderer>();
+	meshRenderer->SetMeshData(meshData);
+	meshRenderer->SetMaterial(firstEntry.meshRenderer->m_materials[firstEntry.subMeshIndex], 0);
+	meshRenderer->SetUseAdvancedLighting(firstEntry.useAdvancedLighting);
+	return true;
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MeshRenderer;
+class MeshData;
+
+/**
+* @brief Merge the mesh renderers of static GameObjects into combined meshes when the game starts
+*
+* Submeshes using the same material, vertex layout and lighting mode are merged into one mesh per grid cell,
+* so the frustum culling can still hide the far parts of the level.
+* The merged mesh renderers are disabled, their memory is not freed.
+*/
+class StaticBatching
+{
+public:
+	/**
+	* @brief Merge the static mesh renderers of the loaded scene
+	*/
+	static void Build();
+
+	/**
+	* @brief Size of a grid cell in world units, the submeshes are merged only with the submeshes of the same cell
+	*/
+	static constexpr float s_cellSize = 32.0f;
+
+	/**
+	* @brief Maximum number of vertices or indices in a combined mesh (to use 16 bits indices)
+	*/
+	static constexpr uint32_t s_maxChunkSize = 65534;
+
+private:
+	struct BatchEntry
+	{
+		MeshRenderer* meshRenderer = nullptr;
+		uint32_t subMeshIndex = 0;
+
+		// Batch key
+		uintptr_t material = 0;
+		uint64_t vertexLayout = 0;
+		uint32_t color = 0;
+		bool useAdvancedLighting = false;
+		int32_t cellX = 0;
+		int32_t cellY = 0;
+		int32_t cellZ = 0;
+	};
+
+	/**
+	* @brief Get if two entries can be merged in the same mesh
+	*/
+	[[nodiscard]] static bool HaveSameKey(const BatchEntry& a, const BatchEntry& b);
+
+	/**
+	* @brief Get if a mesh renderer can be merged
+	*/
+	[[nodiscard]] static bool CanBeBatched(const MeshRenderer& meshRenderer);
+
+	/**
+	* @brief Create a GameObject with the combined mesh of the entries
+	* @return False if there is not enough memory for the combined mesh
+	*/
+	[[nodiscard]] static bool CreateBatch(const BatchEntry* entries, size_t entryCount, uint32_t vertexCount, uint32_t indexCount);
+};
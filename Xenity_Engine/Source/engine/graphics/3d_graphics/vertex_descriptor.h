@@ -10,16 +10,18 @@ enum class VertexElement : uint32_t // Do not change the uint32_t type
 {
 	NONE = 0,
 	POSITION_32_BITS = 1 << 0,
-	POSITION_16_BITS = 1 << 1, // Used for PSP
+	POSITION_16_BITS = 1 << 1, // Used for PSP, and for the quantized meshes (normalized in the submesh bounds)
 	POSITION_8_BITS = 1 << 2, // Used for PSP
 	NORMAL_32_BITS = 1 << 3,
 	NORMAL_16_BITS = 1 << 4, // Used for PSP
 	NORMAL_8_BITS = 1 << 5, // Used for PSP
 	UV_32_BITS = 1 << 6,
-	UV_16_BITS = 1 << 7, // Used for PSP
+	UV_16_BITS = 1 << 7, // Used for PSP, and for the quantized meshes (unsigned normalized, UVs between 0 and 1)
 	UV_8_BITS = 1 << 8, // Used for PSP
 	COLOR_4_FLOATS = 1 << 9,
 	COLOR_32_BITS_UINT = 1 << 10, // Used for PSP
+	NORMAL_OCTAHEDRAL_8_BITS = 1 << 11, // Octahedral encoded normal (x, y), signed normalized
+	NORMAL_OCTAHEDRAL_16_BITS = 1 << 12, // Octahedral encoded normal (x, y), signed normalized
 };
 
 constexpr VertexElement operator|(VertexElement lhs, VertexElement rhs)
@@ -92,6 +94,14 @@ struct VertexDescriptor
 		{
 			vertexSize += sizeof(int8_t[3]);
 		}
+		else if ((vertexElement & VertexElement::NORMAL_OCTAHEDRAL_8_BITS) == VertexElement::NORMAL_OCTAHEDRAL_8_BITS)
+		{
+			vertexSize += sizeof(int8_t[2]);
+		}
+		else if ((vertexElement & VertexElement::NORMAL_OCTAHEDRAL_16_BITS) == VertexElement::NORMAL_OCTAHEDRAL_16_BITS)
+		{
+			vertexSize += sizeof(int16_t[2]);
+		}
 
 		if ((vertexElement & VertexElement::UV_32_BITS) == VertexElement::UV_32_BITS)
 		{
@@ -142,7 +152,8 @@ struct VertexDescriptor
 			}
 			m_positionIndex = static_cast<int>(m_vertexElementInfos.size());
 		}
-		else if ((vertexElement & VertexElement::NORMAL_32_BITS) == VertexElement::NORMAL_32_BITS || (vertexElement & VertexElement::NORMAL_16_BITS) == VertexElement::NORMAL_16_BITS || (vertexElement & VertexElement::NORMAL_8_BITS) == VertexElement::NORMAL_8_BITS)
+		else if ((vertexElement & VertexElement::NORMAL_32_BITS) == VertexElement::NORMAL_32_BITS || (vertexElement & VertexElement::NORMAL_16_BITS) == VertexElement::NORMAL_16_BITS || (vertexElement & VertexElement::NORMAL_8_BITS) == VertexElement::NORMAL_8_BITS ||
+			(vertexElement & VertexElement::NORMAL_OCTAHEDRAL_8_BITS) == VertexElement::NORMAL_OCTAHEDRAL_8_BITS || (vertexElement & VertexElement::NORMAL_OCTAHEDRAL_16_BITS) == VertexElement::NORMAL_OCTAHEDRAL_16_BITS)
 		{
 			if (m_normalIndex != -1)
 			{
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#include <engine/math/vector3.h>
+
+/**
+* @brief Conversions between floats and the quantized vertex elements
+*
+* - POSITION_16_BITS: signed normalized, relative to the submesh position bounds
+* - UV_16_BITS: unsigned normalized, for UVs between 0 and 1
+* - NORMAL_OCTAHEDRAL_*: the unit normal is projected on an octahedron and unfolded on a square (2 components)
+*/
+class VertexQuantization
+{
+public:
+	[[nodiscard]] static int16_t QuantizeSnorm16(float value)
+	{
+		const float clamped = std::clamp(value, -1.0f, 1.0f);
+		return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+	}
+
+	[[nodiscard]] static float DequantizeSnorm16(int16_t value)
+	{
+		return std::max(value / 32767.0f, -1.0f);
+	}
+
+	[[nodiscard]] static uint16_t QuantizeUnorm16(float value)
+	{
+		const float clamped = std::clamp(value, 0.0f, 1.0f);
+		return static_cast<uint16_t>(std::lround(clamped * 65535.0f));
+	}
+
+	[[nodiscard]] static float DequantizeUnorm16(uint16_t value)
+	{
+		return value / 65535.0f;
+	}
+
+	/**
+	* @brief Encode a unit normal in two values between -1 and 1
+	*/
+	static void EncodeOctahedral(const Vector3& normal, float& x, float& y)
+	{
+		const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		if (length == 0)
+		{
+			x = 0;
+			y = 0;
+			return;
+		}
+
+		x = normal.x / length;
+		y = normal.y / length;
+		if (normal.z < 0)
+		{
+			const float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+			const float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+			x = foldedX;
+			y = foldedY;
+		}
+	}
+
+	/**
+	* @brief Decode a normal encoded with EncodeOctahedral (same code as the shaders)
+	*/
+	[[nodiscard]] static Vector3 DecodeOctahedral(float x, float y)
+	{
+		Vector3 normal = Vector3(x, y, 1.0f - std::abs(x) - std::abs(y));
+		if (normal.z < 0)
+		{
+			normal.x = (1.0f - std::abs(y)) * SignNotZero(x);
+			normal.y = (1.0f - std::abs(x)) * SignNotZero(y);
+		}
+
+		const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		return normal / length;
+	}
+
+	/**
+	* @brief Quantize an octahedral encoded normal to integers between -scale and scale
+	*/
+	template<typename T>
+	static void QuantizeOctahedral(const Vector3& normal, T scale, T& x, T& y)
+	{
+		float encodedX;
+		float encodedY;
+		EncodeOctahedral(normal, encodedX, encodedY);
+		x = static_cast<T>(std::lround(encodedX * scale));
+		y = static_cast<T>(std::lround(encodedY * scale));
+	}
+
+private:
+	[[nodiscard]] static float SignNotZero(float value)
+	{
+		return value >= 0 ? 1.0f : -1.0f;
+	}
+};
@@ -6,6 +6,8 @@
 
 #include "camera.h"
 
+#include <algorithm>
+
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
 #include <glad/gl.h>
 #elif defined(__vita__)
@@ -32,6 +34,9 @@
 #include <engine/graphics/renderer/renderer_gu.h>
 #include <engine/graphics/renderer/renderer_rsx.h>
 #include <engine/graphics/renderer/renderer_opengl.h>
+#include <engine/graphics/renderer/opengl_state_cache.h>
+#include <engine/time/time.h>
+#include <engine/graphics/dynamic_resolution.h>
 #include "graphics.h"
 
 #pragma region Constructors / Destructor
@@ -43,10 +48,13 @@ Camera::Camera() : m_fov(DEFAULT_CAMERA_FOV), m_isProjectionDirty(true)
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
-	glGenFramebuffers(1, &m_framebuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
-	glGenFramebuffers(1, &m_secondFramebuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, m_secondFramebuffer);
+	if (!Engine::GetArguments().useNullRenderer)
+	{
+		glGenFramebuffers(1, &m_framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glGenFramebuffers(1, &m_secondFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_secondFramebuffer);
+	}
 #endif
 
 	ChangeFrameBufferSize(Vector2Int(Window::GetWidth(), Window::GetHeight()));
@@ -67,11 +75,11 @@ Camera::~Camera()
 	}
 	if (m_framebufferTexture != -1)
 	{
-		glDeleteTextures(1, &m_framebufferTexture);
+		OpenGLStateCache::DeleteTexture(m_framebufferTexture);
 	}
 	if (m_secondFramebufferTexture != -1)
 	{
-		glDeleteTextures(1, &m_secondFramebufferTexture);
+		OpenGLStateCache::DeleteTexture(m_secondFramebufferTexture);
 	}
 	if (m_depthframebuffer != -1)
 	{
@@ -114,10 +122,24 @@ std::unique_ptr<uint8_t[]> Camera::GetRawFrameBuffer()
 	std::unique_ptr<uint8_t[]> frameBufferData = std::make_unique<uint8_t[]>(frameBufferWidth * frameBufferHeight * 3); // Other platforms
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	// Nothing to read with the null renderer, return a black image
+	if (Engine::GetArguments().useNullRenderer)
+	{
+		return frameBufferData;
+	}
+
 	// Read from texture
-	glBindTexture(GL_TEXTURE_2D, m_secondFramebufferTexture);
+	OpenGLStateCache::BindTexture(GL_TEXTURE_2D, m_secondFramebufferTexture);
 	glPixelStorei(GL_PACK_ALIGNMENT, 1);
 	glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, frameBufferData.get());
+
+	// With a render scale under 1, only a part of the frame buffer is used, scale it to the full size like PresentFrameBuffer
+	if (m_renderWidth < m_width || m_renderHeight < m_height)
+	{
+		std::unique_ptr<uint8_t[]> scaledData = std::make_unique<uint8_t[]>(static_cast<size_t>(m_width) * m_height * 3);
+		DynamicResolution::UpscaleRenderedArea(frameBufferData.get(), m_width, m_height, m_renderWidth, m_renderHeight, scaledData.get());
+		frameBufferData = std::move(scaledData);
+	}
 #elif defined(__vita__)
 	// Read from framebuffer
 	glReadPixels(0, 0, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE, (uint8_t*)frameBufferData.get()); // PsVita
@@ -196,6 +218,9 @@ ReflectiveData Camera::GetReflectiveData()
 	Reflective::AddVariable(reflectedVariables, m_nearClippingPlane, "nearClippingPlane");
 	Reflective::AddVariable(reflectedVariables, m_farClippingPlane, "farClippingPlane");
 	Reflective::AddVariable(reflectedVariables, m_useMultisampling, "useMultisampling");
+	Reflective::AddVariable(reflectedVariables, m_updateMode, "updateMode");
+	Reflective::AddVariable(reflectedVariables, m_updateFrameInterval, "updateFrameInterval").SetIsPublic(m_updateMode == CameraUpdateMode::EveryNFrames);
+	Reflective::AddVariable(reflectedVariables, m_updateTimeInterval, "updateTimeInterval").SetIsPublic(m_updateMode == CameraUpdateMode::TimeInterval);
 	return reflectedVariables;
 }
 
@@ -208,6 +233,8 @@ void Camera::OnReflectionUpdated()
 	SetNearClippingPlane(m_nearClippingPlane);
 	SetFarClippingPlane(m_farClippingPlane);
 	SetProjectionSize(m_projectionSize);
+	SetUpdateFrameInterval(m_updateFrameInterval);
+	SetUpdateTimeInterval(m_updateTimeInterval);
 
 	if (m_lastMultisamplingValue != m_useMultisampling)
 	{
@@ -270,6 +297,16 @@ void Camera::SetFarClippingPlane(float value)
 	m_isProjectionDirty = true;
 }
 
+void Camera::SetUpdateFrameInterval(int frameInterval)
+{
+	m_updateFrameInterval = std::max(frameInterval, 1);
+}
+
+void Camera::SetUpdateTimeInterval(float timeInterval)
+{
+	m_updateTimeInterval = std::max(timeInterval, 0.0f);
+}
+
 Vector2 Camera::ScreenTo2DWorld(int x, int y)
 {
 	const Vector3& camPos = GetTransformRaw()->GetPosition();
@@ -391,16 +428,16 @@ void Camera::UpdateFrameBuffer()
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
-	if (m_needFrameBufferUpdate)
+	if (m_needFrameBufferUpdate && !Engine::GetArguments().useNullRenderer)
 	{
 		if (m_framebufferTexture != -1)
 		{
-			glDeleteTextures(1, &m_framebufferTexture);
+			OpenGLStateCache::DeleteTexture(m_framebufferTexture);
 			m_framebufferTexture = -1;
 		}
 		if (m_secondFramebufferTexture != -1)
 		{
-			glDeleteTextures(1, &m_secondFramebufferTexture);
+			OpenGLStateCache::DeleteTexture(m_secondFramebufferTexture);
 			m_secondFramebufferTexture = -1;
 		}
 		if (m_depthframebuffer != -1)
@@ -414,9 +451,9 @@ void Camera::UpdateFrameBuffer()
 			int sample = 8;
 			glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
 			glGenTextures(1, &m_framebufferTexture);
-			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_framebufferTexture);
+			OpenGLStateCache::BindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_framebufferTexture);
 			glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, sample, GL_RGB, m_width, m_height, GL_TRUE);
-			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+			OpenGLStateCache::BindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, m_framebufferTexture, 0);
 
 			glGenRenderbuffers(1, &m_depthframebuffer);
@@ -432,11 +469,11 @@ void Camera::UpdateFrameBuffer()
 			//Screen buffer
 			glBindFramebuffer(GL_FRAMEBUFFER, m_secondFramebuffer);
 			glGenTextures(1, &m_secondFramebufferTexture);
-			glBindTexture(GL_TEXTURE_2D, m_secondFramebufferTexture);
+			OpenGLStateCache::BindTexture(GL_TEXTURE_2D, m_secondFramebufferTexture);
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_width, m_height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			OpenGLStateCache::BindTexture(GL_TEXTURE_2D, 0);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_secondFramebufferTexture, 0);
 
 			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
@@ -446,11 +483,11 @@ void Camera::UpdateFrameBuffer()
 		{
 			glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
 			glGenTextures(1, &m_secondFramebufferTexture);
-			glBindTexture(GL_TEXTURE_2D, m_secondFramebufferTexture);
+			OpenGLStateCache::BindTexture(GL_TEXTURE_2D, m_secondFramebufferTexture);
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_width, m_height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			OpenGLStateCache::BindTexture(GL_TEXTURE_2D, 0);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_secondFramebufferTexture, 0);
 
 			glGenRenderbuffers(1, &m_depthframebuffer);
@@ -485,20 +522,77 @@ void Camera::ChangeFrameBufferSize(const Vector2Int& resolution)
 #if defined(__PSP__)
 		Engine::GetRenderer().SetViewport(0, 0, m_width, m_height);
 #endif
+		SetRenderScale(m_renderScale);
+	}
+}
+
+void Camera::SetRenderScale(float renderScale)
+{
+	XASSERT(renderScale > 0 && renderScale <= 1, "[Camera::SetRenderScale] The scale has to be between 0 and 1");
+
+	m_renderScale = renderScale;
+	const int renderWidth = std::max(1, static_cast<int>(m_width * m_renderScale + 0.5f));
+	const int renderHeight = std::max(1, static_cast<int>(m_height * m_renderScale + 0.5f));
+	if (renderWidth != m_renderWidth || renderHeight != m_renderHeight)
+	{
+		m_renderWidth = renderWidth;
+		m_renderHeight = renderHeight;
+		m_isRenderedImageValid = false;
 	}
 }
 
+bool Camera::ConsumeRenderTurn()
+{
+	bool needsRender = true;
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	// The editor cameras and the cameras without a valid image always render, the other platforms have no frame buffer to keep the image
+	if (!m_isEditor && m_isRenderedImageValid && !m_needFrameBufferUpdate && !m_isRenderRequested)
+	{
+		switch (m_updateMode)
+		{
+		case CameraUpdateMode::EveryFrame:
+			break;
+		case CameraUpdateMode::EveryNFrames:
+			needsRender = m_framesSinceRender + 1 >= m_updateFrameInterval;
+			break;
+		case CameraUpdateMode::TimeInterval:
+			needsRender = Time::GetUnscaledTime() - m_lastRenderTime >= m_updateTimeInterval;
+			break;
+		case CameraUpdateMode::OnDemand:
+			needsRender = false;
+			break;
+		}
+	}
+#endif
+
+	if (needsRender)
+	{
+		m_framesSinceRender = 0;
+		m_lastRenderTime = Time::GetUnscaledTime();
+		m_isRenderRequested = false;
+		m_isRenderedImageValid = true;
+	}
+	else
+	{
+		m_framesSinceRender++;
+	}
+	return needsRender;
+}
+
 void Camera::BindFrameBuffer()
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
-	UpdateFrameBuffer();
-	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	if (!Engine::GetArguments().useNullRenderer)
+	{
+		UpdateFrameBuffer();
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	}
 #endif
 
 #if !defined(__PSP__)
-	Engine::GetRenderer().SetViewport(0, 0, m_width, m_height);
+	Engine::GetRenderer().SetViewport(0, 0, m_renderWidth, m_renderHeight);
 #endif
 }
 
@@ -587,16 +681,34 @@ void Camera::CopyMultiSampledFrameBuffer()
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if (Engine::GetArguments().useNullRenderer)
+	{
+		return;
+	}
+
 	if (m_useMultisampling)
 	{
 		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
 		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_secondFramebuffer);
-		glBlitFramebuffer(0, 0, GetWidth(), GetHeight(), 0, 0, GetWidth(), GetHeight(), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glBlitFramebuffer(0, 0, m_renderWidth, m_renderHeight, 0, 0, m_renderWidth, m_renderHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
 	}
-#if !defined(EDITOR)
-		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-		glBlitFramebuffer(0, 0, GetWidth(), GetHeight(), 0, 0, GetWidth(), GetHeight(), GL_COLOR_BUFFER_BIT, GL_LINEAR);
 #endif
+}
+
+void Camera::PresentFrameBuffer()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+#if (defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)) && !defined(EDITOR)
+	if (Engine::GetArguments().useNullRenderer)
+	{
+		return;
+	}
+
+	// Stretch the rendered part to the window, from the frame buffer of m_secondFramebufferTexture (the resolved one with multisampling)
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_useMultisampling ? m_secondFramebuffer : m_framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(0, 0, m_renderWidth, m_renderHeight, 0, 0, GetWidth(), GetHeight(), GL_COLOR_BUFFER_BIT, GL_LINEAR);
 #endif
 }
 
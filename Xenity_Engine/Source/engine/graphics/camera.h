@@ -14,6 +14,7 @@
 #include <engine/math/vector2.h>
 #include <engine/math/vector2_int.h>
 #include "camera_projection_type.h"
+#include "camera_update_mode.h"
 
 struct Plane
 {
@@ -219,6 +220,22 @@ public:
 		return m_height;
 	}
 
+	/**
+	* @brief Get the width of the rendered image in pixel (smaller than the view width with the dynamic resolution)
+	*/
+	[[nodiscard]] int GetRenderWidth() const
+	{
+		return m_renderWidth;
+	}
+
+	/**
+	* @brief Get the height of the rendered image in pixel (smaller than the view height with the dynamic resolution)
+	*/
+	[[nodiscard]] int GetRenderHeight() const
+	{
+		return m_renderHeight;
+	}
+
 	/**
 	* @brief Get view aspect ratio
 	*/
@@ -244,6 +261,58 @@ public:
 		m_useMultisampling = useMultisampling;
 	}
 
+	/**
+	* @brief Set when the camera renders a new image, the last image is kept on the other frames (Windows and Linux only, the other platforms render every frame)
+	*/
+	void SetUpdateMode(CameraUpdateMode updateMode)
+	{
+		m_updateMode = updateMode;
+	}
+
+	/**
+	* @brief Get when the camera renders a new image
+	*/
+	[[nodiscard]] CameraUpdateMode GetUpdateMode() const
+	{
+		return m_updateMode;
+	}
+
+	/**
+	* @brief Set the number of frames between two renders (CameraUpdateMode::EveryNFrames)
+	* @param frameInterval 1 or more
+	*/
+	void SetUpdateFrameInterval(int frameInterval);
+
+	/**
+	* @brief Get the number of frames between two renders (CameraUpdateMode::EveryNFrames)
+	*/
+	[[nodiscard]] int GetUpdateFrameInterval() const
+	{
+		return m_updateFrameInterval;
+	}
+
+	/**
+	* @brief Set the time between two renders (CameraUpdateMode::TimeInterval)
+	* @param timeInterval Time in seconds (0 or more), not affected by the time scale
+	*/
+	void SetUpdateTimeInterval(float timeInterval);
+
+	/**
+	* @brief Get the time in seconds between two renders (CameraUpdateMode::TimeInterval)
+	*/
+	[[nodiscard]] float GetUpdateTimeInterval() const
+	{
+		return m_updateTimeInterval;
+	}
+
+	/**
+	* @brief Render a new image in the next frame, whatever the update mode is
+	*/
+	void RequestRender()
+	{
+		m_isRenderRequested = true;
+	}
+
 	/**
 	* @brief Get a copy of the frame buffer
 	* @brief Heavy operation, use with caution
@@ -270,6 +339,8 @@ protected:
 	friend class ParticleSystem;
 	friend class Material;
 	friend class MeshRenderer;
+	friend class OcclusionCulling;
+	friend class DynamicResolution;
 
 	Frustum frustum;
 
@@ -307,6 +378,17 @@ protected:
 	*/
 	void ChangeFrameBufferSize(const Vector2Int& resolution);
 
+	/**
+	* @brief [Internal] Set the part of the frame buffer used for the rendering, the image is stretched to the view size on present
+	* @param renderScale Scale of the view size (between 0 and 1), the frame buffer is not reallocated
+	*/
+	void SetRenderScale(float renderScale);
+
+	/**
+	* @brief [Internal] Get if the camera has to render this frame (from the update mode), and start a new interval if so
+	*/
+	[[nodiscard]] bool ConsumeRenderTurn();
+
 	/**
 	* @brief [Internal] Update FrameBuffer
 	*/
@@ -331,9 +413,26 @@ protected:
 	*/
 	void CopyMultiSampledFrameBuffer();
 
+	/**
+	* @brief [Internal] Stretch the last rendered image to the window (game build only)
+	*/
+	void PresentFrameBuffer();
+
 	unsigned int m_framebuffer = -1;
 	unsigned int m_secondFramebuffer = -1;
-	int m_width, m_height;
+	int m_width = 0;
+	int m_height = 0;
+	int m_renderWidth = 0;
+	int m_renderHeight = 0;
+	float m_renderScale = 1;
+	CameraUpdateMode m_updateMode = CameraUpdateMode::EveryFrame;
+	int m_updateFrameInterval = 2;
+	float m_updateTimeInterval = 0.1f;
+	int m_framesSinceRender = 0;
+	float m_lastRenderTime = 0;
+	bool m_isRenderRequested = false;
+	// False when the frame buffer does not contain a full image of the current size
+	bool m_isRenderedImageValid = false;
 	float m_aspect;
 	float m_fov = 60.0f;		  // For 3D
 	float m_projectionSize = 5; // For 2D
@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <engine/reflection/enum_utils.h>
+
+ENUM(CameraUpdateMode, EveryFrame, EveryNFrames, TimeInterval, OnDemand);
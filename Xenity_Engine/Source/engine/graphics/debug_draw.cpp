@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "debug_draw.h"
+
+#include <vector>
+
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+#include <engine/math/vector3.h>
+#include <engine/graphics/color/color.h>
+#include <engine/graphics/renderer/renderer.h>
+#include <engine/debug/performance.h>
+
+namespace
+{
+	enum BatchIndex
+	{
+		Triangles_Depth,
+		Triangles_No_Depth,
+		Lines_Depth,
+		Lines_No_Depth,
+		Batch_Count,
+	};
+
+	struct DebugDrawBatch
+	{
+		std::vector<DebugDrawVertex> vertices;
+		// Number of vertices added before the render of the cameras (kept for all the cameras)
+		size_t frameVertexCount = 0;
+	};
+
+	DebugDrawBatch batches[Batch_Count];
+
+	void AddVertex(DebugDrawBatch& batch, const Vector3& position, const RGBA& color)
+	{
+		DebugDrawVertex& vertex = batch.vertices.emplace_back();
+		vertex.x = position.x;
+		vertex.y = position.y;
+		vertex.z = position.z;
+		vertex.r = color.r;
+		vertex.g = color.g;
+		vertex.b = color.b;
+		vertex.a = color.a;
+	}
+
+	[[nodiscard]] Vector3 ToRendererSpace(const Vector3& position)
+	{
+		return Vector3(-position.x, position.y, position.z);
+	}
+}
+
+void DebugDraw::DrawLine(const Vector3& a, const Vector3& b, const Color& color, bool useDepth)
+{
+	AddLine(ToRendererSpace(a), ToRendererSpace(b), color, useDepth);
+}
+
+void DebugDraw::DrawTriangle(const Vector3& a, const Vector3& b, const Vector3& c, const Color& color, bool useDepth)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	DebugDrawBatch& batch = batches[useDepth ? Triangles_Depth : Triangles_No_Depth];
+	const RGBA& rgba = color.GetRGBA();
+	AddVertex(batch, ToRendererSpace(a), rgba);
+	AddVertex(batch, ToRendererSpace(b), rgba);
+	AddVertex(batch, ToRendererSpace(c), rgba);
+}
+
+void DebugDraw::AddLine(const Vector3& a, const Vector3& b, const Color& color, bool useDepth)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	DebugDrawBatch& batch = batches[useDepth ? Lines_Depth : Lines_No_Depth];
+	const RGBA& rgba = color.GetRGBA();
+	AddVertex(batch, a, rgba);
+	AddVertex(batch, b, rgba);
+}
+
+void DebugDraw::BeginRender()
+{
+	for (DebugDrawBatch& batch : batches)
+	{
+		batch.frameVertexCount = batch.vertices.size();
+	}
+}
+
+void DebugDraw::DrawCameraShapes()
+{
+	SCOPED_PROFILER("DebugDraw::DrawCameraShapes", scopeBenchmark);
+
+	RenderingSettings renderSettings = RenderingSettings();
+	renderSettings.renderingMode = MaterialRenderingMode::Transparent;
+	renderSettings.useLighting = false;
+	renderSettings.useTexture = false;
+
+	for (int i = 0; i < Batch_Count; i++)
+	{
+		DebugDrawBatch& batch = batches[i];
+		if (!batch.vertices.empty())
+		{
+			renderSettings.useDepth = i == Triangles_Depth || i == Lines_Depth;
+			const bool isTriangleList = i == Triangles_Depth || i == Triangles_No_Depth;
+			Engine::GetRenderer().DrawDebugVertices(batch.vertices.data(), batch.vertices.size(), isTriangleList, renderSettings);
+		}
+
+		// The shapes added during the render (gizmos) are only for the current camera
+		batch.vertices.resize(batch.frameVertexCount);
+	}
+}
+
+void DebugDraw::EndRender()
+{
+	for (DebugDrawBatch& batch : batches)
+	{
+		// Keep the memory for the next frame
+		batch.vertices.clear();
+		batch.frameVertexCount = 0;
+	}
+}
+
+bool DebugDraw::IsEmpty()
+{
+	for (const DebugDrawBatch& batch : batches)
+	{
+		if (!batch.vertices.empty())
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <engine/api.h>
+
+class Vector3;
+class Color;
+
+/**
+* @brief Draw lines and triangles for debugging (in the editor and in game)
+*
+* The shapes are accumulated and drawn by each camera with a few draw calls (one per primitive type and depth mode).
+* Shapes added during the game update are drawn by all the cameras of the frame and removed at the end of the frame.
+*/
+class API DebugDraw
+{
+public:
+	/**
+	* @brief Draw a line from A to B during this frame
+	* @param a Start point
+	* @param b End point
+	* @param color Color of the line
+	* @param useDepth If false, the line is drawn on top of the objects
+	*/
+	static void DrawLine(const Vector3& a, const Vector3& b, const Color& color, bool useDepth = true);
+
+	/**
+	* @brief Draw a filled triangle during this frame (visible from both sides)
+	* @param a, b, c Points of the triangle
+	* @param color Color of the triangle
+	* @param useDepth If false, the triangle is drawn on top of the objects
+	*/
+	static void DrawTriangle(const Vector3& a, const Vector3& b, const Vector3& c, const Color& color, bool useDepth = true);
+
+private:
+	friend class Graphics;
+
+	/**
+	* @brief [Internal] Add a line already in the renderer space (X axis inverted)
+	*/
+	static void AddLine(const Vector3& a, const Vector3& b, const Color& color, bool useDepth);
+
+	/**
+	* @brief [Internal] Called before the render of the cameras, the current shapes are kept for all the cameras
+	*/
+	static void BeginRender();
+
+	/**
+	* @brief [Internal] Draw the shapes with the current camera and remove the shapes added during the camera render
+	*/
+	static void DrawCameraShapes();
+
+	/**
+	* @brief [Internal] Called after the render of the cameras, remove all the shapes
+	*/
+	static void EndRender();
+
+	/**
+	* @brief [Internal] Get if there is nothing to draw
+	*/
+	[[nodiscard]] static bool IsEmpty();
+};
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <stb_image_resize.h>
+
+#include <engine/graphics/graphics.h>
+#include <engine/graphics/camera.h>
+#include <engine/assertions/assertions.h>
+
+bool DynamicResolution::s_isEnabled = false;
+float DynamicResolution::s_targetFrameTime = 15.0f;
+float DynamicResolution::s_minScale = 0.5f;
+float DynamicResolution::s_maxScale = 1.0f;
+float DynamicResolution::s_scale = 1.0f;
+float DynamicResolution::s_averageCpuFrameTime = 0;
+float DynamicResolution::s_averageGpuFrameTime = 0;
+uint32_t DynamicResolution::s_framesSinceChange = 0;
+
+void DynamicResolution::SetIsEnabled(bool isEnabled)
+{
+	s_isEnabled = isEnabled;
+	s_averageCpuFrameTime = 0;
+	s_averageGpuFrameTime = 0;
+	s_framesSinceChange = 0;
+	s_scale = isEnabled ? s_maxScale : 1.0f;
+	ApplyScale();
+}
+
+void DynamicResolution::SetTargetFrameTime(float targetFrameTime)
+{
+	XASSERT(targetFrameTime > 0, "[DynamicResolution::SetTargetFrameTime] The target frame time has to be positive");
+
+	s_targetFrameTime = targetFrameTime;
+}
+
+void DynamicResolution::SetScaleBounds(float minScale, float maxScale)
+{
+	XASSERT(minScale > 0 && minScale <= maxScale && maxScale <= 1, "[DynamicResolution::SetScaleBounds] Wrong bounds");
+
+	s_minScale = minScale;
+	s_maxScale = maxScale;
+	if (s_isEnabled)
+	{
+		s_scale = std::clamp(s_scale, s_minScale, s_maxScale);
+		ApplyScale();
+	}
+}
+
+float DynamicResolution::ComputeScale(float currentScale, float cpuFrameTime, float gpuFrameTime, float targetFrameTime, float minScale, float maxScale)
+{
+	float newScale = currentScale;
+	if (gpuFrameTime > targetFrameTime)
+	{
+		// The GPU time follows the pixel count, so the square of the scale
+		if (cpuFrameTime < targetFrameTime)
+		{
+			newScale = currentScale * std::sqrt(targetFrameTime / gpuFrameTime);
+		}
+	}
+	else if (gpuFrameTime < targetFrameTime * s_upscaleThreshold)
+	{
+		// Aim under the target to not go down again right after
+		newScale = gpuFrameTime > 0 ? currentScale * std::sqrt(targetFrameTime * s_upscaleThreshold / gpuFrameTime) : maxScale;
+	}
+
+	newScale = std::clamp(newScale, currentScale - s_maxScaleStep, currentScale + s_maxScaleStep);
+	return std::clamp(newScale, minScale, maxScale);
+}
+
+void DynamicResolution::Update(float cpuFrameTime, float gpuFrameTime)
+{
+	if (!s_isEnabled || gpuFrameTime < 0)
+		return;
+
+	if (s_averageGpuFrameTime == 0)
+	{
+		s_averageCpuFrameTime = cpuFrameTime;
+		s_averageGpuFrameTime = gpuFrameTime;
+	}
+	else
+	{
+		s_averageCpuFrameTime += (cpuFrameTime - s_averageCpuFrameTime) * s_smoothing;
+		s_averageGpuFrameTime += (gpuFrameTime - s_averageGpuFrameTime) * s_smoothing;
+	}
+
+	s_framesSinceChange++;
+	if (s_framesSinceChange < s_framesBetweenChanges)
+		return;
+
+	const float newScale = ComputeScale(s_scale, s_averageCpuFrameTime, s_averageGpuFrameTime, s_targetFrameTime, s_minScale, s_maxScale);
+	if (newScale != s_scale)
+	{
+		s_scale = newScale;
+		s_framesSinceChange = 0;
+	}
+
+	// Also gives the scale to the cameras created since the last change
+	ApplyScale();
+}
+
+void DynamicResolution::ApplyScale()
+{
+	for (const std::weak_ptr<Camera>& weakCamera : Graphics::cameras)
+	{
+		const std::shared_ptr<Camera> camera = weakCamera.lock();
+		if (camera && !camera->IsEditor())
+		{
+			camera->SetRenderScale(s_scale);
+		}
+	}
+}
+
+void DynamicResolution::UpscaleRenderedArea(const uint8_t* frameBuffer, int width, int height, int renderWidth, int renderHeight, uint8_t* output)
+{
+	XASSERT(frameBuffer != nullptr && output != nullptr, "[DynamicResolution::UpscaleRenderedArea] Buffer is nullptr");
+	XASSERT(renderWidth > 0 && renderHeight > 0 && renderWidth <= width && renderHeight <= height, "[DynamicResolution::UpscaleRenderedArea] Bad rendered area");
+
+	// The rows keep the stride of the whole frame buffer, so only the rendered area is read
+	stbir_resize_uint8(frameBuffer, renderWidth, renderHeight, width * 3, output, width, height, 0, 3);
+}
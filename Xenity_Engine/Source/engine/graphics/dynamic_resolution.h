@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+
+#include <engine/api.h>
+
+/**
+* @brief Scale the render resolution of the game cameras to keep a target frame time
+*
+* The resolution goes down only when the GPU is too slow, a smaller resolution does not help when the CPU is too slow.
+* The frame buffers keep the view size and only a part of them is used, so changing the scale does not reallocate anything.
+* Only works with the renderers that can measure the GPU time (OpenGL on PC).
+*/
+class API DynamicResolution
+{
+public:
+	/**
+	* @brief Enable or disable the dynamic resolution (the cameras go back to the full resolution when disabled)
+	*/
+	static void SetIsEnabled(bool isEnabled);
+
+	/**
+	* @brief Get if the dynamic resolution is enabled
+	*/
+	[[nodiscard]] static bool IsEnabled()
+	{
+		return s_isEnabled;
+	}
+
+	/**
+	* @brief Set the GPU time to keep
+	* @param targetFrameTime Time in milliseconds (a bit less than 16.6 for 60 fps)
+	*/
+	static void SetTargetFrameTime(float targetFrameTime);
+
+	/**
+	* @brief Get the GPU time to keep in milliseconds
+	*/
+	[[nodiscard]] static float GetTargetFrameTime()
+	{
+		return s_targetFrameTime;
+	}
+
+	/**
+	* @brief Set the limits of the render scale
+	* @param minScale Smallest scale of the view size (above 0)
+	* @param maxScale Biggest scale of the view size (1 or less)
+	*/
+	static void SetScaleBounds(float minScale, float maxScale);
+
+	/**
+	* @brief Get the current render scale of the game cameras
+	*/
+	[[nodiscard]] static float GetScale()
+	{
+		return s_scale;
+	}
+
+	/**
+	* @brief Get the next render scale from the frame times
+	* @param currentScale Current render scale
+	* @param cpuFrameTime CPU time of the frame in milliseconds
+	* @param gpuFrameTime GPU time of the frame in milliseconds
+	* @param targetFrameTime Time to keep in milliseconds
+	* @param minScale Smallest scale
+	* @param maxScale Biggest scale
+	*/
+	[[nodiscard]] static float ComputeScale(float currentScale, float cpuFrameTime, float gpuFrameTime, float targetFrameTime, float minScale, float maxScale);
+
+	/**
+	* @brief Scale the rendered area of a frame buffer copy up to the full size (the area starts at the first pixel)
+	* @param frameBuffer RGB pixels of the whole frame buffer
+	* @param width Width of the frame buffer
+	* @param height Height of the frame buffer
+	* @param renderWidth Width of the rendered area
+	* @param renderHeight Height of the rendered area
+	* @param output RGB pixels of width * height, filled with the scaled area
+	*/
+	static void UpscaleRenderedArea(const uint8_t* frameBuffer, int width, int height, int renderWidth, int renderHeight, uint8_t* output);
+
+	/**
+	* @brief The resolution goes up when the GPU time is under this part of the target time
+	*/
+	static constexpr float s_upscaleThreshold = 0.85f;
+
+	/**
+	* @brief Biggest scale change in one step
+	*/
+	static constexpr float s_maxScaleStep = 0.05f;
+
+private:
+	friend class Engine;
+
+	/**
+	* @brief [Internal] Update the scale with the times of the last frame and apply it to the game cameras
+	* @param cpuFrameTime CPU time of the frame in milliseconds
+	* @param gpuFrameTime GPU time of a recent frame in milliseconds (-1 if not available)
+	*/
+	static void Update(float cpuFrameTime, float gpuFrameTime);
+
+	/**
+	* @brief Set the current scale to all the game cameras
+	*/
+	static void ApplyScale();
+
+	// Weight of the new frame in the averaged times
+	static constexpr float s_smoothing = 0.1f;
+	// Number of frames to wait after a change to see its effect (the GPU time comes a few frames late)
+	static constexpr uint32_t s_framesBetweenChanges = 15;
+
+	static bool s_isEnabled;
+	static float s_targetFrameTime;
+	static float s_minScale;
+	static float s_maxScale;
+	static float s_scale;
+	static float s_averageCpuFrameTime;
+	static float s_averageGpuFrameTime;
+	static uint32_t s_framesSinceChange;
+};
@@ -26,10 +26,17 @@
 #include <engine/network/network.h>
 #include <engine/tools/profiler_benchmark.h>
 #include <engine/graphics/3d_graphics/lod.h>
+#include <engine/graphics/3d_graphics/lod_selection.h>
+#include <engine/graphics/3d_graphics/frustum_culling.h>
+#include <engine/graphics/3d_graphics/occlusion_culling.h>
+#include <engine/particle_system/particle_simulation.h>
+#include "debug_draw.h"
 #include <engine/graphics/render_command.h>
 #include <engine/debug/debug.h>
 #include <engine/tools/scope_benchmark.h>
 #include <engine/debug/performance.h>
+#include <engine/asset_management/residency_manager.h>
+#include <engine/graphics/texture/texture_streaming.h>
 #include "iDrawable.h"
 #include "renderer/renderer.h"
 #include "2d_graphics/sprite_manager.h"
@@ -38,6 +45,8 @@
 #include "3d_graphics/mesh_data.h"
 #include "material.h"
 #include "skybox.h"
+#include "texture/cubemap.h"
+#include "texture/texture_default.h"
 #include "camera.h"
 #include <engine/tools/internal_math.h>
 #include <engine/world_partitionner/world_partitionner.h>
@@ -51,21 +60,27 @@ std::vector<std::weak_ptr<Camera>> Graphics::cameras;
 std::shared_ptr<Camera> Graphics::usedCamera;
 bool Graphics::needUpdateCamera = true;
 int Graphics::s_iDrawablesCount = 0;
-int Graphics::s_lodsCount = 0;
 size_t Graphics::s_currentFrame = 0;
 
 std::vector<IDrawable*> Graphics::s_orderedIDrawable;
 
-std::vector<std::weak_ptr<Lod>> Graphics::s_lods;
-
 std::shared_ptr <MeshData> skyPlane = nullptr;
+std::shared_ptr <MeshData> skyCube = nullptr;
 
 Shader* Graphics::s_currentShader = nullptr;
 Material* Graphics::s_currentMaterial = nullptr;
 IDrawableTypes Graphics::s_currentMode = IDrawableTypes::Draw_3D;
-bool Graphics::s_needUpdateUIOrdering = true;
 bool Graphics::s_isRenderingBatchDirty = true;
+std::vector<IDrawable*> Graphics::s_dirtyDrawables;
+uint64_t Graphics::s_nextDrawOrder = 1;
+uint64_t Graphics::s_firstDrawOrder = 1;
 RenderBatch renderBatch;
+// Drawables that need OnNewFrame and OnNewRender calls (see IDrawable::m_useOnNewRender)
+std::vector<IDrawable*> newRenderDrawables;
+// Opaque commands drawn with one instanced draw call
+std::vector<const RenderCommand*> instancedCommands;
+// Minimum number of compatible commands to use an instanced draw call
+constexpr size_t s_minInstanceCount = 2;
 
 GraphicsSettings Graphics::s_settings;
 
@@ -113,7 +128,11 @@ void Graphics::Init()
 
 	Shader::Init();
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
-	ShaderOpenGL::Init();
+	if (!Engine::GetArguments().useNullRenderer)
+	{
+		ShaderOpenGL::Init();
+		TextureDefault::Init();
+	}
 #endif
 
 	SpriteManager::Init();
@@ -129,14 +148,13 @@ void Graphics::Stop()
 
 	cameras.clear();
 	usedCamera.reset();
-	s_iDrawablesCount = 0;
-	s_lods.clear();
-	s_lodsCount = 0;
-	s_orderedIDrawable.clear();
-	s_isRenderingBatchDirty = true;
+	LodSelection::Stop();
+	DeleteAllDrawables();
 	renderBatch.Reset();
+	ParticleSimulation::Stop();
 	s_settings.skybox.reset();
 	skyPlane.reset();
+	skyCube.reset();
 	s_currentShader = nullptr;
 	s_currentMaterial = nullptr;
 }
@@ -166,14 +184,17 @@ void Graphics::Draw()
 	OrderDrawables();
 
 	const int shaderCount = AssetManager::GetShaderCount();
-	const int matCount = AssetManager::GetMaterialCount();
 
 	if constexpr (!s_UseOpenGLFixedFunctions)
 	{
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
+		// One upload for all the shaders reading the lights from the shared buffer
+		ShaderOpenGL::UpdateLightsBuffer();
+#endif
 		for (int shaderIndex = 0; shaderIndex < shaderCount; shaderIndex++)
 		{
 			Shader* shader = AssetManager::GetShader(shaderIndex);
-			if (shader->GetFileStatus() != FileStatus::FileStatus_Loaded)
+			if (shader->GetFileStatus() != FileStatus::FileStatus_Loaded || !shader->NeedsLightUniforms())
 			{
 				continue;
 			}
@@ -183,6 +204,23 @@ void Graphics::Draw()
 		}
 	}
 
+	// The debug shapes added during the game update are drawn by all the cameras
+	DebugDraw::BeginRender();
+
+	{
+		SCOPED_PROFILER("Graphics::CallOnNewFrame", scopeBenchmarkNewFrame);
+		for (IDrawable* drawable : newRenderDrawables)
+		{
+			if (drawable->GetGameObjectRaw()->IsLocalActive() && drawable->IsEnabled())
+			{
+				drawable->OnNewFrame();
+			}
+		}
+		// Once per frame, the cameras skipping this frame do not slow down the particles
+		ParticleSimulation::Run();
+	}
+
+	// Index among the cameras rendered this frame
 	int currentCameraIndex = 0;
 	for (const std::weak_ptr<Camera>& weakCam : cameras)
 	{
@@ -190,18 +228,21 @@ void Graphics::Draw()
 
 		if (usedCamera->IsEnabled() && usedCamera->GetGameObjectRaw()->IsLocalActive())
 		{
+			// Keep the last image of the cameras that do not update this frame
+			if (!usedCamera->ConsumeRenderTurn())
+			{
+				usedCamera->PresentFrameBuffer();
+				continue;
+			}
+
 			Engine::GetRenderer().NewFrame();
 			s_currentFrame++;
 
 			SortDrawables();
 			CheckLods();
 
-			// Set material as dirty
-			for (int materialIndex = 0; materialIndex < matCount; materialIndex++)
-			{
-				Material* mat = AssetManager::GetMaterial(materialIndex);
-				mat->m_updated = false;
-			}
+			// Set materials as dirty
+			Material::InvalidateAllUniforms();
 
 			s_currentMode = IDrawableTypes::Draw_3D;
 
@@ -235,9 +276,15 @@ void Graphics::Draw()
 
 			//Engine::GetRenderer().SetFog(s_settings.isFogEnabled);
 
+			FrustumCulling::Cull(usedCamera->frustum);
+#if defined(ENABLE_OCCLUSION_CULLING)
+			OcclusionCulling::Cull(*usedCamera);
+#endif
+			TextureStreaming::RequestVisibleTextures(*usedCamera);
+
 			{
 				SCOPED_PROFILER("Graphics::CallOnNewRender", scopeBenchmarkNewRender);
-				for (IDrawable* drawable : s_orderedIDrawable)
+				for (IDrawable* drawable : newRenderDrawables)
 				{
 					if (drawable->GetGameObjectRaw()->IsLocalActive() && drawable->IsEnabled())
 					{
@@ -246,48 +293,38 @@ void Graphics::Draw()
 				}
 			}
 
-#if !defined(ENABLE_OVERDRAW_OPTIMIZATION)
-			{
-				SCOPED_PROFILER("Graphics::RenderOpaque", scopeBenchmarkRenderOpaque);
-				for (const auto& renderQueue : renderBatch.renderQueues)
-				{
-					for (const RenderCommand& com : renderQueue.second.commands)
-					{
-						if (com.isEnabled)
-							com.drawable->DrawCommand(com);
-					}
-				}
-			}
-#else
 			{
 				SCOPED_PROFILER("Graphics::RenderOpaque", scopeBenchmarkRenderOpaque);
-				for (const RenderCommand& com : renderBatch.opaqueMeshCommands)
-				{
-					if (com.isEnabled)
-						com.drawable->DrawCommand(com);
-				}
+				DrawRenderQueue(renderBatch.GetQueue(RenderPass::Opaque));
 			}
-#endif
 
 			DrawSkybox(camPos);
 
 			{
 				SCOPED_PROFILER("Graphics::RenderTransparent", scopeBenchmarkRenderTransparent);
-				for (const RenderCommand& com : renderBatch.transparentMeshCommands)
+				const RenderQueue& queue = renderBatch.GetQueue(RenderPass::Transparent);
+				for (const RenderSortEntry& entry : queue.drawOrder)
 				{
-					if (com.isEnabled)
-						com.drawable->DrawCommand(com);
+					const RenderCommand& com = queue.commands[entry.slot];
+					com.drawable->DrawCommand(com);
 				}
 			}
 
+#if defined(ENABLE_OCCLUSION_CULLING)
+			OcclusionCulling::ResetCulledMeshRenderers();
+#endif
+
+			// The editor cameras draw the debug shapes with the gizmos
+			if (!usedCamera->IsEditor() && !DebugDraw::IsEmpty())
+			{
+				SetDebugDrawCamera();
+				DebugDraw::DrawCameraShapes();
+			}
+
 			{
 				SCOPED_PROFILER("Graphics::Render2D", scopeBenchmarkRender2D);
 				s_currentMode = IDrawableTypes::Draw_2D;
-				for (const RenderCommand& com : renderBatch.spriteCommands)
-				{
-					if (com.isEnabled)
-						com.drawable->DrawCommand(com);
-				}
+				DrawRenderQueue(renderBatch.GetQueue(RenderPass::Sprite));
 			}
 
 			if (!usedCamera->IsEditor())
@@ -311,13 +348,7 @@ void Graphics::Draw()
 
 			{
 				SCOPED_PROFILER("Graphics::RenderUI", scopeBenchmarkRender2D);
-				const size_t uiCommandCount = renderBatch.uiCommandIndex;
-				for (size_t commandIndex = 0; commandIndex < uiCommandCount; commandIndex++)
-				{
-					const RenderCommand& com = renderBatch.uiCommands[commandIndex];
-					if (com.isEnabled)
-						com.drawable->DrawCommand(com);
-				}
+				DrawRenderQueue(renderBatch.GetQueue(RenderPass::UI));
 			}
 
 #if defined(EDITOR)
@@ -335,26 +366,6 @@ void Graphics::Draw()
 					}
 				}
 
-				Engine::GetRenderer().ResetTransform();
-				Engine::GetRenderer().SetCameraPosition(*usedCamera);
-
-				// Currently lines do not support shaders
-				if constexpr (!s_UseOpenGLFixedFunctions)
-				{
-					Engine::GetRenderer().UseShaderProgram(0);
-					s_currentShader = nullptr;
-					s_currentMaterial = nullptr;
-				}
-
-				if (usedCamera->GetProjectionType() == ProjectionType::Perspective)
-				{
-					Engine::GetRenderer().SetProjection3D(usedCamera->GetFov(), usedCamera->GetNearClippingPlane(), usedCamera->GetFarClippingPlane(), usedCamera->GetAspectRatio());
-				}
-				else
-				{
-					Engine::GetRenderer().SetProjection2D(usedCamera->GetProjectionSize(), usedCamera->GetNearClippingPlane(), usedCamera->GetFarClippingPlane());
-				}
-
 				// Get the grid axis
 				const std::vector<std::shared_ptr<SceneMenu>> sceneMenus = Editor::GetMenus<SceneMenu>();
 				int gridAxis = 0;
@@ -397,10 +408,15 @@ void Graphics::Draw()
 
 				WorldPartitionner::OnDrawGizmos();
 
+				// Draw the grid, the bounding boxes and the gizmos lines before the tool
+				SetDebugDrawCamera();
+				DebugDraw::DrawCameraShapes();
+
 				DrawEditorTool(camPos);
 			}
 #endif
 			usedCamera->CopyMultiSampledFrameBuffer();
+			usedCamera->PresentFrameBuffer();
 			currentCameraIndex++;
 		}
 	}
@@ -424,24 +440,64 @@ void Graphics::Draw()
 #endif
 	Engine::GetRenderer().EndFrame();
 
+	DebugDraw::EndRender();
+
 	//usedCamera.reset();
 }
 
-Vector3 meshComparatorCamPos;
-
-bool meshComparator2(const RenderCommand& c1, const RenderCommand& c2)
+void Graphics::SetDebugDrawCamera()
 {
-	return Vector3::Distance(c1.transform->GetPosition(), meshComparatorCamPos) > Vector3::Distance(c2.transform->GetPosition(), meshComparatorCamPos);
-}
+	Engine::GetRenderer().ResetTransform();
+	Engine::GetRenderer().SetCameraPosition(*usedCamera);
 
-bool meshComparator3(const RenderCommand& c1, const RenderCommand& c2)
-{
-	return Vector3::Distance(c2.transform->GetPosition(), meshComparatorCamPos) > Vector3::Distance(c1.transform->GetPosition(), meshComparatorCamPos);
+	// Currently lines do not support shaders
+	if constexpr (!s_UseOpenGLFixedFunctions)
+	{
+		Engine::GetRenderer().UseShaderProgram(0);
+		s_currentShader = nullptr;
+		s_currentMaterial = nullptr;
+	}
+
+	if (usedCamera->GetProjectionType() == ProjectionType::Perspective)
+	{
+		Engine::GetRenderer().SetProjection3D(usedCamera->GetFov(), usedCamera->GetNearClippingPlane(), usedCamera->GetFarClippingPlane(), usedCamera->GetAspectRatio());
+	}
+	else
+	{
+		Engine::GetRenderer().SetProjection2D(usedCamera->GetProjectionSize(), usedCamera->GetNearClippingPlane(), usedCamera->GetFarClippingPlane());
+	}
 }
 
-bool UIElementComparator(const RenderCommand& c1, const RenderCommand& c2)
+void Graphics::DrawRenderQueue(const RenderQueue& queue)
 {
-	return c2.drawable->GetOrderInLayer() > c1.drawable->GetOrderInLayer();
+	const size_t drawCount = queue.drawOrder.size();
+	size_t drawIndex = 0;
+	while (drawIndex < drawCount)
+	{
+		const RenderCommand& com = queue.commands[queue.drawOrder[drawIndex].slot];
+		drawIndex++;
+
+		// Group the next commands that can be drawn in the same draw call (they are next to each other thanks to the sort)
+		instancedCommands.clear();
+		instancedCommands.push_back(&com);
+		while (drawIndex < drawCount)
+		{
+			const RenderCommand& nextCom = queue.commands[queue.drawOrder[drawIndex].slot];
+			if (!com.drawable->IsInstanceCompatible(com, nextCom))
+				break;
+
+			instancedCommands.push_back(&nextCom);
+			drawIndex++;
+		}
+
+		if (instancedCommands.size() < s_minInstanceCount || !com.drawable->DrawCommandsInstanced(instancedCommands.data(), instancedCommands.size()))
+		{
+			for (const RenderCommand* instancedCommand : instancedCommands)
+			{
+				instancedCommand->drawable->DrawCommand(*instancedCommand);
+			}
+		}
+	}
 }
 
 void Graphics::SortDrawables()
@@ -449,17 +505,11 @@ void Graphics::SortDrawables()
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
 	SCOPED_PROFILER("Graphics::SortDrawables", scopeBenchmark);
-	meshComparatorCamPos = usedCamera->GetTransformRaw()->GetPosition();
-	std::sort(renderBatch.transparentMeshCommands.begin(), renderBatch.transparentMeshCommands.begin() + renderBatch.transparentMeshCommandIndex, meshComparator2);
-#if defined(ENABLE_OVERDRAW_OPTIMIZATION)
-	std::sort(renderBatch.opaqueMeshCommands.begin(), renderBatch.opaqueMeshCommands.begin() + renderBatch.opaqueMeshCommandIndex, meshComparator3);
-#endif
-
-	if (s_needUpdateUIOrdering)
-	{
-		s_needUpdateUIOrdering = false;
-		std::sort(renderBatch.uiCommands.begin(), renderBatch.uiCommands.begin() + renderBatch.uiCommandIndex, UIElementComparator);
-	}
+	const Vector3& camPos = usedCamera->GetTransformRaw()->GetPosition();
+	renderBatch.UpdateDrawOrder(RenderPass::Opaque, camPos);
+	renderBatch.UpdateDrawOrder(RenderPass::Transparent, camPos);
+	renderBatch.UpdateDrawOrder(RenderPass::Sprite, camPos);
+	renderBatch.UpdateDrawOrder(RenderPass::UI, camPos);
 }
 
 void Graphics::OrderDrawables()
@@ -470,11 +520,30 @@ void Graphics::OrderDrawables()
 	{
 		SCOPED_PROFILER("Graphics::OrderDrawables", scopeBenchmark);
 		s_isRenderingBatchDirty = false;
+		for (IDrawable* drawable : s_dirtyDrawables)
+		{
+			drawable->m_isRenderCommandsDirty = false;
+		}
+		s_dirtyDrawables.clear();
+
 		renderBatch.Reset();
 		for (IDrawable* drawable : s_orderedIDrawable)
 		{
+			drawable->m_renderCommandHandles.clear();
+			drawable->CreateRenderCommands(renderBatch);
+		}
+	}
+	else if (!s_dirtyDrawables.empty())
+	{
+		SCOPED_PROFILER("Graphics::UpdateDirtyDrawables", scopeBenchmark);
+		// Only recreate the commands of the modified drawables, the freed slots are reused by the new commands
+		for (IDrawable* drawable : s_dirtyDrawables)
+		{
+			drawable->m_isRenderCommandsDirty = false;
+			renderBatch.RemoveCommands(*drawable);
 			drawable->CreateRenderCommands(renderBatch);
 		}
+		s_dirtyDrawables.clear();
 	}
 }
 
@@ -482,7 +551,11 @@ void Graphics::DeleteAllDrawables()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
+	// The drawables may already be destroyed, invalidate their draw order instead of accessing them
+	s_firstDrawOrder = s_nextDrawOrder;
 	s_orderedIDrawable.clear();
+	newRenderDrawables.clear();
+	s_dirtyDrawables.clear();
 	s_iDrawablesCount = 0;
 	s_isRenderingBatchDirty = true;
 }
@@ -494,11 +567,18 @@ void Graphics::AddDrawable(IDrawable* drawableToAdd)
 	XASSERT(drawableToAdd != nullptr, "[Graphics::AddDrawable] drawableToAdd is nullptr");
 
 	s_orderedIDrawable.push_back(drawableToAdd);
+	if (drawableToAdd->m_useOnNewRender)
+	{
+		newRenderDrawables.push_back(drawableToAdd);
+	}
 	s_iDrawablesCount++;
-	s_isRenderingBatchDirty = true;
+	drawableToAdd->m_drawOrder = s_nextDrawOrder++;
+	drawableToAdd->m_renderCommandHandles.clear();
+	drawableToAdd->m_isRenderCommandsDirty = false;
+	SetDrawableDirty(*drawableToAdd);
 }
 
-void Graphics::RemoveDrawable(const IDrawable* drawableToRemove)
+void Graphics::RemoveDrawable(IDrawable* drawableToRemove)
 {
 	STACK_DEBUG_OBJECT(STACK_LOW_PRIORITY);
 
@@ -513,40 +593,78 @@ void Graphics::RemoveDrawable(const IDrawable* drawableToRemove)
 		{
 			s_orderedIDrawable.erase(s_orderedIDrawable.begin() + i);
 			s_iDrawablesCount--;
-			s_isRenderingBatchDirty = true;
+			if (drawableToRemove->m_useOnNewRender)
+			{
+				newRenderDrawables.erase(std::find(newRenderDrawables.begin(), newRenderDrawables.end(), drawableToRemove));
+			}
+
+			// Free the commands now, the drawable will not exist anymore when the batch is updated
+			if (!s_isRenderingBatchDirty)
+			{
+				renderBatch.RemoveCommands(*drawableToRemove);
+			}
+			drawableToRemove->m_renderCommandHandles.clear();
+			if (drawableToRemove->m_isRenderCommandsDirty)
+			{
+				drawableToRemove->m_isRenderCommandsDirty = false;
+				s_dirtyDrawables.erase(std::find(s_dirtyDrawables.begin(), s_dirtyDrawables.end(), drawableToRemove));
+			}
+			drawableToRemove->m_drawOrder = 0;
 			break;
 		}
 	}
 }
 
+void Graphics::SetDrawableDirty(IDrawable& drawable)
+{
+	// Not in the drawable list, the commands will be created when the drawable is added
+	if (drawable.m_drawOrder < s_firstDrawOrder || drawable.m_isRenderCommandsDirty)
+		return;
+
+	drawable.m_isRenderCommandsDirty = true;
+	s_dirtyDrawables.push_back(&drawable);
+}
+
+void Graphics::SetDrawablesDirty(const FileReference& fileReference)
+{
+	if (s_isRenderingBatchDirty)
+		return;
+
+	const FileType fileType = fileReference.GetFileType();
+	if (fileType != FileType::File_Mesh && fileType != FileType::File_Material)
+		return;
+
+	for (IDrawable* drawable : s_orderedIDrawable)
+	{
+		if (drawable->UsesFileReference(fileReference))
+		{
+			SetDrawableDirty(*drawable);
+		}
+	}
+}
+
 void Graphics::AddLod(const std::weak_ptr<Lod>& lodToAdd)
 {
 	STACK_DEBUG_OBJECT(STACK_LOW_PRIORITY);
 
-	XASSERT(lodToAdd.lock() != nullptr, "[Graphics::AddLod] lodToAdd is nullptr");
+	const std::shared_ptr<Lod> lod = lodToAdd.lock();
+	XASSERT(lod != nullptr, "[Graphics::AddLod] lodToAdd is nullptr");
 
-	s_lods.push_back(lodToAdd);
-	s_lodsCount++;
+	lod->m_selectionIndex = LodSelection::AddLod(*lod);
 }
 
 void Graphics::RemoveLod(const std::weak_ptr<Lod>& lodToRemove)
 {
 	STACK_DEBUG_OBJECT(STACK_LOW_PRIORITY);
 
-	XASSERT(lodToRemove.lock() != nullptr, "[Graphics::RemoveLod] lodToRemove is nullptr");
+	const std::shared_ptr<Lod> lod = lodToRemove.lock();
+	XASSERT(lod != nullptr, "[Graphics::RemoveLod] lodToRemove is nullptr");
 
 	if (!Engine::IsRunning(true))
 		return;
 
-	for (int i = 0; i < s_lodsCount; i++)
-	{
-		if (s_lods[i].lock() == lodToRemove.lock())
-		{
-			s_lods.erase(s_lods.begin() + i);
-			s_lodsCount--;
-			break;
-		}
-	}
+	LodSelection::RemoveLod(lod->m_selectionIndex);
+	lod->m_selectionIndex = LodSelection::s_invalidIndex;
 }
 
 void Graphics::RemoveCamera(const std::weak_ptr<Camera>& cameraToRemove)
@@ -562,6 +680,7 @@ void Graphics::RemoveCamera(const std::weak_ptr<Camera>& cameraToRemove)
 		if (cam && cam == cameraToRemove.lock())
 		{
 			cameras.erase(cameras.begin() + cameraIndex);
+			LodSelection::RemoveCamera(*cam);
 			break;
 		}
 	}
@@ -580,6 +699,11 @@ void Graphics::DrawSubMesh(const MeshData::SubMesh& subMesh, Material& material,
 
 	XASSERT(usedCamera != nullptr, "[Graphics::DrawSubMesh] usedCamera is nullptr");
 
+	if (!MarkAssetsUsed(subMesh, texture))
+	{
+		return;
+	}
+
 	if (texture == nullptr || texture->GetFileStatus() != FileStatus::FileStatus_Loaded)
 	{
 		texture = AssetManager::defaultTexture.get();
@@ -587,14 +711,24 @@ void Graphics::DrawSubMesh(const MeshData::SubMesh& subMesh, Material& material,
 
 	if constexpr (!s_UseOpenGLFixedFunctions)
 	{
-		material.Use();
+		material.Use(subMesh.HasOctahedralNormals());
 
 		if (!s_currentShader || s_currentShader->GetFileStatus() != FileStatus::FileStatus_Loaded)
 		{
 			return;
 		}
 
-		s_currentShader->SetShaderModel(matrix, normalMatrix, mvpMatrix);
+		s_currentShader->SetUseInstancing(false);
+		if (subMesh.HasQuantizedPositions())
+		{
+			// The normals are not quantized with the positions, the normal matrix stays the same
+			const glm::mat4 dequantizationMatrix = subMesh.GetDequantizationMatrix();
+			s_currentShader->SetShaderModel(matrix * dequantizationMatrix, normalMatrix, mvpMatrix * dequantizationMatrix);
+		}
+		else
+		{
+			s_currentShader->SetShaderModel(matrix, normalMatrix, mvpMatrix);
+		}
 	}
 	else
 	{
@@ -602,12 +736,67 @@ void Graphics::DrawSubMesh(const MeshData::SubMesh& subMesh, Material& material,
 		if (!forUI || usedCamera->IsEditor())
 			Engine::GetRenderer().SetCameraPosition(*usedCamera);
 #endif
-		Engine::GetRenderer().SetTransform(matrix);
+		if (subMesh.HasQuantizedPositions())
+		{
+			Engine::GetRenderer().SetTransform(matrix * subMesh.GetDequantizationMatrix());
+		}
+		else
+		{
+			Engine::GetRenderer().SetTransform(matrix);
+		}
 	}
 
 	Engine::GetRenderer().DrawSubMesh(subMesh, material, *texture, renderSettings);
 }
 
+void Graphics::DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, Material& material, RenderingSettings& renderSettings, const RenderInstanceData* instances, size_t instanceCount)
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	XASSERT(usedCamera != nullptr, "[Graphics::DrawSubMeshInstanced] usedCamera is nullptr");
+	XASSERT(Engine::GetRenderer().IsInstancingSupported(), "[Graphics::DrawSubMeshInstanced] Instancing is not supported by the renderer");
+
+	Texture* texture = material.m_texture.get();
+	if (!MarkAssetsUsed(subMesh, texture))
+	{
+		return;
+	}
+
+	if (texture == nullptr || texture->GetFileStatus() != FileStatus::FileStatus_Loaded)
+	{
+		texture = AssetManager::defaultTexture.get();
+	}
+
+	material.Use(subMesh.HasOctahedralNormals());
+
+	if (!s_currentShader || s_currentShader->GetFileStatus() != FileStatus::FileStatus_Loaded)
+	{
+		return;
+	}
+
+	XASSERT(s_currentShader->IsInstancingSupported(), "[Graphics::DrawSubMeshInstanced] The shader does not support instancing");
+
+	s_currentShader->SetUseInstancing(true);
+	Engine::GetRenderer().DrawSubMeshInstanced(subMesh, material, *texture, renderSettings, instances, instanceCount);
+}
+
+bool Graphics::MarkAssetsUsed(const MeshData::SubMesh& subMesh, Texture* texture)
+{
+	// An evicted texture is replaced by the default texture until its reload at the end of the frame
+	if (texture)
+	{
+		ResidencyManager::MarkUsed(*texture);
+	}
+
+	// The submeshes of an evicted mesh have no data
+	if (subMesh.m_meshData)
+	{
+		ResidencyManager::MarkUsed(*subMesh.m_meshData);
+		return !subMesh.m_isDataFreed;
+	}
+	return true;
+}
+
 void Graphics::CreateLightLists()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
@@ -653,6 +842,55 @@ void Graphics::OnProjectLoaded()
 			Debug::PrintError("[Graphics::OnProjectLoaded] skyPlane is null", true);
 		}
 	}
+
+	if (!skyCube && Engine::GetRenderer().IsCubemapSupported())
+	{
+		CreateSkyCube();
+	}
+}
+
+void Graphics::CreateSkyCube()
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	// Unit cube around the camera, the positions are also the directions used to sample the cubemap
+	static const float vertices[8][3] =
+	{
+		{ -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+		{ -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 },
+	};
+	static const uint32_t indices[36] =
+	{
+		0, 1, 2, 2, 3, 0, // -Z
+		4, 6, 5, 6, 4, 7, // +Z
+		0, 3, 7, 7, 4, 0, // -X
+		1, 5, 6, 6, 2, 1, // +X
+		0, 4, 5, 5, 1, 0, // -Y
+		3, 2, 6, 6, 7, 3, // +Y
+	};
+
+	skyCube = MeshData::CreateMeshData();
+
+	VertexDescriptor descriptor;
+	descriptor.AddVertexElement(VertexElement::POSITION_32_BITS);
+	skyCube->CreateSubMesh(8, 36, descriptor);
+	if (skyCube->m_subMeshCount == 0)
+	{
+		skyCube.reset();
+		return;
+	}
+
+	MeshData::SubMesh& subMesh = *skyCube->m_subMeshes[0];
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		subMesh.SetVertex(vertices[i][0], vertices[i][1], vertices[i][2], i);
+	}
+	for (uint32_t i = 0; i < 36; i++)
+	{
+		subMesh.SetIndex(i, indices[i]);
+	}
+
+	skyCube->OnLoadFileReferenceFinished();
 }
 
 void Graphics::DrawSkybox(const Vector3& cameraPosition)
@@ -674,60 +912,81 @@ void Graphics::DrawSkybox(const Vector3& cameraPosition)
 		renderSettings.useLighting = false;
 		renderSettings.max_depth = true;
 
-		const std::shared_ptr<Texture> texture = AssetManager::unlitMaterial->m_texture;
+		// One draw call when the renderer supports cubemaps
+		const std::shared_ptr<Shader>& skyboxShader = AssetManager::skyboxShader;
+		if (skyCube && skyboxShader && skyboxShader->GetFileStatus() == FileStatus::FileStatus_Loaded)
+		{
+			const Cubemap* cubemap = s_settings.skybox->GetCubemap();
+			if (cubemap)
+			{
+				// Only the rotation of the camera is used, the cube stays around the camera
+				const glm::mat4 viewProjection = usedCamera->GetProjection() * glm::mat4(glm::mat3(usedCamera->viewMatrix));
+
+				skyboxShader->Use();
+				// The next material has to send its uniforms again
+				s_currentMaterial = nullptr;
+				skyboxShader->SetUseInstancing(false);
+				skyboxShader->SetShaderModel(glm::mat4(1), glm::mat3(1), viewProjection);
+				Engine::GetRenderer().DrawCubemapSubMesh(*skyCube->m_subMeshes[0], cubemap->GetId(), renderSettings);
+				return;
+			}
+		}
+
+		// Fallback: one plane per face, the texture is given to the draw call to not change the shared unlit material
+		const MeshData::SubMesh& planeSubMesh = *skyPlane->m_subMeshes[0];
+		Material& material = *AssetManager::unlitMaterial;
 
-		AssetManager::unlitMaterial->m_texture = s_settings.skybox->down;
 		static const Quaternion q0 = Quaternion::Euler(0, 180, 0);
-		Graphics::DrawSubMesh(Vector3(0, -5, 0) + cameraPosition, q0, scale, *skyPlane->m_subMeshes[0], *AssetManager::unlitMaterial, renderSettings);
+		DrawSkyboxFace(Vector3(0, -5, 0) + cameraPosition, q0, scale, planeSubMesh, material, s_settings.skybox->down.get(), renderSettings);
 
-		AssetManager::unlitMaterial->m_texture = s_settings.skybox->up;
 		static const Quaternion q1 = Quaternion::Euler(180, 180, 0);
-		Graphics::DrawSubMesh(Vector3(0, 5, 0) + cameraPosition, q1, scale, *skyPlane->m_subMeshes[0], *AssetManager::unlitMaterial, renderSettings);
+		DrawSkyboxFace(Vector3(0, 5, 0) + cameraPosition, q1, scale, planeSubMesh, material, s_settings.skybox->up.get(), renderSettings);
 
-		AssetManager::unlitMaterial->m_texture = s_settings.skybox->front;
 		static const Quaternion q2 = Quaternion::Euler(90, 0, 180);
-		Graphics::DrawSubMesh(Vector3(0, 0, 5) + cameraPosition, q2, scale, *skyPlane->m_subMeshes[0], *AssetManager::unlitMaterial, renderSettings);
+		DrawSkyboxFace(Vector3(0, 0, 5) + cameraPosition, q2, scale, planeSubMesh, material, s_settings.skybox->front.get(), renderSettings);
 
-		AssetManager::unlitMaterial->m_texture = s_settings.skybox->back;
 		static const Quaternion q3 = Quaternion::Euler(90, 0, 0);
-		Graphics::DrawSubMesh(Vector3(0, 0, -5) + cameraPosition, q3, scale, *skyPlane->m_subMeshes[0], *AssetManager::unlitMaterial, renderSettings);
+		DrawSkyboxFace(Vector3(0, 0, -5) + cameraPosition, q3, scale, planeSubMesh, material, s_settings.skybox->back.get(), renderSettings);
 
-		AssetManager::unlitMaterial->m_texture = s_settings.skybox->left;
 		static const Quaternion q4 = Quaternion::Euler(90, -90, 0);
-		Graphics::DrawSubMesh(Vector3(5, 0, 0) + cameraPosition, q4, scale, *skyPlane->m_subMeshes[0], *AssetManager::unlitMaterial, renderSettings);
+		DrawSkyboxFace(Vector3(5, 0, 0) + cameraPosition, q4, scale, planeSubMesh, material, s_settings.skybox->left.get(), renderSettings);
 
-		AssetManager::unlitMaterial->m_texture = s_settings.skybox->right;
 		static const Quaternion q5 = Quaternion::Euler(90, 0, -90);
-		Graphics::DrawSubMesh(Vector3(-5, 0, 0) + cameraPosition, q5, scale, *skyPlane->m_subMeshes[0], *AssetManager::unlitMaterial, renderSettings);
-
-		AssetManager::unlitMaterial->m_texture = texture;
+		DrawSkyboxFace(Vector3(-5, 0, 0) + cameraPosition, q5, scale, planeSubMesh, material, s_settings.skybox->right.get(), renderSettings);
 	}
 }
 
+void Graphics::DrawSkyboxFace(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const MeshData::SubMesh& subMesh, Material& material, Texture* texture, RenderingSettings& renderSettings)
+{
+	const glm::mat4 transformationMatrix = InternalMath::CreateModelMatrix(position, rotation, scale);
+	const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transformationMatrix)));
+	const glm::mat4 MVP = usedCamera->m_viewProjectionMatrix * transformationMatrix;
+
+	DrawSubMesh(subMesh, material, texture, renderSettings, transformationMatrix, normalMatrix, MVP, false);
+}
+
 void Graphics::CheckLods()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
 	SCOPED_PROFILER("Graphics::CheckLods", scopeBenchmark);
-	for (int i = 0; i < s_lodsCount; i++)
-	{
-		const std::shared_ptr<Lod> lod = s_lods[i].lock();
-		if (lod)
-		{
-			lod->CheckLod();
-		}
-	}
+	LodSelection::Select(*usedCamera);
 }
 
 void Graphics::UpdateShadersCameraMatrices()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
+	// One upload for all the shaders reading the camera from the shared buffer
+	ShaderOpenGL::UpdateCameraBuffer(Graphics::s_currentMode == IDrawableTypes::Draw_UI);
+#endif
+
 	const int shaderCount = AssetManager::GetShaderCount();
 	for (int shaderIndex = 0; shaderIndex < shaderCount; shaderIndex++)
 	{
 		Shader* shader = AssetManager::GetShader(shaderIndex);
-		if (shader->GetFileStatus() != FileStatus::FileStatus_Loaded)
+		if (shader->GetFileStatus() != FileStatus::FileStatus_Loaded || !shader->NeedsCameraUniforms())
 		{
 			continue;
 		}
@@ -776,12 +1035,6 @@ void Graphics::DrawSelectedItemBoundingBox()
 		{
 			const Color color = Color::CreateFromRGBAFloat(0.0f, 1.0f, 1.0f, 1.0f);
 
-			RenderingSettings renderSettings = RenderingSettings();
-			renderSettings.renderingMode = MaterialRenderingMode::Transparent;
-			renderSettings.useDepth = true;
-			renderSettings.useLighting = false;
-			renderSettings.useTexture = false;
-
 			const Vector3& min = meshRenderer->GetMeshData()->GetMinBoundingBox();
 			const Vector3& max = meshRenderer->GetMeshData()->GetMaxBoundingBox();
 
@@ -796,20 +1049,20 @@ void Graphics::DrawSelectedItemBoundingBox()
 			const Vector3 top2 = Vector3(matrix * glm::vec4(max.x, max.y, min.z, 1));
 			const Vector3 top3 = Vector3(matrix * glm::vec4(max.x, max.y, max.z, 1));
 
-			Engine::GetRenderer().DrawLine(bottom0, bottom1, color, renderSettings);
-			Engine::GetRenderer().DrawLine(bottom1, bottom3, color, renderSettings);
-			Engine::GetRenderer().DrawLine(bottom2, bottom0, color, renderSettings);
-			Engine::GetRenderer().DrawLine(bottom2, bottom3, color, renderSettings);
+			DebugDraw::AddLine(bottom0, bottom1, color, true);
+			DebugDraw::AddLine(bottom1, bottom3, color, true);
+			DebugDraw::AddLine(bottom2, bottom0, color, true);
+			DebugDraw::AddLine(bottom2, bottom3, color, true);
 
-			Engine::GetRenderer().DrawLine(top0, top1, color, renderSettings);
-			Engine::GetRenderer().DrawLine(top1, top3, color, renderSettings);
-			Engine::GetRenderer().DrawLine(top2, top0, color, renderSettings);
-			Engine::GetRenderer().DrawLine(top2, top3, color, renderSettings);
+			DebugDraw::AddLine(top0, top1, color, true);
+			DebugDraw::AddLine(top1, top3, color, true);
+			DebugDraw::AddLine(top2, top0, color, true);
+			DebugDraw::AddLine(top2, top3, color, true);
 
-			Engine::GetRenderer().DrawLine(bottom0, top0, color, renderSettings);
-			Engine::GetRenderer().DrawLine(bottom1, top1, color, renderSettings);
-			Engine::GetRenderer().DrawLine(bottom2, top2, color, renderSettings);
-			Engine::GetRenderer().DrawLine(bottom3, top3, color, renderSettings);
+			DebugDraw::AddLine(bottom0, top0, color, true);
+			DebugDraw::AddLine(bottom1, top1, color, true);
+			DebugDraw::AddLine(bottom2, top2, color, true);
+			DebugDraw::AddLine(bottom3, top3, color, true);
 		}
 	}
 }
@@ -866,24 +1119,18 @@ void Graphics::DrawEditorGrid(const Vector3& cameraPosition, int gridAxis)
 	const float lineCount = lineLenght / coef;
 	const Color color = Color::CreateFromRGBAFloat(0.7f, 0.7f, 0.7f, 0.2f * s_gridAlphaMultiplier);
 
-	RenderingSettings renderSettings = RenderingSettings();
-	renderSettings.renderingMode = MaterialRenderingMode::Transparent;
-	renderSettings.useDepth = true;
-	renderSettings.useLighting = false;
-	renderSettings.useTexture = false;
-
 	if (gridAxis == 0)
 	{
 		// For XZ
 		for (int z = static_cast<int>(-lineCount + cameraPosition.z / coef); z < lineCount + cameraPosition.z / coef; z++)
 		{
 			const float zPos = static_cast<float>(z * coef);
-			Engine::GetRenderer().DrawLine(Vector3(-lineLenght - cameraPosition.x, 0, zPos), Vector3(lineLenght - cameraPosition.x, 0, zPos), color, renderSettings);
+			DebugDraw::AddLine(Vector3(-lineLenght - cameraPosition.x, 0, zPos), Vector3(lineLenght - cameraPosition.x, 0, zPos), color, true);
 		}
 		for (int x = static_cast<int>(-lineCount + cameraPosition.x / coef); x < lineCount + cameraPosition.x / coef; x++)
 		{
 			const float xPos = static_cast<float>(-x * coef);
-			Engine::GetRenderer().DrawLine(Vector3(xPos, 0, -lineLenght + cameraPosition.z), Vector3(xPos, 0, lineLenght + cameraPosition.z), color, renderSettings);
+			DebugDraw::AddLine(Vector3(xPos, 0, -lineLenght + cameraPosition.z), Vector3(xPos, 0, lineLenght + cameraPosition.z), color, true);
 		}
 	}
 	else if (gridAxis == 1)
@@ -892,12 +1139,12 @@ void Graphics::DrawEditorGrid(const Vector3& cameraPosition, int gridAxis)
 		for (int z = static_cast<int>(-lineCount + cameraPosition.z / coef); z < lineCount + cameraPosition.z / coef; z++)
 		{
 			const float zPos = static_cast<float>(z * coef);
-			Engine::GetRenderer().DrawLine(Vector3(0, -lineLenght - cameraPosition.y, zPos), Vector3(0, lineLenght - cameraPosition.y, zPos), color, renderSettings);
+			DebugDraw::AddLine(Vector3(0, -lineLenght - cameraPosition.y, zPos), Vector3(0, lineLenght - cameraPosition.y, zPos), color, true);
 		}
 		for (int y = static_cast<int>(-lineCount + cameraPosition.y / coef); y < lineCount + cameraPosition.y / coef; y++)
 		{
 			const float yPos = static_cast<float>(-y * coef);
-			Engine::GetRenderer().DrawLine(Vector3(0, yPos, -lineLenght + cameraPosition.z), Vector3(0, yPos, lineLenght + cameraPosition.z), color, renderSettings);
+			DebugDraw::AddLine(Vector3(0, yPos, -lineLenght + cameraPosition.z), Vector3(0, yPos, lineLenght + cameraPosition.z), color, true);
 		}
 	}
 	else if (gridAxis == 2)
@@ -906,12 +1153,12 @@ void Graphics::DrawEditorGrid(const Vector3& cameraPosition, int gridAxis)
 		for (int x = static_cast<int>(-lineCount + cameraPosition.x / coef); x < lineCount + cameraPosition.x / coef; x++)
 		{
 			const float xPos = static_cast<float>(x * coef);
-			Engine::GetRenderer().DrawLine(Vector3(xPos, -lineLenght - cameraPosition.y, 0), Vector3(xPos, lineLenght - cameraPosition.y, 0), color, renderSettings);
+			DebugDraw::AddLine(Vector3(xPos, -lineLenght - cameraPosition.y, 0), Vector3(xPos, lineLenght - cameraPosition.y, 0), color, true);
 		}
 		for (int y = static_cast<int>(-lineCount + cameraPosition.y / coef); y < lineCount + cameraPosition.y / coef; y++)
 		{
 			const float yPos = static_cast<float>(-y * coef);
-			Engine::GetRenderer().DrawLine(Vector3(-lineLenght + cameraPosition.x, yPos, 0), Vector3(lineLenght + cameraPosition.x, yPos, 0), color, renderSettings);
+			DebugDraw::AddLine(Vector3(-lineLenght + cameraPosition.x, yPos, 0), Vector3(lineLenght + cameraPosition.x, yPos, 0), color, true);
 		}
 	}
 }
@@ -17,12 +17,14 @@
 #include "renderer/renderer.h" // For RenderingSettings
 
 class IDrawable;
+class RenderQueue;
 class Material;
 class Camera;
 class Texture;
 class SkyBox;
 class Vector3;
 class Shader;
+class FileReference;
 class Lod;
 class Quaternion;
 
@@ -69,7 +71,7 @@ public:
 	static void Draw();
 
 	/**
-	* @brief Order all drawables
+	* @brief Create the render commands of the new and modified drawables (or of all drawables if the whole batch is dirty)
 	*/
 	static void OrderDrawables();
 
@@ -78,6 +80,11 @@ public:
 	*/
 	static void SortDrawables();
 
+	/**
+	* @brief Draw the commands of a queue in draw order, consecutive compatible commands are drawn with one draw call when possible
+	*/
+	static void DrawRenderQueue(const RenderQueue& queue);
+
 	/**
 	* @brief Delete all drawables
 	*/
@@ -93,7 +100,19 @@ public:
 	* @brief Remove a drawable
 	* @param drawableToRemove Drawable to remove
 	*/
-	static void RemoveDrawable(const IDrawable* drawableToRemove);
+	static void RemoveDrawable(IDrawable* drawableToRemove);
+
+	/**
+	* @brief Recreate the render commands of a drawable before the next render
+	* @param drawable Drawable to update
+	*/
+	static void SetDrawableDirty(IDrawable& drawable);
+
+	/**
+	* @brief Recreate the render commands of the drawables using a file before the next render
+	* @param fileReference Loaded or unloaded file (only the mesh data and the materials change the commands)
+	*/
+	static void SetDrawablesDirty(const FileReference& fileReference);
 
 	/**
 	* @brief Add a lod
@@ -137,12 +156,21 @@ public:
 
 	static void DrawSubMesh(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const MeshData::SubMesh& subMesh, Material& material, RenderingSettings& renderSettings);
 
+	/**
+	* @brief Draw several instances of a submesh with one draw call (the renderer and the material's shader have to support instancing)
+	* @param subMesh The submesh to draw
+	* @param material The material to use
+	* @param renderSettings The rendering settings
+	* @param instances The matrices of each instance
+	* @param instanceCount The number of instances
+	*/
+	static void DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, Material& material, RenderingSettings& renderSettings, const RenderInstanceData* instances, size_t instanceCount);
+
 	static std::vector<std::weak_ptr<Camera>> cameras;
 	API static std::shared_ptr<Camera> usedCamera;
 	static bool needUpdateCamera;
 
 	static std::vector <IDrawable*> s_orderedIDrawable;
-	static std::vector<std::weak_ptr<Lod>> s_lods;
 
 	
 	static Shader* s_currentShader;
@@ -155,7 +183,6 @@ public:
 	static std::vector <Light*> s_directionalLights;
 	static void CreateLightLists();
 	static bool s_isLightUpdateNeeded;
-	static bool s_needUpdateUIOrdering;
 	static void SetIsGridRenderingEnabled(bool enabled);
 	[[nodiscard]] static bool IsGridRenderingEnabled();
 
@@ -171,13 +198,34 @@ private:
 	*/
 	static void DrawSkybox(const Vector3& cameraPosition);
 
+	/**
+	* @brief Draw one face of the skybox with a plane (used when the renderer can't draw the skybox with a cubemap)
+	*/
+	static void DrawSkyboxFace(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const MeshData::SubMesh& subMesh, Material& material, Texture* texture, RenderingSettings& renderSettings);
+
+	/**
+	* @brief Create the cube used to draw the skybox with a cubemap
+	*/
+	static void CreateSkyCube();
+
 	/**
 	* @brief Check lods
 	*/
 	static void CheckLods();
 
+	/**
+	* @brief Give the drawn texture and mesh to the ResidencyManager
+	* @return False if the mesh is evicted and can't be drawn this frame
+	*/
+	[[nodiscard]] static bool MarkAssetsUsed(const MeshData::SubMesh& subMesh, Texture* texture);
+
 	static void UpdateShadersCameraMatrices();
 
+	/**
+	* @brief Set the fixed function camera used by the debug lines and triangles (they do not support shaders)
+	*/
+	static void SetDebugDrawCamera();
+
 #if defined(EDITOR)
 	/**
 	* @brief Draw selected item bounding box
@@ -199,6 +247,10 @@ private:
 	static void DrawEditorTool(const Vector3& cameraPosition);
 #endif
 
+	// Drawables waiting for their render commands to be recreated
+	static std::vector<IDrawable*> s_dirtyDrawables;
+	static uint64_t s_nextDrawOrder;
+	// Drawables with a lower draw order are not in the drawable list anymore
+	static uint64_t s_firstDrawOrder;
 	static int s_iDrawablesCount;
-	static int s_lodsCount;
 };
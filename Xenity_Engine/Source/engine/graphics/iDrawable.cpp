@@ -16,5 +16,10 @@ void IDrawable::RemoveReferences()
 void IDrawable::SetOrderInLayer(int orderInLayer)
 {
 	m_orderInLayer = orderInLayer;
-	Graphics::s_needUpdateUIOrdering = true;
-}
\ No newline at end of file
+	SetRenderCommandsDirty();
+}
+
+void IDrawable::SetRenderCommandsDirty()
+{
+	Graphics::SetDrawableDirty(*this);
+}
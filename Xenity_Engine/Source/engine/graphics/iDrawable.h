@@ -11,6 +11,18 @@
 #include "render_command.h"
 
 class Material;
+class FileReference;
+
+/**
+* @brief Type of a drawable, to check the type of the drawable of a command without dynamic_cast
+*/
+enum class DrawableType : uint8_t
+{
+	Other = 0,
+	MeshRenderer = 1, // Also the classes inheriting from MeshRenderer
+	SpriteRenderer = 2,
+	ImageRenderer = 3, // Also the classes inheriting from ImageRenderer
+};
 
 class API IDrawable : public Component
 {
@@ -31,11 +43,25 @@ public:
 	*/
 	void SetOrderInLayer(int orderInLayer);
 
+	/**
+	* @brief Get the type of the drawable
+	*/
+	[[nodiscard]] DrawableType GetDrawableType() const
+	{
+		return m_drawableType;
+	}
+
 protected:
 	friend class Graphics;
+	friend class RenderBatch;
 
 	void RemoveReferences() override;
 
+	/**
+	* @brief Ask to recreate the render commands of this drawable before the next render
+	*/
+	void SetRenderCommandsDirty();
+
 	/**
 	* @brief Create the render commands
 	*/
@@ -46,7 +72,47 @@ protected:
 	*/
 	virtual void DrawCommand(const RenderCommand & renderCommand) = 0;
 
+	/**
+	* @brief Get if the render commands of this drawable depend on a file (mesh data or material), to recreate them when the file is loaded
+	*/
+	[[nodiscard]] virtual bool UsesFileReference(const FileReference& fileReference) const { return false; }
+
+	/**
+	* @brief Get if another command can be drawn in the same draw call (instanced or batched) as a command of this drawable
+	* @param renderCommand Command of this drawable
+	* @param otherCommand Command to check (from any drawable)
+	*/
+	[[nodiscard]] virtual bool IsInstanceCompatible(const RenderCommand& renderCommand, const RenderCommand& otherCommand) const { return false; }
+
+	/**
+	* @brief Draw several compatible commands with one draw call (instanced or batched), the first command is from this drawable
+	* @param renderCommands Commands to draw (see IsInstanceCompatible)
+	* @param commandCount Number of commands
+	* @return False if the commands were not drawn and have to be drawn one by one
+	*/
+	[[nodiscard]] virtual bool DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount) { return false; }
+
+	/**
+	* @brief Called once per frame before the camera renders, even if no camera renders this frame (only if m_useOnNewRender is true)
+	*/
+	virtual void OnNewFrame() {};
+
+	/**
+	* @brief Called before each camera render (only if m_useOnNewRender is true)
+	* @param cameraIndex Index of the camera among the cameras rendered this frame
+	*/
 	virtual void OnNewRender(int cameraIndex) {};
 
 	int m_orderInLayer = 0;
+	// Set to true in the constructor to receive the OnNewFrame and OnNewRender calls, the other drawables are skipped
+	bool m_useOnNewRender = false;
+	// Set in the constructor of the drawables with a type
+	DrawableType m_drawableType = DrawableType::Other;
+
+private:
+	// Position of the commands of this drawable in the render batch
+	std::vector<RenderCommandHandle> m_renderCommandHandles;
+	// Order of the drawable in the drawable list, 0 if not in the list (see Graphics::s_firstDrawOrder)
+	uint64_t m_drawOrder = 0;
+	bool m_isRenderCommandsDirty = false;
 };
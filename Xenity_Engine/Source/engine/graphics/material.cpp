@@ -22,6 +22,8 @@
 
 using ordered_json = nlohmann::ordered_json;
 
+uint64_t Material::s_uploadEpoch = 0;
+
 #pragma region Constructors / Destructor
 
 //ProfilerBenchmark* materialUpdateBenchmark = new ProfilerBenchmark("Material update");
@@ -38,11 +40,30 @@ Material::~Material()
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
 	AssetManager::RemoveMaterial(this);
-	Graphics::s_isRenderingBatchDirty = true;
+	// Only the commands of the drawables still using this material are recreated
+	Graphics::SetDrawablesDirty(*this);
 }
 
 #pragma endregion
 
+namespace
+{
+	template<typename T>
+	void SetUniformValue(std::vector<std::pair<ShaderUniformHandle, T>>& uniforms, const char* attribute, const T& value)
+	{
+		const ShaderUniformHandle uniform(attribute);
+		for (std::pair<ShaderUniformHandle, T>& kv : uniforms)
+		{
+			if (kv.first.GetHash() == uniform.GetHash())
+			{
+				kv.second = value;
+				return;
+			}
+		}
+		uniforms.emplace_back(uniform, value);
+	}
+}
+
 #pragma region Attributs setters
 
 /// <summary>
@@ -53,7 +74,8 @@ Material::~Material()
 void Material::SetAttribute(const char* attribute, const Vector2& value)
 {
 	XASSERT(strlen(attribute) != 0, "[Material::SetAttribute] attribute name is empty");
-	m_uniformsVector2.emplace(std::pair <const char*, Vector2>(attribute, value));
+	SetUniformValue(m_uniformsVector2, attribute, value);
+	InvalidateUniforms();
 }
 
 /// <summary>
@@ -64,7 +86,8 @@ void Material::SetAttribute(const char* attribute, const Vector2& value)
 void Material::SetAttribute(const char* attribute, const Vector3& value)
 {
 	XASSERT(strlen(attribute) != 0, "[Material::SetAttribute] attribute name is empty");
-	m_uniformsVector3.emplace(std::pair <const char*, Vector3>(attribute, value));
+	SetUniformValue(m_uniformsVector3, attribute, value);
+	InvalidateUniforms();
 }
 
 /// <summary>
@@ -75,7 +98,8 @@ void Material::SetAttribute(const char* attribute, const Vector3& value)
 void Material::SetAttribute(const char* attribute, const Vector4& value)
 {
 	XASSERT(strlen(attribute) != 0, "[Material::SetAttribute] attribute name is empty");
-	m_uniformsVector4.emplace(std::pair <const char*, Vector4>(attribute, value));
+	SetUniformValue(m_uniformsVector4, attribute, value);
+	InvalidateUniforms();
 }
 
 /// <summary>
@@ -96,7 +120,8 @@ void Material::SetAttribute(const char* attribute, const Vector4& value)
 void Material::SetAttribute(const char* attribute, const float value)
 {
 	XASSERT(strlen(attribute) != 0, "[Material::SetAttribute] attribute name is empty");
-	m_uniformsFloat.emplace(std::pair <const char*, float>(attribute, value));
+	SetUniformValue(m_uniformsFloat, attribute, value);
+	InvalidateUniforms();
 }
 
 /// <summary>
@@ -107,7 +132,8 @@ void Material::SetAttribute(const char* attribute, const float value)
 void Material::SetAttribute(const char* attribute, const int value)
 {
 	XASSERT(strlen(attribute) != 0, "[Material::SetAttribute] attribute name is empty");
-	m_uniformsInt.emplace(std::pair <const char*, int>(attribute, value));
+	SetUniformValue(m_uniformsInt, attribute, value);
+	InvalidateUniforms();
 }
 
 std::shared_ptr<Material> Material::MakeMaterial()
@@ -151,9 +177,16 @@ std::vector<uint64_t> Material::GetUsedFilesIds()
 /// <summary>
 /// Use the material to draw something
 /// </summary>
-void Material::Use()
+void Material::Use(bool useOctahedralNormals)
 {
-	const bool matChanged = Graphics::s_currentMaterial != this;
+	Shader* shader = m_shader.get();
+	if (useOctahedralNormals && shader && shader->m_octahedralNormalsVariant)
+	{
+		shader = shader->m_octahedralNormalsVariant.get();
+	}
+
+	// The same material can be used with the shader and its variant
+	const bool matChanged = Graphics::s_currentMaterial != this || Graphics::s_currentShader != shader;
 	const bool cameraChanged = m_lastUsedCamera != Graphics::usedCamera.get();
 	const bool drawTypeChanged = Graphics::s_currentMode != m_lastUpdatedType;
 
@@ -161,23 +194,13 @@ void Material::Use()
 	{
 		Graphics::s_currentMaterial = this;
 		SCOPED_PROFILER("Material::OnMaterialChanged", scopeBenchmark);
-		if (m_shader && m_shader->GetFileStatus() == FileStatus::FileStatus_Loaded)
+		if (shader && shader->GetFileStatus() == FileStatus::FileStatus_Loaded)
 		{
 			m_lastUsedCamera = Graphics::usedCamera.get();
 			m_lastUpdatedType = Graphics::s_currentMode;
 
-			m_shader->Use();
-			Update();
-
-			const int matCount = AssetManager::GetMaterialCount();
-			for (int i = 0; i < matCount; i++)
-			{
-				Material* mat = AssetManager::GetMaterial(i);
-				if (mat->m_shader == m_shader && mat != this)
-				{
-					mat->m_updated = false;
-				}
-			}
+			shader->Use();
+			Update(*shader);
 		}
 		else
 		{
@@ -187,20 +210,33 @@ void Material::Use()
 	}
 }
 
+bool Material::AreUniformsUpToDate(const Shader& shader) const
+{
+	return m_uploadedShader == &shader && m_uploadedEpoch == s_uploadEpoch && m_uploadedGeneration == shader.m_materialGeneration;
+}
+
 /// <summary>
 /// Update the material 
 /// </summary>
-void Material::Update()
+void Material::Update(Shader& shader)
 {
+	const bool isUpToDate = AreUniformsUpToDate(shader);
 	if (Graphics::usedCamera->IsEditor())
 	{
-		Performance::AddMaterialUpdate();
+		if (isUpToDate)
+		{
+			Performance::AddSkippedMaterialUpdate();
+		}
+		else
+		{
+			Performance::AddMaterialUpdate();
+		}
 	}
 
 	//Send all uniforms
-	if (!m_updated)
+	if (!isUpToDate)
 	{
-		m_shader->SetShaderOffsetAndTiling(t_offset, t_tiling);
+		shader.SetShaderOffsetAndTiling(t_offset, t_tiling);
 		//if(m_renderingMode == MaterialRenderingMode::Cutout)
 		//	m_shader->SetAlphaThreshold(m_alphaCutoff);
 		//else
@@ -217,26 +253,30 @@ void Material::Update()
 		}*/
 		for (const auto& kv : m_uniformsVector2)
 		{
-			m_shader->SetShaderAttribut(kv.first, kv.second);
+			shader.SetShaderAttribut(kv.first, kv.second);
 		}
 		for (const auto& kv : m_uniformsVector3)
 		{
-			m_shader->SetShaderAttribut(kv.first, kv.second);
+			shader.SetShaderAttribut(kv.first, kv.second);
 		}
 		for (auto& kv : m_uniformsVector4)
 		{
-			m_shader->SetShaderAttribut(kv.first, kv.second);
+			shader.SetShaderAttribut(kv.first, kv.second);
 		}
 		for (const auto& kv : m_uniformsInt)
 		{
-			m_shader->SetShaderAttribut(kv.first, kv.second);
+			shader.SetShaderAttribut(kv.first, kv.second);
 		}
 		for (const auto& kv : m_uniformsFloat)
 		{
-			m_shader->SetShaderAttribut(kv.first, kv.second);
+			shader.SetShaderAttribut(kv.first, kv.second);
 		}
 
-		m_updated = true;
+		// The other materials using this shader are now outdated
+		shader.m_materialGeneration++;
+		m_uploadedShader = &shader;
+		m_uploadedGeneration = shader.m_materialGeneration;
+		m_uploadedEpoch = s_uploadEpoch;
 	}
 }
 
@@ -271,7 +311,7 @@ void Material::OnReflectionUpdated()
 	SetAlphaCutoff(m_alphaCutoff);
 
 #if defined(EDITOR)
-	Graphics::s_isRenderingBatchDirty = true;
+	Graphics::SetDrawablesDirty(*this);
 
 	ordered_json jsonData;
 	jsonData["Values"] = ReflectionUtils::ReflectiveDataToJson(GetReflectiveData());
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <vector>
 #include <string>
 #include <memory>
 
@@ -18,6 +18,7 @@
 #include <engine/reflection/reflection.h>
 #include <engine/graphics/material_rendering_mode.h>
 #include "iDrawableTypes.h"
+#include <engine/graphics/shader/shader_uniform_handle.h>
 
 class Texture;
 class Shader;
@@ -46,7 +47,7 @@ public:
 	void SetShader(const std::shared_ptr<Shader>& shader)
 	{
 		m_shader = shader;
-		m_updated = false;
+		InvalidateUniforms();
 	}
 
 	/**
@@ -181,8 +182,11 @@ protected:
 	friend class ProjectManager;
 	friend class Graphics;
 
-	// [Internal]
-	void Use();
+	/**
+	* [Internal] Use the shader of the material and send the uniforms if needed
+	* @param useOctahedralNormals True to use the OCTAHEDRAL_NORMALS variant of the shader (if the shader has one)
+	*/
+	void Use(bool useOctahedralNormals = false);
 
 	ReflectiveData GetReflectiveData() override;
 	ReflectiveData GetMetaReflectiveData(AssetPlatform platform) override;
@@ -194,15 +198,38 @@ protected:
 
 	/**
 	* @brief Update the material
+	* @param shader Shader of the material or one of its variants
+	*/
+	void Update(Shader& shader);
+
+	/**
+	* @brief Get if the uniforms of the material are still the ones in the shader
+	*/
+	[[nodiscard]] bool AreUniformsUpToDate(const Shader& shader) const;
+
+	/**
+	* @brief Force the next Update to send the uniforms of the material
 	*/
-	void Update();
+	void InvalidateUniforms()
+	{
+		m_uploadedShader = nullptr;
+	}
+
+	/**
+	* @brief Force the next Update of every material to send its uniforms
+	*/
+	static void InvalidateAllUniforms()
+	{
+		s_uploadEpoch++;
+	}
 
 	Camera* m_lastUsedCamera = nullptr;
-	std::unordered_map <const char*, Vector2> m_uniformsVector2;
-	std::unordered_map <const char*, Vector3> m_uniformsVector3;
-	std::unordered_map <const char*, Vector4> m_uniformsVector4;
-	std::unordered_map <const char*, int> m_uniformsInt;
-	std::unordered_map <const char*, float> m_uniformsFloat;
+	// Uniform handles are created once in SetAttribute to not hash the names on each update
+	std::vector<std::pair<ShaderUniformHandle, Vector2>> m_uniformsVector2;
+	std::vector<std::pair<ShaderUniformHandle, Vector3>> m_uniformsVector3;
+	std::vector<std::pair<ShaderUniformHandle, Vector4>> m_uniformsVector4;
+	std::vector<std::pair<ShaderUniformHandle, int>> m_uniformsInt;
+	std::vector<std::pair<ShaderUniformHandle, float>> m_uniformsFloat;
 
 	std::shared_ptr<Shader> m_shader = nullptr;
 	std::shared_ptr<Texture> m_texture;
@@ -212,7 +239,11 @@ protected:
 	IDrawableTypes m_lastUpdatedType = IDrawableTypes::Draw_3D;
 	MaterialRenderingMode m_renderingMode = MaterialRenderingMode::Opaque;
 	float m_alphaCutoff = 0.5f;
-	bool m_updated = false;
+	// Shader, shader generation and epoch of the last uniforms upload
+	const Shader* m_uploadedShader = nullptr;
+	uint64_t m_uploadedGeneration = 0;
+	uint64_t m_uploadedEpoch = 0;
+	static uint64_t s_uploadEpoch;
 	bool m_useLighting = false; // Defines if the material uses lighting or not in fixed pipeline mode (PSP)
 
 	static constexpr int s_version = 1;
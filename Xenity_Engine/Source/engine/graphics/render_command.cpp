@@ -5,3 +5,308 @@
 // This file is part of Xenity Engine
 
 #include "render_command.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include <engine/graphics/material.h>
+#include <engine/graphics/iDrawable.h>
+#include <engine/graphics/shader/shader.h>
+#include <engine/graphics/texture/texture.h>
+#include <engine/game_elements/transform.h>
+#include <engine/assertions/assertions.h>
+
+namespace
+{
+	constexpr uint32_t s_depthFirstShift = RenderSortKey::s_layerShift - RenderSortKey::s_depthBits;
+
+	RenderPass GetPass(uint64_t key)
+	{
+		return static_cast<RenderPass>(key >> RenderSortKey::s_passShift);
+	}
+}
+
+uint64_t RenderSortKey::Make(RenderPass pass, const RenderCommand& command)
+{
+	uint64_t shaderId = 0;
+	uint64_t materialId = 0;
+	uint64_t textureId = 0;
+	if (command.material)
+	{
+		materialId = FoldId(command.material->GetFileId(), s_materialBits);
+		if (command.material->GetShader())
+		{
+			shaderId = FoldId(command.material->GetShader()->GetFileId(), s_shaderBits);
+		}
+		if (command.material->GetTexture())
+		{
+			textureId = FoldId(command.material->GetTexture()->GetFileId(), s_textureBits);
+		}
+	}
+
+	uint64_t meshId = 0;
+	if (command.subMesh)
+	{
+		// Identify the submesh (not only its mesh) to put the same submeshes next to each other (used by the instanced draws)
+		// The meshes created at runtime do not have a file id, their submesh address is used
+		const uint64_t meshFileId = command.subMesh->m_meshData ? command.subMesh->m_meshData->GetFileId() : static_cast<uint64_t>(-1);
+		uint64_t subMeshId = 0;
+		if (meshFileId != static_cast<uint64_t>(-1))
+		{
+			subMeshId = (meshFileId << 8) ^ command.subMesh->m_subMeshIndex;
+		}
+		else
+		{
+			subMeshId = reinterpret_cast<uintptr_t>(command.subMesh) >> 4;
+		}
+		meshId = FoldId(subMeshId, s_meshBits);
+	}
+
+	int layer = 0;
+	if (command.drawable)
+	{
+		layer = command.drawable->GetOrderInLayer();
+	}
+	// Center the layer range around 0
+	const uint64_t clampedLayer = static_cast<uint64_t>(std::clamp(layer + (1 << (s_layerBits - 1)), 0, (1 << s_layerBits) - 1));
+
+	const uint64_t state = (shaderId << (s_materialBits + s_textureBits + s_meshBits)) |
+		(materialId << (s_textureBits + s_meshBits)) |
+		(textureId << s_meshBits) |
+		meshId;
+
+	uint64_t key = (static_cast<uint64_t>(pass) << s_passShift) | (clampedLayer << s_layerShift);
+	if (IsDepthFirst(pass))
+	{
+		key |= state;
+	}
+	else
+	{
+		key |= state << s_depthBits;
+	}
+	return key;
+}
+
+uint64_t RenderSortKey::MakeUI(int orderInLayer, uint64_t drawOrder)
+{
+	// Flip the sign bit to keep the order between negative and positive values
+	const uint64_t layer = static_cast<uint32_t>(orderInLayer) ^ 0x80000000u;
+	const uint64_t drawOrderMask = (1ULL << s_uiDrawOrderBits) - 1;
+	return (static_cast<uint64_t>(RenderPass::UI) << s_passShift) | (layer << s_uiDrawOrderBits) | (drawOrder & drawOrderMask);
+}
+
+uint64_t RenderSortKey::MakeSprite(uint64_t drawOrder)
+{
+	const uint64_t drawOrderMask = (1ULL << s_passShift) - 1;
+	return (static_cast<uint64_t>(RenderPass::Sprite) << s_passShift) | (drawOrder & drawOrderMask);
+}
+
+uint64_t RenderSortKey::SetDepth(uint64_t key, uint16_t depth)
+{
+	const RenderPass pass = GetPass(key);
+	uint64_t depthValue = depth;
+	if (pass == RenderPass::Transparent)
+	{
+		// Back to front
+		depthValue = s_depthMask - depthValue;
+	}
+
+	if (IsDepthFirst(pass))
+	{
+		return (key & ~(s_depthMask << s_depthFirstShift)) | (depthValue << s_depthFirstShift);
+	}
+	else
+	{
+		return (key & ~s_depthMask) | depthValue;
+	}
+}
+
+uint16_t RenderSortKey::QuantizeDepth(float squaredDistance)
+{
+	if (!(squaredDistance > 0))
+	{
+		return 0;
+	}
+
+	// The bits of a positive float are ordered like the float values,
+	// keep the exponent and the highest bits of the mantissa (the sign bit is always 0)
+	uint32_t bits = 0;
+	memcpy(&bits, &squaredDistance, sizeof(float));
+	return static_cast<uint16_t>(bits >> 15);
+}
+
+void RenderSortKey::Sort(std::vector<RenderSortEntry>& entries, size_t count, std::vector<RenderSortEntry>& buffer)
+{
+	if (count <= 1)
+	{
+		return;
+	}
+
+	XASSERT(count <= entries.size(), "[RenderSortKey::Sort] count is larger than the entry list");
+
+	// Count all the bytes in one pass
+	constexpr size_t byteCount = sizeof(uint64_t);
+	size_t histograms[byteCount][256];
+	memset(histograms, 0, sizeof(histograms));
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint64_t key = entries[i].sortKey;
+		for (size_t byteIndex = 0; byteIndex < byteCount; byteIndex++)
+		{
+			histograms[byteIndex][(key >> (byteIndex * 8)) & 0xFF]++;
+		}
+	}
+
+	if (buffer.size() < count)
+	{
+		buffer.resize(count);
+	}
+
+	RenderSortEntry* source = entries.data();
+	RenderSortEntry* destination = buffer.data();
+	for (size_t byteIndex = 0; byteIndex < byteCount; byteIndex++)
+	{
+		size_t* histogram = histograms[byteIndex];
+
+		// Skip the byte if all the keys have the same value
+		if (histogram[(source[0].sortKey >> (byteIndex * 8)) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		size_t offset = 0;
+		for (size_t bucket = 0; bucket < 256; bucket++)
+		{
+			const size_t bucketSize = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketSize;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const size_t bucket = (source[i].sortKey >> (byteIndex * 8)) & 0xFF;
+			destination[histogram[bucket]++] = source[i];
+		}
+
+		std::swap(source, destination);
+	}
+
+	// Copy back the result if the last pass has written in the buffer
+	if (source != entries.data())
+	{
+		std::copy(source, source + count, entries.data());
+	}
+}
+
+uint32_t RenderQueue::Add(const RenderCommand& command)
+{
+	uint32_t slot;
+	if (!m_freeSlots.empty())
+	{
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		commands[slot] = command;
+	}
+	else
+	{
+		slot = static_cast<uint32_t>(commands.size());
+		commands.push_back(command);
+	}
+	commandCount++;
+	isDrawOrderDirty = true;
+	return slot;
+}
+
+void RenderQueue::Remove(uint32_t slot)
+{
+	XASSERT(slot < commands.size(), "[RenderQueue::Remove] slot is out of range");
+	XASSERT(commands[slot].drawable != nullptr, "[RenderQueue::Remove] slot is already free");
+
+	commands[slot] = RenderCommand();
+	m_freeSlots.push_back(slot);
+	commandCount--;
+	isDrawOrderDirty = true;
+}
+
+void RenderQueue::Clear()
+{
+	commands.clear();
+	drawOrder.clear();
+	m_freeSlots.clear();
+	commandCount = 0;
+	isDrawOrderDirty = true;
+}
+
+void RenderBatch::AddCommand(RenderPass pass, const RenderCommand& command)
+{
+	XASSERT(command.drawable != nullptr, "[RenderBatch::AddCommand] command.drawable is nullptr");
+
+	RenderCommand newCommand = command;
+	switch (pass)
+	{
+	case RenderPass::Opaque:
+	case RenderPass::Transparent:
+		newCommand.sortKey = RenderSortKey::Make(pass, command);
+		break;
+	case RenderPass::Sprite:
+		newCommand.sortKey = RenderSortKey::MakeSprite(command.drawable->m_drawOrder);
+		break;
+	case RenderPass::UI:
+		newCommand.sortKey = RenderSortKey::MakeUI(command.drawable->GetOrderInLayer(), command.drawable->m_drawOrder);
+		break;
+	}
+
+	RenderCommandHandle handle;
+	handle.pass = pass;
+	handle.slot = GetQueue(pass).Add(newCommand);
+	command.drawable->m_renderCommandHandles.push_back(handle);
+}
+
+void RenderBatch::RemoveCommands(IDrawable& drawable)
+{
+	// Free the slots in reverse order to get the same slots back in the same order when the commands are added again
+	const size_t handleCount = drawable.m_renderCommandHandles.size();
+	for (size_t i = handleCount; i > 0; i--)
+	{
+		const RenderCommandHandle& handle = drawable.m_renderCommandHandles[i - 1];
+		GetQueue(handle.pass).Remove(handle.slot);
+	}
+	drawable.m_renderCommandHandles.clear();
+}
+
+void RenderBatch::UpdateDrawOrder(RenderPass pass, const Vector3& camPos)
+{
+	RenderQueue& queue = GetQueue(pass);
+	const bool useDepth = pass == RenderPass::Opaque || pass == RenderPass::Transparent;
+
+	// The sprite and UI orders only change when commands are added or removed
+	if (!useDepth && !queue.isDrawOrderDirty)
+	{
+		return;
+	}
+	queue.isDrawOrderDirty = false;
+
+	queue.drawOrder.clear();
+	const size_t slotCount = queue.commands.size();
+	for (size_t slot = 0; slot < slotCount; slot++)
+	{
+		const RenderCommand& command = queue.commands[slot];
+		if (!command.drawable || !command.isEnabled)
+		{
+			continue;
+		}
+
+		RenderSortEntry entry;
+		entry.slot = static_cast<uint32_t>(slot);
+		entry.sortKey = command.sortKey;
+		if (useDepth)
+		{
+			const Vector3 delta = command.transform->GetPosition() - camPos;
+			const float squaredDistance = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+			entry.sortKey = RenderSortKey::SetDepth(entry.sortKey, RenderSortKey::QuantizeDepth(squaredDistance));
+		}
+		queue.drawOrder.push_back(entry);
+	}
+
+	RenderSortKey::Sort(queue.drawOrder, queue.drawOrder.size(), m_sortBuffer);
+}
@@ -6,13 +6,27 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
+#include <engine/api.h>
 #include <engine/graphics/3d_graphics/mesh_data.h>
 #include <engine/constants.h>
 
 class Material;
 class IDrawable;
+class Vector3;
+
+/**
+* @brief Rendering pass of a command, stored in the highest bits of the sort key
+*/
+enum class RenderPass : uint8_t
+{
+	Opaque = 0,
+	Transparent = 1,
+	Sprite = 2,
+	UI = 3,
+};
 
 class RenderCommand
 {
@@ -21,55 +35,208 @@ public:
 	Material* material = nullptr;
 	const MeshData::SubMesh* subMesh = nullptr;
 	IDrawable* drawable = nullptr;
-	bool isEnabled;
+	// Packed sort key (see RenderSortKey), the depth part is updated for each camera
+	uint64_t sortKey = 0;
+	bool isEnabled = false;
 };
 
-class RenderQueue 
+/**
+* @brief Sort key and slot of a command, used to sort the commands without moving them
+*/
+struct RenderSortEntry
 {
-public:
-	std::vector<RenderCommand> commands;
-	int commandIndex = 0;
+	uint64_t sortKey = 0;
+	uint32_t slot = 0;
 };
 
-class RenderBatch
+/**
+* @brief [Internal] Build and sort the packed 64 bits sort keys of the render commands
+*
+* Layout (from the highest bit):
+* pass (2 bits) | layer (6 bits) | depth (16 bits) and state (40 bits) in an order depending of the pass
+* state: shader (8 bits) | material (12 bits) | texture (10 bits) | submesh (10 bits)
+* Opaque commands are sorted by state then front to back (unless ENABLE_OVERDRAW_OPTIMIZATION is defined),
+* transparent commands are sorted back to front then by state.
+* UI commands use the full order in layer instead of the depth and state, sprite commands are kept in the drawables order.
+*/
+class API RenderSortKey
 {
 public:
-	// uint64_t = material id
-	std::unordered_map<uint64_t, RenderQueue> renderQueues;
-#if defined(ENABLE_OVERDRAW_OPTIMIZATION)
-	std::vector<RenderCommand> opaqueMeshCommands;
-#endif
-	std::vector<RenderCommand> transparentMeshCommands;
-	std::vector<RenderCommand> spriteCommands;
-	std::vector<RenderCommand> uiCommands;
+	static constexpr uint32_t s_passBits = 2;
+	static constexpr uint32_t s_layerBits = 6;
+	static constexpr uint32_t s_depthBits = 16;
+	static constexpr uint32_t s_shaderBits = 8;
+	static constexpr uint32_t s_materialBits = 12;
+	static constexpr uint32_t s_textureBits = 10;
+	static constexpr uint32_t s_meshBits = 10;
+	static constexpr uint32_t s_stateBits = s_shaderBits + s_materialBits + s_textureBits + s_meshBits;
+
+	static constexpr uint32_t s_passShift = 64 - s_passBits;
+	static constexpr uint32_t s_layerShift = s_passShift - s_layerBits;
+
+	static constexpr uint64_t s_depthMask = (1ULL << s_depthBits) - 1;
+	static constexpr uint64_t s_stateMask = (1ULL << s_stateBits) - 1;
+	static constexpr uint32_t s_uiDrawOrderBits = 30;
+
+	/**
+	* @brief Create the sort key of a command without the depth part
+	* @param pass Rendering pass of the command
+	* @param command Command to use
+	*/
+	[[nodiscard]] static uint64_t Make(RenderPass pass, const RenderCommand& command);
+
+	/**
+	* @brief Create the sort key of an UI command (ordered by order in layer then by drawable order)
+	* @param orderInLayer Order in layer of the UI element
+	* @param drawOrder Order of the drawable in the drawable list
+	*/
+	[[nodiscard]] static uint64_t MakeUI(int orderInLayer, uint64_t drawOrder);
+
+	/**
+	* @brief Create the sort key of a sprite command (ordered by drawable order)
+	* @param drawOrder Order of the drawable in the drawable list
+	*/
+	[[nodiscard]] static uint64_t MakeSprite(uint64_t drawOrder);
+
+	/**
+	* @brief Replace the depth part of a sort key
+	* @param key Key to update
+	* @param depth Quantized depth (see QuantizeDepth)
+	*/
+	[[nodiscard]] static uint64_t SetDepth(uint64_t key, uint16_t depth);
+
+	/**
+	* @brief Quantize a squared distance to 16 bits, the order between values is kept
+	* @param squaredDistance Squared distance between the camera and the object (>= 0)
+	*/
+	[[nodiscard]] static uint16_t QuantizeDepth(float squaredDistance);
+
+	/**
+	* @brief Get if the depth part of the key has a higher priority than the state part
+	* @param pass Rendering pass
+	*/
+	[[nodiscard]] static constexpr bool IsDepthFirst(RenderPass pass)
+	{
 #if defined(ENABLE_OVERDRAW_OPTIMIZATION)
-	size_t opaqueMeshCommandIndex = 0;
+		return pass != RenderPass::UI;
+#else
+		return pass == RenderPass::Transparent;
 #endif
-	size_t transparentMeshCommandIndex = 0;
-	size_t spriteCommandIndex = 0;
-	size_t uiCommandIndex = 0;
+	}
+
+	/**
+	* @brief Fold an id to a smaller number of bits, equal ids always give the same result
+	* @param id Id to fold
+	* @param bitCount Number of bits of the result
+	*/
+	[[nodiscard]] static constexpr uint64_t FoldId(uint64_t id, uint32_t bitCount)
+	{
+		uint64_t result = 0;
+		while (id != 0)
+		{
+			result ^= id;
+			id >>= bitCount;
+		}
+		return result & ((1ULL << bitCount) - 1);
+	}
+
+	/**
+	* @brief Sort entries by their sort key (ascending), the sort is stable
+	* @param entries Entries to sort
+	* @param count Number of entries to sort from the beginning of the list
+	* @param buffer Temporary buffer reused between sorts
+	*/
+	static void Sort(std::vector<RenderSortEntry>& entries, size_t count, std::vector<RenderSortEntry>& buffer);
+};
+
+/**
+* @brief Position of a command in the render batch, kept by the drawable to update its commands in place
+*/
+struct RenderCommandHandle
+{
+	RenderPass pass = RenderPass::Opaque;
+	uint32_t slot = 0;
+};
+
+/**
+* @brief Commands of one rendering pass
+* Commands are stored in slots that do not move, removed commands leave a free slot that is reused by the next added command
+*/
+class API RenderQueue
+{
+public:
+	std::vector<RenderCommand> commands;
+	// Slots of the enabled commands, sorted by sort key
+	std::vector<RenderSortEntry> drawOrder;
+	size_t commandCount = 0;
+	bool isDrawOrderDirty = true;
 
 	/**
-	* @brief Reset the render batch
+	* @brief Add a command in a free slot
+	* @return Slot of the command
+	*/
+	[[nodiscard]] uint32_t Add(const RenderCommand& command);
+
+	/**
+	* @brief Free the slot of a command
+	*/
+	void Remove(uint32_t slot);
+
+	/**
+	* @brief Remove all commands
+	*/
+	void Clear();
+
+private:
+	std::vector<uint32_t> m_freeSlots;
+};
+
+class API RenderBatch
+{
+public:
+	static constexpr size_t s_passCount = 4;
+
+	/**
+	* @brief Get the commands of a pass
+	*/
+	[[nodiscard]] RenderQueue& GetQueue(RenderPass pass)
+	{
+		return m_queues[static_cast<size_t>(pass)];
+	}
+
+	/**
+	* @brief Add a command to a pass and keep its position in the command's drawable
+	* @param pass Rendering pass of the command
+	* @param command Command to add (the drawable should be set)
+	*/
+	void AddCommand(RenderPass pass, const RenderCommand& command);
+
+	/**
+	* @brief Remove all the commands of a drawable
+	*/
+	void RemoveCommands(IDrawable& drawable);
+
+	/**
+	* @brief Rebuild the draw order of a pass from the sort keys of the enabled commands
+	* @param pass Rendering pass to order
+	* @param camPos Camera position used to update the depth of the sort keys (ignored by the UI and sprite passes)
+	*/
+	void UpdateDrawOrder(RenderPass pass, const Vector3& camPos);
+
+	/**
+	* @brief Reset the render batch (does not access the drawables)
 	*/
 	void Reset()
 	{
-		for (auto& renderQueue : renderQueues)
+		for (RenderQueue& queue : m_queues)
 		{
-			renderQueue.second.commands.clear();
-			renderQueue.second.commandIndex = 0;
+			queue.Clear();
 		}
-#if defined(ENABLE_OVERDRAW_OPTIMIZATION)
-		opaqueMeshCommandIndex = 0;
-#endif
-		transparentMeshCommandIndex = 0;
-		spriteCommandIndex = 0;
-		uiCommandIndex = 0;
-#if defined(ENABLE_OVERDRAW_OPTIMIZATION)
-		opaqueMeshCommands.clear();
-#endif
-		transparentMeshCommands.clear();
-		spriteCommands.clear();
-		uiCommands.clear();
 	}
-};
\ No newline at end of file
+
+private:
+	RenderQueue m_queues[s_passCount];
+
+	// Temporary buffer used by the sort
+	std::vector<RenderSortEntry> m_sortBuffer;
+};
@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
+#include "opengl_state_cache.h"
+
+#include <cstring>
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+#include <glad/gl.h>
+#elif defined(__vita__)
+#include <vitaGL.h>
+#endif
+
+#include <engine/debug/performance.h>
+
+OpenGLStateCache::CachedValue<unsigned int> OpenGLStateCache::s_program;
+OpenGLStateCache::CachedValue<unsigned int> OpenGLStateCache::s_vertexArray;
+OpenGLStateCache::CachedValue<unsigned int> OpenGLStateCache::s_buffers[s_bufferTargetCount];
+OpenGLStateCache::CachedValue<unsigned int> OpenGLStateCache::s_texture2D;
+OpenGLStateCache::CachedValue<bool> OpenGLStateCache::s_capabilities[s_capabilityCount];
+OpenGLStateCache::CachedValue<bool> OpenGLStateCache::s_depthMask;
+OpenGLStateCache::CachedValue<uint64_t> OpenGLStateCache::s_depthRange;
+OpenGLStateCache::CachedValue<unsigned int> OpenGLStateCache::s_frontFace;
+OpenGLStateCache::CachedValue<uint64_t> OpenGLStateCache::s_blendFunc;
+OpenGLStateCache::CachedValue<uint64_t> OpenGLStateCache::s_alphaFunc;
+OpenGLStateCache::CachedValue<unsigned int> OpenGLStateCache::s_polygonMode;
+
+namespace
+{
+	uint64_t PackValues(uint32_t a, uint32_t b)
+	{
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+
+	uint32_t FloatBits(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+}
+
+template<typename T>
+bool OpenGLStateCache::UpdateValue(T& cachedValue, bool& isKnown, const T& newValue)
+{
+	if (isKnown && cachedValue == newValue)
+	{
+		Performance::AddFilteredStateChange();
+		return false;
+	}
+
+	cachedValue = newValue;
+	isKnown = true;
+	Performance::AddIssuedStateChange();
+	return true;
+}
+
+int OpenGLStateCache::GetCapabilityIndex(unsigned int capability)
+{
+	switch (capability)
+	{
+	case GL_DEPTH_TEST:
+		return 0;
+	case GL_BLEND:
+		return 1;
+	case GL_ALPHA_TEST:
+		return 2;
+	case GL_LIGHTING:
+		return 3;
+	case GL_TEXTURE_2D:
+		return 4;
+	case GL_CULL_FACE:
+		return 5;
+	default:
+		return -1;
+	}
+}
+
+int OpenGLStateCache::GetBufferTargetIndex(unsigned int target)
+{
+	switch (target)
+	{
+	case GL_ARRAY_BUFFER:
+		return 0;
+	case GL_ELEMENT_ARRAY_BUFFER:
+		return 1;
+	case GL_UNIFORM_BUFFER:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+void OpenGLStateCache::Reset()
+{
+	s_program.isKnown = false;
+	s_vertexArray.isKnown = false;
+	for (CachedValue<unsigned int>& buffer : s_buffers)
+	{
+		buffer.isKnown = false;
+	}
+	s_texture2D.isKnown = false;
+	for (CachedValue<bool>& capability : s_capabilities)
+	{
+		capability.isKnown = false;
+	}
+	s_depthMask.isKnown = false;
+	s_depthRange.isKnown = false;
+	s_frontFace.isKnown = false;
+	s_blendFunc.isKnown = false;
+	s_alphaFunc.isKnown = false;
+	s_polygonMode.isKnown = false;
+}
+
+void OpenGLStateCache::UseProgram(unsigned int programId)
+{
+	if (UpdateValue(s_program.value, s_program.isKnown, programId))
+	{
+		glUseProgram(programId);
+	}
+}
+
+void OpenGLStateCache::BindVertexArray(unsigned int vertexArrayId)
+{
+	if (UpdateValue(s_vertexArray.value, s_vertexArray.isKnown, vertexArrayId))
+	{
+		glBindVertexArray(vertexArrayId);
+		// The element array buffer binding is stored in the vertex array
+		s_buffers[GetBufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)].isKnown = false;
+	}
+}
+
+void OpenGLStateCache::BindBuffer(unsigned int target, unsigned int bufferId)
+{
+	const int targetIndex = GetBufferTargetIndex(target);
+	if (targetIndex == -1)
+	{
+		Performance::AddIssuedStateChange();
+		glBindBuffer(target, bufferId);
+		return;
+	}
+
+	CachedValue<unsigned int>& buffer = s_buffers[targetIndex];
+	if (UpdateValue(buffer.value, buffer.isKnown, bufferId))
+	{
+		glBindBuffer(target, bufferId);
+	}
+}
+
+bool OpenGLStateCache::BindTexture(unsigned int target, unsigned int textureId)
+{
+	if (target != GL_TEXTURE_2D)
+	{
+		Performance::AddIssuedStateChange();
+		glBindTexture(target, textureId);
+		return true;
+	}
+
+	if (UpdateValue(s_texture2D.value, s_texture2D.isKnown, textureId))
+	{
+		glBindTexture(target, textureId);
+		return true;
+	}
+	return false;
+}
+
+void OpenGLStateCache::SetEnabled(unsigned int capability, bool enabled)
+{
+	const int capabilityIndex = GetCapabilityIndex(capability);
+	if (capabilityIndex != -1)
+	{
+		CachedValue<bool>& cachedCapability = s_capabilities[capabilityIndex];
+		if (!UpdateValue(cachedCapability.value, cachedCapability.isKnown, enabled))
+		{
+			return;
+		}
+	}
+	else
+	{
+		Performance::AddIssuedStateChange();
+	}
+
+	if (enabled)
+	{
+		glEnable(capability);
+	}
+	else
+	{
+		glDisable(capability);
+	}
+}
+
+void OpenGLStateCache::SetDepthMask(bool enabled)
+{
+	if (UpdateValue(s_depthMask.value, s_depthMask.isKnown, enabled))
+	{
+		glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+}
+
+void OpenGLStateCache::SetDepthRange(float nearValue, float farValue)
+{
+	if (UpdateValue(s_depthRange.value, s_depthRange.isKnown, PackValues(FloatBits(nearValue), FloatBits(farValue))))
+	{
+		glDepthRange(nearValue, farValue);
+	}
+}
+
+void OpenGLStateCache::SetFrontFace(unsigned int mode)
+{
+	if (UpdateValue(s_frontFace.value, s_frontFace.isKnown, mode))
+	{
+		glFrontFace(mode);
+	}
+}
+
+void OpenGLStateCache::SetBlendFunc(unsigned int source, unsigned int destination)
+{
+	if (UpdateValue(s_blendFunc.value, s_blendFunc.isKnown, PackValues(source, destination)))
+	{
+		glBlendFunc(source, destination);
+	}
+}
+
+void OpenGLStateCache::SetAlphaFunc(unsigned int function, float reference)
+{
+	if (UpdateValue(s_alphaFunc.value, s_alphaFunc.isKnown, PackValues(function, FloatBits(reference))))
+	{
+		glAlphaFunc(function, reference);
+	}
+}
+
+void OpenGLStateCache::SetPolygonMode(unsigned int mode)
+{
+	if (UpdateValue(s_polygonMode.value, s_polygonMode.isKnown, mode))
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, mode);
+	}
+}
+
+void OpenGLStateCache::DeleteProgram(unsigned int programId)
+{
+	glDeleteProgram(programId);
+	if (s_program.value == programId)
+	{
+		s_program.isKnown = false;
+	}
+}
+
+void OpenGLStateCache::DeleteTexture(unsigned int textureId)
+{
+	glDeleteTextures(1, &textureId);
+	// The id can be reused by the next created texture
+	if (s_texture2D.value == textureId)
+	{
+		s_texture2D.isKnown = false;
+	}
+}
+
+void OpenGLStateCache::DeleteBuffer(unsigned int bufferId)
+{
+	glDeleteBuffers(1, &bufferId);
+	for (CachedValue<unsigned int>& buffer : s_buffers)
+	{
+		if (buffer.value == bufferId)
+		{
+			buffer.isKnown = false;
+		}
+	}
+}
+
+void OpenGLStateCache::DeleteVertexArray(unsigned int vertexArrayId)
+{
+	glDeleteVertexArrays(1, &vertexArrayId);
+	if (s_vertexArray.value == vertexArrayId)
+	{
+		s_vertexArray.isKnown = false;
+		s_buffers[GetBufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)].isKnown = false;
+	}
+}
+
+#endif
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
+
+#include <cstdint>
+
+/**
+* @brief Cache of the OpenGL bindings and render states, calls that would not change the state are not sent to the driver
+*
+* All the code binding programs, vertex arrays, buffers or textures (or changing the cached states) has to go through this class,
+* otherwise the cache has to be reset with Reset().
+* The number of sent and filtered calls is added to the Performance counters.
+*/
+class OpenGLStateCache
+{
+public:
+	/**
+	* @brief Forget all the cached values, the next call of each function will be sent
+	*/
+	static void Reset();
+
+	/**
+	* @brief Use a shader program (glUseProgram)
+	*/
+	static void UseProgram(unsigned int programId);
+
+	/**
+	* @brief Bind a vertex array (glBindVertexArray), the element array buffer binding is part of the vertex array
+	*/
+	static void BindVertexArray(unsigned int vertexArrayId);
+
+	/**
+	* @brief Bind a buffer (glBindBuffer), GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER and GL_UNIFORM_BUFFER are cached
+	*/
+	static void BindBuffer(unsigned int target, unsigned int bufferId);
+
+	/**
+	* @brief Bind a texture on the active texture unit (glBindTexture), GL_TEXTURE_2D is cached
+	* @return True if the bind call was sent (the texture was not already bound)
+	*/
+	static bool BindTexture(unsigned int target, unsigned int textureId);
+
+	/**
+	* @brief Enable or disable a capability (glEnable/glDisable)
+	*/
+	static void SetEnabled(unsigned int capability, bool enabled);
+
+	static void SetDepthMask(bool enabled);
+	static void SetDepthRange(float nearValue, float farValue);
+	static void SetFrontFace(unsigned int mode);
+	static void SetBlendFunc(unsigned int source, unsigned int destination);
+	static void SetAlphaFunc(unsigned int function, float reference);
+	static void SetPolygonMode(unsigned int mode);
+
+	/**
+	* @brief Delete programs/textures/buffers/vertex arrays and forget them if they were bound (their ids can be reused)
+	*/
+	static void DeleteProgram(unsigned int programId);
+	static void DeleteTexture(unsigned int textureId);
+	static void DeleteBuffer(unsigned int bufferId);
+	static void DeleteVertexArray(unsigned int vertexArrayId);
+
+private:
+	/**
+	* @brief Compare a cached value with a new one and update the counters
+	* @return True if the value has changed and the call has to be sent
+	*/
+	template<typename T>
+	[[nodiscard]] static bool UpdateValue(T& cachedValue, bool& isKnown, const T& newValue);
+
+	/**
+	* @brief Get the index of a cached capability (-1 if the capability is not cached)
+	*/
+	[[nodiscard]] static int GetCapabilityIndex(unsigned int capability);
+
+	/**
+	* @brief Get the index of a cached buffer target (-1 if the target is not cached)
+	*/
+	[[nodiscard]] static int GetBufferTargetIndex(unsigned int target);
+
+	static constexpr int s_capabilityCount = 6;
+	static constexpr int s_bufferTargetCount = 3;
+
+	template<typename T>
+	struct CachedValue
+	{
+		T value = T();
+		bool isKnown = false;
+	};
+
+	static CachedValue<unsigned int> s_program;
+	static CachedValue<unsigned int> s_vertexArray;
+	static CachedValue<unsigned int> s_buffers[s_bufferTargetCount];
+	static CachedValue<unsigned int> s_texture2D;
+	static CachedValue<bool> s_capabilities[s_capabilityCount];
+	static CachedValue<bool> s_depthMask;
+	static CachedValue<uint64_t> s_depthRange;
+	static CachedValue<unsigned int> s_frontFace;
+	static CachedValue<uint64_t> s_blendFunc;
+	static CachedValue<uint64_t> s_alphaFunc;
+	static CachedValue<unsigned int> s_polygonMode;
+};
+
+#endif
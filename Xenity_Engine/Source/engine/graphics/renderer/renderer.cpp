@@ -4,4 +4,44 @@
 //
 // This file is part of Xenity Engine
 
-#include "renderer.h"
\ No newline at end of file
+#include "renderer.h"
+
+#include <engine/math/vector3.h>
+#include <engine/graphics/color/color.h>
+
+namespace
+{
+	[[nodiscard]] Vector3 GetDebugVertexPosition(const DebugDrawVertex& vertex)
+	{
+		return Vector3(vertex.x, vertex.y, vertex.z);
+	}
+
+	[[nodiscard]] Color GetDebugVertexColor(const DebugDrawVertex& vertex)
+	{
+		return Color::CreateFromRGBAFloat(vertex.r, vertex.g, vertex.b, vertex.a);
+	}
+}
+
+void Renderer::DrawDebugVertices(const DebugDrawVertex* vertices, size_t vertexCount, bool isTriangleList, RenderingSettings& settings)
+{
+	if (isTriangleList)
+	{
+		for (size_t i = 0; i + 2 < vertexCount; i += 3)
+		{
+			const Color color = GetDebugVertexColor(vertices[i]);
+			const Vector3 a = GetDebugVertexPosition(vertices[i]);
+			const Vector3 b = GetDebugVertexPosition(vertices[i + 1]);
+			const Vector3 c = GetDebugVertexPosition(vertices[i + 2]);
+			DrawLine(a, b, color, settings);
+			DrawLine(b, c, color, settings);
+			DrawLine(c, a, color, settings);
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i + 1 < vertexCount; i += 2)
+		{
+			DrawLine(GetDebugVertexPosition(vertices[i]), GetDebugVertexPosition(vertices[i + 1]), GetDebugVertexColor(vertices[i]), settings);
+		}
+	}
+}
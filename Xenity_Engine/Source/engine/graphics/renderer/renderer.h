@@ -11,6 +11,8 @@
  */
 
 #include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/mat3x3.hpp>
 
 #include <vector>
 
@@ -40,6 +42,25 @@ struct RenderingSettings
 	bool wireframe = false;
 };
 
+/**
+* @brief Data of one instance of an instanced draw call
+*/
+struct RenderInstanceData
+{
+	glm::mat4 model;
+	glm::mat4 mvp;
+	glm::mat3 normalMatrix;
+};
+
+/**
+* @brief Vertex of the debug lines and triangles (see DebugDraw)
+*/
+struct DebugDrawVertex
+{
+	float x, y, z;
+	float r, g, b, a;
+};
+
 enum class PolygoneFillMode
 {
 	Fill,
@@ -112,6 +133,45 @@ public:
 	virtual void DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings) = 0;
 	virtual void DrawLine(const Vector3& a, const Vector3& b, const Color& color, RenderingSettings& settings) = 0;
 
+	/**
+	* @brief Draw a list of colored lines (two vertices per line) or triangles (three vertices per triangle)
+	* By default the lines are drawn one by one with DrawLine and only the edges of the triangles are drawn
+	*/
+	virtual void DrawDebugVertices(const DebugDrawVertex* vertices, size_t vertexCount, bool isTriangleList, RenderingSettings& settings);
+
+	// Instancing
+	[[nodiscard]] virtual bool IsInstancingSupported() const { return false; }
+	virtual void DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings, const RenderInstanceData* instances, size_t instanceCount) {}
+
+	// Vertex streaming (meshes rewritten every frame)
+	[[nodiscard]] virtual bool IsVertexStreamingSupported() const { return false; }
+	virtual void UpdateSubMeshVertices(const MeshData::SubMesh& subMesh, uint32_t vertexCount) {}
+	virtual void UpdateSubMeshIndices(const MeshData::SubMesh& subMesh, uint32_t indexCount) {}
+
+	// GPU timing (time spent by the GPU on the draw calls between the begin and the end)
+	virtual void BeginGpuTimer() {}
+	virtual void EndGpuTimer() {}
+
+	/**
+	* @brief Get the GPU time of a recent frame in milliseconds (the result comes a few frames late), -1 if not supported
+	*/
+	[[nodiscard]] virtual float GetGpuFrameTime() const { return -1; }
+
+	// Cubemap (one texture for the six faces of the skybox)
+	[[nodiscard]] virtual bool IsCubemapSupported() const { return false; }
+
+	/**
+	* @brief Create a cubemap from six square RGBA faces in the +X, -X, +Y, -Y, +Z, -Z order
+	* @return The id of the cubemap (0 if the cubemap cannot be created)
+	*/
+	[[nodiscard]] virtual unsigned int CreateCubemap(const unsigned char* const* faces, int faceSize) { return 0; }
+	virtual void DeleteCubemap(unsigned int cubemapId) {}
+
+	/**
+	* @brief Draw a submesh with the current shader and a cubemap bound instead of a texture
+	*/
+	virtual void DrawCubemapSubMesh(const MeshData::SubMesh& subMesh, unsigned int cubemapId, RenderingSettings& settings) {}
+
 	virtual void Setlights(const LightsIndices& lightsIndices) = 0;
 
 	//Shader
@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "renderer_null.h"
+
+#include <string>
+
+#include <engine/graphics/graphics.h>
+#include <engine/graphics/material.h>
+#include <engine/graphics/texture/texture.h>
+#include <engine/graphics/3d_graphics/mesh_data.h>
+#include <engine/ui/window.h>
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/debug.h>
+#include <engine/debug/performance.h>
+
+void NullRendererStats::Add(const NullRendererStats& other)
+{
+	drawCallCount += other.drawCallCount;
+	instancedDrawCallCount += other.instancedDrawCallCount;
+	instanceCount += other.instanceCount;
+	triangleCount += other.triangleCount;
+	lineCount += other.lineCount;
+	stateChangeCount += other.stateChangeCount;
+	colorChangeCount += other.colorChangeCount;
+	textureBindCount += other.textureBindCount;
+	shaderProgramChangeCount += other.shaderProgramChangeCount;
+	lightUpdateCount += other.lightUpdateCount;
+	clearCount += other.clearCount;
+	textureCreationCount += other.textureCreationCount;
+	textureUploadCount += other.textureUploadCount;
+	textureUploadSize += other.textureUploadSize;
+	textureDeletionCount += other.textureDeletionCount;
+	meshUploadCount += other.meshUploadCount;
+	meshUploadSize += other.meshUploadSize;
+	meshDeletionCount += other.meshDeletionCount;
+}
+
+int RendererNull::Init()
+{
+	// Use a fixed resolution to get comparable results between runs
+	Window::SetResolution(1280, 720);
+
+	Debug::Print("-------- Null Renderer initiated --------", true);
+	return 0;
+}
+
+void RendererNull::Setup()
+{
+	lastSettings.invertFaces = false;
+	lastSettings.renderingMode = MaterialRenderingMode::Opaque;
+	lastSettings.useDepth = true;
+	lastSettings.useLighting = false;
+	lastSettings.useTexture = true;
+	lastSettings.max_depth = false;
+	lastSettings.wireframe = false;
+}
+
+void RendererNull::Stop()
+{
+	m_totalStats.Add(m_frameStats);
+	m_frameStats = NullRendererStats();
+
+	std::string report = "-------- Null Renderer stopped after " + std::to_string(m_frameCount) + " frames --------";
+	report += "\nDraw calls: " + std::to_string(m_totalStats.drawCallCount);
+	report += "\nInstanced draw calls: " + std::to_string(m_totalStats.instancedDrawCallCount) + " (" + std::to_string(m_totalStats.instanceCount) + " instances)";
+	report += "\nTriangles: " + std::to_string(m_totalStats.triangleCount);
+	report += "\nLines: " + std::to_string(m_totalStats.lineCount);
+	report += "\nState changes: " + std::to_string(m_totalStats.stateChangeCount);
+	report += "\nColor changes: " + std::to_string(m_totalStats.colorChangeCount);
+	report += "\nTexture binds: " + std::to_string(m_totalStats.textureBindCount);
+	report += "\nShader program changes: " + std::to_string(m_totalStats.shaderProgramChangeCount);
+	report += "\nLight updates: " + std::to_string(m_totalStats.lightUpdateCount);
+	report += "\nTexture uploads: " + std::to_string(m_totalStats.textureUploadCount) + " (" + std::to_string(m_totalStats.textureUploadSize) + " bytes)";
+	report += "\nMesh uploads: " + std::to_string(m_totalStats.meshUploadCount) + " (" + std::to_string(m_totalStats.meshUploadSize) + " bytes)";
+	Debug::Print(report, true);
+}
+
+void RendererNull::NewFrame()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	// Same cache reset as the real renderers to get the same amount of state changes
+	lastUsedColor = 0x00000000;
+	lastUsedColor2 = 0xFFFFFFFF;
+}
+
+void RendererNull::EndFrame()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	m_lastFrameStats = m_frameStats;
+	m_totalStats.Add(m_frameStats);
+	m_frameStats = NullRendererStats();
+	m_frameCount++;
+}
+
+void RendererNull::SetViewport(int x, int y, int width, int height)
+{
+	m_frameStats.stateChangeCount++;
+}
+
+void RendererNull::SetClearColor(const Color& color)
+{
+	if (clearColor.GetUnsignedIntRGBA() != color.GetUnsignedIntRGBA())
+	{
+		clearColor = color;
+		m_frameStats.stateChangeCount++;
+	}
+}
+
+void RendererNull::SetProjection2D(float projectionSize, float nearClippingPlane, float farClippingPlane)
+{
+	m_frameStats.stateChangeCount++;
+}
+
+void RendererNull::SetProjection3D(float fov, float nearClippingPlane, float farClippingPlane, float aspect)
+{
+	m_frameStats.stateChangeCount++;
+}
+
+void RendererNull::ResetView()
+{
+}
+
+void RendererNull::SetCameraPosition(const Camera& camera)
+{
+}
+
+void RendererNull::SetCameraPosition(const Vector3& position, const Vector3& rotation)
+{
+}
+
+void RendererNull::ResetTransform()
+{
+}
+
+void RendererNull::SetTransform(const Vector3& position, const Vector3& rotation, const Vector3& scale, bool resetTransform)
+{
+}
+
+void RendererNull::SetTransform(const glm::mat4& mat)
+{
+}
+
+void RendererNull::BindTexture(const Texture& texture)
+{
+	if (usedTexture != &texture)
+	{
+		usedTexture = &texture;
+		m_frameStats.textureBindCount++;
+	}
+}
+
+void RendererNull::ApplySettings(const RenderingSettings& settings)
+{
+	if (settings.invertFaces != lastSettings.invertFaces)
+		m_frameStats.stateChangeCount++;
+	if (settings.renderingMode != lastSettings.renderingMode)
+		m_frameStats.stateChangeCount++;
+	if (settings.useDepth != lastSettings.useDepth)
+		m_frameStats.stateChangeCount++;
+	if (settings.useTexture != lastSettings.useTexture)
+		m_frameStats.stateChangeCount++;
+	if (settings.useLighting != lastSettings.useLighting)
+		m_frameStats.stateChangeCount++;
+	if (settings.max_depth != lastSettings.max_depth)
+		m_frameStats.stateChangeCount++;
+	if (settings.wireframe != lastSettings.wireframe)
+		m_frameStats.stateChangeCount++;
+
+	lastSettings = settings;
+}
+
+void RendererNull::DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, RenderingSettings& settings)
+{
+	DrawSubMesh(subMesh, material, *material.GetTexture(), settings);
+}
+
+uint32_t RendererNull::PrepareSubMeshDraw(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, const RenderingSettings& settings)
+{
+	ApplySettings(settings);
+
+	if (lastUsedColor != material.GetColor().GetUnsignedIntRGBA() || lastUsedColor2 != subMesh.m_meshData->unifiedColor.GetUnsignedIntRGBA())
+	{
+		lastUsedColor = material.GetColor().GetUnsignedIntRGBA();
+		lastUsedColor2 = subMesh.m_meshData->unifiedColor.GetUnsignedIntRGBA();
+		m_frameStats.colorChangeCount++;
+	}
+
+	BindTexture(texture);
+
+	if (subMesh.m_index_count == 0)
+	{
+		return subMesh.m_isQuad ? subMesh.m_vertice_count / 2 : subMesh.m_vertice_count / 3;
+	}
+	return subMesh.m_isQuad ? subMesh.m_index_count / 2 : subMesh.m_index_count / 3;
+}
+
+void RendererNull::DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	const uint32_t triangleCount = PrepareSubMeshDraw(subMesh, material, texture, settings);
+
+	m_frameStats.drawCallCount++;
+	m_frameStats.triangleCount += triangleCount;
+
+	Performance::AddDrawCall();
+	Performance::AddDrawTriangles(static_cast<int>(triangleCount));
+}
+
+bool RendererNull::IsInstancingSupported() const
+{
+	return true;
+}
+
+void RendererNull::DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings, const RenderInstanceData* instances, size_t instanceCount)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+	XASSERT(instances != nullptr, "[RendererNull::DrawSubMeshInstanced] instances is nullptr");
+
+	if (instanceCount == 0)
+		return;
+
+	const uint64_t triangleCount = static_cast<uint64_t>(PrepareSubMeshDraw(subMesh, material, texture, settings)) * instanceCount;
+
+	m_frameStats.drawCallCount++;
+	m_frameStats.instancedDrawCallCount++;
+	m_frameStats.instanceCount += instanceCount;
+	m_frameStats.triangleCount += triangleCount;
+
+	Performance::AddDrawCall();
+	Performance::AddDrawTriangles(static_cast<int>(triangleCount));
+}
+
+void RendererNull::DrawLine(const Vector3& a, const Vector3& b, const Color& color, RenderingSettings& settings)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	ApplySettings(settings);
+
+	m_frameStats.drawCallCount++;
+	m_frameStats.lineCount++;
+
+	Performance::AddDrawCall();
+}
+
+unsigned int RendererNull::CreateNewTexture()
+{
+	m_frameStats.textureCreationCount++;
+	return nextTextureId++;
+}
+
+void RendererNull::DeleteTexture(Texture& texture)
+{
+	if (usedTexture == &texture)
+	{
+		usedTexture = nullptr;
+	}
+	m_frameStats.textureDeletionCount++;
+}
+
+void RendererNull::SetTextureData(const Texture& texture, unsigned int textureType, const unsigned char* buffer)
+{
+	XASSERT(buffer != nullptr, "[RendererNull::SetTextureData] buffer is nullptr");
+
+	m_frameStats.textureUploadCount++;
+	// Textures are always uploaded in RGBA
+	m_frameStats.textureUploadSize += static_cast<uint64_t>(texture.GetWidth()) * texture.GetHeight() * 4;
+}
+
+void RendererNull::Clear(ClearMode mode)
+{
+	m_frameStats.clearCount++;
+}
+
+void RendererNull::SetFog(bool active)
+{
+	if (fogActive != active)
+	{
+		fogActive = active;
+		m_frameStats.stateChangeCount++;
+	}
+}
+
+void RendererNull::SetFogValues(float start, float end, const Color& color)
+{
+	if (fogStart != start || fogEnd != end || fogColor.GetUnsignedIntRGBA() != color.GetUnsignedIntRGBA())
+	{
+		fogStart = start;
+		fogEnd = end;
+		fogColor = color;
+		m_frameStats.stateChangeCount++;
+	}
+}
+
+void RendererNull::DeleteSubMeshData(MeshData::SubMesh& subMesh)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	m_frameStats.meshDeletionCount++;
+}
+
+void RendererNull::UploadMeshData(MeshData& meshData)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	for (uint32_t i = 0; i < meshData.m_subMeshCount; i++)
+	{
+		const std::unique_ptr<MeshData::SubMesh>& subMesh = meshData.m_subMeshes[i];
+		m_frameStats.meshUploadCount++;
+		m_frameStats.meshUploadSize += subMesh->m_vertexMemSize + subMesh->m_indexMemSize;
+	}
+}
+
+void RendererNull::UseShaderProgram(unsigned int programId)
+{
+	if (usedProgram != programId)
+	{
+		usedProgram = programId;
+		m_frameStats.shaderProgramChangeCount++;
+	}
+}
+
+void RendererNull::Setlights(const LightsIndices& lightsIndices)
+{
+	m_frameStats.lightUpdateCount++;
+}
+
+void RendererNull::SetLight(const int lightIndex, const Light& light, const Vector3& lightPosition, const Vector3& lightDirection)
+{
+	m_frameStats.lightUpdateCount++;
+}
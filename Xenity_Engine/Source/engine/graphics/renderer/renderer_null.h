@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <engine/api.h>
+
+#include <cstdint>
+
+#include "renderer.h"
+#include <engine/graphics/color/color.h>
+
+/**
+* @brief Counters recorded by the null renderer
+*/
+struct NullRendererStats
+{
+	uint64_t drawCallCount = 0;
+	uint64_t instancedDrawCallCount = 0;
+	uint64_t instanceCount = 0;
+	uint64_t triangleCount = 0;
+	uint64_t lineCount = 0;
+	uint64_t stateChangeCount = 0;
+	uint64_t colorChangeCount = 0;
+	uint64_t textureBindCount = 0;
+	uint64_t shaderProgramChangeCount = 0;
+	uint64_t lightUpdateCount = 0;
+	uint64_t clearCount = 0;
+	uint64_t textureCreationCount = 0;
+	uint64_t textureUploadCount = 0;
+	uint64_t textureUploadSize = 0;
+	uint64_t textureDeletionCount = 0;
+	uint64_t meshUploadCount = 0;
+	uint64_t meshUploadSize = 0;
+	uint64_t meshDeletionCount = 0;
+
+	void Add(const NullRendererStats& other);
+};
+
+/**
+* @brief Renderer that does not use any GPU, it only records what would have been sent to the GPU
+* Used to measure the CPU side of the rendering on machines without GPU (enabled with the "renderer=null" argument)
+*/
+class API RendererNull : public Renderer
+{
+public:
+	RendererNull() = default;
+	RendererNull(const RendererNull& other) = delete;
+	RendererNull& operator=(const RendererNull&) = delete;
+
+	[[nodiscard]] int Init() override;
+	void Setup() override;
+	void Stop() override;
+	void NewFrame() override;
+	void EndFrame() override;
+	void SetViewport(int x, int y, int width, int height) override;
+	void SetClearColor(const Color& color) override;
+	void SetProjection2D(float projectionSize, float nearClippingPlane, float farClippingPlane) override;
+	void SetProjection3D(float fov, float nearClippingPlane, float farClippingPlane, float aspect) override;
+	void ResetView() override;
+	void SetCameraPosition(const Camera& camera) override;
+	void SetCameraPosition(const Vector3& position, const Vector3& rotation) override;
+	void ResetTransform() override;
+	void SetTransform(const Vector3& position, const Vector3& rotation, const Vector3& scale, bool resetTransform) override;
+	void SetTransform(const glm::mat4& mat) override;
+	void BindTexture(const Texture& texture) override;
+	void DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, RenderingSettings& settings) override;
+	void DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings) override;
+	void DrawLine(const Vector3& a, const Vector3& b, const Color& color, RenderingSettings& settings) override;
+	[[nodiscard]] bool IsInstancingSupported() const override;
+	void DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings, const RenderInstanceData* instances, size_t instanceCount) override;
+	[[nodiscard]] unsigned int CreateNewTexture() override;
+	void DeleteTexture(Texture& texture) override;
+	void SetTextureData(const Texture& texture, unsigned int textureType, const unsigned char* buffer) override;
+	void Clear(ClearMode mode) override;
+	void SetFog(bool active) override;
+	void SetFogValues(float start, float end, const Color& color) override;
+
+	void DeleteSubMeshData(MeshData::SubMesh& subMesh) override;
+	void UploadMeshData(MeshData& meshData) override;
+
+	//Shader
+	void UseShaderProgram(unsigned int programId) override;
+
+	void Setlights(const LightsIndices& lightsIndices) override;
+
+	/**
+	* @brief Get the counters of the last finished frame
+	*/
+	[[nodiscard]] const NullRendererStats& GetLastFrameStats() const
+	{
+		return m_lastFrameStats;
+	}
+
+	/**
+	* @brief Get the counters accumulated since the renderer initialization
+	*/
+	[[nodiscard]] const NullRendererStats& GetTotalStats() const
+	{
+		return m_totalStats;
+	}
+
+	/**
+	* @brief Get the number of finished frames
+	*/
+	[[nodiscard]] uint64_t GetFrameCount() const
+	{
+		return m_frameCount;
+	}
+
+private:
+	void SetLight(const int lightIndex, const Light& light, const Vector3& lightPosition, const Vector3& lightDirection) override;
+
+	/**
+	* @brief Count the rendering settings that are different from the last used settings
+	*/
+	void ApplySettings(const RenderingSettings& settings);
+
+	/**
+	* @brief Count the state changes of a submesh draw and get the number of triangles of the submesh
+	*/
+	[[nodiscard]] uint32_t PrepareSubMeshDraw(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, const RenderingSettings& settings);
+
+	NullRendererStats m_frameStats;
+	NullRendererStats m_lastFrameStats;
+	NullRendererStats m_totalStats;
+	uint64_t m_frameCount = 0;
+
+	RenderingSettings lastSettings;
+	const Texture* usedTexture = nullptr;
+	unsigned int usedProgram = 0;
+	unsigned int lastUsedColor = 0x00000000;
+	unsigned int lastUsedColor2 = 0xFFFFFFFF;
+	unsigned int nextTextureId = 1;
+
+	bool fogActive = false;
+	float fogStart = 0;
+	float fogEnd = 10;
+	Color fogColor;
+	Color clearColor;
+};
@@ -8,6 +8,9 @@
 #include "renderer_opengl.h"
 
 #include <memory>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/quaternion.hpp>
 
@@ -34,7 +37,13 @@
 
 #include <engine/tools/internal_math.h>
 #include <engine/graphics/texture/texture_default.h>
+#include <engine/graphics/shader/shader_uniform_handle.h>
+#include "opengl_state_cache.h"
 
+namespace
+{
+	constexpr ShaderUniformHandle s_colorUniform("color");
+}
 
 RendererOpengl::RendererOpengl()
 {
@@ -42,8 +51,6 @@ RendererOpengl::RendererOpengl()
 
 int RendererOpengl::Init()
 {
-	lastSettings.useTexture = false;
-
 	int result = 1;
 #if defined(__vita__)
 #if defined(VITA_USE_MSAA)
@@ -86,12 +93,13 @@ void RendererOpengl::Setup()
 	glEnable(GL_NORMALIZE);
 
 	glDepthFunc(GL_LESS);
-	glEnable(GL_CULL_FACE);
-	glFrontFace(GL_CCW);
-	glEnable(GL_TEXTURE_2D);
-	glEnable(GL_DEPTH_TEST);
-	glDisable(GL_BLEND);
-	glDisable(GL_ALPHA_TEST);
+	OpenGLStateCache::Reset();
+	OpenGLStateCache::SetEnabled(GL_CULL_FACE, true);
+	OpenGLStateCache::SetFrontFace(GL_CCW);
+	OpenGLStateCache::SetEnabled(GL_TEXTURE_2D, true);
+	OpenGLStateCache::SetEnabled(GL_DEPTH_TEST, true);
+	OpenGLStateCache::SetEnabled(GL_BLEND, false);
+	OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, false);
 
 	glEnable(GL_COLOR_MATERIAL);
 	glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
@@ -104,16 +112,55 @@ void RendererOpengl::Setup()
 	GLfloat globalAmbient[] = { 0.0f, 0.0f, 0.0f, 1.0f };
 	glLightModelfv(GL_LIGHT_MODEL_AMBIENT, globalAmbient);
 
-	lastSettings.invertFaces = false;
-	lastSettings.renderingMode = MaterialRenderingMode::Opaque;
-	lastSettings.useDepth = true;
-	lastSettings.useLighting = false;
-	lastSettings.useTexture = true;
-	lastSettings.max_depth = false;
+	// Instanced draws need OpenGL 3.3 and the per instance matrices need 15 vertex attributes
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if constexpr (!s_UseOpenGLFixedFunctions)
+	{
+		GLint maxVertexAttribs = 0;
+		glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxVertexAttribs);
+		isInstancingSupported = glDrawElementsInstanced && glDrawArraysInstanced && glVertexAttribDivisor && glMapBufferRange &&
+			maxVertexAttribs > static_cast<GLint>(s_instanceNormalMatrixLocation + 2);
+	}
+	if (isInstancingSupported)
+	{
+		instanceBuffer = CreateBuffer();
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		glBufferData(GL_ARRAY_BUFFER, s_instanceBufferSize, nullptr, GL_STREAM_DRAW);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+		instanceBufferOffset = 0;
+	}
+	else
+	{
+		Debug::PrintWarning("[RendererOpengl::Setup] Instancing is not supported, meshes will be drawn one by one", true);
+	}
+#endif
 }
 
 void RendererOpengl::Stop()
 {
+	if (instanceBuffer != 0)
+	{
+		DeleteBuffer(instanceBuffer);
+		instanceBuffer = 0;
+	}
+	isInstancingSupported = false;
+	if (debugDrawBuffer != 0)
+	{
+		DeleteBuffer(debugDrawBuffer);
+		debugDrawBuffer = 0;
+	}
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if (gpuTimerQueries[0] != 0)
+	{
+		glDeleteQueries(static_cast<GLsizei>(s_gpuTimerQueryCount), gpuTimerQueries.data());
+		gpuTimerQueries.fill(0);
+		isGpuTimerQueryPending.fill(false);
+	}
+	isGpuTimerRunning = false;
+	gpuFrameTime = -1;
+#endif
+
 #if defined(__vita__)
 	vglEnd();
 #endif
@@ -125,12 +172,15 @@ void RendererOpengl::NewFrame()
 
 	lastUsedColor = 0x00000000;
 	lastUsedColor2 = 0xFFFFFFFF;
+	lastShaderUsedColor = nullptr;
 
 	for (int i = 0; i < maxLightCount; i++)
 	{
 		lastUpdatedLights[i] = nullptr;
 	}
-	lastUsedVAO = -1;
+
+	// Other code (ImGui, the framebuffers) may have changed the OpenGL state since the last frame
+	OpenGLStateCache::Reset();
 }
 
 void RendererOpengl::EndFrame()
@@ -139,12 +189,66 @@ void RendererOpengl::EndFrame()
 
 	SCOPED_PROFILER("RendererOpengl::EndFrame", scopeBenchmark);
 
-	usedTexture = 0;
 #if defined(__vita__)
 	vglSwapBuffers(GL_FALSE);
 #endif
 }
 
+void RendererOpengl::BeginGpuTimer()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	// Timer queries are not available with vitaGL
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	XASSERT(!isGpuTimerRunning, "[RendererOpengl::BeginGpuTimer] The timer is already running");
+
+	if (gpuTimerQueries[0] == 0)
+	{
+		glGenQueries(static_cast<GLsizei>(s_gpuTimerQueryCount), gpuTimerQueries.data());
+	}
+
+	const unsigned int query = gpuTimerQueries[gpuTimerQueryIndex];
+	if (isGpuTimerQueryPending[gpuTimerQueryIndex])
+	{
+		GLint isAvailable = GL_FALSE;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		if (isAvailable == GL_FALSE)
+		{
+			// Skip the measure of this frame instead of waiting for the GPU
+			return;
+		}
+
+		GLuint64 elapsedNanoseconds = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNanoseconds);
+		gpuFrameTime = static_cast<float>(elapsedNanoseconds / 1000000.0);
+		isGpuTimerQueryPending[gpuTimerQueryIndex] = false;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, query);
+	isGpuTimerRunning = true;
+#endif
+}
+
+void RendererOpengl::EndGpuTimer()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if (!isGpuTimerRunning)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	isGpuTimerQueryPending[gpuTimerQueryIndex] = true;
+	gpuTimerQueryIndex = (gpuTimerQueryIndex + 1) % s_gpuTimerQueryCount;
+	isGpuTimerRunning = false;
+#endif
+}
+
+float RendererOpengl::GetGpuFrameTime() const
+{
+	return gpuFrameTime;
+}
+
 void RendererOpengl::SetViewport(int x, int y, int width, int height)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
@@ -305,122 +409,58 @@ void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Materia
 	DrawSubMesh(subMesh, material, *material.GetTexture(), settings);
 }
 
-void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings)
+void RendererOpengl::PrepareSubMeshDraw(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, const RenderingSettings& settings)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	// Apply rendering settings
-	if (lastSettings.invertFaces != settings.invertFaces)
-	{
-		if (settings.invertFaces)
-		{
-			glFrontFace(GL_CW);
-		}
-		else
-		{
-			glFrontFace(GL_CCW);
-		}
-	}
+	// Apply rendering settings, the state cache skips the states that are already set
+	OpenGLStateCache::SetFrontFace(settings.invertFaces ? GL_CW : GL_CCW);
+	OpenGLStateCache::SetEnabled(GL_DEPTH_TEST, settings.useDepth);
 
-	if (lastSettings.useDepth != settings.useDepth)
+	if (settings.renderingMode == MaterialRenderingMode::Opaque)
 	{
-		if (settings.useDepth)
-		{
-			glEnable(GL_DEPTH_TEST);
-		}
-		else
-		{
-			glDisable(GL_DEPTH_TEST);
-		}
+		OpenGLStateCache::SetEnabled(GL_BLEND, false);
+		OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, false);
 	}
-
-	if (lastSettings.renderingMode != settings.renderingMode)
+	else if (settings.renderingMode == MaterialRenderingMode::Cutout)
 	{
-		if (settings.renderingMode == MaterialRenderingMode::Opaque)
-		{
-			glDisable(GL_BLEND);
-			glDisable(GL_ALPHA_TEST);
-		}
-		else if (settings.renderingMode == MaterialRenderingMode::Cutout)
-		{
-			glDisable(GL_BLEND);
-			glEnable(GL_ALPHA_TEST);
-			glAlphaFunc(GL_GEQUAL, material.GetAlphaCutoff());
-		}
-		else
-		{
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			glDisable(GL_ALPHA_TEST);
-		}
+		OpenGLStateCache::SetEnabled(GL_BLEND, false);
+		OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, true);
+		OpenGLStateCache::SetAlphaFunc(GL_GEQUAL, material.GetAlphaCutoff());
 	}
-
-	if (lastSettings.useLighting != settings.useLighting)
+	else
 	{
-		if (settings.useLighting)
-		{
-			glEnable(GL_LIGHTING);
-		}
-		else
-		{
-			glDisable(GL_LIGHTING);
-		}
+		OpenGLStateCache::SetEnabled(GL_BLEND, true);
+		OpenGLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, false);
 	}
 
-	if (lastSettings.useTexture != settings.useTexture)
-	{
-		if (settings.useTexture)
-		{
-			glEnable(GL_TEXTURE_2D);
-		}
-		else
-		{
-			glDisable(GL_TEXTURE_2D);
-		}
-	}
+	OpenGLStateCache::SetEnabled(GL_LIGHTING, settings.useLighting);
+	OpenGLStateCache::SetEnabled(GL_TEXTURE_2D, settings.useTexture);
 
 	if (settings.renderingMode == MaterialRenderingMode::Transparent || settings.max_depth)
 	{
-		glDepthMask(GL_FALSE);
+		OpenGLStateCache::SetDepthMask(false);
 	}
 
-	if (lastSettings.max_depth != settings.max_depth)
+	if (settings.max_depth)
 	{
-		if (settings.max_depth)
-		{
-			glDepthRange(0.9999f, 1);
-		}
-		else
-		{
-			glDepthRange(0, 1);
-		}
+		OpenGLStateCache::SetDepthRange(0.9999f, 1);
 	}
-
-	if (lastSettings.wireframe != settings.wireframe)
+	else
 	{
-		if (settings.wireframe)
-		{
-			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		}
-		else
-		{
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-		}
+		OpenGLStateCache::SetDepthRange(0, 1);
 	}
 
-	// Keep in memory the used settings
-	lastSettings.invertFaces = settings.invertFaces;
-	lastSettings.renderingMode = settings.renderingMode;
-	lastSettings.useDepth = settings.useDepth;
-	lastSettings.useLighting = settings.useLighting;
-	lastSettings.useTexture = settings.useTexture;
-	lastSettings.max_depth = settings.max_depth;
-	lastSettings.wireframe = settings.wireframe;
+	OpenGLStateCache::SetPolygonMode(settings.wireframe ? GL_LINE : GL_FILL);
+
+	// The bound program may be a variant of the material shader (see Material::Use)
+	Shader* shader = Graphics::s_currentShader;
 
 	// Maybe check if useLighting was changed to recalculate the color in fixed pipeline?
 	if (lastUsedColor != material.GetColor().GetUnsignedIntRGBA() ||
 		lastUsedColor2 != subMesh.m_meshData->unifiedColor.GetUnsignedIntRGBA() ||
-		(!s_UseOpenGLFixedFunctions && lastShaderIdUsedColor != material.GetShader()->m_fileId))
+		(!s_UseOpenGLFixedFunctions && lastShaderUsedColor != shader))
 	{
 		lastUsedColor = material.GetColor().GetUnsignedIntRGBA();
 		lastUsedColor2 = subMesh.m_meshData->unifiedColor.GetUnsignedIntRGBA();
@@ -439,8 +479,11 @@ void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Materia
 		}
 		else
 		{
-			lastShaderIdUsedColor = material.GetShader()->m_fileId;
-			material.GetShader()->SetShaderAttribut("color", colorMix);
+			lastShaderUsedColor = shader;
+			if (shader)
+			{
+				shader->SetShaderAttribut(s_colorUniform, colorMix);
+			}
 		}
 	}
 
@@ -461,17 +504,8 @@ void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Materia
 #endif
 
 	//Bind all the data
-	if (lastUsedVAO != subMesh.VAO)
-	{
-		glBindVertexArray(subMesh.VAO);
-		lastUsedVAO = subMesh.VAO;
-	}
-	const TextureDefault& openglTexture = dynamic_cast<const TextureDefault&>(texture);
-	if (usedTexture != openglTexture.GetTextureId())
-	{
-		usedTexture = openglTexture.GetTextureId();
-		texture.Bind();
-	}
+	OpenGLStateCache::BindVertexArray(subMesh.VAO);
+	texture.Bind();
 
 	if constexpr (s_UseOpenGLFixedFunctions)
 	{
@@ -480,6 +514,13 @@ void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Materia
 		glTranslatef(material.GetOffset().x, material.GetOffset().y, 0);
 		glScalef(material.GetTiling().x, material.GetTiling().y, 1.0f);
 	}
+}
+
+void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	PrepareSubMeshDraw(subMesh, material, texture, settings);
 
 	// Draw
 	int primitiveType = subMesh.m_isQuad ? GL_QUADS : GL_TRIANGLES;
@@ -508,31 +549,171 @@ void RendererOpengl::DrawSubMesh(const MeshData::SubMesh& subMesh, const Materia
 	}
 #endif
 
-	glDepthMask(GL_TRUE);
+	OpenGLStateCache::SetDepthMask(true);
 }
 
-// TODO : Improve this function, it's not optimized and not using shaders
-void RendererOpengl::DrawLine(const Vector3& a, const Vector3& b, const Color& color, RenderingSettings& settings)
+bool RendererOpengl::IsInstancingSupported() const
+{
+	return isInstancingSupported;
+}
+
+void RendererOpengl::DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings, const RenderInstanceData* instances, size_t instanceCount)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+	XASSERT(isInstancingSupported, "[RendererOpengl::DrawSubMeshInstanced] Instancing is not supported");
+	XASSERT(instances != nullptr, "[RendererOpengl::DrawSubMeshInstanced] instances is nullptr");
 
-	if (settings.useDepth)
-		glEnable(GL_DEPTH_TEST);
-	else
-		glDisable(GL_DEPTH_TEST);
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+// Disable warning about (void*) cast
+#pragma warning( push )
+#pragma warning( disable : 4312 )
 
-	if (lastUsedVAO != 0)
+	if (instanceCount == 0)
+		return;
+
+	PrepareSubMeshDraw(subMesh, material, texture, settings);
+
+	const int primitiveType = subMesh.m_isQuad ? GL_QUADS : GL_TRIANGLES;
+	const int indiceMode = subMesh.usesShortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	constexpr size_t maxInstancesPerDraw = s_instanceBufferSize / sizeof(RenderInstanceData);
+	constexpr GLsizei stride = sizeof(RenderInstanceData);
+
+	OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	for (unsigned int i = 0; i < 4; i++)
 	{
-		glBindVertexArray(0);
-		lastUsedVAO = 0;
+		glEnableVertexAttribArray(s_instanceModelLocation + i);
+		glVertexAttribDivisor(s_instanceModelLocation + i, 1);
+		glEnableVertexAttribArray(s_instanceMVPLocation + i);
+		glVertexAttribDivisor(s_instanceMVPLocation + i, 1);
 	}
-	glDepthRange(0, 1);
-	glEnable(GL_BLEND);
-	glDisable(GL_ALPHA_TEST);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_LIGHTING);
-	glDisable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		glEnableVertexAttribArray(s_instanceNormalMatrixLocation + i);
+		glVertexAttribDivisor(s_instanceNormalMatrixLocation + i, 1);
+	}
+
+	size_t drawnInstanceCount = 0;
+	while (drawnInstanceCount < instanceCount)
+	{
+		const size_t count = std::min(instanceCount - drawnInstanceCount, maxInstancesPerDraw);
+		const size_t dataSize = count * sizeof(RenderInstanceData);
+
+		// Orphan the buffer when it is full to not wait for the draw calls still using it
+		if (instanceBufferOffset + dataSize > s_instanceBufferSize)
+		{
+			glBufferData(GL_ARRAY_BUFFER, s_instanceBufferSize, nullptr, GL_STREAM_DRAW);
+			instanceBufferOffset = 0;
+		}
+
+		void* bufferData = glMapBufferRange(GL_ARRAY_BUFFER, instanceBufferOffset, dataSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (!bufferData)
+		{
+			Debug::PrintError("[RendererOpengl::DrawSubMeshInstanced] Cannot map the instance buffer", true);
+			break;
+		}
+		memcpy(bufferData, instances + drawnInstanceCount, dataSize);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+
+		// Point the instance attributes to the written instances (one attribute per matrix column)
+		for (unsigned int column = 0; column < 4; column++)
+		{
+			glVertexAttribPointer(s_instanceModelLocation + column, 4, GL_FLOAT, false, stride, (void*)(instanceBufferOffset + offsetof(RenderInstanceData, model) + column * sizeof(glm::vec4)));
+			glVertexAttribPointer(s_instanceMVPLocation + column, 4, GL_FLOAT, false, stride, (void*)(instanceBufferOffset + offsetof(RenderInstanceData, mvp) + column * sizeof(glm::vec4)));
+		}
+		for (unsigned int column = 0; column < 3; column++)
+		{
+			glVertexAttribPointer(s_instanceNormalMatrixLocation + column, 3, GL_FLOAT, false, stride, (void*)(instanceBufferOffset + offsetof(RenderInstanceData, normalMatrix) + column * sizeof(glm::vec3)));
+		}
+
+		if (subMesh.m_index_count == 0)
+		{
+			glDrawArraysInstanced(primitiveType, 0, subMesh.m_vertice_count, static_cast<GLsizei>(count));
+		}
+		else
+		{
+			glDrawElementsInstanced(primitiveType, subMesh.m_index_count, indiceMode, 0, static_cast<GLsizei>(count));
+		}
+
+#if defined(EDITOR)
+		if (Graphics::usedCamera->IsEditor())
+		{
+			const uint32_t elementCount = subMesh.m_index_count == 0 ? subMesh.m_vertice_count : subMesh.m_index_count;
+			Performance::AddDrawTriangles(static_cast<int>(elementCount / 3 * count));
+			Performance::AddDrawCall();
+		}
+#endif
+
+		instanceBufferOffset += dataSize;
+		drawnInstanceCount += count;
+	}
+
+	// The attributes are part of the submesh VAO, disable them to not use them in the next non instanced draws
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		glDisableVertexAttribArray(s_instanceModelLocation + i);
+		glDisableVertexAttribArray(s_instanceMVPLocation + i);
+	}
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		glDisableVertexAttribArray(s_instanceNormalMatrixLocation + i);
+	}
+	OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+	OpenGLStateCache::SetDepthMask(true);
+
+#pragma warning( pop )
+#endif
+}
+
+bool RendererOpengl::IsVertexStreamingSupported() const
+{
+	// The fixed pipeline reads the vertex arrays set when the mesh is uploaded
+	return !s_UseOpenGLFixedFunctions;
+}
+
+void RendererOpengl::UpdateSubMeshVertices(const MeshData::SubMesh& subMesh, uint32_t vertexCount)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+	XASSERT(subMesh.VBO != 0, "[RendererOpengl::UpdateSubMeshVertices] The submesh is not uploaded");
+	XASSERT(vertexCount <= subMesh.m_vertice_count, "[RendererOpengl::UpdateSubMeshVertices] vertexCount is larger than the submesh");
+
+	const size_t dataSize = static_cast<size_t>(vertexCount) * subMesh.m_vertexDescriptor.GetVertexSize();
+	OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, subMesh.VBO);
+	// Orphan the buffer to not wait for the draw calls still using the previous data
+	glBufferData(GL_ARRAY_BUFFER, subMesh.m_vertexMemSize, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, subMesh.m_data);
+}
+
+void RendererOpengl::UpdateSubMeshIndices(const MeshData::SubMesh& subMesh, uint32_t indexCount)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+	XASSERT(subMesh.EBO != 0, "[RendererOpengl::UpdateSubMeshIndices] The submesh is not uploaded");
+	XASSERT(indexCount <= subMesh.m_index_count, "[RendererOpengl::UpdateSubMeshIndices] indexCount is larger than the submesh");
+
+	const size_t indexSize = subMesh.usesShortIndices ? sizeof(unsigned short) : sizeof(unsigned int);
+	// The element array buffer binding is stored in the vertex array
+	OpenGLStateCache::BindVertexArray(subMesh.VAO);
+	OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, subMesh.EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, subMesh.m_indexMemSize, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * indexSize, subMesh.GetIndices());
+}
+
+// TODO : Improve this function, it's not optimized and not using shaders
+void RendererOpengl::DrawLine(const Vector3& a, const Vector3& b, const Color& color, RenderingSettings& settings)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	OpenGLStateCache::SetEnabled(GL_DEPTH_TEST, settings.useDepth);
+	OpenGLStateCache::BindVertexArray(0);
+	// The vertices are read from client memory
+	OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+	OpenGLStateCache::SetDepthRange(0, 1);
+	OpenGLStateCache::SetEnabled(GL_BLEND, true);
+	OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, false);
+	OpenGLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLStateCache::SetEnabled(GL_LIGHTING, false);
+	OpenGLStateCache::SetEnabled(GL_TEXTURE_2D, false);
+	OpenGLStateCache::BindTexture(GL_TEXTURE_2D, 0);
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glDisableClientState(GL_COLOR_ARRAY);
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
@@ -542,12 +723,6 @@ void RendererOpengl::DrawLine(const Vector3& a, const Vector3& b, const Color& c
 	glDisableVertexAttribArray(1);
 	glDisableVertexAttribArray(2);
 
-	lastSettings.renderingMode = MaterialRenderingMode::Transparent;
-	lastSettings.useDepth = settings.useDepth;
-	lastSettings.useLighting = false;
-	lastSettings.useTexture = false;
-	usedTexture = 0;
-
 	struct Vertex
 	{
 		float x, y, z;
@@ -572,6 +747,132 @@ void RendererOpengl::DrawLine(const Vector3& a, const Vector3& b, const Color& c
 	glColor4f(1, 1, 1, 1);
 }
 
+void RendererOpengl::DrawDebugVertices(const DebugDrawVertex* vertices, size_t vertexCount, bool isTriangleList, RenderingSettings& settings)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	if (vertexCount == 0)
+		return;
+
+	if (debugDrawBuffer == 0)
+	{
+		debugDrawBuffer = CreateBuffer();
+	}
+
+	OpenGLStateCache::SetEnabled(GL_DEPTH_TEST, settings.useDepth);
+	OpenGLStateCache::BindVertexArray(0);
+	OpenGLStateCache::SetDepthRange(0, 1);
+	OpenGLStateCache::SetEnabled(GL_BLEND, true);
+	OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, false);
+	OpenGLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLStateCache::SetEnabled(GL_LIGHTING, false);
+	OpenGLStateCache::SetEnabled(GL_TEXTURE_2D, false);
+	OpenGLStateCache::SetEnabled(GL_CULL_FACE, false);
+	OpenGLStateCache::BindTexture(GL_TEXTURE_2D, 0);
+
+	// Orphan the buffer to not wait for the previous debug draws
+	OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, debugDrawBuffer);
+	glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(DebugDrawVertex), vertices, GL_STREAM_DRAW);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+
+	glDisableVertexAttribArray(0);
+	glDisableVertexAttribArray(1);
+	glDisableVertexAttribArray(2);
+	glDisableVertexAttribArray(3);
+
+	static const int stride = sizeof(DebugDrawVertex);
+	glVertexPointer(3, GL_FLOAT, stride, (void*)offsetof(DebugDrawVertex, x));
+	glColorPointer(4, GL_FLOAT, stride, (void*)offsetof(DebugDrawVertex, r));
+
+	lastUsedColor = 0x00000000;
+	lastUsedColor2 = 0xFFFFFFFF;
+	glDrawArrays(isTriangleList ? GL_TRIANGLES : GL_LINES, 0, static_cast<GLsizei>(vertexCount));
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	OpenGLStateCache::SetEnabled(GL_CULL_FACE, true);
+	// The other client side draws (DrawLine) read the vertices from the memory
+	OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool RendererOpengl::IsCubemapSupported() const
+{
+	return !s_UseOpenGLFixedFunctions;
+}
+
+unsigned int RendererOpengl::CreateCubemap(const unsigned char* const* faces, int faceSize)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	unsigned int cubemapId = 0;
+	glGenTextures(1, &cubemapId);
+	OpenGLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, cubemapId);
+
+	for (int i = 0; i < 6; i++)
+	{
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, faceSize, faceSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, faces[i]);
+	}
+
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+#endif
+
+	OpenGLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	return cubemapId;
+}
+
+void RendererOpengl::DeleteCubemap(unsigned int cubemapId)
+{
+	OpenGLStateCache::DeleteTexture(cubemapId);
+}
+
+void RendererOpengl::DrawCubemapSubMesh(const MeshData::SubMesh& subMesh, unsigned int cubemapId, RenderingSettings& settings)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	OpenGLStateCache::SetEnabled(GL_DEPTH_TEST, settings.useDepth);
+	OpenGLStateCache::SetEnabled(GL_BLEND, false);
+	OpenGLStateCache::SetEnabled(GL_ALPHA_TEST, false);
+	// The camera is inside the cube, both sides are drawn to not depend on the winding
+	OpenGLStateCache::SetEnabled(GL_CULL_FACE, false);
+	OpenGLStateCache::SetPolygonMode(GL_FILL);
+
+	if (settings.max_depth)
+	{
+		OpenGLStateCache::SetDepthMask(false);
+		OpenGLStateCache::SetDepthRange(0.9999f, 1);
+	}
+	else
+	{
+		OpenGLStateCache::SetDepthRange(0, 1);
+	}
+
+	OpenGLStateCache::BindVertexArray(subMesh.VAO);
+	OpenGLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, cubemapId);
+
+	const int indiceMode = subMesh.usesShortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	glDrawElements(GL_TRIANGLES, subMesh.m_index_count, indiceMode, 0);
+
+#if defined(EDITOR)
+	if (Graphics::usedCamera->IsEditor())
+	{
+		Performance::AddDrawTriangles(subMesh.m_index_count / 3);
+		Performance::AddDrawCall();
+	}
+#endif
+
+	OpenGLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	OpenGLStateCache::SetEnabled(GL_CULL_FACE, true);
+	OpenGLStateCache::SetDepthMask(true);
+}
+
 unsigned int RendererOpengl::CreateNewTexture()
 {
 	// Should be deleted
@@ -830,21 +1131,21 @@ void RendererOpengl::BindVertexArray(unsigned int bufferId)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	glBindVertexArray(bufferId);
+	OpenGLStateCache::BindVertexArray(bufferId);
 }
 
 void RendererOpengl::DeleteBuffer(unsigned int bufferId)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	glDeleteBuffers(1, &bufferId);
+	OpenGLStateCache::DeleteBuffer(bufferId);
 }
 
 void RendererOpengl::DeleteVertexArray(unsigned int bufferId)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	glDeleteVertexArrays(1, &bufferId);
+	OpenGLStateCache::DeleteVertexArray(bufferId);
 }
 
 void RendererOpengl::DeleteSubMeshData(MeshData::SubMesh& subMesh)
@@ -882,18 +1183,18 @@ void RendererOpengl::UploadMeshData(MeshData& meshData)
 
 		XASSERT(newSubMesh->VAO != 0, "VAO not created");
 
-		glBindVertexArray(newSubMesh->VAO);
+		OpenGLStateCache::BindVertexArray(newSubMesh->VAO);
 
 		if (newSubMesh->VBO == 0)
 			newSubMesh->VBO = CreateBuffer();
 
-		glBindBuffer(GL_ARRAY_BUFFER, newSubMesh->VBO);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, newSubMesh->VBO);
 
 		glBufferData(GL_ARRAY_BUFFER, newSubMesh->m_vertexMemSize, newSubMesh->m_data, GL_STATIC_DRAW);
 
 		if (newSubMesh->EBO == 0)
 			newSubMesh->EBO = CreateBuffer();
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, newSubMesh->EBO);
+		OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, newSubMesh->EBO);
 		size_t indexSize = newSubMesh->usesShortIndices ? sizeof(unsigned short) : sizeof(unsigned int);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexSize * newSubMesh->m_index_count, newSubMesh->GetIndices(), GL_STATIC_DRAW);
 
@@ -936,13 +1237,11 @@ void RendererOpengl::UploadMeshData(MeshData& meshData)
 		}
 		else
 		{
-			glEnableVertexAttribArray(2);
-			glVertexAttribPointer(2, 3, GL_FLOAT, false, stride, (void*)vertexDescriptorList.GetPositionOffset());
+			SetVertexAttribute(2, vertexDescriptorList.GetElementFromIndex(vertexDescriptorList.GetPositionIndex()), stride, vertexDescriptorList.GetPositionOffset());
 
 			if (vertexDescriptorList.GetUvIndex() != -1)
 			{
-				glEnableVertexAttribArray(0);
-				glVertexAttribPointer(0, 2, GL_FLOAT, false, stride, (void*)vertexDescriptorList.GetUvOffset());
+				SetVertexAttribute(0, vertexDescriptorList.GetElementFromIndex(vertexDescriptorList.GetUvIndex()), stride, vertexDescriptorList.GetUvOffset());
 			}
 			else
 			{
@@ -951,8 +1250,7 @@ void RendererOpengl::UploadMeshData(MeshData& meshData)
 
 			if (vertexDescriptorList.GetNormalIndex() != -1)
 			{
-				glEnableVertexAttribArray(1);
-				glVertexAttribPointer(1, 3, GL_FLOAT, false, stride, (void*)vertexDescriptorList.GetNormalOffset());
+				SetVertexAttribute(1, vertexDescriptorList.GetElementFromIndex(vertexDescriptorList.GetNormalIndex()), stride, vertexDescriptorList.GetNormalOffset());
 			}
 			else
 			{
@@ -970,9 +1268,9 @@ void RendererOpengl::UploadMeshData(MeshData& meshData)
 			}
 		}
 
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		OpenGLStateCache::BindVertexArray(0);
+		OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
 #pragma warning( pop )
@@ -982,7 +1280,7 @@ void RendererOpengl::UseShaderProgram(unsigned int programId)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	glUseProgram(programId); // Cannot remove this for now
+	OpenGLStateCache::UseProgram(programId);
 }
 
 int RendererOpengl::GetBufferTypeEnum(BufferType bufferType)
@@ -1034,6 +1332,55 @@ int RendererOpengl::GetWrapModeEnum(WrapMode wrapMode)
 	return mode;
 }
 
+void RendererOpengl::SetVertexAttribute(unsigned int location, VertexElement vertexElement, int stride, size_t offset)
+{
+	int componentCount = 3;
+	GLenum type = GL_FLOAT;
+	bool normalized = false;
+	switch (vertexElement)
+	{
+	case VertexElement::POSITION_16_BITS:
+	case VertexElement::NORMAL_16_BITS:
+		type = GL_SHORT;
+		normalized = true;
+		break;
+	case VertexElement::POSITION_8_BITS:
+	case VertexElement::NORMAL_8_BITS:
+		type = GL_BYTE;
+		normalized = true;
+		break;
+	case VertexElement::UV_32_BITS:
+		componentCount = 2;
+		break;
+	case VertexElement::UV_16_BITS:
+		componentCount = 2;
+		type = GL_UNSIGNED_SHORT;
+		normalized = true;
+		break;
+	case VertexElement::UV_8_BITS:
+		componentCount = 2;
+		type = GL_UNSIGNED_BYTE;
+		normalized = true;
+		break;
+	// Decoded by the OCTAHEDRAL_NORMALS variant of the shaders
+	case VertexElement::NORMAL_OCTAHEDRAL_8_BITS:
+		componentCount = 2;
+		type = GL_BYTE;
+		normalized = true;
+		break;
+	case VertexElement::NORMAL_OCTAHEDRAL_16_BITS:
+		componentCount = 2;
+		type = GL_SHORT;
+		normalized = true;
+		break;
+	default:
+		break;
+	}
+
+	glEnableVertexAttribArray(location);
+	glVertexAttribPointer(location, componentCount, type, normalized, stride, (void*)offset);
+}
+
 // int RendererOpengl::GetCullFaceEnum(CullFace face)
 // {
 // 	int side = GL_BACK;
@@ -19,6 +19,8 @@
 #include <engine/lighting/lighting.h>
 #include <engine/graphics/texture/texture.h>
 
+class Shader;
+
 enum class BufferType
 {
 	Array_Buffer,
@@ -57,6 +59,19 @@ public:
 	void DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, RenderingSettings& settings) override;
 	void DrawSubMesh(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings) override;
 	void DrawLine(const Vector3& a, const Vector3& bn, const Color& color, RenderingSettings& settings) override;
+	void DrawDebugVertices(const DebugDrawVertex* vertices, size_t vertexCount, bool isTriangleList, RenderingSettings& settings) override;
+	[[nodiscard]] bool IsInstancingSupported() const override;
+	void DrawSubMeshInstanced(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, RenderingSettings& settings, const RenderInstanceData* instances, size_t instanceCount) override;
+	[[nodiscard]] bool IsVertexStreamingSupported() const override;
+	void UpdateSubMeshVertices(const MeshData::SubMesh& subMesh, uint32_t vertexCount) override;
+	void UpdateSubMeshIndices(const MeshData::SubMesh& subMesh, uint32_t indexCount) override;
+	[[nodiscard]] bool IsCubemapSupported() const override;
+	[[nodiscard]] unsigned int CreateCubemap(const unsigned char* const* faces, int faceSize) override;
+	void DeleteCubemap(unsigned int cubemapId) override;
+	void DrawCubemapSubMesh(const MeshData::SubMesh& subMesh, unsigned int cubemapId, RenderingSettings& settings) override;
+	void BeginGpuTimer() override;
+	void EndGpuTimer() override;
+	[[nodiscard]] float GetGpuFrameTime() const override;
 	[[nodiscard]] unsigned int CreateNewTexture() override;
 	void DeleteTexture(Texture& texture) override;
 	void SetTextureData(const Texture& texture, unsigned int textureType, const unsigned char* buffer) override;
@@ -73,6 +88,11 @@ public:
 	void Setlights(const LightsIndices& lightsIndices) override;
 
 private:
+	/**
+	* @brief Apply the rendering settings, the color and bind the mesh and the texture before a draw call
+	*/
+	void PrepareSubMeshDraw(const MeshData::SubMesh& subMesh, const Material& material, const Texture& texture, const RenderingSettings& settings);
+
 	void ApplyTextureFilters(const Texture& texture);
 	[[nodiscard]] unsigned int CreateVertexArray();
 	[[nodiscard]] unsigned int CreateBuffer();
@@ -83,6 +103,11 @@ private:
 	[[nodiscard]] int GetBufferTypeEnum(BufferType bufferType);
 	// int GetBufferModeEnum(BufferMode bufferMode);
 	[[nodiscard]] int GetWrapModeEnum(WrapMode wrapMode);
+
+	/**
+	* @brief Enable a vertex attribute with the format of a vertex element (floats, normalized integers or octahedral normals)
+	*/
+	void SetVertexAttribute(unsigned int location, VertexElement vertexElement, int stride, size_t offset);
 	int maxLightCount = 8;
 	void DisableAllLight();
 	void SetLight(const int lightIndex, const Light& light, const Vector3& lightPosition, const Vector3& lightDirection) override;
@@ -94,12 +119,29 @@ private:
 	// int GetCullFaceEnum(CullFace face);
 	// float GetAnisotropicValueEnum(Texture::AnisotropicLevel level);
 
-	RenderingSettings lastSettings;
-	unsigned int usedTexture = 0;
 	unsigned int lastUsedColor = 0x00000000;
 	unsigned int lastUsedColor2 = 0xFFFFFFFF;
-	unsigned int lastUsedVAO = 0;
-	uint64_t lastShaderIdUsedColor = 0;
+	// Program that received the last color (the variants of the shaders have no file id)
+	const Shader* lastShaderUsedColor = nullptr;
+
+	// Vertex attribute locations of the instance matrices (one location per column, see the standard shaders)
+	static constexpr unsigned int s_instanceModelLocation = 4;
+	static constexpr unsigned int s_instanceMVPLocation = 8;
+	static constexpr unsigned int s_instanceNormalMatrixLocation = 12;
+	// Size of the streaming buffer of the instance data
+	static constexpr size_t s_instanceBufferSize = 1024 * 1024;
+	unsigned int instanceBuffer = 0;
+	size_t instanceBufferOffset = 0;
+	bool isInstancingSupported = false;
+	// Vertex buffer of the debug lines and triangles, rewritten for each draw
+	unsigned int debugDrawBuffer = 0;
+	// Timer queries of the last frames, a query is read when its slot is reused to not wait for the GPU
+	static constexpr size_t s_gpuTimerQueryCount = 4;
+	std::array<unsigned int, s_gpuTimerQueryCount> gpuTimerQueries = {};
+	std::array<bool, s_gpuTimerQueryCount> isGpuTimerQueryPending = {};
+	size_t gpuTimerQueryIndex = 0;
+	bool isGpuTimerRunning = false;
+	float gpuFrameTime = -1;
 	// int GetDrawModeEnum(DrawMode drawMode);
 };
 #endif
\ No newline at end of file
@@ -62,6 +62,31 @@ void Shader::Init()
 	m_canvasCameraTransformationMatrix = glm::lookAt(glm::vec3(0, 0, 0), glm::vec3(0, 0, 1), glm::vec3(0, 1, 0));
 }
 
+void Shader::SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector4& value)
+{
+	SetShaderAttribut(std::string(uniform.GetName()), value);
+}
+
+void Shader::SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector3& value)
+{
+	SetShaderAttribut(std::string(uniform.GetName()), value);
+}
+
+void Shader::SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector2& value)
+{
+	SetShaderAttribut(std::string(uniform.GetName()), value);
+}
+
+void Shader::SetShaderAttribut(const ShaderUniformHandle& uniform, float value)
+{
+	SetShaderAttribut(std::string(uniform.GetName()), value);
+}
+
+void Shader::SetShaderAttribut(const ShaderUniformHandle& uniform, int value)
+{
+	SetShaderAttribut(std::string(uniform.GetName()), value);
+}
+
 Shader::Shader()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
@@ -204,13 +229,21 @@ std::shared_ptr<Shader> Shader::MakeShader()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
+	std::shared_ptr<Shader> newFileRef;
+	if (Engine::GetArguments().useNullRenderer)
+	{
+		newFileRef = std::make_shared<ShaderNull>();
+	}
+	else
+	{
 #if defined(__PS3__)
-	std::shared_ptr<Shader> newFileRef = std::make_shared<ShaderRSX>();
+		newFileRef = std::make_shared<ShaderRSX>();
 #elif defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
-	std::shared_ptr<Shader> newFileRef = std::make_shared<ShaderOpenGL>();
+		newFileRef = std::make_shared<ShaderOpenGL>();
 #else
-	std::shared_ptr<Shader> newFileRef = std::make_shared<ShaderNull>();
+		newFileRef = std::make_shared<ShaderNull>();
 #endif
+	}
 	AssetManager::AddFileReference(newFileRef);
 	return newFileRef;
 }
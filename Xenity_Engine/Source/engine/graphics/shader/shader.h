@@ -14,6 +14,7 @@
 #include <engine/file_system/file_reference.h>
 
 #include <engine/constants.h>
+#include <engine/graphics/shader/shader_uniform_handle.h>
 
 class Light;
 class Material;
@@ -174,6 +175,26 @@ protected:
 	*/
 	virtual void SetShaderModel(const glm::mat4& trans, const glm::mat3& normalMatrix, const glm::mat4& mvpMatrix) = 0;
 
+	/**
+	* @brief Get if the shader can read the object matrices from the instance attributes
+	*/
+	[[nodiscard]] virtual bool IsInstancingSupported() const { return false; }
+
+	/**
+	* @brief Set if the shader reads the object matrices from the instance attributes instead of the model uniforms
+	*/
+	virtual void SetUseInstancing(bool useInstancing) {}
+
+	/**
+	* @brief Get if the camera uniforms have to be sent to this shader (false if the shader reads them from a shared buffer or does not use them)
+	*/
+	[[nodiscard]] virtual bool NeedsCameraUniforms() const { return true; }
+
+	/**
+	* @brief Get if the light uniforms have to be sent to this shader (false if the shader reads them from a shared buffer or does not use them)
+	*/
+	[[nodiscard]] virtual bool NeedsLightUniforms() const { return true; }
+
 	virtual void SetShaderOffsetAndTiling(const Vector2& offset, const Vector2& tiling) = 0;
 
 	virtual void SetAlphaThreshold(float alphaThreshold) = 0;
@@ -197,6 +218,15 @@ protected:
 	virtual void SetShaderAttribut(const std::string& attribut, float value) = 0;
 	virtual void SetShaderAttribut(const std::string& attribut, int value) = 0;
 
+	/**
+	* @brief Set the shader uniform for basic types from a handle (the name is not hashed or copied again)
+	*/
+	virtual void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector4& value);
+	virtual void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector3& value);
+	virtual void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector2& value);
+	virtual void SetShaderAttribut(const ShaderUniformHandle& uniform, float value);
+	virtual void SetShaderAttribut(const ShaderUniformHandle& uniform, int value);
+
 	/**
 	* @brief Update lights in the shader
 	*/
@@ -239,6 +269,13 @@ protected:
 	static glm::mat4 m_canvasCameraTransformationMatrix;
 
 	bool m_useTessellation = false;
+
+	// Incremented each time a material sends its uniforms to this shader (see Material::AreUniformsUpToDate)
+	uint64_t m_materialGeneration = 0;
+
+	// Same shader compiled with the OCTAHEDRAL_NORMALS define, used by the materials to draw the meshes with octahedral normals
+	// nullptr if the shader code does not use the define
+	std::shared_ptr<Shader> m_octahedralNormalsVariant;
 	
 	std::vector<Light*> m_currentLights;
 	std::vector<Light*> m_currentDirectionalLights;
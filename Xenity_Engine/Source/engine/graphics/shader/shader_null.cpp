@@ -4,4 +4,23 @@
 //
 // This file is part of Xenity Engine
 
-#include "shader_null.h"
\ No newline at end of file
+#include "shader_null.h"
+
+#include <engine/graphics/graphics.h>
+#include <engine/graphics/renderer/renderer.h>
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+
+bool ShaderNull::Use()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	// Mark the shader as used like the real shaders, otherwise nothing is sent to the renderer
+	if (Graphics::s_currentShader != this)
+	{
+		Engine::GetRenderer().UseShaderProgram(static_cast<unsigned int>(m_fileId));
+		Graphics::s_currentShader = this;
+		return true;
+	}
+	return false;
+}
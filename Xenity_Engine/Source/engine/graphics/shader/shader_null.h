@@ -17,7 +17,7 @@ public:
 	void Load(const LoadOptions& loadOptions) override {}
 	void CreateShader(Shader::ShaderType type) override {}
 
-	bool Use() override { return false; }
+	bool Use() override;
 
 	void SetShaderCameraPosition() override {}
 
@@ -29,6 +29,9 @@ public:
 
 	void SetShaderModel(const glm::mat4& trans, const glm::mat3& normalMatrix, const glm::mat4& mvpMatrix) override {}
 
+	// Let the null renderer count the instanced draw calls
+	[[nodiscard]] bool IsInstancingSupported() const override { return true; }
+
 	void SetShaderModel(const Vector3& position, const Vector3& eulerAngle, const Vector3& scale) override {}
 
 	void SetLightIndices(const LightsIndices& lightsIndices) override {}
@@ -38,6 +41,11 @@ public:
 	void SetShaderAttribut(const std::string& attribut, const Vector2& value) override {}
 	void SetShaderAttribut(const std::string& attribut, float value) override {}
 	void SetShaderAttribut(const std::string& attribut, int value) override {}
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector4& value) override {}
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector3& value) override {}
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector2& value) override {}
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, float value) override {}
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, int value) override {}
 
 	void UpdateLights() override {}
 
@@ -11,6 +11,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 #include <engine/graphics/graphics.h>
 #include <engine/application.h>
 #include <engine/file_system/file.h>
@@ -29,8 +32,43 @@
 #include <engine/asset_management/asset_manager.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <engine/file_system/async_file_loading.h>
+#include <engine/graphics/renderer/opengl_state_cache.h>
 
 unsigned int uboLightBlock;
+unsigned int uboCameraBlock = 0;
+unsigned int uboLightsDataBlock = 0;
+
+namespace
+{
+	constexpr unsigned int s_lightIndicesBindingPoint = 0;
+	constexpr unsigned int s_cameraBindingPoint = 1;
+	constexpr unsigned int s_lightsDataBindingPoint = 2;
+
+	constexpr ShaderUniformHandle s_offsetUniform("offset");
+	constexpr ShaderUniformHandle s_tilingUniform("tiling");
+
+	constexpr const char* s_octahedralNormalsDefine = "OCTAHEDRAL_NORMALS";
+
+	/**
+	* @brief Add a define after the #version line of a shader code
+	*/
+	[[nodiscard]] std::string AddDefine(const std::string& shaderCode, const char* define)
+	{
+		size_t insertPosition = 0;
+		const size_t versionPosition = shaderCode.find("#version");
+		if (versionPosition != std::string::npos)
+		{
+			const size_t lineEnd = shaderCode.find('\n', versionPosition);
+			insertPosition = lineEnd != std::string::npos ? lineEnd + 1 : shaderCode.size();
+		}
+
+		std::string newShaderCode = shaderCode;
+		newShaderCode.insert(insertPosition, std::string("#define ") + define + "\n");
+		return newShaderCode;
+	}
+}
+
+ShaderOpenGL::LightsBufferData ShaderOpenGL::s_lightsBufferData;
 
 ShaderOpenGL::PointLightVariableIds::PointLightVariableIds(int index, unsigned int programId)
 {
@@ -88,7 +126,7 @@ ShaderOpenGL::~ShaderOpenGL()
 					glDeleteShader(m_tessellationEvaluationShaderId);
 					glDeleteShader(m_fragmentShaderId);
 				}
-				glDeleteProgram(m_programId);
+				OpenGLStateCache::DeleteProgram(m_programId);
 			}
 		}
 		m_fileStatus = FileStatus::FileStatus_Not_Loaded;
@@ -101,11 +139,178 @@ void ShaderOpenGL::Init()
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
 	glGenBuffers(1, &uboLightBlock);
-	glBindBuffer(GL_UNIFORM_BUFFER, uboLightBlock);
+	OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboLightBlock);
 	glBufferData(GL_UNIFORM_BUFFER, sizeof(LightsIndices), NULL, GL_DYNAMIC_DRAW);
+
+	// Buffers shared by all the shaders, bound once to their binding points
+	glGenBuffers(1, &uboCameraBlock);
+	OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboCameraBlock);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBufferData), NULL, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, s_cameraBindingPoint, uboCameraBlock);
+
+	glGenBuffers(1, &uboLightsDataBlock);
+	OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboLightsDataBlock);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(LightsBufferData), NULL, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, s_lightsDataBindingPoint, uboLightsDataBlock);
 #endif
 }
 
+glm::vec4 ShaderOpenGL::GetLightBufferColor(const Light& light)
+{
+	const Vector4 lightColorV4 = light.color.GetRGBA().ToVector4();
+	return glm::vec4(lightColorV4.x, lightColorV4.y, lightColorV4.z, 0) * light.GetIntensity();
+}
+
+void ShaderOpenGL::FillPointLightBuffer(PointLightBufferData& data, const Light& light)
+{
+	Vector3 pos = Vector3(0);
+	if (light.GetTransformRaw())
+	{
+		pos = light.GetTransformRaw()->GetPosition();
+		pos.x = -pos.x;
+	}
+
+	data.position = glm::vec4(pos.x, pos.y, pos.z, 0);
+	data.color = GetLightBufferColor(light);
+	data.light_data = glm::vec4(lightConstant, light.GetLinearValue(), light.GetQuadraticValue(), 0);
+}
+
+void ShaderOpenGL::FillSpotLightBuffer(SpotLightBufferData& data, const Light& light)
+{
+	Vector3 pos = Vector3(0);
+	Vector3 dir = Vector3(0);
+	if (light.GetTransformRaw())
+	{
+		pos = light.GetTransformRaw()->GetPosition();
+		pos.x = -pos.x;
+
+		dir = light.GetTransformRaw()->GetForward();
+		dir.x = -dir.x;
+	}
+
+	data.position = glm::vec4(pos.x, pos.y, pos.z, 0);
+	data.direction = glm::vec4(dir.x, dir.y, dir.z, 0);
+	data.color = GetLightBufferColor(light);
+	data.light_data = glm::vec4(light.GetLinearValue(),
+		light.GetQuadraticValue(),
+		glm::cos(glm::radians(light.GetSpotAngle() * (1 - light.GetSpotSmoothness()))),
+		glm::cos(glm::radians(light.GetSpotAngle())));
+}
+
+void ShaderOpenGL::FillDirectionalLightBuffer(DirectionalLightBufferData& data, const Light& light)
+{
+	Vector3 dir = Vector3(0);
+	if (light.GetTransformRaw())
+	{
+		dir = light.GetTransformRaw()->GetForward();
+		dir.x = -dir.x;
+	}
+
+	data.direction = glm::vec4(dir.x, dir.y, dir.z, 0);
+	data.color = GetLightBufferColor(light);
+}
+
+void ShaderOpenGL::UpdateCameraBuffer(bool isCanvas)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	if (uboCameraBlock == 0 || Graphics::usedCamera == nullptr)
+	{
+		return;
+	}
+
+	const Camera& camera = *Graphics::usedCamera;
+	CameraBufferData data;
+	if (isCanvas)
+	{
+		data.view = m_canvasCameraTransformationMatrix;
+		data.projection = camera.GetCanvasProjection();
+		data.viewProjection = data.projection * data.view;
+		data.cameraPosition = glm::vec4(0, 0, 0, 1);
+		data.fogColor = glm::vec4(0);
+		data.fogData = glm::vec4(0);
+	}
+	else
+	{
+		const Vector3& camPos = camera.GetTransformRaw()->GetPosition();
+		const GraphicsSettings& settings = Graphics::s_settings;
+		const Vector4 fogColor = settings.fogColor.GetRGBA().ToVector4();
+
+		data.view = camera.viewMatrix;
+		data.projection = camera.GetProjection();
+		data.viewProjection = camera.m_viewProjectionMatrix;
+		data.cameraPosition = glm::vec4(-camPos.x, camPos.y, camPos.z, 1);
+		data.fogColor = glm::vec4(fogColor.x, fogColor.y, fogColor.z, fogColor.w);
+		data.fogData = glm::vec4(settings.fogStart, settings.fogEnd, settings.isFogEnabled ? 1.0f : 0.0f, 0);
+	}
+
+	OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboCameraBlock);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(data), &data);
+}
+
+void ShaderOpenGL::UpdateLightsBuffer()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	if (uboLightsDataBlock == 0)
+	{
+		return;
+	}
+
+	// Same layout as the per shader uniforms: the first light of each type is a dark light,
+	// then the lights are stored at their m_indexInShaderList + 1
+	FillPointLightBuffer(s_lightsBufferData.pointLights[0], *defaultDarkLight);
+	FillSpotLightBuffer(s_lightsBufferData.spotLights[0], *defaultDarkLight);
+	FillDirectionalLightBuffer(s_lightsBufferData.directionalLights[0], *defaultDarkLight);
+
+	constexpr int offset = 1;
+	int directionalUsed = 0;
+	int pointUsed = 0;
+	int spotUsed = 0;
+	Vector4 ambientLight = Vector4(0, 0, 0, 0);
+
+	const int lightCount = AssetManager::GetLightCount();
+	for (int lightI = 0; lightI < lightCount; lightI++)
+	{
+		const Light& light = *AssetManager::GetLight(lightI);
+		if (light.IsEnabled() && light.GetGameObjectRaw()->IsLocalActive())
+		{
+			if (light.m_type == LightType::Directional)
+			{
+				if (directionalUsed + offset < MAX_LIGHT_COUNT)
+				{
+					FillDirectionalLightBuffer(s_lightsBufferData.directionalLights[directionalUsed + offset], light);
+				}
+				directionalUsed++;
+			}
+			else if (light.m_type == LightType::Point)
+			{
+				if (pointUsed + offset < MAX_LIGHT_COUNT)
+				{
+					FillPointLightBuffer(s_lightsBufferData.pointLights[pointUsed + offset], light);
+				}
+				pointUsed++;
+			}
+			else if (light.m_type == LightType::Spot)
+			{
+				if (spotUsed + offset < MAX_LIGHT_COUNT)
+				{
+					FillSpotLightBuffer(s_lightsBufferData.spotLights[spotUsed + offset], light);
+				}
+				spotUsed++;
+			}
+			else if (light.m_type == LightType::Ambient)
+			{
+				ambientLight += light.color.GetRGBA().ToVector4() * light.m_intensity;
+			}
+		}
+	}
+	s_lightsBufferData.ambientLight = glm::vec4(ambientLight.x, ambientLight.y, ambientLight.z, 0);
+
+	OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboLightsDataBlock);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(s_lightsBufferData), &s_lightsBufferData);
+}
+
 void ShaderOpenGL::OnLoadFileReferenceFinished()
 {
 	// Make sure the shader is loading on the main thread for OpenGL calls
@@ -122,6 +327,25 @@ void ShaderOpenGL::OnLoadFileReferenceFinished()
 		{
 			Link();
 			m_fileStatus = FileStatus::FileStatus_Loaded;
+
+			// The meshes with octahedral normals are drawn with a variant that decodes them
+			// The variant is added to the AssetManager by the Shader constructor, so it gets the light and camera updates like the other shaders
+			m_octahedralNormalsVariant.reset();
+			if (vertexShaderCode.find(s_octahedralNormalsDefine) != std::string::npos)
+			{
+				std::shared_ptr<ShaderOpenGL> variant = std::make_shared<ShaderOpenGL>();
+				if (variant->Compile(AddDefine(vertexShaderCode, s_octahedralNormalsDefine), ShaderType::Vertex_Shader) &&
+					variant->Compile(AddDefine(fragmentShaderCode, s_octahedralNormalsDefine), ShaderType::Fragment_Shader))
+				{
+					variant->Link();
+					variant->m_fileStatus = FileStatus::FileStatus_Loaded;
+					m_octahedralNormalsVariant = variant;
+				}
+				else
+				{
+					Debug::PrintError("[Shader::LoadFileReference] Cannot compile the OCTAHEDRAL_NORMALS variant of the shader: " + m_file->GetPath(), true);
+				}
+			}
 		}
 		else
 		{
@@ -156,7 +380,7 @@ bool ShaderOpenGL::Use()
 
 	if (Graphics::s_currentShader != this)
 	{
-		glUseProgram(m_programId);
+		OpenGLStateCache::UseProgram(m_programId);
 		Graphics::s_currentShader = this;
 		return true;
 	}
@@ -322,6 +546,30 @@ void ShaderOpenGL::SetShaderModel(const glm::mat4& trans, const glm::mat3& norma
 	}
 }
 
+bool ShaderOpenGL::IsInstancingSupported() const
+{
+	return m_useInstancingLocation != INVALID_SHADER_UNIFORM;
+}
+
+void ShaderOpenGL::SetUseInstancing(bool useInstancing)
+{
+	if (m_isUsingInstancing != useInstancing && m_useInstancingLocation != INVALID_SHADER_UNIFORM)
+	{
+		m_isUsingInstancing = useInstancing;
+		SetShaderAttribut(m_useInstancingLocation, useInstancing ? 1 : 0);
+	}
+}
+
+bool ShaderOpenGL::NeedsCameraUniforms() const
+{
+	return !m_useSharedCameraBuffer && (m_cameraLocation != INVALID_SHADER_UNIFORM || m_projectionLocation != INVALID_SHADER_UNIFORM);
+}
+
+bool ShaderOpenGL::NeedsLightUniforms() const
+{
+	return !m_useSharedLightsBuffer && m_hasLightUniforms;
+}
+
 /// <summary>
 /// Send to the shader transform's model
 /// </summary>
@@ -348,8 +596,8 @@ void ShaderOpenGL::SetShaderModel(const Vector3& position, const Vector3& rotati
 
 void ShaderOpenGL::SetShaderOffsetAndTiling(const Vector2& offset, const Vector2& tiling)
 {
-	SetShaderAttribut(m_offsetLocation, offset);
-	SetShaderAttribut(m_tilingLocation, tiling);
+	SetShaderAttribut(s_offsetUniform, offset);
+	SetShaderAttribut(s_tilingUniform, tiling);
 }
 
 void ShaderOpenGL::SetAlphaThreshold(float alphaThreshold) 
@@ -364,7 +612,7 @@ void ShaderOpenGL::SetLightIndices(const LightsIndices& lightsIndices)
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
-	glBindBuffer(GL_UNIFORM_BUFFER, uboLightBlock);
+	OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboLightBlock);
 	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(lightsIndices), &lightsIndices);
 #endif
 }
@@ -383,55 +631,161 @@ unsigned int ShaderOpenGL::GetShaderUniformLocation(unsigned int programId, cons
 	return glGetUniformLocation(programId, name);
 }
 
-unsigned int ShaderOpenGL::FindOrAddAttributId(const std::string& attribut)
+ShaderOpenGL::UniformSlot& ShaderOpenGL::FindOrAddUniformSlot(const ShaderUniformHandle& uniform)
+{
+	const uint64_t hash = uniform.GetHash();
+	auto it = std::lower_bound(m_uniformSlots.begin(), m_uniformSlots.end(), hash,
+		[](const UniformSlot& slot, uint64_t value) { return slot.hash < value; });
+	if (it == m_uniformSlots.end() || it->hash != hash)
+	{
+		// Not an active uniform found at link time, keep the location (maybe invalid) to not query it again
+		UniformSlot slot;
+		slot.hash = hash;
+		slot.location = GetShaderUniformLocation(uniform.GetName());
+		it = m_uniformSlots.insert(it, slot);
+	}
+	return *it;
+}
+
+bool ShaderOpenGL::UpdateUniformSlotCache(UniformSlot& slot, const void* value, uint8_t componentCount, bool isInt)
+{
+	const size_t size = componentCount * sizeof(uint32_t);
+	if (slot.componentCount == componentCount && slot.isInt == isInt && memcmp(slot.cachedValue, value, size) == 0)
+	{
+		return false;
+	}
+
+	memcpy(slot.cachedValue, value, size);
+	slot.componentCount = componentCount;
+	slot.isInt = isInt;
+	return true;
+}
+
+void ShaderOpenGL::RegisterActiveUniforms()
 {
-	auto it = m_uniformsIds.find(attribut);
-	if (it == m_uniformsIds.end())
+	m_uniformSlots.clear();
+
+#if !defined(__vita__)
+	GLint uniformCount = 0;
+	glGetProgramiv(m_programId, GL_ACTIVE_UNIFORMS, &uniformCount);
+	GLint maxNameLength = 0;
+	glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+	if (uniformCount <= 0 || maxNameLength <= 0)
+	{
+		return;
+	}
+
+	std::vector<char> name(maxNameLength);
+	m_uniformSlots.reserve(uniformCount);
+	for (GLint i = 0; i < uniformCount; i++)
 	{
-		const unsigned int id = GetShaderUniformLocation(attribut.c_str());
-		it = m_uniformsIds.emplace(attribut, id).first;
+		GLsizei nameLength = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(m_programId, i, maxNameLength, &nameLength, &size, &type, name.data());
+
+		UniformSlot slot;
+		slot.location = glGetUniformLocation(m_programId, name.data());
+		if (slot.location == INVALID_SHADER_UNIFORM)
+		{
+			// Uniform from a block
+			continue;
+		}
+
+		// Arrays are named "name[0]", register them with their short name
+		if (nameLength > 3 && strcmp(name.data() + nameLength - 3, "[0]") == 0)
+		{
+			nameLength -= 3;
+		}
+		slot.hash = ShaderUniformHandle::Hash(name.data(), nameLength);
+		m_uniformSlots.push_back(slot);
 	}
-	return it->second;
+
+	std::sort(m_uniformSlots.begin(), m_uniformSlots.end(), [](const UniformSlot& a, const UniformSlot& b) { return a.hash < b.hash; });
+#endif
 }
 
 void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, const Vector4& value)
+{
+	SetShaderAttribut(ShaderUniformHandle(attribut.c_str()), value);
+}
+
+void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, const Vector3& value)
+{
+	SetShaderAttribut(ShaderUniformHandle(attribut.c_str()), value);
+}
+
+void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, const Vector2& value)
+{
+	SetShaderAttribut(ShaderUniformHandle(attribut.c_str()), value);
+}
+
+void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, float value)
+{
+	SetShaderAttribut(ShaderUniformHandle(attribut.c_str()), value);
+}
+
+void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, int value)
+{
+	SetShaderAttribut(ShaderUniformHandle(attribut.c_str()), value);
+}
+
+void ShaderOpenGL::SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector4& value)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	unsigned int attributId = FindOrAddAttributId(attribut);
-	glUniform4f(attributId, value.x, value.y, value.z, value.w);
+	UniformSlot& slot = FindOrAddUniformSlot(uniform);
+	const float values[4] = { value.x, value.y, value.z, value.w };
+	if (slot.location != INVALID_SHADER_UNIFORM && UpdateUniformSlotCache(slot, values, 4, false))
+	{
+		glUniform4f(slot.location, value.x, value.y, value.z, value.w);
+	}
 }
 
-void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, const Vector3& value)
+void ShaderOpenGL::SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector3& value)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	unsigned int attributId = FindOrAddAttributId(attribut);
-	glUniform3f(attributId, value.x, value.y, value.z);
+	UniformSlot& slot = FindOrAddUniformSlot(uniform);
+	const float values[3] = { value.x, value.y, value.z };
+	if (slot.location != INVALID_SHADER_UNIFORM && UpdateUniformSlotCache(slot, values, 3, false))
+	{
+		glUniform3f(slot.location, value.x, value.y, value.z);
+	}
 }
 
-void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, const Vector2& value)
+void ShaderOpenGL::SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector2& value)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	unsigned int attributId = FindOrAddAttributId(attribut);
-	glUniform2f(attributId, value.x, value.y);
+	UniformSlot& slot = FindOrAddUniformSlot(uniform);
+	const float values[2] = { value.x, value.y };
+	if (slot.location != INVALID_SHADER_UNIFORM && UpdateUniformSlotCache(slot, values, 2, false))
+	{
+		glUniform2f(slot.location, value.x, value.y);
+	}
 }
 
-void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, float value)
+void ShaderOpenGL::SetShaderAttribut(const ShaderUniformHandle& uniform, float value)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	unsigned int attributId = FindOrAddAttributId(attribut);
-	glUniform1f(attributId, value);
+	UniformSlot& slot = FindOrAddUniformSlot(uniform);
+	if (slot.location != INVALID_SHADER_UNIFORM && UpdateUniformSlotCache(slot, &value, 1, false))
+	{
+		glUniform1f(slot.location, value);
+	}
 }
 
-void ShaderOpenGL::SetShaderAttribut(const std::string& attribut, int value)
+void ShaderOpenGL::SetShaderAttribut(const ShaderUniformHandle& uniform, int value)
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	unsigned int attributId = FindOrAddAttributId(attribut);
-	glUniform1i(attributId, value);
+	UniformSlot& slot = FindOrAddUniformSlot(uniform);
+	if (slot.location != INVALID_SHADER_UNIFORM && UpdateUniformSlotCache(slot, &value, 1, true))
+	{
+		glUniform1i(slot.location, value);
+	}
 }
 
 void ShaderOpenGL::SetShaderAttribut(unsigned int attributId, const Vector4& value)
@@ -506,6 +860,7 @@ void ShaderOpenGL::Link()
 	glVertexAttrib4f(3, 1.0f, 1.0f, 1.0f, 1.0f); // Valeur par dfaut
 	glLinkProgram(m_programId);
 	Engine::GetRenderer().UseShaderProgram(m_programId);
+	RegisterActiveUniforms();
 
 	m_modelLocation = GetShaderUniformLocation("model");
 	m_MVPLocation = GetShaderUniformLocation("MVP");
@@ -513,8 +868,8 @@ void ShaderOpenGL::Link()
 	m_projectionLocation = GetShaderUniformLocation("projection");
 	m_cameraLocation = GetShaderUniformLocation("camera");
 	m_ambientLightLocation = GetShaderUniformLocation("ambientLight");
-	m_tilingLocation = GetShaderUniformLocation("tiling");
-	m_offsetLocation = GetShaderUniformLocation("offset");
+	m_useInstancingLocation = GetShaderUniformLocation("useInstancing");
+	m_isUsingInstancing = false;
 #if defined(__vita__)
 	m_alphaThresholdLocation = GetShaderUniformLocation("alphaThreshold");
 #endif
@@ -531,6 +886,10 @@ void ShaderOpenGL::Link()
 		m_directionallightVariableIds.emplace_back(i, m_programId);
 		m_spotlightVariableIds.emplace_back(i, m_programId);
 	}
+	m_hasLightUniforms = m_pointlightVariableIds[0].color != INVALID_SHADER_UNIFORM ||
+		m_directionallightVariableIds[0].color != INVALID_SHADER_UNIFORM ||
+		m_spotlightVariableIds[0].color != INVALID_SHADER_UNIFORM ||
+		m_ambientLightLocation != INVALID_SHADER_UNIFORM;
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
 	GLuint blockIndex = -1;
@@ -546,11 +905,26 @@ void ShaderOpenGL::Link()
 	}
 	else
 	{
-		GLuint bindingPoint = 0;
+		GLuint bindingPoint = s_lightIndicesBindingPoint;
 		glUniformBlockBinding(m_programId, blockIndex, bindingPoint);
-		glBindBuffer(GL_UNIFORM_BUFFER, uboLightBlock);
+		OpenGLStateCache::BindBuffer(GL_UNIFORM_BUFFER, uboLightBlock);
 		glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, uboLightBlock);
 	}
+
+	// Shaders with the shared blocks do not need the per shader camera and light uniforms
+	const GLuint cameraBlockIndex = glGetUniformBlockIndex(m_programId, "CameraData");
+	m_useSharedCameraBuffer = cameraBlockIndex != GL_INVALID_INDEX;
+	if (m_useSharedCameraBuffer)
+	{
+		glUniformBlockBinding(m_programId, cameraBlockIndex, s_cameraBindingPoint);
+	}
+
+	const GLuint lightsDataBlockIndex = glGetUniformBlockIndex(m_programId, "LightsData");
+	m_useSharedLightsBuffer = lightsDataBlockIndex != GL_INVALID_INDEX;
+	if (m_useSharedLightsBuffer)
+	{
+		glUniformBlockBinding(m_programId, lightsDataBlockIndex, s_lightsDataBindingPoint);
+	}
 #endif // #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
 }
 
@@ -8,7 +8,11 @@
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
 
-#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
 
 #include <engine/graphics/shader/shader.h>
 /**
@@ -20,6 +24,17 @@ public:
 	~ShaderOpenGL();
 	static void Init();
 
+	/**
+	* @brief Upload the camera data in the buffer shared by all the shaders (call once per camera, and again for the canvas)
+	* @param isCanvas True to upload the canvas camera instead of the 3D camera
+	*/
+	static void UpdateCameraBuffer(bool isCanvas);
+
+	/**
+	* @brief Upload the lights in the buffer shared by all the shaders (call once per frame)
+	*/
+	static void UpdateLightsBuffer();
+
 protected:
 	void Load(const LoadOptions& loadOptions) override;
 	void CreateShader(Shader::ShaderType type) override;
@@ -56,6 +71,19 @@ protected:
 	*/
 	void SetShaderModel(const glm::mat4& trans, const glm::mat3& normalMatrix, const glm::mat4& mvpMatrix) override;
 
+	/**
+	* @brief Get if the shader has the useInstancing uniform
+	*/
+	[[nodiscard]] bool IsInstancingSupported() const override;
+
+	/**
+	* @brief Set the useInstancing uniform (only sent when the value changes)
+	*/
+	void SetUseInstancing(bool useInstancing) override;
+
+	[[nodiscard]] bool NeedsCameraUniforms() const override;
+	[[nodiscard]] bool NeedsLightUniforms() const override;
+
 	/**
 	* @brief Set the shader uniform of the object model
 	* @param position The position of the object
@@ -80,6 +108,15 @@ protected:
 	void SetShaderAttribut(const std::string& attribut, float value) override;
 	void SetShaderAttribut(const std::string& attribut, int value) override;
 
+	/**
+	* @brief Set the shader uniform for basic types from a handle, the call is skipped if the uniform already has this value
+	*/
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector4& value) override;
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector3& value) override;
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, const Vector2& value) override;
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, float value) override;
+	void SetShaderAttribut(const ShaderUniformHandle& uniform, int value) override;
+
 	static void SetShaderAttribut(unsigned int attributId, const Vector4& value);
 	static void SetShaderAttribut(unsigned int attributId, const Vector3& value);
 	static void SetShaderAttribut(unsigned int attributId, const Vector2& value);
@@ -129,7 +166,34 @@ protected:
 	*/
 	void SetSpotLightData(const Light& light, const int index) override;
 
-	[[nodiscard]] unsigned int FindOrAddAttributId(const std::string& attribut);
+	/**
+	* @brief Location of a uniform and its last uploaded value
+	*/
+	struct UniformSlot
+	{
+		uint64_t hash = 0;
+		unsigned int location = INVALID_SHADER_UNIFORM;
+		// Raw bits of the last uploaded value (floats or ints), valid if componentCount is not 0
+		uint32_t cachedValue[4] = { 0, 0, 0, 0 };
+		uint8_t componentCount = 0;
+		bool isInt = false;
+	};
+
+	/**
+	* @brief Fill the uniform slots with the active uniforms of the program (called by Link)
+	*/
+	void RegisterActiveUniforms();
+
+	/**
+	* @brief Find the slot of a uniform, the location is queried if the uniform is not in the slots yet
+	*/
+	[[nodiscard]] UniformSlot& FindOrAddUniformSlot(const ShaderUniformHandle& uniform);
+
+	/**
+	* @brief Store a value in the cache of a slot
+	* @return True if the value is different from the cached one and has to be sent to the program
+	*/
+	[[nodiscard]] static bool UpdateUniformSlotCache(UniformSlot& slot, const void* value, uint8_t componentCount, bool isInt);
 
 	class PointLightVariableIds
 	{
@@ -171,7 +235,7 @@ protected:
 	std::vector<PointLightVariableIds> m_pointlightVariableIds;
 	std::vector<DirectionalLightsVariableIds> m_directionallightVariableIds;
 	std::vector<SpotLightVariableIds> m_spotlightVariableIds;
-	std::unordered_map<std::string, unsigned int> m_uniformsIds;
+	std::vector<UniformSlot> m_uniformSlots; // Sorted by hash
 
 	unsigned int m_vertexShaderId = 0;
 	unsigned int m_fragmentShaderId = 0;
@@ -184,13 +248,65 @@ protected:
 	unsigned int m_projectionLocation = 0;
 	unsigned int m_cameraLocation = 0;
 	unsigned int m_ambientLightLocation = 0;
-	unsigned int m_tilingLocation = 0;
-	unsigned int m_offsetLocation = 0;
 	unsigned int m_alphaThresholdLocation = 0;
+	unsigned int m_useInstancingLocation = INVALID_SHADER_UNIFORM;
+	bool m_isUsingInstancing = false;
+	bool m_useSharedCameraBuffer = false;
+	bool m_useSharedLightsBuffer = false;
+	bool m_hasLightUniforms = false;
 
 	unsigned int m_usedPointLightCountLocation = 0;
 	unsigned int m_usedSpotLightCountLocation = 0;
 	unsigned int m_usedDirectionalLightCountLocation = 0;
+
+private:
+	// std140 layouts of the CameraData and LightsData shader blocks
+	struct alignas(16) CameraBufferData
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::mat4 viewProjection;
+		glm::vec4 cameraPosition;
+		glm::vec4 fogColor;
+		glm::vec4 fogData; // x = start, y = end, z = 1 if the fog is enabled
+	};
+
+	struct PointLightBufferData
+	{
+		glm::vec4 position;
+		glm::vec4 color;
+		glm::vec4 light_data;
+	};
+
+	struct SpotLightBufferData
+	{
+		glm::vec4 position;
+		glm::vec4 direction;
+		glm::vec4 color;
+		glm::vec4 light_data;
+	};
+
+	struct DirectionalLightBufferData
+	{
+		glm::vec4 direction;
+		glm::vec4 color;
+	};
+
+	struct alignas(16) LightsBufferData
+	{
+		PointLightBufferData pointLights[MAX_LIGHT_COUNT];
+		SpotLightBufferData spotLights[MAX_LIGHT_COUNT];
+		DirectionalLightBufferData directionalLights[MAX_LIGHT_COUNT];
+		glm::vec4 ambientLight;
+	};
+
+
+	[[nodiscard]] static glm::vec4 GetLightBufferColor(const Light& light);
+	static void FillPointLightBuffer(PointLightBufferData& data, const Light& light);
+	static void FillSpotLightBuffer(SpotLightBufferData& data, const Light& light);
+	static void FillDirectionalLightBuffer(DirectionalLightBufferData& data, const Light& light);
+
+	static LightsBufferData s_lightsBufferData;
 };
 
 #endif
\ No newline at end of file
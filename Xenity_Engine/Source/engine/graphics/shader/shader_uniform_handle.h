@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+* @brief Name of a shader uniform with its hash, computed once (at compile time when constructed from a string literal in a constexpr variable)
+* The name pointer is not copied, it has to live as long as the handle
+*/
+class ShaderUniformHandle
+{
+public:
+	constexpr explicit ShaderUniformHandle(const char* name) : m_name(name), m_hash(Hash(name))
+	{
+	}
+
+	/**
+	* @brief Get the name of the uniform
+	*/
+	[[nodiscard]] constexpr const char* GetName() const
+	{
+		return m_name;
+	}
+
+	/**
+	* @brief Get the hash of the uniform name
+	*/
+	[[nodiscard]] constexpr uint64_t GetHash() const
+	{
+		return m_hash;
+	}
+
+	/**
+	* @brief Hash a uniform name (64 bits FNV-1a)
+	*/
+	[[nodiscard]] static constexpr uint64_t Hash(const char* name)
+	{
+		size_t length = 0;
+		while (name[length] != '\0')
+		{
+			length++;
+		}
+		return Hash(name, length);
+	}
+
+	/**
+	* @brief Hash the first characters of a uniform name (64 bits FNV-1a)
+	* @param length Number of characters to hash
+	*/
+	[[nodiscard]] static constexpr uint64_t Hash(const char* name, size_t length)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+		for (size_t i = 0; i < length; i++)
+		{
+			hash ^= static_cast<uint8_t>(name[i]);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+private:
+	const char* m_name = nullptr;
+	uint64_t m_hash = 0;
+};
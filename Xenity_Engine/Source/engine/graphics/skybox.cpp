@@ -14,6 +14,7 @@
 #include <engine/file_system/file.h>
 #include <engine/debug/stack_debug_object.h>
 #include <engine/graphics/texture/texture.h>
+#include <engine/graphics/texture/cubemap.h>
 
 using ordered_json = nlohmann::ordered_json;
 
@@ -44,6 +45,8 @@ void SkyBox::OnReflectionUpdated()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
+	m_isCubemapDirty = true;
+
 #if defined(EDITOR)
 	ordered_json jsonData;
 	jsonData["Values"] = ReflectionUtils::ReflectiveDataToJson(GetReflectiveData());
@@ -78,6 +81,7 @@ void SkyBox::LoadFileReference(const LoadOptions& loadOptions)
 				return;
 			}
 			ReflectionUtils::JsonToReflectiveData(j, GetReflectiveData());
+			m_isCubemapDirty = true;
 
 			m_fileStatus = FileStatus::FileStatus_Loaded;
 		}
@@ -97,6 +101,23 @@ void SkyBox::UnloadFileReference()
 	down = nullptr;
 	left = nullptr;
 	right = nullptr;
+	m_cubemap.reset();
+	m_isCubemapDirty = true;
+}
+
+Cubemap* SkyBox::GetCubemap()
+{
+	if (m_isCubemapDirty)
+	{
+		m_isCubemapDirty = false;
+		m_cubemap.reset();
+
+		// Renderer space: X is flipped, so the right face is on +X
+		const std::shared_ptr<Texture> faces[6] = { right, left, up, down, front, back };
+		m_cubemap = Cubemap::Create(faces);
+	}
+
+	return m_cubemap.get();
 }
 
 std::shared_ptr<SkyBox> SkyBox::MakeSkyBox()
@@ -12,6 +12,7 @@
 #include <engine/reflection/reflection.h>
 
 class Texture;
+class Cubemap;
 
 /**
 * @brief Skybox file class
@@ -30,6 +31,7 @@ public:
 
 protected:
 	friend class ProjectManager;
+	friend class Graphics;
 
 	/**
 	* @brief Create a skybox
@@ -49,5 +51,14 @@ protected:
 	void LoadFileReference(const LoadOptions& loadOptions) override;
 	void UnloadFileReference() override;
 
+	/**
+	* @brief [Internal] Get the cubemap made of the six faces, created on the first call after a change of the faces
+	* @return The cubemap or nullptr if the renderer does not support cubemaps or if a face is missing
+	*/
+	[[nodiscard]] Cubemap* GetCubemap();
+
 	static constexpr int s_version = 1;
-};
\ No newline at end of file
+
+	std::shared_ptr<Cubemap> m_cubemap;
+	bool m_isCubemapDirty = true;
+};
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "compressed_texture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	void DecodeColorBlock(const unsigned char* block, unsigned char* pixels, bool allowTransparency)
+	{
+		const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+		const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+
+		int palette[4][4];
+		const uint16_t colors[2] = { color0, color1 };
+		for (int i = 0; i < 2; i++)
+		{
+			const int r = (colors[i] >> 11) & 31;
+			const int g = (colors[i] >> 5) & 63;
+			const int b = colors[i] & 31;
+			palette[i][0] = (r << 3) | (r >> 2);
+			palette[i][1] = (g << 2) | (g >> 4);
+			palette[i][2] = (b << 3) | (b >> 2);
+			palette[i][3] = 255;
+		}
+
+		// BC1 uses 3 colors and a transparent black when color0 <= color1, BC3 always uses 4 colors
+		const bool isFourColors = !allowTransparency || color0 > color1;
+		for (int c = 0; c < 3; c++)
+		{
+			if (isFourColors)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		palette[2][3] = 255;
+		palette[3][3] = isFourColors ? 255 : 0;
+
+		const uint32_t indices = static_cast<uint32_t>(block[4]) | (static_cast<uint32_t>(block[5]) << 8) |
+			(static_cast<uint32_t>(block[6]) << 16) | (static_cast<uint32_t>(block[7]) << 24);
+		for (int i = 0; i < 16; i++)
+		{
+			const int* color = palette[(indices >> (i * 2)) & 3];
+			for (int c = 0; c < 4; c++)
+			{
+				pixels[i * 4 + c] = static_cast<unsigned char>(color[c]);
+			}
+		}
+	}
+
+	void DecodeSingleChannelBlock(const unsigned char* block, unsigned char* pixels, int channel)
+	{
+		const int value0 = block[0];
+		const int value1 = block[1];
+
+		int palette[8];
+		palette[0] = value0;
+		palette[1] = value1;
+		if (value0 > value1)
+		{
+			for (int i = 2; i < 8; i++)
+			{
+				palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+			}
+		}
+		else
+		{
+			for (int i = 2; i < 6; i++)
+			{
+				palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		uint64_t indices = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+		}
+		for (int i = 0; i < 16; i++)
+		{
+			pixels[i * 4 + channel] = static_cast<unsigned char>(palette[(indices >> (i * 3)) & 7]);
+		}
+	}
+}
+
+void CompressedTexture::DecodeBlock(CompressedTextureFormat format, const unsigned char* block, unsigned char* pixels)
+{
+	switch (format)
+	{
+	case CompressedTextureFormat::BC1:
+		DecodeColorBlock(block, pixels, true);
+		break;
+	case CompressedTextureFormat::BC3:
+		DecodeColorBlock(block + 8, pixels, false);
+		DecodeSingleChannelBlock(block, pixels, 3);
+		break;
+	case CompressedTextureFormat::BC5:
+		for (int i = 0; i < 16; i++)
+		{
+			pixels[i * 4 + 2] = 0;
+			pixels[i * 4 + 3] = 255;
+		}
+		DecodeSingleChannelBlock(block, pixels, 0);
+		DecodeSingleChannelBlock(block + 8, pixels, 1);
+		break;
+	case CompressedTextureFormat::RGBA8:
+		// Not block compressed, the pixels are copied by DecodeImage
+		break;
+	}
+}
+
+void CompressedTexture::DecodeImage(CompressedTextureFormat format, const unsigned char* data, int width, int height, unsigned char* pixels)
+{
+	if (format == CompressedTextureFormat::RGBA8)
+	{
+		memcpy(pixels, data, CompressedTextureHeader::GetImageSize(format, width, height));
+		return;
+	}
+
+	const size_t blockSize = CompressedTextureHeader::GetBlockSize(format);
+	const unsigned char* block = data;
+	unsigned char blockPixels[16 * 4];
+	for (int blockY = 0; blockY < height; blockY += 4)
+	{
+		for (int blockX = 0; blockX < width; blockX += 4)
+		{
+			DecodeBlock(format, block, blockPixels);
+			block += blockSize;
+
+			// The pixels of the last blocks can be outside of the image
+			const int blockWidth = std::min(4, width - blockX);
+			const int blockHeight = std::min(4, height - blockY);
+			for (int y = 0; y < blockHeight; y++)
+			{
+				memcpy(&pixels[(static_cast<size_t>(blockY + y) * width + blockX) * 4], &blockPixels[y * 16], blockWidth * 4);
+			}
+		}
+	}
+}
+
+unsigned char* CompressedTexture::DecodeFirstLevel(const unsigned char* fileData, size_t fileSize, int& width, int& height)
+{
+	CompressedTextureHeader header;
+	if (!CompressedTextureHeader::Read(fileData, fileSize, header))
+		return nullptr;
+
+	width = static_cast<int>(header.width);
+	height = static_cast<int>(header.height);
+	const size_t levelSize = CompressedTextureHeader::GetImageSize(header.format, width, height);
+	const size_t dataOffset = sizeof(CompressedTextureHeader) + sizeof(uint32_t);
+	if (header.mipCount == 0 || dataOffset + levelSize > fileSize)
+		return nullptr;
+
+	unsigned char* pixels = static_cast<unsigned char*>(malloc(static_cast<size_t>(width) * height * 4));
+	if (!pixels)
+		return nullptr;
+
+	DecodeImage(header.format, fileData + dataOffset, width, height, pixels);
+	return pixels;
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <engine/api.h>
+
+/**
+* @brief Formats of the cooked texture files
+*/
+enum class CompressedTextureFormat : uint32_t
+{
+	BC1 = 0, // RGB, 8 bytes per 4x4 block
+	BC3 = 1, // RGBA, 16 bytes per 4x4 block
+	BC5 = 2, // RG (normal maps), 16 bytes per 4x4 block
+	RGBA8 = 3, // Not compressed, 4 bytes per pixel (streamed textures without compression, for their mip levels)
+};
+
+/**
+* @brief Header of the compressed texture files written by the cooker
+*
+* The header is followed by the mip levels (biggest first), each level is its size in bytes (uint32_t) and its blocks (or pixels for RGBA8).
+*/
+struct CompressedTextureHeader
+{
+	char magic[4] = { 'X', 'C', 'T', 'X' };
+	uint32_t version = 1;
+	CompressedTextureFormat format = CompressedTextureFormat::BC1;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t mipCount = 0;
+
+	/**
+	* @brief Read the header at the start of a texture file
+	* @return False if the file is not a compressed texture (PNG, JPG...)
+	*/
+	[[nodiscard]] static bool Read(const unsigned char* data, size_t size, CompressedTextureHeader& header)
+	{
+		if (size < sizeof(CompressedTextureHeader))
+			return false;
+
+		const CompressedTextureHeader expected;
+		if (memcmp(data, expected.magic, sizeof(expected.magic)) != 0)
+			return false;
+
+		memcpy(&header, data, sizeof(CompressedTextureHeader));
+		return header.version == expected.version && header.format <= CompressedTextureFormat::RGBA8 && header.width != 0 && header.height != 0;
+	}
+
+	/**
+	* @brief Get the size in bytes of a 4x4 block (not used by RGBA8)
+	*/
+	[[nodiscard]] static size_t GetBlockSize(CompressedTextureFormat format)
+	{
+		return format == CompressedTextureFormat::BC1 ? 8 : 16;
+	}
+
+	/**
+	* @brief Get the size in bytes of an image (the last blocks are padded)
+	*/
+	[[nodiscard]] static size_t GetImageSize(CompressedTextureFormat format, int width, int height)
+	{
+		if (format == CompressedTextureFormat::RGBA8)
+			return static_cast<size_t>(width) * height * 4;
+
+		return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+	}
+
+	/**
+	* @brief Get the size in bytes of the blocks of a level (without the level size)
+	*/
+	[[nodiscard]] size_t GetLevelSize(uint32_t level) const
+	{
+		const int levelWidth = static_cast<int>(width >> level);
+		const int levelHeight = static_cast<int>(height >> level);
+		return GetImageSize(format, levelWidth > 1 ? levelWidth : 1, levelHeight > 1 ? levelHeight : 1);
+	}
+
+	/**
+	* @brief Get the size in bytes of the blocks of the levels from firstLevel to the last level (without the level sizes)
+	*/
+	[[nodiscard]] size_t GetLevelsSize(uint32_t firstLevel) const
+	{
+		size_t size = 0;
+		for (uint32_t level = firstLevel; level < mipCount; level++)
+		{
+			size += GetLevelSize(level);
+		}
+		return size;
+	}
+
+	/**
+	* @brief Get the position of a level in the file (position of its size), mipCount gives the end of the file
+	*/
+	[[nodiscard]] size_t GetLevelOffset(uint32_t level) const
+	{
+		size_t offset = sizeof(CompressedTextureHeader);
+		for (uint32_t i = 0; i < level; i++)
+		{
+			offset += sizeof(uint32_t) + GetLevelSize(i);
+		}
+		return offset;
+	}
+};
+
+/**
+* @brief CPU decoding of the cooked texture files (for the code that needs the pixels, like the cubemaps)
+*/
+class API CompressedTexture
+{
+public:
+	/**
+	* @brief Decode a 4x4 block
+	* @param block Block data (GetBlockSize bytes)
+	* @param pixels 16 RGBA pixels (row by row), BC5 gives 0 in blue and 255 in alpha
+	*/
+	static void DecodeBlock(CompressedTextureFormat format, const unsigned char* block, unsigned char* pixels);
+
+	/**
+	* @brief Decode an image (one level of a file, without its size)
+	* @param data Blocks of the image (GetImageSize bytes)
+	* @param pixels width * height RGBA pixels
+	*/
+	static void DecodeImage(CompressedTextureFormat format, const unsigned char* data, int width, int height, unsigned char* pixels);
+
+	/**
+	* @brief Decode the biggest level of a compressed texture file
+	* @return RGBA pixels allocated with malloc, nullptr if the file is not valid
+	*/
+	[[nodiscard]] static unsigned char* DecodeFirstLevel(const unsigned char* fileData, size_t fileSize, int& width, int& height);
+};
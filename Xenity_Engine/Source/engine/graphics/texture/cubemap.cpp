@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "cubemap.h"
+
+#include <malloc.h>
+#include <algorithm>
+
+#include <stb_image.h>
+#include <stb_image_resize.h>
+
+#include <engine/engine.h>
+#include <engine/debug/debug.h>
+#include <engine/debug/stack_debug_object.h>
+#include <engine/file_system/file.h>
+#include <engine/graphics/renderer/renderer.h>
+#include "texture.h"
+#include "compressed_texture.h"
+
+Cubemap::~Cubemap()
+{
+	Engine::GetRenderer().DeleteCubemap(m_cubemapId);
+}
+
+unsigned char* Cubemap::ReadFacePixels(const Texture& texture, int& faceSize)
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	size_t fileBufferSize = 0;
+	unsigned char* fileData = texture.ReadBinary(fileBufferSize);
+	if (!fileData)
+	{
+		return nullptr;
+	}
+
+	int width = 0;
+	int height = 0;
+	int channelCount = 0;
+	unsigned char* pixels = stbi_load_from_memory(fileData, static_cast<int>(fileBufferSize), &width, &height, &channelCount, 4);
+	if (!pixels)
+	{
+		// The cooker can compress the textures of the standalone builds
+		pixels = CompressedTexture::DecodeFirstLevel(fileData, fileBufferSize, width, height);
+	}
+#if defined(EDITOR)
+	delete[] fileData;
+#else
+	free(fileData);
+#endif
+
+	if (!pixels)
+	{
+		return nullptr;
+	}
+
+	if (faceSize == 0)
+	{
+		faceSize = std::min(std::max(width, height), static_cast<int>(texture.GetCookResolution()));
+	}
+
+	if (width == faceSize && height == faceSize)
+	{
+		return pixels;
+	}
+
+	// The faces of a cubemap have to be square and have the same size
+	unsigned char* resizedPixels = static_cast<unsigned char*>(malloc(faceSize * faceSize * 4)); // Keep this malloc because stbi_load_from_memory uses malloc internally
+	stbir_resize_uint8(pixels, width, height, 0, resizedPixels, faceSize, faceSize, 0, 4);
+	free(pixels);
+	return resizedPixels;
+}
+
+std::shared_ptr<Cubemap> Cubemap::Create(const std::shared_ptr<Texture>* faces)
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	Renderer& renderer = Engine::GetRenderer();
+	if (!renderer.IsCubemapSupported())
+	{
+		return nullptr;
+	}
+
+	unsigned char* facePixels[6] = { nullptr };
+	int faceSize = 0;
+	bool isValid = true;
+	for (int i = 0; i < 6; i++)
+	{
+		if (!faces[i])
+		{
+			isValid = false;
+			break;
+		}
+
+		facePixels[i] = ReadFacePixels(*faces[i], faceSize);
+		if (!facePixels[i])
+		{
+			Debug::PrintError("[Cubemap::Create] Failed to read the cubemap face: " + faces[i]->m_file->GetPath(), true);
+			isValid = false;
+			break;
+		}
+	}
+
+	std::shared_ptr<Cubemap> cubemap;
+	if (isValid)
+	{
+		const unsigned int cubemapId = renderer.CreateCubemap(facePixels, faceSize);
+		if (cubemapId != 0)
+		{
+			cubemap = std::shared_ptr<Cubemap>(new Cubemap(cubemapId));
+		}
+	}
+
+	for (unsigned char* pixels : facePixels)
+	{
+		free(pixels);
+	}
+
+	return cubemap;
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <memory>
+
+class Texture;
+
+/**
+* @brief Texture with six square faces sampled with a direction (used to draw the skybox in one draw call)
+*/
+class Cubemap
+{
+public:
+	Cubemap(const Cubemap& other) = delete;
+	Cubemap& operator=(const Cubemap&) = delete;
+	~Cubemap();
+
+	/**
+	* @brief Create a cubemap from six textures, the faces are resized to the size of the first face
+	* @param faces Textures in the +X, -X, +Y, -Y, +Z, -Z order (renderer space)
+	* @return The cubemap or nullptr if the renderer does not support cubemaps or if a face can't be read
+	*/
+	[[nodiscard]] static std::shared_ptr<Cubemap> Create(const std::shared_ptr<Texture>* faces);
+
+	/**
+	* @brief Get the renderer id of the cubemap
+	*/
+	[[nodiscard]] unsigned int GetId() const
+	{
+		return m_cubemapId;
+	}
+
+private:
+	explicit Cubemap(unsigned int cubemapId) : m_cubemapId(cubemapId)
+	{
+	}
+
+	/**
+	* @brief Read and decode the pixels of a texture file in RGBA, resized to faceSize (first face if faceSize is 0)
+	* @return The pixels (to free with free()) or nullptr on failure
+	*/
+	[[nodiscard]] static unsigned char* ReadFacePixels(const Texture& texture, int& faceSize);
+
+	unsigned int m_cubemapId = 0;
+};
@@ -37,6 +37,7 @@
 #include <engine/engine.h>
 #include <engine/debug/debug.h>
 #include <engine/asset_management/asset_manager.h>
+#include <engine/asset_management/residency_manager.h>
 #include <engine/file_system/file.h>
 #include <engine/tools/internal_math.h>
 #include <engine/file_system/async_file_loading.h>
@@ -45,10 +46,13 @@
 #include <engine/debug/performance.h>
 #include <engine/debug/stack_debug_object.h>
 #include <engine/graphics/renderer/renderer.h>
+#include <engine/graphics/texture/compressed_texture.h>
+#include <engine/graphics/texture/texture_streaming.h>
 
 #include "texture_default.h"
 #include "texture_psp.h"
 #include "texture_ps3.h"
+#include "texture_null.h"
 
 Texture::Texture()
 {
@@ -125,13 +129,21 @@ std::shared_ptr<Texture> Texture::MakeTexture(bool isDynamic)
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
+	std::shared_ptr<Texture> newTexture;
+	if (Engine::GetArguments().useNullRenderer)
+	{
+		newTexture = std::make_shared<TextureNull>();
+	}
+	else
+	{
 #if defined(__PSP__)
-	std::shared_ptr<Texture> newTexture = std::make_shared<TexturePSP>();
+		newTexture = std::make_shared<TexturePSP>();
 #elif defined(__PS3__)
-	std::shared_ptr<Texture> newTexture = std::make_shared<TexturePS3>();
+		newTexture = std::make_shared<TexturePS3>();
 #else
-	std::shared_ptr<Texture> newTexture = std::make_shared<TextureDefault>();
+		newTexture = std::make_shared<TextureDefault>();
 #endif
+	}
 	if (!isDynamic)
 	{
 		AssetManager::AddFileReference(newTexture);
@@ -173,6 +185,7 @@ void Texture::UnloadFileReference()
 
 	if (Engine::IsRunning(true))
 	{
+		ResidencyManager::Forget(*this);
 		if (m_fileStatus == FileStatus::FileStatus_Loaded)
 		{
 			m_fileStatus = FileStatus::FileStatus_Not_Loaded;
@@ -197,6 +210,11 @@ void Texture::LoadTexture()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
+#if !defined(EDITOR) && (defined(_WIN32) || defined(_WIN64) || defined(__LINUX__))
+	if (GetIsStreamed() && LoadStreamedLevels())
+		return;
+#endif
+
 	size_t fileBufferSize = 0;
 	unsigned char* fileData = ReadBinary(fileBufferSize);
 	if (!fileData)
@@ -249,6 +267,22 @@ void Texture::LoadTexture()
 	m_width = newWidth;
 	height = newHeight;
 #else
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	// Block compressed textures are uploaded as they are
+	m_isCompressed = CompressedTextureHeader::Read(fileData, fileBufferSize, m_compressedHeader);
+	if (m_isCompressed)
+	{
+		m_width = static_cast<int>(m_compressedHeader.width);
+		height = static_cast<int>(m_compressedHeader.height);
+		nrChannels = 4;
+		m_buffer = fileData;
+		m_bufferSize = fileBufferSize;
+		m_compressedFirstLevel = 0;
+		m_fileStatus = FileStatus::FileStatus_AsyncWaiting;
+		return;
+	}
+#endif
+
 		// Load image with stb_image
 	m_buffer = stbi_load_from_memory(fileData, static_cast<int>(fileBufferSize), &m_width, &height,
 		&nrChannels, 4);
@@ -266,4 +300,48 @@ void Texture::LoadTexture()
 	m_fileStatus = FileStatus::FileStatus_AsyncWaiting;
 }
 
+bool Texture::LoadStreamedLevels()
+{
+#if !defined(EDITOR) && (defined(_WIN32) || defined(_WIN64) || defined(__LINUX__))
+	if (m_fileSize < sizeof(CompressedTextureHeader))
+		return false;
+
+	unsigned char* headerData = ReadBinary(0, sizeof(CompressedTextureHeader));
+	if (!headerData)
+		return false;
+
+	CompressedTextureHeader header;
+	const bool isHeaderValid = CompressedTextureHeader::Read(headerData, sizeof(CompressedTextureHeader), header);
+	delete[] headerData;
+	if (!isHeaderValid)
+		return false;
+
+	// The cooker writes all the levels of the streamed textures, the level 0 is only read by TextureStreaming
+	const int width = static_cast<int>(header.width);
+	const int textureHeight = static_cast<int>(header.height);
+	const int lowestLevel = TextureStreaming::GetLevelForSize(width, textureHeight, TextureStreaming::s_initialSize);
+	const size_t levelsOffset = header.GetLevelOffset(lowestLevel);
+	if (lowestLevel == 0 || static_cast<int>(header.mipCount) != TextureStreaming::GetMipCount(width, textureHeight) || levelsOffset >= m_fileSize)
+		return false;
+
+	const size_t levelsSize = m_fileSize - levelsOffset;
+	unsigned char* levelsData = ReadBinary(levelsOffset, levelsSize);
+	if (!levelsData)
+		return false;
+
+	m_compressedHeader = header;
+	m_isCompressed = true;
+	m_compressedFirstLevel = static_cast<uint32_t>(lowestLevel);
+	m_width = width;
+	height = textureHeight;
+	nrChannels = 4;
+	m_buffer = levelsData;
+	m_bufferSize = levelsSize;
+	m_fileStatus = FileStatus::FileStatus_AsyncWaiting;
+	return true;
+#else
+	return false;
+#endif
+}
+
 #pragma endregion
\ No newline at end of file
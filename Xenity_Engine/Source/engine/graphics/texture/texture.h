@@ -17,6 +17,7 @@
 #include <engine/file_system/file_reference.h>
 #include <engine/reflection/reflection.h>
 #include <engine/graphics/2d_graphics/sprite_selection.h>
+#include <engine/graphics/texture/compressed_texture.h>
 #include <engine/reflection/enum_utils.h>
 #include <engine/platform.h>
 #include <engine/application.h>
@@ -27,6 +28,8 @@ ENUM(TextureResolution, R_64x64 = 64, R_128x128 = 128, R_256x256 = 256, R_512x51
 ENUM(WrapMode, ClampToEdge = 0, Repeat = 3);
 ENUM(PSPTextureType, RGBA_8888, RGBA_5551, RGBA_5650, RGBA_4444);
 ENUM(PS3TextureType, ARGB_8888, ARGB_1555, ARGB_0565, ARGB_4444);
+// Auto: BC1 for opaque textures, BC3 for the others. BC5 only keeps the red and green channels (normal maps)
+ENUM(TextureCompression, None, Auto, BC1, BC3, BC5);
 
 class TextureSettings : public Reflective
 {
@@ -35,6 +38,7 @@ public:
 	Filter filter = Filter::Bilinear;
 	WrapMode wrapMode = WrapMode::Repeat;
 	bool useMipMap = false;
+	bool isStreamed = false; // Only used on Windows and Linux
 	//int mipmaplevelCount = 0;
 	int pixelPerUnit = 100;
 
@@ -62,6 +66,16 @@ public:
 class TextureSettingsStandalone : public TextureSettings
 {
 public:
+	ReflectiveData GetReflectiveData() override
+	{
+		ReflectiveData reflectedVariables = TextureSettings::GetReflectiveData();
+		Reflective::AddVariable(reflectedVariables, isStreamed, "isStreamed");
+		Reflective::AddVariable(reflectedVariables, compression, "compression");
+		return reflectedVariables;
+	}
+
+	// Format of the cooked texture (if the texture compression is enabled in the build settings)
+	TextureCompression compression = TextureCompression::Auto;
 };
 
 class TextureSettingsPSVITA : public TextureSettings
@@ -210,6 +224,14 @@ public:
 		return m_settings.at(Application::GetAssetPlatform())->useMipMap;
 	}
 
+	/**
+	 * @brief Get if the mip levels of the texture are loaded when needed (see TextureStreaming)
+	 */
+	[[nodiscard]] bool GetIsStreamed() const
+	{
+		return m_settings.at(Application::GetAssetPlatform())->isStreamed;
+	}
+
 	/**
 	 * @brief Get texture filter
 	 */
@@ -254,6 +276,9 @@ protected:
 	friend class TextManager;
 	friend class Cooker;
 	friend class EditorIcons;
+	friend class Cubemap;
+	friend class ResidencyManager;
+	friend class TextureStreaming;
 
 	void SetSize(int width, int height)
 	{
@@ -329,6 +354,12 @@ protected:
 	 */
 	void LoadTexture();
 
+	/**
+	 * @brief Read only the small mip levels of a cooked streamed texture (the others are read by TextureStreaming)
+	 * @return False if the file does not have all the mip levels
+	 */
+	[[nodiscard]] bool LoadStreamedLevels();
+
 	/**
 	 * @brief Unload texture data
 	 */
@@ -337,9 +368,16 @@ protected:
 
 	std::map<AssetPlatform, std::unique_ptr<TextureSettings>> m_settings;
 	unsigned char* m_buffer = nullptr;
+	size_t m_bufferSize = 0; // Only set for the compressed textures
+	bool m_isCompressed = false; // m_buffer contains the levels of a cooked compressed texture file (see CompressedTextureHeader)
+	CompressedTextureHeader m_compressedHeader; // Only set for the compressed textures
+	uint32_t m_compressedFirstLevel = 0; // First level in m_buffer, the streamed textures only read their small levels
 	int m_width = 0, height = 0, nrChannels = 0;
 	int m_originalWidth = 0, m_originalHeight = 0;
 
+	// Index in the streaming list (TextureDefault only)
+	uint32_t m_streamingIndex = UINT32_MAX;
+
 #if defined(EDITOR)
 	TextureResolution previousResolution = TextureResolution::R_2048x2048;
 #endif
@@ -9,7 +9,10 @@
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__) || defined(__vita__)
 
 #include <malloc.h>
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 //#define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 //#define STB_IMAGE_RESIZE_IMPLEMENTATION
@@ -35,6 +38,55 @@
 #include <engine/debug/performance.h>
 #include <engine/debug/stack_debug_object.h>
 #include <engine/graphics/renderer/renderer.h>
+#include <engine/graphics/renderer/opengl_state_cache.h>
+#include <engine/graphics/texture/texture_streaming.h>
+#include <engine/graphics/texture/compressed_texture.h>
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+// From EXT_texture_compression_s3tc, not in the core profile
+#if !defined(GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#if !defined(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace
+{
+	bool HasExtension(const char* name)
+	{
+		GLint extensionCount = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+		for (GLint i = 0; i < extensionCount; i++)
+		{
+			const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			if (extension && strcmp(extension, name) == 0)
+				return true;
+		}
+		return false;
+	}
+}
+#endif
+
+bool TextureDefault::s_isS3tcSupported = false;
+bool TextureDefault::s_isRgtcSupported = false;
+
+void TextureDefault::Init()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	s_isS3tcSupported = HasExtension("GL_EXT_texture_compression_s3tc");
+	s_isRgtcSupported = GLAD_GL_VERSION_3_0 || HasExtension("GL_ARB_texture_compression_rgtc");
+	if (!s_isS3tcSupported)
+	{
+		Debug::PrintWarning("[TextureDefault::Init] S3TC is not supported, the BC1 and BC3 textures will be decoded on load", true);
+	}
+#else
+	s_isS3tcSupported = true;
+	s_isRgtcSupported = true;
+#endif
+}
 
 
 TextureDefault::~TextureDefault()
@@ -47,8 +99,11 @@ void TextureDefault::Bind() const
 {
 	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
 
-	glBindTexture(GL_TEXTURE_2D, m_textureId);
-	ApplyTextureFilters();
+	// The filters are stored in the texture object, only apply them when the texture is bound again
+	if (OpenGLStateCache::BindTexture(GL_TEXTURE_2D, m_textureId))
+	{
+		ApplyTextureFilters();
+	}
 }
 
 int TextureDefault::GetWrapModeEnum(WrapMode wrapMode) const
@@ -112,7 +167,18 @@ void TextureDefault::OnLoadFileReferenceFinished()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
-	SetData(m_buffer);
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if (m_isCompressed)
+	{
+		// The streamed textures are read from their first level, the other files from their header
+		const size_t levelsOffset = m_compressedFirstLevel == 0 ? sizeof(CompressedTextureHeader) : 0;
+		SetCompressedData(m_buffer + levelsOffset, m_bufferSize - levelsOffset);
+	}
+	else
+#endif
+	{
+		SetData(m_buffer);
+	}
 
 	free(m_buffer);
 }
@@ -130,10 +196,31 @@ void TextureDefault::SetData(const unsigned char *texData)
 	{
 		glGenTextures(1, &m_textureId);
 #if defined (DEBUG)
-		Performance::s_textureMemoryTracker->Allocate(m_width * height * 4);
+		m_trackedMemorySize = static_cast<size_t>(m_width) * height * 4;
+		Performance::s_textureMemoryTracker->Allocate(m_trackedMemorySize);
 #endif
 	}
-	Bind();
+	OpenGLStateCache::BindTexture(GL_TEXTURE_2D, m_textureId);
+	ApplyTextureFilters();
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if (m_streamingIndex != TextureStreaming::s_invalidIndex)
+	{
+		// New data, the streamed levels are replaced
+		TextureStreaming::RemoveTexture(m_streamingIndex);
+		m_streamingIndex = TextureStreaming::s_invalidIndex;
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+	}
+
+	// The streamed levels are read again from the file
+	if (GetIsStreamed() && m_file && SetStreamedData(texData))
+	{
+		isValid = true;
+		m_fileStatus = FileStatus::FileStatus_Loaded;
+		return;
+	}
+#endif
 
 	//const unsigned int textureType = GL_LUMINANCE_ALPHA;
 	const unsigned int textureType = GL_RGBA; // rgba
@@ -147,17 +234,165 @@ void TextureDefault::SetData(const unsigned char *texData)
 	m_fileStatus = FileStatus::FileStatus_Loaded;
 }
 
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+bool TextureDefault::SetStreamedData(const unsigned char* texData)
+{
+	const int width = GetWidth();
+	const int height = GetHeight();
+	const int lowestLevel = TextureStreaming::GetLevelForSize(width, height, TextureStreaming::s_initialSize);
+	if (lowestLevel == 0)
+		return false;
+
+	// The texture only has the levels from lowestLevel to 1x1, the others are uploaded by TextureStreaming
+	const int mipCount = TextureStreaming::GetMipCount(width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, lowestLevel);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+
+	std::vector<unsigned char> previousLevel;
+	std::vector<unsigned char> levelPixels;
+	const unsigned char* source = texData;
+	int sourceWidth = width;
+	int sourceHeight = height;
+	for (int level = lowestLevel; level < mipCount; level++)
+	{
+		const int levelWidth = std::max(1, width >> level);
+		const int levelHeight = std::max(1, height >> level);
+		levelPixels.resize(static_cast<size_t>(levelWidth) * levelHeight * 4);
+		stbir_resize_uint8(source, sourceWidth, sourceHeight, 0, levelPixels.data(), levelWidth, levelHeight, 0, 4);
+		glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, levelPixels.data());
+
+		previousLevel.swap(levelPixels);
+		source = previousLevel.data();
+		sourceWidth = levelWidth;
+		sourceHeight = levelHeight;
+	}
+
+	m_streamingIndex = TextureStreaming::AddTexture(*this, lowestLevel);
+	return true;
+}
+
+bool TextureDefault::IsFormatSupported(CompressedTextureFormat format)
+{
+	switch (format)
+	{
+	case CompressedTextureFormat::BC1:
+	case CompressedTextureFormat::BC3:
+		return s_isS3tcSupported;
+	case CompressedTextureFormat::BC5:
+		return s_isRgtcSupported;
+	case CompressedTextureFormat::RGBA8:
+		return true;
+	}
+	return false;
+}
+
+void TextureDefault::UploadCompressedLevel(CompressedTextureFormat format, int level, int width, int height, size_t size, const unsigned char* data)
+{
+	if (!IsFormatSupported(format))
+	{
+		// Decoded here, the blocks can't be used by the GPU
+		std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+		CompressedTexture::DecodeImage(format, data, width, height, pixels.data());
+		glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		return;
+	}
+
+	switch (format)
+	{
+	case CompressedTextureFormat::BC1:
+		glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, width, height, 0, static_cast<GLsizei>(size), data);
+		break;
+	case CompressedTextureFormat::BC3:
+		glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, width, height, 0, static_cast<GLsizei>(size), data);
+		break;
+	case CompressedTextureFormat::BC5:
+		glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RG_RGTC2, width, height, 0, static_cast<GLsizei>(size), data);
+		break;
+	case CompressedTextureFormat::RGBA8:
+		glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		break;
+	}
+}
+
+void TextureDefault::SetCompressedData(const unsigned char* levelsData, size_t levelsSize)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	const CompressedTextureHeader& header = m_compressedHeader;
+
+	if (m_textureId == -1)
+	{
+		glGenTextures(1, &m_textureId);
+#if defined (DEBUG)
+		m_trackedMemorySize = header.GetLevelsSize(0);
+		Performance::s_textureMemoryTracker->Allocate(m_trackedMemorySize);
+#endif
+	}
+	OpenGLStateCache::BindTexture(GL_TEXTURE_2D, m_textureId);
+	ApplyTextureFilters();
+
+	if (m_streamingIndex != TextureStreaming::s_invalidIndex)
+	{
+		// New data, the streamed levels are replaced
+		TextureStreaming::RemoveTexture(m_streamingIndex);
+		m_streamingIndex = TextureStreaming::s_invalidIndex;
+	}
+
+	// The mip levels come from the cooker, nothing is generated here
+	size_t offset = 0;
+	for (uint32_t level = m_compressedFirstLevel; level < header.mipCount; level++)
+	{
+		const int levelWidth = std::max(1, m_width >> level);
+		const int levelHeight = std::max(1, height >> level);
+		uint32_t levelSize = 0;
+		if (offset + sizeof(uint32_t) <= levelsSize)
+		{
+			memcpy(&levelSize, levelsData + offset, sizeof(uint32_t));
+			offset += sizeof(uint32_t);
+		}
+
+		if (levelSize != header.GetLevelSize(level) || offset + levelSize > levelsSize)
+		{
+			Debug::PrintError("[TextureDefault::SetCompressedData] Wrong compressed texture level size", true);
+			m_fileStatus = FileStatus::FileStatus_Failed;
+			return;
+		}
+
+		UploadCompressedLevel(header.format, static_cast<int>(level), levelWidth, levelHeight, levelSize, levelsData + offset);
+		offset += levelSize;
+	}
+	// The missing levels are uploaded by TextureStreaming
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, m_compressedFirstLevel);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.mipCount - 1);
+	if (m_compressedFirstLevel != 0)
+	{
+		m_streamingIndex = TextureStreaming::AddTexture(*this, static_cast<int>(m_compressedFirstLevel));
+	}
+
+	isValid = true;
+	m_fileStatus = FileStatus::FileStatus_Loaded;
+}
+#endif
+
 void TextureDefault::Unload()
 {
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
 	ClearSpriteSelections();
+	if (m_streamingIndex != TextureStreaming::s_invalidIndex)
+	{
+		TextureStreaming::RemoveTexture(m_streamingIndex);
+		m_streamingIndex = TextureStreaming::s_invalidIndex;
+	}
 	if (m_textureId != -1)
 	{
-		glDeleteTextures(1, &m_textureId);
+		OpenGLStateCache::DeleteTexture(m_textureId);
 		m_textureId = -1;
 #if defined (DEBUG)
-		Performance::s_textureMemoryTracker->Deallocate(m_width * height * 4);
+		Performance::s_textureMemoryTracker->Deallocate(m_trackedMemorySize);
+		m_trackedMemorySize = 0;
 #endif
 	}
 }
@@ -27,6 +27,11 @@ public:
 	TextureDefault() = default;
 	~TextureDefault();
 
+	/**
+	* @brief [Internal] Check the compressed formats supported by the GPU (once the OpenGL context is created)
+	*/
+	static void Init();
+
 	/**
 	* @brief [Internal] Get texture ID
 	*/
@@ -36,6 +41,8 @@ public:
 	}
 
 protected:
+	friend class TextureStreaming;
+
 	void OnLoadFileReferenceFinished() override;
 
 	void SetData(const unsigned char* data) override;
@@ -45,7 +52,39 @@ protected:
 	[[nodiscard]] int GetWrapModeEnum(WrapMode wrapMode) const;
 	void Unload() override;
 
+	/**
+	* @brief Upload only the small mip levels and register the texture in the streaming list
+	* @return False if the texture is too small to be streamed
+	*/
+	[[nodiscard]] bool SetStreamedData(const unsigned char* data);
+
+	/**
+	* @brief Upload the mip levels of a cooked compressed texture file (see CompressedTextureHeader)
+	* @param levelsData Levels of the file from m_compressedFirstLevel (each with its size), the texture is streamed if the first level is not 0
+	* @param levelsSize Size in bytes of levelsData
+	*/
+	void SetCompressedData(const unsigned char* levelsData, size_t levelsSize);
+
+	/**
+	* @brief Upload a level of a cooked compressed texture to the bound texture
+	* @brief The level is decoded and uploaded as RGBA8 if the GPU does not support its format
+	*/
+	static void UploadCompressedLevel(CompressedTextureFormat format, int level, int width, int height, size_t size, const unsigned char* data);
+
+	/**
+	* @brief Get if the GPU can use the blocks of a format without decoding them
+	*/
+	[[nodiscard]] static bool IsFormatSupported(CompressedTextureFormat format);
+
+	// BC1 and BC3 (EXT_texture_compression_s3tc)
+	static bool s_isS3tcSupported;
+	// BC5 (ARB_texture_compression_rgtc, core since OpenGL 3.0)
+	static bool s_isRgtcSupported;
+
 	unsigned int m_textureId = -1;
+#if defined (DEBUG)
+	size_t m_trackedMemorySize = 0;
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "texture_null.h"
+
+#include <malloc.h>
+
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/memory_tracker.h>
+#include <engine/debug/performance.h>
+#include <engine/debug/stack_debug_object.h>
+#include <engine/graphics/renderer/renderer.h>
+
+TextureNull::~TextureNull()
+{
+	this->UnloadFileReference();
+}
+
+void TextureNull::Bind() const
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	Engine::GetRenderer().BindTexture(*this);
+}
+
+void TextureNull::OnLoadFileReferenceFinished()
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	SetData(m_buffer);
+
+	free(m_buffer);
+}
+
+void TextureNull::SetData(const unsigned char* texData)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	XASSERT(texData != nullptr, "[TextureNull::SetData] texData is nullptr");
+
+	if (m_textureId == -1)
+	{
+		m_textureId = Engine::GetRenderer().CreateNewTexture();
+#if defined (DEBUG)
+		Performance::s_textureMemoryTracker->Allocate(m_width * height * 4);
+#endif
+	}
+
+	Engine::GetRenderer().SetTextureData(*this, 0, texData);
+
+	isValid = true;
+	m_fileStatus = FileStatus::FileStatus_Loaded;
+}
+
+void TextureNull::Unload()
+{
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	ClearSpriteSelections();
+	if (m_textureId != -1)
+	{
+		if (Engine::IsRunning(true))
+		{
+			Engine::GetRenderer().DeleteTexture(*this);
+		}
+		m_textureId = -1;
+#if defined (DEBUG)
+		Performance::s_textureMemoryTracker->Deallocate(m_width * height * 4);
+#endif
+	}
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+#include <engine/api.h>
+#include <engine/graphics/texture/texture.h>
+
+/**
+* @brief [Internal] Texture class used with the null renderer, the data is only sent to the renderer to be counted
+*/
+class API TextureNull : public Texture
+{
+public:
+	TextureNull() = default;
+	~TextureNull();
+
+	/**
+	* @brief [Internal] Get texture ID
+	*/
+	[[nodiscard]] unsigned int GetTextureId() const
+	{
+		return m_textureId;
+	}
+
+protected:
+	void OnLoadFileReferenceFinished() override;
+
+	void SetData(const unsigned char* data) override;
+
+	void Bind() const override;
+	void Unload() override;
+
+	unsigned int m_textureId = -1;
+};
@@ -0,0 +1,529 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "texture_streaming.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+#include <glad/gl.h>
+#include <stb_image.h>
+#include <stb_image_resize.h>
+#endif
+
+#include <engine/engine.h>
+#include <engine/asset_management/project_manager.h>
+#include <engine/file_system/file.h>
+#include <engine/file_system/file_system.h>
+#include <engine/file_system/data_base/file_data_base.h>
+#include <engine/graphics/camera.h>
+#include <engine/graphics/material.h>
+#include <engine/graphics/3d_graphics/mesh_renderer.h>
+#include <engine/graphics/3d_graphics/frustum_culling.h>
+#include <engine/graphics/texture/texture_default.h>
+#include <engine/game_elements/transform.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/debug.h>
+#include <engine/debug/performance.h>
+#include <engine/debug/stack_debug_object.h>
+#include <engine/tools/scope_benchmark.h>
+#include <engine/tools/job_system.h>
+
+struct TextureStreaming::StreamingJob
+{
+	// The job does not use the texture, it can be deleted during the job
+#if defined(EDITOR)
+	std::shared_ptr<File> file; // Source image, not shared with the texture
+#else
+	size_t filePosition = 0; // Position of the texture file in the bit file
+	size_t fileSize = 0;
+#endif
+	bool isCompressedFile = false; // Cooked file with all the levels (see CompressedTextureHeader), else an image to decode
+	CompressedTextureHeader header;
+	int width = 0; // Size of the level 0
+	int height = 0;
+	int firstLevel = 0;
+	int lastLevel = 0;
+	std::vector<std::vector<unsigned char>> levels; // Pixels (or blocks of the compressed files) of the levels from firstLevel to lastLevel
+	bool isFailed = false;
+	std::atomic<bool> isDone = false;
+};
+
+std::vector<TextureStreaming::StreamedTexture> TextureStreaming::s_textures;
+size_t TextureStreaming::s_poolBudget = static_cast<size_t>(256) * 1024 * 1024;
+size_t TextureStreaming::s_poolSize = 0;
+std::vector<std::shared_ptr<TextureStreaming::StreamingJob>> TextureStreaming::s_runningJobs;
+uint64_t TextureStreaming::s_currentFrame = 1;
+
+int TextureStreaming::GetMipCount(int width, int height)
+{
+	int maxSize = std::max(width, height);
+	int count = 1;
+	while (maxSize > 1)
+	{
+		maxSize >>= 1;
+		count++;
+	}
+	return count;
+}
+
+size_t TextureStreaming::GetLevelsSize(int width, int height, int firstLevel)
+{
+	const int mipCount = GetMipCount(width, height);
+	size_t size = 0;
+	for (int level = firstLevel; level < mipCount; level++)
+	{
+		size += static_cast<size_t>(std::max(1, width >> level)) * std::max(1, height >> level) * 4;
+	}
+	return size;
+}
+
+int TextureStreaming::GetLevelForSize(int width, int height, int size)
+{
+	const int maxSize = std::max(width, height);
+	int level = 0;
+	while ((maxSize >> level) > size)
+	{
+		level++;
+	}
+	return level;
+}
+
+int TextureStreaming::ComputeRequestedLevel(int width, int height, float screenPixels, int lowestLevel)
+{
+	if (screenPixels <= 0)
+		return lowestLevel;
+
+	// One texel per pixel: each level halves the size
+	const float ratio = static_cast<float>(std::max(width, height)) / screenPixels;
+	if (ratio <= 1)
+		return 0;
+
+	const int level = static_cast<int>(std::floor(std::log2(ratio)));
+	return std::min(level, lowestLevel);
+}
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+
+uint32_t TextureStreaming::AddTexture(TextureDefault& texture, int lowestLevel)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	StreamedTexture& streamedTexture = s_textures.emplace_back();
+	streamedTexture.texture = &texture;
+	streamedTexture.residentLevel = lowestLevel;
+	streamedTexture.lowestLevel = lowestLevel;
+	streamedTexture.requestedLevel = lowestLevel;
+	streamedTexture.lastRequestFrame = s_currentFrame;
+	return static_cast<uint32_t>(s_textures.size() - 1);
+}
+
+void TextureStreaming::RemoveTexture(uint32_t index)
+{
+	if (index == s_invalidIndex)
+		return;
+
+	XASSERT(index < s_textures.size(), "[TextureStreaming::RemoveTexture] index is out of range");
+
+	StreamedTexture& streamedTexture = s_textures[index];
+	// The texture object is deleted with its levels
+	s_poolSize -= GetTextureLevelsSize(*streamedTexture.texture, streamedTexture.residentLevel) - GetTextureLevelsSize(*streamedTexture.texture, streamedTexture.lowestLevel);
+
+	// Move the last texture to the free index to keep the list contiguous
+	const size_t lastIndex = s_textures.size() - 1;
+	if (index != lastIndex)
+	{
+		s_textures[index] = std::move(s_textures[lastIndex]);
+		s_textures[index].texture->m_streamingIndex = index;
+	}
+	s_textures.pop_back();
+}
+
+void TextureStreaming::RequestVisibleTextures(const Camera& camera)
+{
+	if (s_textures.empty())
+		return;
+
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	SCOPED_PROFILER("TextureStreaming::RequestVisibleTextures", scopeBenchmark);
+
+	const Vector3& cameraPosition = camera.GetTransformRaw()->GetPosition();
+
+	// Same screen size as LodSelection::Select, converted to pixels with the render height
+	const bool isPerspective = camera.GetProjectionType() == ProjectionType::Perspective;
+	float sizeFactor = 0;
+	if (isPerspective)
+	{
+		sizeFactor = 1.0f / std::tan(camera.GetFov() * 0.5f * 3.14159265f / 180.0f);
+	}
+	else
+	{
+		sizeFactor = 10.0f / camera.GetProjectionSize();
+	}
+	sizeFactor *= static_cast<float>(camera.GetRenderHeight());
+
+	const size_t count = FrustumCulling::GetCount();
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!FrustumCulling::IsVisible(static_cast<uint32_t>(i)))
+			continue;
+
+		const MeshRenderer& meshRenderer = *FrustumCulling::s_meshRenderers[i];
+		float screenPixels = FrustumCulling::s_radii[i] * sizeFactor;
+		if (isPerspective)
+		{
+			const float dx = FrustumCulling::s_centersX[i] - cameraPosition.x;
+			const float dy = FrustumCulling::s_centersY[i] - cameraPosition.y;
+			const float dz = FrustumCulling::s_centersZ[i] - cameraPosition.z;
+			const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+			screenPixels = distance > FrustumCulling::s_radii[i] ? screenPixels / distance : std::numeric_limits<float>::max();
+		}
+
+		for (const std::shared_ptr<Material>& material : meshRenderer.m_materials)
+		{
+			if (!material)
+				continue;
+
+			const Texture* texture = material->GetTexture().get();
+			if (!texture || texture->m_streamingIndex == s_invalidIndex)
+				continue;
+
+			StreamedTexture& streamedTexture = s_textures[texture->m_streamingIndex];
+			const int level = ComputeRequestedLevel(streamedTexture.texture->GetWidth(), streamedTexture.texture->GetHeight(), screenPixels, streamedTexture.lowestLevel);
+			// The biggest request of the frame is kept (several objects or cameras)
+			if (streamedTexture.lastRequestFrame != s_currentFrame || level < streamedTexture.requestedLevel)
+			{
+				streamedTexture.requestedLevel = level;
+				streamedTexture.lastRequestFrame = s_currentFrame;
+			}
+		}
+	}
+}
+
+int TextureStreaming::GetTargetLevel(const StreamedTexture& streamedTexture)
+{
+	if (s_currentFrame - streamedTexture.lastRequestFrame > s_keepFrameCount)
+		return streamedTexture.lowestLevel;
+
+	return streamedTexture.requestedLevel;
+}
+
+size_t TextureStreaming::GetTextureLevelsSize(const TextureDefault& texture, int firstLevel)
+{
+	if (texture.m_isCompressed)
+		return texture.m_compressedHeader.GetLevelsSize(static_cast<uint32_t>(firstLevel));
+
+	return GetLevelsSize(texture.GetWidth(), texture.GetHeight(), firstLevel);
+}
+
+unsigned char* TextureStreaming::ReadFile(const StreamingJob& job, size_t& size)
+{
+	unsigned char* fileData = nullptr;
+#if defined(EDITOR)
+	if (job.file->Open(FileMode::ReadOnly))
+	{
+		fileData = job.file->ReadAllBinary(size);
+		job.file->Close();
+	}
+#else
+	fileData = ProjectManager::s_fileDataBase.GetBitFile().ReadBinary(job.filePosition, job.fileSize);
+	size = job.fileSize;
+#endif
+	return fileData;
+}
+
+unsigned char* TextureStreaming::ReadFile(const StreamingJob& job, size_t offset, size_t size)
+{
+	unsigned char* fileData = nullptr;
+#if defined(EDITOR)
+	if (job.file->Open(FileMode::ReadOnly))
+	{
+		fileData = job.file->ReadBinary(offset, size);
+		job.file->Close();
+	}
+#else
+	if (offset + size <= job.fileSize)
+	{
+		fileData = ProjectManager::s_fileDataBase.GetBitFile().ReadBinary(job.filePosition + offset, size);
+	}
+#endif
+	return fileData;
+}
+
+void TextureStreaming::RunJob(StreamingJob& job)
+{
+	if (job.isCompressedFile)
+	{
+		ReadCompressedLevels(job);
+	}
+	else
+	{
+		DecodeLevels(job);
+	}
+	job.isDone = true;
+}
+
+void TextureStreaming::ReadCompressedLevels(StreamingJob& job)
+{
+	// Only the bytes of the missing levels are read
+	const size_t offset = job.header.GetLevelOffset(static_cast<uint32_t>(job.firstLevel));
+	const size_t size = job.header.GetLevelOffset(static_cast<uint32_t>(job.lastLevel + 1)) - offset;
+	unsigned char* levelsData = ReadFile(job, offset, size);
+	if (!levelsData)
+	{
+		job.isFailed = true;
+		return;
+	}
+
+	size_t levelOffset = 0;
+	for (int level = job.firstLevel; level <= job.lastLevel; level++)
+	{
+		uint32_t levelSize = 0;
+		memcpy(&levelSize, levelsData + levelOffset, sizeof(uint32_t));
+		levelOffset += sizeof(uint32_t);
+		if (levelSize != job.header.GetLevelSize(static_cast<uint32_t>(level)))
+		{
+			job.isFailed = true;
+			break;
+		}
+
+		job.levels.emplace_back(levelsData + levelOffset, levelsData + levelOffset + levelSize);
+		levelOffset += levelSize;
+	}
+	delete[] levelsData;
+}
+
+void TextureStreaming::DecodeLevels(StreamingJob& job)
+{
+	size_t fileSize = 0;
+	unsigned char* fileData = ReadFile(job, fileSize);
+	if (!fileData)
+	{
+		job.isFailed = true;
+		return;
+	}
+
+	// PNG and JPG can't be partially decoded, the whole image is decoded for any level
+	int fileWidth = 0;
+	int fileHeight = 0;
+	int channelCount = 0;
+	unsigned char* pixels = stbi_load_from_memory(fileData, static_cast<int>(fileSize), &fileWidth, &fileHeight, &channelCount, 4);
+	delete[] fileData;
+	if (!pixels)
+	{
+		job.isFailed = true;
+		return;
+	}
+
+	// Each level is resized from the previous one, the first one from the file (bigger than the cooked size in the editor)
+	const unsigned char* source = pixels;
+	int sourceWidth = fileWidth;
+	int sourceHeight = fileHeight;
+	for (int level = job.firstLevel; level <= job.lastLevel; level++)
+	{
+		const int levelWidth = std::max(1, job.width >> level);
+		const int levelHeight = std::max(1, job.height >> level);
+		std::vector<unsigned char>& levelPixels = job.levels.emplace_back(static_cast<size_t>(levelWidth) * levelHeight * 4);
+		stbir_resize_uint8(source, sourceWidth, sourceHeight, 0, levelPixels.data(), levelWidth, levelHeight, 0, 4);
+		source = levelPixels.data();
+		sourceWidth = levelWidth;
+		sourceHeight = levelHeight;
+	}
+	free(pixels);
+}
+
+void TextureStreaming::StartJob(StreamedTexture& streamedTexture, int targetLevel)
+{
+	const TextureDefault& texture = *streamedTexture.texture;
+
+	std::shared_ptr<StreamingJob> job = std::make_shared<StreamingJob>();
+#if defined(EDITOR)
+	job->file = FileSystem::MakeFile(texture.m_file->GetPath());
+#else
+	job->filePosition = texture.m_filePosition;
+	job->fileSize = texture.m_fileSize;
+#endif
+	job->isCompressedFile = texture.m_isCompressed;
+	job->header = texture.m_compressedHeader;
+	job->width = texture.GetWidth();
+	job->height = texture.GetHeight();
+	job->firstLevel = targetLevel;
+	job->lastLevel = streamedTexture.residentLevel - 1;
+
+	streamedTexture.job = job;
+	s_runningJobs.push_back(job);
+
+	// The file is read on a worker, the job is kept alive by the lambda if the texture is removed
+	JobSystem::Submit([job]()
+		{
+			RunJob(*job);
+		});
+}
+
+void TextureStreaming::FinishJob(StreamedTexture& streamedTexture)
+{
+	const std::shared_ptr<StreamingJob> job = std::move(streamedTexture.job);
+	if (job->isFailed)
+	{
+		Debug::PrintError("[TextureStreaming::FinishJob] Failed to read texture levels", true);
+		// Do not try again every frame
+		streamedTexture.lowestLevel = streamedTexture.residentLevel;
+		return;
+	}
+
+	TextureDefault& texture = *streamedTexture.texture;
+	texture.Bind();
+	for (int level = job->lastLevel; level >= job->firstLevel; level--)
+	{
+		const std::vector<unsigned char>& levelData = job->levels[level - job->firstLevel];
+		const int levelWidth = std::max(1, job->width >> level);
+		const int levelHeight = std::max(1, job->height >> level);
+		if (job->isCompressedFile)
+		{
+			TextureDefault::UploadCompressedLevel(job->header.format, level, levelWidth, levelHeight, levelData.size(), levelData.data());
+		}
+		else
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, levelData.data());
+		}
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, job->firstLevel);
+
+	s_poolSize += GetTextureLevelsSize(texture, job->firstLevel) - GetTextureLevelsSize(texture, streamedTexture.residentLevel);
+	streamedTexture.residentLevel = job->firstLevel;
+}
+
+void TextureStreaming::DropLevels(StreamedTexture& streamedTexture, int newResidentLevel)
+{
+	TextureDefault& texture = *streamedTexture.texture;
+
+	texture.Bind();
+	// Move the base level before freeing the levels to keep the texture complete
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, newResidentLevel);
+	for (int level = streamedTexture.residentLevel; level < newResidentLevel; level++)
+	{
+		glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+
+	s_poolSize -= GetTextureLevelsSize(texture, streamedTexture.residentLevel) - GetTextureLevelsSize(texture, newResidentLevel);
+	streamedTexture.residentLevel = newResidentLevel;
+}
+
+void TextureStreaming::Update()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
+
+	SCOPED_PROFILER("TextureStreaming::Update", scopeBenchmark);
+
+	// The jobs of the removed textures are also in this list
+	s_runningJobs.erase(std::remove_if(s_runningJobs.begin(), s_runningJobs.end(), [](const std::shared_ptr<StreamingJob>& job)
+		{
+			return job->isDone.load();
+		}), s_runningJobs.end());
+
+	std::vector<StreamedTexture*> texturesToLoad;
+	for (StreamedTexture& streamedTexture : s_textures)
+	{
+		if (streamedTexture.job)
+		{
+			if (!streamedTexture.job->isDone)
+				continue;
+
+			FinishJob(streamedTexture);
+		}
+
+		const int targetLevel = GetTargetLevel(streamedTexture);
+		if (targetLevel > streamedTexture.residentLevel)
+		{
+			DropLevels(streamedTexture, targetLevel);
+		}
+		else if (targetLevel < streamedTexture.residentLevel)
+		{
+			texturesToLoad.push_back(&streamedTexture);
+		}
+	}
+
+	// Over budget: drop the highest levels of the least recently requested textures
+	if (s_poolSize > s_poolBudget)
+	{
+		std::vector<StreamedTexture*> texturesToDrop;
+		for (StreamedTexture& streamedTexture : s_textures)
+		{
+			if (!streamedTexture.job && streamedTexture.residentLevel < streamedTexture.lowestLevel)
+			{
+				texturesToDrop.push_back(&streamedTexture);
+			}
+		}
+		std::stable_sort(texturesToDrop.begin(), texturesToDrop.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+			{
+				return a->lastRequestFrame < b->lastRequestFrame;
+			});
+
+		for (StreamedTexture* streamedTexture : texturesToDrop)
+		{
+			while (s_poolSize > s_poolBudget && streamedTexture->residentLevel < streamedTexture->lowestLevel)
+			{
+				DropLevels(*streamedTexture, streamedTexture->residentLevel + 1);
+			}
+		}
+	}
+
+	// The most missing levels first
+	std::stable_sort(texturesToLoad.begin(), texturesToLoad.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+		{
+			return a->residentLevel - a->requestedLevel > b->residentLevel - b->requestedLevel;
+		});
+
+	for (StreamedTexture* streamedTexture : texturesToLoad)
+	{
+		if (s_runningJobs.size() >= s_maxJobCount)
+			break;
+
+		// Skip the levels that do not fit in the budget
+		const TextureDefault& texture = *streamedTexture->texture;
+		const size_t residentSize = GetTextureLevelsSize(texture, streamedTexture->residentLevel);
+		int targetLevel = GetTargetLevel(*streamedTexture);
+		while (targetLevel < streamedTexture->residentLevel && s_poolSize + GetTextureLevelsSize(texture, targetLevel) - residentSize > s_poolBudget)
+		{
+			targetLevel++;
+		}
+
+		if (targetLevel < streamedTexture->residentLevel)
+		{
+			StartJob(*streamedTexture, targetLevel);
+		}
+	}
+
+	s_currentFrame++;
+}
+
+#else
+
+uint32_t TextureStreaming::AddTexture(TextureDefault& texture, int lowestLevel)
+{
+	return s_invalidIndex;
+}
+
+void TextureStreaming::RemoveTexture(uint32_t index)
+{
+}
+
+void TextureStreaming::RequestVisibleTextures(const Camera& camera)
+{
+}
+
+void TextureStreaming::Update()
+{
+}
+
+#endif
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <engine/api.h>
+
+class Camera;
+class TextureDefault;
+
+/**
+* @brief Mip level streaming of the textures with the isStreamed setting (Windows and Linux only)
+*
+* A streamed texture is first uploaded with its small mip levels only (s_initialSize pixels or less).
+* During the culling, the visible mesh renderers request the mip level matching their size on the screen.
+* The missing levels are read from the file by the job system (the cooked files have all the levels, the editor decodes and resizes the source image),
+* then uploaded and used by moving the base level of the texture.
+* The levels not requested for s_keepFrameCount frames are dropped, and the highest levels are dropped first when the pool is over budget.
+*/
+class API TextureStreaming
+{
+public:
+	static constexpr uint32_t s_invalidIndex = UINT32_MAX;
+
+	// Biggest side of the levels uploaded when the texture is loaded
+	static constexpr int s_initialSize = 64;
+
+	// Number of frames without request before the high levels of a texture are dropped
+	static constexpr uint64_t s_keepFrameCount = 120;
+
+	// Number of textures read at the same time
+	static constexpr size_t s_maxJobCount = 2;
+
+	/**
+	* @brief Set the memory budget of the streamed levels
+	* @param budget Size in bytes
+	*/
+	static void SetPoolBudget(size_t budget)
+	{
+		s_poolBudget = budget;
+	}
+
+	/**
+	* @brief Get the memory budget of the streamed levels in bytes
+	*/
+	[[nodiscard]] static size_t GetPoolBudget()
+	{
+		return s_poolBudget;
+	}
+
+	/**
+	* @brief Get the memory used by the streamed levels in bytes
+	*/
+	[[nodiscard]] static size_t GetPoolSize()
+	{
+		return s_poolSize;
+	}
+
+	/**
+	* @brief Get the number of mip levels of a texture (down to 1x1)
+	*/
+	[[nodiscard]] static int GetMipCount(int width, int height);
+
+	/**
+	* @brief Get the size in bytes of the levels of a RGBA texture from firstLevel to the last level
+	*/
+	[[nodiscard]] static size_t GetLevelsSize(int width, int height, int firstLevel);
+
+	/**
+	* @brief Get the first level with both sides smaller or equal to a size
+	*/
+	[[nodiscard]] static int GetLevelForSize(int width, int height, int size);
+
+	/**
+	* @brief Get the level needed to draw a texture over a number of pixels
+	* @param width, height Size of the level 0
+	* @param screenPixels Number of pixels covered by the object on the screen (in height)
+	* @param lowestLevel Level used when the object is very small
+	*/
+	[[nodiscard]] static int ComputeRequestedLevel(int width, int height, float screenPixels, int lowestLevel);
+
+private:
+	friend class Engine;
+	friend class Graphics;
+	friend class TextureDefault;
+
+	struct StreamingJob;
+
+	struct StreamedTexture
+	{
+		TextureDefault* texture = nullptr;
+		int residentLevel = 0; // Highest detail level uploaded
+		int lowestLevel = 0; // Level uploaded at the loading
+		int requestedLevel = 0;
+		uint64_t lastRequestFrame = 0;
+		std::shared_ptr<StreamingJob> job;
+	};
+
+	/**
+	* @brief [Internal] Add a texture to the streaming list
+	* @param lowestLevel Level uploaded at the loading, never dropped
+	* @return Index of the texture in the list
+	*/
+	[[nodiscard]] static uint32_t AddTexture(TextureDefault& texture, int lowestLevel);
+
+	/**
+	* @brief [Internal] Remove a texture from the streaming list, the last texture takes its index
+	* @param index Index of the texture (ignored if invalid)
+	*/
+	static void RemoveTexture(uint32_t index);
+
+	/**
+	* @brief [Internal] Request the levels of the textures of the visible mesh renderers (call after the frustum culling)
+	*/
+	static void RequestVisibleTextures(const Camera& camera);
+
+	/**
+	* @brief [Internal] Upload the decoded levels, drop the unused levels and start the decoding of the requested levels
+	*/
+	static void Update();
+
+	/**
+	* @brief Read the levels of the job from the texture file (worker thread)
+	*/
+	static void RunJob(StreamingJob& job);
+
+	/**
+	* @brief Read the levels of the job from a cooked texture file, nothing is decoded (worker thread)
+	*/
+	static void ReadCompressedLevels(StreamingJob& job);
+
+	/**
+	* @brief Decode the image file and resize it to the levels of the job (worker thread)
+	*/
+	static void DecodeLevels(StreamingJob& job);
+
+	/**
+	* @brief Read the whole texture file of a job (worker thread)
+	* @return Data allocated with new[], nullptr if the file can't be read
+	*/
+	[[nodiscard]] static unsigned char* ReadFile(const StreamingJob& job, size_t& size);
+
+	/**
+	* @brief Read a part of the texture file of a job (worker thread)
+	* @return Data allocated with new[], nullptr if the file can't be read
+	*/
+	[[nodiscard]] static unsigned char* ReadFile(const StreamingJob& job, size_t offset, size_t size);
+
+	/**
+	* @brief Get the size in bytes of the levels of a streamed texture from firstLevel to the last level
+	*/
+	[[nodiscard]] static size_t GetTextureLevelsSize(const TextureDefault& texture, int firstLevel);
+
+	static void StartJob(StreamedTexture& streamedTexture, int targetLevel);
+	static void FinishJob(StreamedTexture& streamedTexture);
+	static void DropLevels(StreamedTexture& streamedTexture, int newResidentLevel);
+	[[nodiscard]] static int GetTargetLevel(const StreamedTexture& streamedTexture);
+
+	static std::vector<StreamedTexture> s_textures;
+	static size_t s_poolBudget;
+	static size_t s_poolSize;
+	static std::vector<std::shared_ptr<StreamingJob>> s_runningJobs;
+	static uint64_t s_currentFrame;
+};
@@ -82,12 +82,12 @@ void Canvas::Update()
 
 void Canvas::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void Canvas::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void Canvas::CreateRenderCommands(RenderBatch& renderBatch)
@@ -97,8 +97,7 @@ void Canvas::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransformRaw();
 	command.isEnabled = IsEnabled() && GetGameObject()->IsLocalActive();
 
-	renderBatch.uiCommands.push_back(command);
-	renderBatch.uiCommandIndex++;
+	renderBatch.AddCommand(RenderPass::UI, command);
 }
 
 void Canvas::DrawCommand(const RenderCommand& renderCommand)
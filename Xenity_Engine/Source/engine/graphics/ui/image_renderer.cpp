@@ -3,6 +3,7 @@
 #include <engine/graphics/texture/texture.h>
 #include <engine/asset_management/asset_manager.h>
 #include <engine/game_elements/gameobject.h>
+#include <engine/game_elements/transform.h>
 #include <engine/graphics/2d_graphics/sprite_manager.h>
 #include <engine/graphics/graphics.h>
 #include <engine/debug/stack_debug_object.h>
@@ -10,6 +11,11 @@
 #include <engine/game_elements/rect_transform.h>
 #include <engine/graphics/ui/canvas.h>
 
+ImageRenderer::ImageRenderer()
+{
+	m_drawableType = DrawableType::ImageRenderer;
+}
+
 ReflectiveData ImageRenderer::GetReflectiveData()
 {
 	ReflectiveData reflectedVariables;
@@ -23,8 +29,7 @@ void ImageRenderer::OnReflectionUpdated()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
-	Graphics::s_isRenderingBatchDirty = true;
-	Graphics::s_needUpdateUIOrdering = true;
+	SetRenderCommandsDirty();
 }
 
 void ImageRenderer::CreateRenderCommands(RenderBatch& renderBatch)
@@ -39,8 +44,7 @@ void ImageRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransformRaw();
 	command.isEnabled = IsEnabled() && GetGameObjectRaw()->IsLocalActive();
 
-	renderBatch.uiCommands.push_back(command);
-	renderBatch.uiCommandIndex++;
+	renderBatch.AddCommand(RenderPass::UI, command);
 }
 
 void ImageRenderer::DrawCommand(const RenderCommand& renderCommand)
@@ -50,18 +54,52 @@ void ImageRenderer::DrawCommand(const RenderCommand& renderCommand)
 	SpriteManager::DrawSprite(*GetTransformRaw(), color, *AssetManager::unlitMaterial, m_image.get(), true);
 }
 
+bool ImageRenderer::IsInstanceCompatible([[maybe_unused]] const RenderCommand& renderCommand, [[maybe_unused]] const RenderCommand& otherCommand) const
+{
+#if defined(ENABLE_SPRITE_BATCHING)
+	if (otherCommand.drawable->GetDrawableType() != DrawableType::ImageRenderer)
+		return false;
+
+	const ImageRenderer* otherRenderer = static_cast<const ImageRenderer*>(otherCommand.drawable);
+	if (otherRenderer->m_image != m_image)
+		return false;
+
+	// The face order is shared by all the images of a batch
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	const Vector3& otherScale = otherRenderer->GetTransformRaw()->GetScale();
+	return (scale.x * scale.y < 0) == (otherScale.x * otherScale.y < 0);
+#else
+	return false;
+#endif
+}
+
+bool ImageRenderer::DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount)
+{
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	if (!SpriteManager::BeginSpriteBatch(*AssetManager::unlitMaterial, m_image.get(), true, scale.x * scale.y < 0))
+		return false;
+
+	for (size_t i = 0; i < commandCount; i++)
+	{
+		const ImageRenderer& imageRenderer = static_cast<const ImageRenderer&>(*renderCommands[i]->drawable);
+		SpriteManager::AddSpriteToBatch(*imageRenderer.GetTransformRaw(), imageRenderer.color);
+	}
+	SpriteManager::EndSpriteBatch();
+	return true;
+}
+
 void ImageRenderer::SetImage(const std::shared_ptr<Texture>& image)
 {
 	m_image = image;
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void ImageRenderer::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void ImageRenderer::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
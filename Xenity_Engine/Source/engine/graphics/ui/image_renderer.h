@@ -12,6 +12,8 @@ class Canvas;
 class API ImageRenderer : public IDrawable
 {
 public:
+	ImageRenderer();
+
 	Color color;
 
 	/**
@@ -52,6 +54,16 @@ protected:
 	*/
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
+	/**
+	* @brief Get if the other command is a image renderer with the same image and face order
+	*/
+	[[nodiscard]] bool IsInstanceCompatible(const RenderCommand& renderCommand, const RenderCommand& otherCommand) const override;
+
+	/**
+	* @brief Draw the images of the commands with one draw call (see SpriteManager::BeginSpriteBatch)
+	*/
+	[[nodiscard]] bool DrawCommandsInstanced(const RenderCommand* const* renderCommands, size_t commandCount) override;
+
 	std::shared_ptr<Texture> m_image;
 };
 
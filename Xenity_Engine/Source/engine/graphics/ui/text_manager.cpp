@@ -12,6 +12,7 @@
 
 #include <engine/graphics/graphics.h>
 #include <engine/graphics/3d_graphics/mesh_data.h>
+#include <engine/graphics/3d_graphics/dynamic_mesh.h>
 #include <engine/debug/debug.h>
 #include <engine/tools/profiler_benchmark.h>
 #include <engine/game_elements/transform.h>
@@ -30,10 +31,24 @@ void TextManager::Init()
 {
 }
 
-std::shared_ptr<MeshData> TextManager::CreateMesh(const std::string &text, TextInfo *textInfo, HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment, const Color &color, const std::shared_ptr<Font> &font, float scale)
+VertexDescriptor TextManager::CreateVertexDescriptor()
+{
+	VertexDescriptor vertexDescriptorList;
+	vertexDescriptorList.AddVertexElement(VertexElement::UV_32_BITS);
+#if defined(__vita__)
+	vertexDescriptorList.AddVertexElement(VertexElement::COLOR_4_FLOATS);
+#endif
+	vertexDescriptorList.AddVertexElement(VertexElement::POSITION_32_BITS);
+	return vertexDescriptorList;
+}
+
+void TextManager::UpdateMesh(DynamicMesh& mesh, const std::string &text, TextInfo *textInfo, HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment, const Color &color, const std::shared_ptr<Font> &font, float scale)
 {
 	if (!font->GetFontAtlas())
-		return nullptr;
+	{
+		mesh.Clear();
+		return;
+	}
 
 	const int textLenght = (int)text.size();
 
@@ -70,20 +85,11 @@ std::shared_ptr<MeshData> TextManager::CreateMesh(const std::string &text, TextI
 		y += totalY * scale;
 	}
 
-	// Create empty mesh
+	// Reuse the mesh memory, it only grows if the text is longer than before
 	const int charCountToDraw = textLenght - (textInfo->lineCount - 1);
 
-	VertexDescriptor vertexDescriptorList;
-	vertexDescriptorList.AddVertexElement(VertexElement::UV_32_BITS);
-#if defined(__vita__)
-	vertexDescriptorList.AddVertexElement(VertexElement::COLOR_4_FLOATS);
-#endif
-	vertexDescriptorList.AddVertexElement(VertexElement::POSITION_32_BITS);
-
-
-	std::shared_ptr<MeshData> mesh = MeshData::CreateMeshData();
-	mesh->CreateSubMesh(6 * charCountToDraw, 6 * charCountToDraw, vertexDescriptorList);
-	mesh->unifiedColor = color;
+	mesh.Begin(6 * charCountToDraw, 6 * charCountToDraw);
+	mesh.GetMeshData().unifiedColor = color;
 
 	int drawnCharIndex = 0;
 	for (int i = 0; i < textLenght; i++)
@@ -106,18 +112,17 @@ std::shared_ptr<MeshData> TextManager::CreateMesh(const std::string &text, TextI
 		}
 		else
 		{
-			AddCharToMesh(mesh, ch, x, y, drawnCharIndex, scale);
+			AddCharToMesh(mesh.GetSubMesh(), ch, x, y, drawnCharIndex, scale);
 			drawnCharIndex++;
 			x -= ch->rightAdvance * scale;
 		}
 	}
 
-	mesh->OnLoadFileReferenceFinished();
+	mesh.End(6 * drawnCharIndex, 6 * drawnCharIndex);
 
 #if defined(__PSP__)
 	sceKernelDcacheWritebackInvalidateAll(); // Very important
 #endif
-	return mesh;
 }
 
 void TextManager::DrawText(const std::string &text, TextInfo *textInfo, HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment, const Transform &transform, const Color& color, bool canvas, const MeshData& mesh, const Font& font, Material& material)
@@ -159,7 +164,7 @@ void TextManager::DrawText(const std::string &text, TextInfo *textInfo, Horizont
 	}
 }
 
-void TextManager::AddCharToMesh(const std::shared_ptr<MeshData> &mesh, Character *ch, float x, float y, int letterIndex, float scale)
+void TextManager::AddCharToMesh(MeshData::SubMesh& subMesh, Character *ch, float x, float y, int letterIndex, float scale)
 {
 	const int indice = letterIndex * 6;
 	const int indiceIndex = letterIndex * 6;
@@ -171,32 +176,30 @@ void TextManager::AddCharToMesh(const std::shared_ptr<MeshData> &mesh, Character
 
 	// Use 6 vertices instead of 4 because at the time the PS2 VU1 renderer do not supports indices
 
-	std::unique_ptr<MeshData::SubMesh>& subMesh = mesh->m_subMeshes[0];
-
 	const Color white = Color::CreateFromRGBFloat(1, 1, 1);
 #if defined(__vita__)
-	subMesh->SetVertex(ch->uv.x, ch->uv.y, white, w + x, fixedY, 0, indice);
-	subMesh->SetVertex(ch->uvOffet.x, ch->uv.y, white, x, fixedY, 0, 1 + indice);
-	subMesh->SetVertex(ch->uvOffet.x, ch->uvOffet.y, white, x, h + fixedY, 0, 2 + indice);
+	subMesh.SetVertex(ch->uv.x, ch->uv.y, white, w + x, fixedY, 0, indice);
+	subMesh.SetVertex(ch->uvOffet.x, ch->uv.y, white, x, fixedY, 0, 1 + indice);
+	subMesh.SetVertex(ch->uvOffet.x, ch->uvOffet.y, white, x, h + fixedY, 0, 2 + indice);
 
-	subMesh->SetVertex(ch->uv.x, ch->uv.y, white, w + x, fixedY, 0, 3 + indice);
-	subMesh->SetVertex(ch->uv.x, ch->uvOffet.y, white, w + x, h + fixedY, 0, 4 + indice);
-	subMesh->SetVertex(ch->uvOffet.x, ch->uvOffet.y, white, x, h + fixedY, 0, 5 + indice);
+	subMesh.SetVertex(ch->uv.x, ch->uv.y, white, w + x, fixedY, 0, 3 + indice);
+	subMesh.SetVertex(ch->uv.x, ch->uvOffet.y, white, w + x, h + fixedY, 0, 4 + indice);
+	subMesh.SetVertex(ch->uvOffet.x, ch->uvOffet.y, white, x, h + fixedY, 0, 5 + indice);
 #else
-	subMesh->SetVertex(ch->uv.x, ch->uv.y, w + x, fixedY, 0, indice);
-	subMesh->SetVertex(ch->uvOffet.x, ch->uv.y, x, fixedY, 0, 1 + indice);
-	subMesh->SetVertex(ch->uvOffet.x, ch->uvOffet.y, x, h + fixedY, 0, 2 + indice);
+	subMesh.SetVertex(ch->uv.x, ch->uv.y, w + x, fixedY, 0, indice);
+	subMesh.SetVertex(ch->uvOffet.x, ch->uv.y, x, fixedY, 0, 1 + indice);
+	subMesh.SetVertex(ch->uvOffet.x, ch->uvOffet.y, x, h + fixedY, 0, 2 + indice);
 
-	subMesh->SetVertex(ch->uv.x, ch->uv.y, w + x, fixedY, 0, 3 + indice);
-	subMesh->SetVertex(ch->uv.x, ch->uvOffet.y, w + x, h + fixedY, 0, 4 + indice);
-	subMesh->SetVertex(ch->uvOffet.x, ch->uvOffet.y, x, h + fixedY, 0, 5 + indice);
+	subMesh.SetVertex(ch->uv.x, ch->uv.y, w + x, fixedY, 0, 3 + indice);
+	subMesh.SetVertex(ch->uv.x, ch->uvOffet.y, w + x, h + fixedY, 0, 4 + indice);
+	subMesh.SetVertex(ch->uvOffet.x, ch->uvOffet.y, x, h + fixedY, 0, 5 + indice);
 #endif
-	subMesh->SetIndex(indiceIndex + 0, indice + 0);
-	subMesh->SetIndex(indiceIndex + 1, indice + 2);
-	subMesh->SetIndex(indiceIndex + 2, indice + 1);
-	subMesh->SetIndex(indiceIndex + 3, indice + 3);
-	subMesh->SetIndex(indiceIndex + 4, indice + 4);
-	subMesh->SetIndex(indiceIndex + 5, indice + 5);
+	subMesh.SetIndex(indiceIndex + 0, indice + 0);
+	subMesh.SetIndex(indiceIndex + 1, indice + 2);
+	subMesh.SetIndex(indiceIndex + 2, indice + 1);
+	subMesh.SetIndex(indiceIndex + 3, indice + 3);
+	subMesh.SetIndex(indiceIndex + 4, indice + 4);
+	subMesh.SetIndex(indiceIndex + 5, indice + 5);
 }
 
 TextInfo *TextManager::GetTextInfomations(const std::string &text, int textLen, std::shared_ptr<Font> font, float scale)
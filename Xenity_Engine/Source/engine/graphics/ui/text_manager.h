@@ -12,12 +12,13 @@
 #include <glm/vec2.hpp>
 
 #include <engine/math/vector2.h>
+#include <engine/graphics/3d_graphics/mesh_data.h>
 #include "text_alignments.h"
 
 class Texture;
 class Vector4;
 class Transform;
-class MeshData;
+class DynamicMesh;
 class Vector3;
 class Color;
 class Font;
@@ -95,7 +96,13 @@ public:
 	[[nodiscard]] static TextInfo* GetTextInfomations(const std::string& text, int textLen, std::shared_ptr<Font> font, float scale);
 
 	/**
-	* @brief Create a mesh from a text
+	* @brief Get the vertex descriptor of the text meshes
+	*/
+	[[nodiscard]] static VertexDescriptor CreateVertexDescriptor();
+
+	/**
+	* @brief Write a text in a mesh, the mesh memory is reused
+	* @param mesh Mesh to fill
 	* @param text Text
 	* @param textInfo Text information
 	* @param horizontalAlignment Horizontal alignment
@@ -103,19 +110,18 @@ public:
 	* @param color Color
 	* @param font Font
 	* @param scale Scale
-	* @return The mesh
 	*/
-	[[nodiscard]] static std::shared_ptr <MeshData> CreateMesh(const std::string& text, TextInfo* textInfo, HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment, const Color& color, const std::shared_ptr<Font>& font, float scale);
+	static void UpdateMesh(DynamicMesh& mesh, const std::string& text, TextInfo* textInfo, HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment, const Color& color, const std::shared_ptr<Font>& font, float scale);
 
 private:
 
 	/**
 	* @brief Add a char to the mesh
-	* @param mesh Mesh to modify
+	* @param subMesh Submesh to modify
 	* @param ch Char to add
 	* @param x Char X position
 	* @param y Char Y position
 	* @param letterIndex Letter index in the string
 	*/
-	static void AddCharToMesh(const std::shared_ptr<MeshData>& mesh, Character* ch, float x, float y, int letterIndex, float scale);
+	static void AddCharToMesh(MeshData::SubMesh& subMesh, Character* ch, float x, float y, int letterIndex, float scale);
 };
\ No newline at end of file
@@ -17,7 +17,7 @@
 
 #pragma region Constructors / Destructor
 
-TextMesh::TextMesh()
+TextMesh::TextMesh() : m_mesh(TextManager::CreateVertexDescriptor())
 {
 }
 
@@ -38,7 +38,7 @@ void TextMesh::OnReflectionUpdated()
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
 	m_isTextInfoDirty = true;
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 #pragma endregion
@@ -63,12 +63,12 @@ void TextMesh::SetFont(const std::shared_ptr<Font>& font)
 
 void TextMesh::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void TextMesh::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void TextMesh::CreateRenderCommands(RenderBatch& renderBatch)
@@ -81,8 +81,7 @@ void TextMesh::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransformRaw();
 	command.isEnabled = IsEnabled() && GetGameObject()->IsLocalActive();
 
-	renderBatch.transparentMeshCommands.push_back(command);
-	renderBatch.transparentMeshCommandIndex++;
+	renderBatch.AddCommand(RenderPass::Transparent, command);
 }
 
 /// <summary>
@@ -94,21 +93,22 @@ void TextMesh::DrawCommand(const RenderCommand& renderCommand)
 
 	if (m_isTextInfoDirty)
 	{
-		if (m_mesh)
-		{
-			delete m_textInfo;
-			m_mesh.reset();
-		}
+		delete m_textInfo;
+		m_textInfo = nullptr;
 		if (!m_text.empty())
 		{
 			m_textInfo = TextManager::GetTextInfomations(m_text, (int)m_text.size(), m_font, 1);
-			m_mesh = TextManager::CreateMesh(m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, m_color, m_font, m_fontSize);
+			TextManager::UpdateMesh(m_mesh, m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, m_color, m_font, m_fontSize);
+		}
+		else
+		{
+			m_mesh.Clear();
 		}
 		m_isTextInfoDirty = false;
 	}
-	if (m_mesh)
+	if (!m_mesh.IsEmpty())
 	{
-		TextManager::DrawText(m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, *GetTransformRaw(), m_color, false, *m_mesh, *m_font, *AssetManager::unlitMaterial);
+		TextManager::DrawText(m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, *GetTransformRaw(), m_color, false, m_mesh.GetMeshData(), *m_font, *AssetManager::unlitMaterial);
 	}
 }
 
@@ -10,11 +10,11 @@
 #include <engine/api.h>
 #include <engine/graphics/iDrawable.h>
 #include <engine/graphics/color/color.h>
+#include <engine/graphics/3d_graphics/dynamic_mesh.h>
 #include "text_alignments.h"
 
 class Font;
 struct TextInfo;
-class MeshData;
 
 /**
 * @brief Component for rendering text in 3D space
@@ -162,7 +162,7 @@ protected:
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
 	TextInfo* m_textInfo = nullptr;
-	std::shared_ptr <MeshData> m_mesh = nullptr;
+	DynamicMesh m_mesh;
 	std::shared_ptr<Font> m_font;
 	std::string m_text = "Text";
 	Color m_color = Color();
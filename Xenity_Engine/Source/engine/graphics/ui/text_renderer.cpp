@@ -17,7 +17,7 @@
 
 #pragma region Constructors / Destructor
 
-TextRenderer::TextRenderer()
+TextRenderer::TextRenderer() : m_mesh(TextManager::CreateVertexDescriptor())
 {
 }
 
@@ -39,8 +39,7 @@ void TextRenderer::OnReflectionUpdated()
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
 	m_isTextInfoDirty = true;
-	Graphics::s_isRenderingBatchDirty = true;
-	Graphics::s_needUpdateUIOrdering = true;
+	SetRenderCommandsDirty();
 }
 
 #pragma endregion
@@ -60,18 +59,18 @@ void TextRenderer::SetFont(const std::shared_ptr<Font>& font)
 	{
 		m_font = font;
 		m_isTextInfoDirty = true;
-		Graphics::s_isRenderingBatchDirty = true;
+		SetRenderCommandsDirty();
 	}
 }
 
 void TextRenderer::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void TextRenderer::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void TextRenderer::CreateRenderCommands(RenderBatch& renderBatch)
@@ -85,8 +84,7 @@ void TextRenderer::CreateRenderCommands(RenderBatch& renderBatch)
 	command.transform = GetTransformRaw();
 	command.isEnabled = IsEnabled() && GetGameObjectRaw()->IsLocalActive();
 
-	renderBatch.uiCommands.push_back(command);
-	renderBatch.uiCommandIndex++;
+	renderBatch.AddCommand(RenderPass::UI, command);
 }
 
 /// <summary>
@@ -98,21 +96,22 @@ void TextRenderer::DrawCommand(const RenderCommand& renderCommand)
 
 	if (m_isTextInfoDirty)
 	{
-		if (m_mesh)
-		{
-			delete m_textInfo;
-			m_mesh.reset();
-		}
+		delete m_textInfo;
+		m_textInfo = nullptr;
 		if(!m_text.empty())
 		{
 			m_textInfo = TextManager::GetTextInfomations(m_text, (int)m_text.size(), m_font, 1);
-			m_mesh = TextManager::CreateMesh(m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, m_color, m_font, m_fontSize);
+			TextManager::UpdateMesh(m_mesh, m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, m_color, m_font, m_fontSize);
+		}
+		else
+		{
+			m_mesh.Clear();
 		}
 		m_isTextInfoDirty = false;
 	}
-	if (m_mesh)
+	if (!m_mesh.IsEmpty())
 	{
-		TextManager::DrawText(m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, *GetTransformRaw(), m_color, true, *m_mesh, *m_font, *AssetManager::unlitMaterial.get());
+		TextManager::DrawText(m_text, m_textInfo, m_horizontalAlignment, m_verticalAlignment, *GetTransformRaw(), m_color, true, m_mesh.GetMeshData(), *m_font, *AssetManager::unlitMaterial.get());
 	}
 }
 
@@ -10,11 +10,11 @@
 #include <engine/api.h>
 #include <engine/graphics/iDrawable.h>
 #include <engine/graphics/color/color.h>
+#include <engine/graphics/3d_graphics/dynamic_mesh.h>
 #include "text_alignments.h"
 
 class Font;
 struct TextInfo;
-class MeshData;
 
 /**
 * @brief Component for rendering text in a canvas
@@ -173,7 +173,7 @@ protected:
 	*/
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
-	std::shared_ptr<MeshData> m_mesh = nullptr;
+	DynamicMesh m_mesh;
 	std::shared_ptr<Font> m_font;
 	TextInfo* m_textInfo = nullptr;
 	std::string m_text = "Text";
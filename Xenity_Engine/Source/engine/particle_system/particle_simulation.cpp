@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "particle_simulation.h"
+
+#include <engine/constants.h>
+#include <engine/particle_system/particle_system.h>
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+#include <engine/debug/performance.h>
+#include <engine/tools/job_system.h>
+
+std::vector<ParticleSystem*> ParticleSimulation::s_emitters;
+
+namespace
+{
+#if defined(ENABLE_MULTITHREADED_PARTICLES)
+	// Do not use the worker threads for a few emitters
+	constexpr size_t s_minEmitterCountForThreads = 4;
+#endif
+}
+
+void ParticleSimulation::Stop()
+{
+	s_emitters.clear();
+}
+
+void ParticleSimulation::AddEmitter(ParticleSystem& particleSystem)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	s_emitters.push_back(&particleSystem);
+}
+
+void ParticleSimulation::Run()
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+	if (s_emitters.empty())
+		return;
+
+	SCOPED_PROFILER("ParticleSimulation::Run", scopeBenchmark);
+
+#if defined(ENABLE_MULTITHREADED_PARTICLES)
+	if (s_emitters.size() >= s_minEmitterCountForThreads)
+	{
+		JobSystem::ParallelFor(s_emitters.size(), 1, [](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				s_emitters[i]->Simulate();
+			}
+		});
+		s_emitters.clear();
+		return;
+	}
+#endif
+
+	for (ParticleSystem* particleSystem : s_emitters)
+	{
+		particleSystem->Simulate();
+	}
+	s_emitters.clear();
+}
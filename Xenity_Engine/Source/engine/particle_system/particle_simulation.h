@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstdint>
+#include <vector>
+
+class ParticleSystem;
+
+/**
+* @brief Simulation of the particle systems of the frame
+*
+* The particle systems are queued during the OnNewFrame calls and simulated together with Run(), once per frame before the camera renders.
+* With ENABLE_MULTITHREADED_PARTICLES, the emitters are split between the workers of the JobSystem (each emitter has its own random generator).
+*/
+class ParticleSimulation
+{
+public:
+	/**
+	* @brief Clear the queue
+	*/
+	static void Stop();
+
+	/**
+	* @brief Queue a particle system to simulate during the next Run() call
+	*/
+	static void AddEmitter(ParticleSystem& particleSystem);
+
+	/**
+	* @brief Simulate all the queued particle systems and wait for the end of the simulation
+	*/
+	static void Run();
+
+private:
+	static std::vector<ParticleSystem*> s_emitters;
+};
@@ -7,9 +7,19 @@
 #include "particle_system.h"
 
 #include <random>
+#include <algorithm>
+#include <cmath>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PARTICLES_USE_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PARTICLES_USE_NEON
+#include <arm_neon.h>
+#endif
+
 #if defined(EDITOR)
 #include <editor/rendering/gizmo.h>
 #include <engine/game_elements/gameplay_manager.h>
@@ -29,20 +39,53 @@
 #include <engine/engine.h>
 #include <engine/math/math.h>
 #include <engine/graphics/2d_graphics/sprite_manager.h>
+#include <engine/graphics/3d_graphics/dynamic_mesh.h>
+#include "particle_simulation.h"
 #include <engine/debug/stack_debug_object.h>
 #include <engine/debug/performance.h>
 #include <engine/debug/debug.h>
 
-std::default_random_engine ParticleSystem::m_gen;
+namespace
+{
+	struct ParticleVertex
+	{
+		float u, v;
+		float r, g, b, a;
+		float nx, ny, nz;
+		float x, y, z;
+	};
+
+	void SetParticleVertex(ParticleVertex& vertex, float u, float v, const Vector4& color, const glm::vec3& normal, const glm::vec3& position)
+	{
+		vertex.u = u;
+		vertex.v = v;
+		vertex.r = color.x;
+		vertex.g = color.y;
+		vertex.b = color.z;
+		vertex.a = color.w;
+		vertex.nx = normal.x;
+		vertex.ny = normal.y;
+		vertex.nz = normal.z;
+		vertex.x = position.x;
+		vertex.y = position.y;
+		vertex.z = position.z;
+	}
+}
 
 ParticleSystem::ParticleSystem()
 {
+	m_useOnNewRender = true;
 	scaleOverLifeTimeFunction = DefaultGetScaleOverLifeTime;
 	speedMultiplierOverLifeTimeFunction = DefaultGetSpeedOverLifeTime;
 	colorOverLifeTimeFunction = DefaultGetColorOverLifeTime;
+	BakeLifeTimeTables();
 	AllocateParticlesMemory();
 }
 
+ParticleSystem::~ParticleSystem()
+{
+}
+
 ReflectiveData ParticleSystem::GetReflectiveData()
 {
 	ReflectiveData reflectedVariables;
@@ -65,6 +108,7 @@ ReflectiveData ParticleSystem::GetReflectiveData()
 	Reflective::AddVariable(reflectedVariables, m_spawnRate, "spawnRate");
 	Reflective::AddVariable(reflectedVariables, m_maxParticles, "maxParticles");
 	Reflective::AddVariable(reflectedVariables, m_randomRotation, "randomRotation");
+	Reflective::AddVariable(reflectedVariables, m_randomSeed, "randomSeed");
 
 	//Reflective::AddVariable(reflectedVariables, reset, "reset", true);
 	Reflective::AddVariable(reflectedVariables, m_isEmitting, "isEmitting");
@@ -80,7 +124,7 @@ void ParticleSystem::OnReflectionUpdated()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 
 	// Check variables values and correct them if needed
 	if (m_speedMin > m_speedMax)
@@ -117,11 +161,14 @@ void ParticleSystem::OnReflectionUpdated()
 	m_boxYDistribution = std::uniform_real_distribution<float>(-m_boxSize.y / 2.0f, m_boxSize.y / 2.0f);
 	m_boxZDistribution = std::uniform_real_distribution<float>(-m_boxSize.z / 2.0f, m_boxSize.z / 2.0f);
 
+	ResetRandomGenerator();
 	AllocateParticlesMemory();
 }
 
 void ParticleSystem::Start()
 {
+	// The unique id of the component is known at this point (loaded from the scene)
+	ResetRandomGenerator();
 	if (m_loop)
 	{
 		ResetParticles();
@@ -135,17 +182,31 @@ void ParticleSystem::Update()
 
 void ParticleSystem::Play()
 {
-	for (int i = 0; i < m_maxParticles; i++)
+	for (size_t i = 0; i < m_particleCount; i++)
+	{
+		ResetParticle(i, false);
+	}
+}
+
+void ParticleSystem::ResetRandomGenerator()
+{
+	// Same particles after a reload or in a replay, whatever the creation order of the emitters
+	if (m_randomSeed != 0)
+	{
+		m_gen.seed(static_cast<uint32_t>(m_randomSeed));
+	}
+	else
 	{
-		ResetParticle(m_particles[i], false);
+		const uint64_t uniqueId = GetUniqueId();
+		m_gen.seed(static_cast<uint32_t>(uniqueId ^ (uniqueId >> 32)));
 	}
 }
 
 void ParticleSystem::ResetParticles()
 {
-	for (int i = 0; i < m_maxParticles; i++)
+	for (size_t i = 0; i < m_particleCount; i++)
 	{
-		ResetParticle(m_particles[i], true);
+		ResetParticle(i, true);
 	}
 }
 
@@ -208,20 +269,19 @@ void ParticleSystem::OnDrawGizmosSelected()
 #endif
 }
 
-int currentFrame = 0;
-
-void ParticleSystem::ResetParticle(Particle& particle, bool setIsDead)
+void ParticleSystem::ResetParticle(size_t index, bool setIsDead)
 {
+	Vector3 position;
 	glm::vec3 direction;
 	if (m_emitterShape == EmitterShape::Cone)
 	{
-		particle.position = Vector3(0);
-		direction = glm::vec3((rand() % 2000 - 1000) / 1000.0f * m_coneAngle / 180.0f, (rand() % 1000) / 1000.0f + (180 - m_coneAngle) / 180.0f, (rand() % 2000 - 1000) / 1000.0f * m_coneAngle / 180.0f);
+		position = Vector3(0);
+		direction = glm::vec3((GetRandomInt(2000) - 1000) / 1000.0f * m_coneAngle / 180.0f, GetRandomInt(1000) / 1000.0f + (180 - m_coneAngle) / 180.0f, (GetRandomInt(2000) - 1000) / 1000.0f * m_coneAngle / 180.0f);
 		direction = glm::normalize(direction);
 	}
 	else if (m_emitterShape == EmitterShape::Box)
 	{
-		particle.position = Vector3(m_boxXDistribution(m_gen), m_boxYDistribution(m_gen), m_boxZDistribution(m_gen));
+		position = Vector3(m_boxXDistribution(m_gen), m_boxYDistribution(m_gen), m_boxZDistribution(m_gen));
 		direction = glm::vec3(m_direction.x, m_direction.y, m_direction.z);
 	}
 
@@ -234,76 +294,120 @@ void ParticleSystem::ResetParticle(Particle& particle, bool setIsDead)
 		// Fix particle speed
 		direction *= glm::vec3(scale.x, scale.y, scale.z);
 		// Apply the object rotation to the direction
-		particle.direction = Vector3(glmObjectRotation * direction);
-	}
-	else
-	{
-		particle.direction = Vector3(direction);
+		direction = glmObjectRotation * direction;
 	}
 	if (m_randomRotation)
 	{
-		particle.billboardRotation = static_cast<float>(rand() % 360);
+		m_particles.billboardRotations[index] = static_cast<float>(GetRandomInt(360));
 	}
-	particle.currentSpeed = m_speedDistribution(m_gen);
-
-	particle.currentLifeTime = 0;
+	const glm::vec3 velocity = direction * m_speedDistribution(m_gen);
+	m_particles.velocitiesX[index] = velocity.x;
+	m_particles.velocitiesY[index] = velocity.y;
+	m_particles.velocitiesZ[index] = velocity.z;
 
-	particle.lifeTime = m_lifeTimeDistribution(m_gen);
-	particle.isDead = setIsDead;
+	const float lifeTime = m_lifeTimeDistribution(m_gen);
+	m_particles.lifeTimes[index] = lifeTime;
+	// A dead particle has reached its life time
+	m_particles.currentLifeTimes[index] = setIsDead ? lifeTime : 0;
 
 	static const Quaternion identity = Quaternion::Identity();
-	const Quaternion rotation = m_randomRotation ? Quaternion((rand() % 100) / 100.0f, (rand() % 100) / 100.0f, (rand() % 100) / 100.0f, (rand() % 100) / 100.0f) : identity;
+	const Quaternion rotation = m_randomRotation ? Quaternion(GetRandomInt(100) / 100.0f, GetRandomInt(100) / 100.0f, GetRandomInt(100) / 100.0f, GetRandomInt(100) / 100.0f) : identity;
 
+	glm::mat4 matrix;
 	if (m_worldSimulation)
 	{
 		const glm::mat4& transMat = GetTransformRaw()->GetTransformationMatrix();
-		particle.matrix = InternalMath::MultiplyMatrices(transMat, InternalMath::CreateModelMatrix(particle.position, rotation, Vector3(1)));
+		matrix = InternalMath::MultiplyMatrices(transMat, InternalMath::CreateModelMatrix(position, rotation, Vector3(1)));
 	}
 	else
 	{
-		particle.matrix = InternalMath::CreateModelMatrix(particle.position, rotation, Vector3(1));
+		matrix = InternalMath::CreateModelMatrix(position, rotation, Vector3(1));
 	}
+	m_particles.positionsX[index] = matrix[3].x;
+	m_particles.positionsY[index] = matrix[3].y;
+	m_particles.positionsZ[index] = matrix[3].z;
+	m_particles.orientations[index] = glm::mat3(matrix);
 
-	particle.scale = scaleOverLifeTimeFunction(0);
+	m_particles.speedMultipliers[index] = m_speedMultiplierOverLifeTimeTable[0];
 
-	//particle.frameBeforeUpdate = currentFrame + 1;
-	if (currentFrame == 0)
+	float& simulationCooldown = m_particles.simulationCooldowns[index];
+	if (m_spawnFrame == 0)
 	{
 		if (m_simulationRate == SimulationRate::fps_30)
 		{
-			particle.simulationCooldown = 1 / 30.0f;
+			simulationCooldown = 1 / 30.0f;
 		}
 		else if (m_simulationRate == SimulationRate::fps_60)
 		{
-			particle.simulationCooldown = 1 / 60.0f;
+			simulationCooldown = 1 / 60.0f;
 		}
 		else
 		{
-			particle.simulationCooldown = 0;
+			simulationCooldown = 0;
 		}
 	}
 	else
 	{
-		particle.simulationCooldown = 0;
+		simulationCooldown = 0;
 	}
 
-	currentFrame++;
-	currentFrame %= 2;
+	m_spawnFrame++;
+	m_spawnFrame %= 2;
+}
+
+int ParticleSystem::GetRandomInt(int max)
+{
+	return static_cast<int>(m_gen() % static_cast<uint32_t>(max));
 }
 
 void ParticleSystem::AllocateParticlesMemory()
 {
-	m_particles.clear();
-	for (int i = 0; i < m_maxParticles; i++)
-	{
-		Particle& newParticle = m_particles.emplace_back();
-		if (GetTransformRaw())
+	m_particleCount = static_cast<size_t>(std::ceil(std::max(m_maxParticles, 0.0f)));
+
+	// Round the size up to a multiple of 4 for the SIMD simulation, the padding particles stay dead (0 life time)
+	const size_t arraySize = (m_particleCount + 3) & ~static_cast<size_t>(3);
+	m_particles.positionsX.assign(arraySize, 0.0f);
+	m_particles.positionsY.assign(arraySize, 0.0f);
+	m_particles.positionsZ.assign(arraySize, 0.0f);
+	m_particles.velocitiesX.assign(arraySize, 0.0f);
+	m_particles.velocitiesY.assign(arraySize, 0.0f);
+	m_particles.velocitiesZ.assign(arraySize, 0.0f);
+	m_particles.currentLifeTimes.assign(arraySize, 0.0f);
+	m_particles.lifeTimes.assign(arraySize, 0.0f);
+	m_particles.speedMultipliers.assign(arraySize, 1.0f);
+	m_particles.simulationCooldowns.assign(arraySize, 0.0f);
+	m_particles.billboardRotations.assign(arraySize, 0.0f);
+	m_particles.orientations.assign(arraySize, glm::mat3(1));
+
+	if (GetTransformRaw())
+	{
+		for (size_t i = 0; i < m_particleCount; i++)
 		{
-			ResetParticle(newParticle, true);
+			ResetParticle(i, true);
 		}
 	}
 }
 
+void ParticleSystem::BakeLifeTimeTables()
+{
+	for (size_t i = 0; i <= s_lifeTimeTableSize; i++)
+	{
+		const float lifeTimeRatio = i / static_cast<float>(s_lifeTimeTableSize);
+		m_scaleOverLifeTimeTable[i] = scaleOverLifeTimeFunction(lifeTimeRatio);
+		m_speedMultiplierOverLifeTimeTable[i] = speedMultiplierOverLifeTimeFunction(lifeTimeRatio);
+		m_colorOverLifeTimeTable[i] = colorOverLifeTimeFunction(lifeTimeRatio);
+	}
+}
+
+template<typename T>
+T ParticleSystem::SampleLifeTimeTable(const T* table, float lifeTimeRatio)
+{
+	const float position = std::clamp(lifeTimeRatio, 0.0f, 1.0f) * s_lifeTimeTableSize;
+	const size_t index = std::min(static_cast<size_t>(position), s_lifeTimeTableSize - 1);
+	const float fraction = position - index;
+	return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
 float ParticleSystem::DefaultGetScaleOverLifeTime(float lifeTime)
 {
 	return std::sin(lifeTime * Math::PI);
@@ -330,47 +434,138 @@ void ParticleSystem::DrawCommand(const RenderCommand& renderCommand)
 	renderSettings.useLighting = renderCommand.material->GetUseLighting();
 	renderSettings.renderingMode = renderCommand.material->GetRenderingMode();
 
+	// The quads are written in one mesh, custom meshes are drawn one by one
+	if (!m_mesh && Engine::GetRenderer().IsVertexStreamingSupported())
+	{
+		DrawParticlesInOneDrawCall(renderSettings);
+	}
+	else
+	{
+		DrawParticlesOneByOne(renderCommand, renderSettings);
+	}
+}
+
+glm::mat4 ParticleSystem::GetParticleMatrix(size_t index, const glm::mat4& cameraMatrix, const glm::mat4& emitterMatrix, const glm::vec3& billboardScale) const
+{
+	glm::mat4 matrix = glm::mat4(m_particles.orientations[index]);
+	matrix[3] = glm::vec4(m_particles.positionsX[index], m_particles.positionsY[index], m_particles.positionsZ[index], 1);
+
+	if (!m_worldSimulation)
+	{
+		matrix = InternalMath::MultiplyMatrices(emitterMatrix, matrix);
+	}
+	if (m_isBillboard)
+	{
+		// Copy camera rotation matrix
+		matrix[0] = cameraMatrix[0];
+		matrix[1] = cameraMatrix[1];
+		matrix[2] = cameraMatrix[2];
+		// Apply the object rotation on Z
+		matrix = glm::rotate(matrix, m_particles.billboardRotations[index], glm::vec3(0, 0, 1));
+		// Fix scale if the camera has a scale (Y and Z are inverted for some raison)
+		matrix = glm::scale(matrix, billboardScale);
+	}
+	return matrix;
+}
+
+void ParticleSystem::DrawParticlesInOneDrawCall(RenderingSettings& renderSettings)
+{
+	if (m_particleCount == 0)
+		return;
+
+	if (!m_particlesMesh)
+	{
+		VertexDescriptor vertexDescriptor;
+		vertexDescriptor.AddVertexElement(VertexElement::UV_32_BITS);
+		vertexDescriptor.AddVertexElement(VertexElement::COLOR_4_FLOATS);
+		vertexDescriptor.AddVertexElement(VertexElement::NORMAL_32_BITS);
+		vertexDescriptor.AddVertexElement(VertexElement::POSITION_32_BITS);
+		XASSERT(vertexDescriptor.GetVertexSize() == sizeof(ParticleVertex), "[ParticleSystem::DrawParticlesInOneDrawCall] Wrong particle vertex size");
+		m_particlesMesh = std::make_unique<DynamicMesh>(vertexDescriptor);
+	}
+
 	const Vector3& camScale = Graphics::usedCamera->GetTransformRaw()->GetScale();
 	const glm::mat4& camMat = Graphics::usedCamera->GetTransformRaw()->GetTransformationMatrix();
 	const glm::mat4& transMat = GetTransformRaw()->GetTransformationMatrix();
-
-	/*const RGBA& rgba = m_color.GetRGBA();*/
 	const Vector3& scale = GetTransformRaw()->GetScale();
 	const glm::vec3 fixedScale = glm::vec3(1.0f / camScale.x, 1.0f / camScale.z, 1.0f / camScale.y) * glm::vec3(scale.x, scale.y, scale.z);
+	const Vector4 emitterColor = m_color.GetRGBA().ToVector4();
+
+	DynamicMesh& mesh = *m_particlesMesh;
+	mesh.Begin(static_cast<uint32_t>(m_particleCount * 4), static_cast<uint32_t>(m_particleCount * 6));
+	MeshData::SubMesh& subMesh = mesh.GetSubMesh();
+	ParticleVertex* vertices = static_cast<ParticleVertex*>(subMesh.m_data);
 
-	glm::mat4 newMat;
-	for (int i = 0; i < m_maxParticles; i++)
+	// Write the quads of the living particles in world space (same quad as the sprite mesh)
+	uint32_t quadCount = 0;
+	for (size_t i = 0; i < m_particleCount; i++)
 	{
-		const Particle& particle = m_particles[i];
-		if (particle.isDead)
+		if (IsParticleDead(i))
 		{
 			continue;
 		}
 
-		newMat = particle.matrix;
+		const glm::mat4 matrix = GetParticleMatrix(i, camMat, transMat, fixedScale);
+		const float lifeTimeRatio = m_particles.currentLifeTimes[i] / m_particles.lifeTimes[i];
+		const float halfSize = SampleLifeTimeTable(m_scaleOverLifeTimeTable, lifeTimeRatio) * 0.5f;
+		const Vector4 color = emitterColor * SampleLifeTimeTable(m_colorOverLifeTimeTable, lifeTimeRatio);
+
+		const glm::vec3 center = glm::vec3(matrix[3]);
+		const glm::vec3 halfRight = glm::vec3(matrix[0]) * halfSize;
+		const glm::vec3 halfUp = glm::vec3(matrix[1]) * halfSize;
+		// Normal of the sprite mesh (0, 0, -1) transformed by the particle matrix
+		const glm::vec3 normal = -glm::normalize(glm::vec3(matrix[2]));
+
+		ParticleVertex* quad = vertices + quadCount * 4;
+		SetParticleVertex(quad[0], 1.0f, 1.0f, color, normal, center - halfRight - halfUp);
+		SetParticleVertex(quad[1], 0.0f, 1.0f, color, normal, center + halfRight - halfUp);
+		SetParticleVertex(quad[2], 0.0f, 0.0f, color, normal, center + halfRight + halfUp);
+		SetParticleVertex(quad[3], 1.0f, 0.0f, color, normal, center - halfRight + halfUp);
+
+		const uint32_t firstVertex = quadCount * 4;
+		const size_t firstIndex = static_cast<size_t>(quadCount) * 6;
+		subMesh.SetIndex(firstIndex, firstVertex);
+		subMesh.SetIndex(firstIndex + 1, firstVertex + 2);
+		subMesh.SetIndex(firstIndex + 2, firstVertex + 1);
+		subMesh.SetIndex(firstIndex + 3, firstVertex + 2);
+		subMesh.SetIndex(firstIndex + 4, firstVertex);
+		subMesh.SetIndex(firstIndex + 5, firstVertex + 3);
+		quadCount++;
+	}
+
+	mesh.End(quadCount * 4, quadCount * 6);
+	if (mesh.IsEmpty())
+	{
+		return;
+	}
+
+	// The vertices are already in world space
+	static const glm::mat4 identityMatrix = glm::mat4(1);
+	static const glm::mat3 identityNormalMatrix = glm::mat3(1);
+	Graphics::DrawSubMesh(subMesh, *m_material, m_texture.get(), renderSettings, identityMatrix, identityNormalMatrix, Graphics::usedCamera->m_viewProjectionMatrix, false);
+}
 
-		if (!m_worldSimulation)
-		{
-			newMat = InternalMath::MultiplyMatrices(transMat, newMat);
-		}
-		if (m_isBillboard)
+void ParticleSystem::DrawParticlesOneByOne(const RenderCommand& renderCommand, RenderingSettings& renderSettings)
+{
+	const Vector3& camScale = Graphics::usedCamera->GetTransformRaw()->GetScale();
+	const glm::mat4& camMat = Graphics::usedCamera->GetTransformRaw()->GetTransformationMatrix();
+	const glm::mat4& transMat = GetTransformRaw()->GetTransformationMatrix();
+
+	const Vector3& scale = GetTransformRaw()->GetScale();
+	const glm::vec3 fixedScale = glm::vec3(1.0f / camScale.x, 1.0f / camScale.z, 1.0f / camScale.y) * glm::vec3(scale.x, scale.y, scale.z);
+	const Vector4 emitterColor = m_color.GetRGBA().ToVector4();
+
+	for (size_t i = 0; i < m_particleCount; i++)
+	{
+		if (IsParticleDead(i))
 		{
-			// Copy camera rotation matrix
-			newMat[0] = camMat[0];
-			newMat[1] = camMat[1];
-			newMat[2] = camMat[2];
-			// Apply the object rotation on Z
-			newMat = glm::rotate(newMat, particle.billboardRotation, glm::vec3(0, 0, 1));
-			// Fix scale if the camera has a scale (Y and Z are inverted for some raison)
-			newMat = glm::scale(newMat, fixedScale);
+			continue;
 		}
-		Vector4 lifeTimeColorVec4 = colorOverLifeTimeFunction(particle.currentLifeTime / particle.lifeTime);
-		const Color col = Color::CreateFromRGBAFloat(lifeTimeColorVec4.x, lifeTimeColorVec4.y, lifeTimeColorVec4.z, lifeTimeColorVec4.w);
-		const Color finalColor = m_color * col;
-		const RGBA& rgba = finalColor.GetRGBA();
 
-		newMat = glm::scale(newMat, glm::vec3(particle.scale));
-		renderCommand.subMesh->m_meshData->unifiedColor.SetFromRGBAFloat(rgba.r, rgba.g, rgba.b, rgba.a);
+		const float lifeTimeRatio = m_particles.currentLifeTimes[i] / m_particles.lifeTimes[i];
+		const Vector4 color = emitterColor * SampleLifeTimeTable(m_colorOverLifeTimeTable, lifeTimeRatio);
+		const glm::mat4 newMat = glm::scale(GetParticleMatrix(i, camMat, transMat, fixedScale), glm::vec3(SampleLifeTimeTable(m_scaleOverLifeTimeTable, lifeTimeRatio)));
+		renderCommand.subMesh->m_meshData->unifiedColor.SetFromRGBAFloat(color.x, color.y, color.z, color.w);
 
 #if defined(__PSP__)
 		Graphics::DrawSubMesh(*renderCommand.subMesh, *m_material, m_texture.get(), renderSettings, newMat, newMat, newMat, false);
@@ -381,13 +576,99 @@ void ParticleSystem::DrawCommand(const RenderCommand& renderCommand)
 	}
 }
 
-void ParticleSystem::OnNewRender(int cameraIndex)
+void ParticleSystem::SimulateParticles(ParticleArrays& particles, const SimulationStep& step, size_t begin, size_t end)
 {
-	// Only update particles for the render
-	if (cameraIndex != 0)
+	XASSERT(begin % 4 == 0 && end % 4 == 0, "[ParticleSystem::SimulateParticles] The range is not a multiple of 4");
+
+	float* positionsX = particles.positionsX.data();
+	float* positionsY = particles.positionsY.data();
+	float* positionsZ = particles.positionsZ.data();
+	const float* velocitiesX = particles.velocitiesX.data();
+	const float* velocitiesY = particles.velocitiesY.data();
+	const float* velocitiesZ = particles.velocitiesZ.data();
+	float* currentLifeTimes = particles.currentLifeTimes.data();
+	const float* lifeTimes = particles.lifeTimes.data();
+	float* speedMultipliers = particles.speedMultipliers.data();
+	float* simulationCooldowns = particles.simulationCooldowns.data();
+
+	// Living particles are moved when their simulation cooldown is over, the dead particles are not changed
+#if defined(PARTICLES_USE_SSE)
+	const __m128 deltaTime = _mm_set1_ps(step.deltaTime);
+	const __m128 unscaledDeltaTime = _mm_set1_ps(step.unscaledDeltaTime);
+	const __m128 simulationTimer = _mm_set1_ps(step.simulationTimer);
+	const __m128 simulationSpeedMultiplier = _mm_set1_ps(step.simulationSpeedMultiplier);
+	const __m128 zero = _mm_setzero_ps();
+	for (size_t i = begin; i < end; i += 4)
+	{
+		const __m128 currentLifeTime = _mm_loadu_ps(currentLifeTimes + i);
+		const __m128 alive = _mm_cmplt_ps(currentLifeTime, _mm_loadu_ps(lifeTimes + i));
+		if (_mm_movemask_ps(alive) == 0)
+			continue;
+
+		__m128 cooldown = _mm_sub_ps(_mm_loadu_ps(simulationCooldowns + i), unscaledDeltaTime);
+		const __m128 simulate = _mm_and_ps(alive, _mm_cmple_ps(cooldown, zero));
+		const __m128 moveFactor = _mm_and_ps(simulate, _mm_mul_ps(_mm_loadu_ps(speedMultipliers + i), simulationSpeedMultiplier));
+		_mm_storeu_ps(positionsX + i, _mm_add_ps(_mm_loadu_ps(positionsX + i), _mm_mul_ps(_mm_loadu_ps(velocitiesX + i), moveFactor)));
+		_mm_storeu_ps(positionsY + i, _mm_add_ps(_mm_loadu_ps(positionsY + i), _mm_mul_ps(_mm_loadu_ps(velocitiesY + i), moveFactor)));
+		_mm_storeu_ps(positionsZ + i, _mm_add_ps(_mm_loadu_ps(positionsZ + i), _mm_mul_ps(_mm_loadu_ps(velocitiesZ + i), moveFactor)));
+		cooldown = _mm_add_ps(cooldown, _mm_and_ps(simulate, simulationTimer));
+		_mm_storeu_ps(simulationCooldowns + i, cooldown);
+		_mm_storeu_ps(currentLifeTimes + i, _mm_add_ps(currentLifeTime, _mm_and_ps(alive, deltaTime)));
+	}
+#elif defined(PARTICLES_USE_NEON)
+	const uint32x4_t deltaTime = vreinterpretq_u32_f32(vdupq_n_f32(step.deltaTime));
+	const float32x4_t unscaledDeltaTime = vdupq_n_f32(step.unscaledDeltaTime);
+	const uint32x4_t simulationTimer = vreinterpretq_u32_f32(vdupq_n_f32(step.simulationTimer));
+	const float32x4_t simulationSpeedMultiplier = vdupq_n_f32(step.simulationSpeedMultiplier);
+	const float32x4_t zero = vdupq_n_f32(0);
+	for (size_t i = begin; i < end; i += 4)
+	{
+		const float32x4_t currentLifeTime = vld1q_f32(currentLifeTimes + i);
+		const uint32x4_t alive = vcltq_f32(currentLifeTime, vld1q_f32(lifeTimes + i));
+		if ((vgetq_lane_u32(alive, 0) | vgetq_lane_u32(alive, 1) | vgetq_lane_u32(alive, 2) | vgetq_lane_u32(alive, 3)) == 0)
+			continue;
+
+		float32x4_t cooldown = vsubq_f32(vld1q_f32(simulationCooldowns + i), unscaledDeltaTime);
+		const uint32x4_t simulate = vandq_u32(alive, vcleq_f32(cooldown, zero));
+		const float32x4_t moveFactor = vreinterpretq_f32_u32(vandq_u32(simulate, vreinterpretq_u32_f32(vmulq_f32(vld1q_f32(speedMultipliers + i), simulationSpeedMultiplier))));
+		vst1q_f32(positionsX + i, vmlaq_f32(vld1q_f32(positionsX + i), vld1q_f32(velocitiesX + i), moveFactor));
+		vst1q_f32(positionsY + i, vmlaq_f32(vld1q_f32(positionsY + i), vld1q_f32(velocitiesY + i), moveFactor));
+		vst1q_f32(positionsZ + i, vmlaq_f32(vld1q_f32(positionsZ + i), vld1q_f32(velocitiesZ + i), moveFactor));
+		cooldown = vaddq_f32(cooldown, vreinterpretq_f32_u32(vandq_u32(simulate, simulationTimer)));
+		vst1q_f32(simulationCooldowns + i, cooldown);
+		vst1q_f32(currentLifeTimes + i, vaddq_f32(currentLifeTime, vreinterpretq_f32_u32(vandq_u32(alive, deltaTime))));
+	}
+#else
+	for (size_t i = begin; i < end; i++)
 	{
-		return;
+		if (currentLifeTimes[i] >= lifeTimes[i])
+			continue;
+
+		simulationCooldowns[i] -= step.unscaledDeltaTime;
+		if (simulationCooldowns[i] <= 0)
+		{
+			const float moveFactor = speedMultipliers[i] * step.simulationSpeedMultiplier;
+			positionsX[i] += velocitiesX[i] * moveFactor;
+			positionsY[i] += velocitiesY[i] * moveFactor;
+			positionsZ[i] += velocitiesZ[i] * moveFactor;
+			simulationCooldowns[i] += step.simulationTimer;
+		}
+		currentLifeTimes[i] += step.deltaTime;
 	}
+#endif
+
+	// The table lookups are not vectorized
+	for (size_t i = begin; i < end; i++)
+	{
+		if (currentLifeTimes[i] < lifeTimes[i])
+		{
+			speedMultipliers[i] = SampleLifeTimeTable(step.speedMultiplierTable, currentLifeTimes[i] / lifeTimes[i]);
+		}
+	}
+}
+
+void ParticleSystem::OnNewFrame()
+{
 #if defined(EDITOR)
 	if (GameplayManager::GetGameState() == GameState::Paused)
 	{
@@ -418,53 +699,35 @@ void ParticleSystem::OnNewRender(int cameraIndex)
 		simulationSpeedMultiplier = simulationTimer;
 	}
 
-	for (int i = 0; i < m_maxParticles; i++)
+	m_simulationStep.deltaTime = Time::GetDeltaTime();
+	m_simulationStep.unscaledDeltaTime = Time::GetUnscaledDeltaTime();
+	m_simulationStep.simulationTimer = simulationTimer;
+	m_simulationStep.simulationSpeedMultiplier = simulationSpeedMultiplier;
+	m_simulationStep.speedMultiplierTable = m_speedMultiplierOverLifeTimeTable;
+
+	// Simulated with the other emitters before the draw
+	ParticleSimulation::AddEmitter(*this);
+}
+
+void ParticleSystem::Simulate()
+{
+	SimulateParticles(m_particles, m_simulationStep, 0, m_particles.lifeTimes.size());
+
+	if (m_isEmitting && m_loop)
 	{
-		Particle& particle = m_particles[i];
-		if (particle.isDead)
+		// Spawn new particles
+		for (size_t i = 0; i < m_particleCount && m_timer >= 1; i++)
 		{
-			// Spawn new particles
-			if (m_isEmitting && m_loop && m_timer >= 1)
+			if (IsParticleDead(i))
 			{
-				ResetParticle(particle, false);
+				ResetParticle(i, false);
 				m_timer -= 1;
 			}
-			continue;
 		}
 
-		particle.simulationCooldown -= Time::GetUnscaledDeltaTime();
-		if (particle.simulationCooldown <= 0)
-		{
-			particle.matrix[3] += glm::vec4(glm::vec3(particle.direction.x, particle.direction.y, particle.direction.z), 0.0f) * simulationSpeedMultiplier * particle.currentSpeed * particle.speedMultiplier * 1.0f;
-
-			particle.scale = scaleOverLifeTimeFunction(particle.currentLifeTime / particle.lifeTime);
-			particle.speedMultiplier = speedMultiplierOverLifeTimeFunction(particle.currentLifeTime / particle.lifeTime);
-			//particle.matrix *= glm::toMat4(glm::quat(particle.rotation.w, particle.rotation.x, -particle.rotation.y, -particle.rotation.z));
-
-			particle.simulationCooldown += simulationTimer;
-		}
-
-		particle.currentLifeTime += Time::GetDeltaTime();
-		if (particle.currentLifeTime >= particle.lifeTime)
-		{
-			particle.isDead = true;
-		}
-	}
-
-	if (m_isEmitting && m_loop)
-	{
-		m_timer += Time::GetDeltaTime() * m_spawnRate;
+		m_timer += m_simulationStep.deltaTime * m_spawnRate;
 	}
 
-	/*if (reset)
-	{
-		reset = false;
-		for (int i = 0; i < maxParticles; i++)
-		{
-			ResetParticle(particles[i], false);
-		}
-	}*/
-
 	if (m_play)
 	{
 		m_play = false;
@@ -474,12 +737,17 @@ void ParticleSystem::OnNewRender(int cameraIndex)
 
 void ParticleSystem::OnDisabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
 }
 
 void ParticleSystem::OnEnabled()
 {
-	Graphics::s_isRenderingBatchDirty = true;
+	SetRenderCommandsDirty();
+}
+
+bool ParticleSystem::UsesFileReference(const FileReference& fileReference) const
+{
+	return m_mesh.get() == &fileReference || m_material.get() == &fileReference;
 }
 
 void ParticleSystem::CreateRenderCommands(RenderBatch& renderBatch)
@@ -501,13 +769,10 @@ void ParticleSystem::CreateRenderCommands(RenderBatch& renderBatch)
 	command.isEnabled = IsEnabled() && GetGameObjectRaw()->IsLocalActive();
 	if (m_material->GetRenderingMode() == MaterialRenderingMode::Opaque || m_material->GetRenderingMode() == MaterialRenderingMode::Cutout)
 	{
-		RenderQueue& renderQueue = renderBatch.renderQueues[m_material->GetFileId()];
-		renderQueue.commands.push_back(command);
-		renderQueue.commandIndex++;
+		renderBatch.AddCommand(RenderPass::Opaque, command);
 	}
 	else
 	{
-		renderBatch.transparentMeshCommands.push_back(command);
-		renderBatch.transparentMeshCommandIndex++;
+		renderBatch.AddCommand(RenderPass::Transparent, command);
 	}
 }
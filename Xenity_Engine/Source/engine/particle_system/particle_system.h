@@ -8,16 +8,21 @@
 
 #include <vector>
 #include <random>
+#include <memory>
 
 #include <glm/ext/matrix_transform.hpp>
+#include <glm/mat3x3.hpp>
 
 #include <engine/api.h>
 #include <engine/graphics/iDrawable.h>
 #include <engine/math/vector3.h>
 #include <engine/math/quaternion.h>
+#include <engine/math/vector4.h>
 
 class MeshData;
 class Material;
+class DynamicMesh;
+struct RenderingSettings;
 
 ENUM(EmitterShape, Box, Cone);
 ENUM(SimulationRate, fps_30, fps_60, every_frame);
@@ -29,6 +34,7 @@ class API ParticleSystem : public IDrawable
 {
 public:
 	ParticleSystem();
+	~ParticleSystem();
 
 	/**
 	* Emitte all particles when not in loop mode
@@ -91,6 +97,7 @@ public:
 		{
 			scaleOverLifeTimeFunction = function;
 		}
+		BakeLifeTimeTables();
 	}
 
 	/**
@@ -108,6 +115,7 @@ public:
 		{
 			speedMultiplierOverLifeTimeFunction = function;
 		}
+		BakeLifeTimeTables();
 	}
 
 	/**
@@ -126,23 +134,46 @@ public:
 		{
 			colorOverLifeTimeFunction = function;
 		}
+		BakeLifeTimeTables();
 	}
 
 protected:
-	struct Particle
+	friend class ParticleSimulation;
+
+	/**
+	* @brief Data of the particles stored in arrays (structure of arrays) to simulate 4 particles at a time with SIMD
+	* The arrays are sized to a multiple of 4, the padding particles are always dead
+	* A particle is dead when its current life time has reached its life time
+	*/
+	struct ParticleArrays
+	{
+		// World position with world simulation, position relative to the emitter otherwise
+		std::vector<float> positionsX;
+		std::vector<float> positionsY;
+		std::vector<float> positionsZ;
+		// Direction multiplied by the speed
+		std::vector<float> velocitiesX;
+		std::vector<float> velocitiesY;
+		std::vector<float> velocitiesZ;
+		std::vector<float> currentLifeTimes;
+		std::vector<float> lifeTimes;
+		std::vector<float> speedMultipliers;
+		std::vector<float> simulationCooldowns;
+		std::vector<float> billboardRotations;
+		// Rotation and scale of the particle (not used in billboard mode)
+		std::vector<glm::mat3> orientations;
+	};
+
+	/**
+	* @brief Values used to simulate the particles during one frame
+	*/
+	struct SimulationStep
 	{
-		glm::mat4 matrix;
-		Vector3 position;
-		Vector3 direction;
-		Quaternion rotation;
-		float billboardRotation = 0;
-		float speedMultiplier = 1;
-		float currentSpeed = 1;
-		float currentLifeTime = 0;
-		float scale = 1;
-		float lifeTime = 1;
-		float simulationCooldown = 0;
-		bool isDead = true;
+		float deltaTime = 0;
+		float unscaledDeltaTime = 0;
+		float simulationTimer = 0;
+		float simulationSpeedMultiplier = 1;
+		const float* speedMultiplierTable = nullptr;
 	};
 
 	ReflectiveData GetReflectiveData() override;
@@ -157,12 +188,20 @@ protected:
 	*/
 	void CreateRenderCommands(RenderBatch& renderBatch) override;
 
+	/**
+	* @brief Get if the mesh or the material is this file
+	*/
+	[[nodiscard]] bool UsesFileReference(const FileReference& fileReference) const override;
+
 	/**
 	* @brief Draw the command
 	*/
 	void DrawCommand(const RenderCommand& renderCommand) override;
 
-	void OnNewRender(int cameraIndex) override;
+	/**
+	* @brief Queue the simulation of the frame (see ParticleSimulation)
+	*/
+	void OnNewFrame() override;
 
 	/**
 	* @brief Called when the component is disabled
@@ -173,9 +212,68 @@ protected:
 	* @brief Called when the component is enabled
 	*/
 	void OnEnabled() override;
-	void ResetParticle(Particle& particle, bool setIsDead);
+	void ResetParticle(size_t index, bool setIsDead);
 	void AllocateParticlesMemory();
 
+	/**
+	* @brief Seed the random generator with the serialized seed or the unique id of the component
+	*/
+	void ResetRandomGenerator();
+
+	/**
+	* @brief Get if a particle is dead (can be spawned again)
+	*/
+	[[nodiscard]] bool IsParticleDead(size_t index) const
+	{
+		return m_particles.currentLifeTimes[index] >= m_particles.lifeTimes[index];
+	}
+
+	/**
+	* @brief Move the particles and update their life time
+	* @param particles Particles to simulate
+	* @param step Values of the current frame
+	* @param begin First particle to simulate (multiple of 4)
+	* @param end Last particle to simulate (excluded, multiple of 4)
+	*/
+	static void SimulateParticles(ParticleArrays& particles, const SimulationStep& step, size_t begin, size_t end);
+
+	/**
+	* @brief Simulate and spawn the particles of the frame with m_simulationStep (called by ParticleSimulation, can be called from a worker thread)
+	*/
+	void Simulate();
+
+	/**
+	* @brief Get a random number between 0 and max (excluded) from the emitter random generator
+	*/
+	[[nodiscard]] int GetRandomInt(int max);
+
+	/**
+	* @brief Draw all the living particles with one draw call (quad mesh only)
+	*/
+	void DrawParticlesInOneDrawCall(RenderingSettings& renderSettings);
+
+	/**
+	* @brief Draw the living particles one by one (custom mesh or renderer without vertex streaming)
+	*/
+	void DrawParticlesOneByOne(const RenderCommand& renderCommand, RenderingSettings& renderSettings);
+
+	/**
+	* @brief Get the world matrix of a particle (without the scale over life time)
+	* @param cameraMatrix Transformation matrix of the camera (used for the billboards)
+	*/
+	[[nodiscard]] glm::mat4 GetParticleMatrix(size_t index, const glm::mat4& cameraMatrix, const glm::mat4& emitterMatrix, const glm::vec3& billboardScale) const;
+
+	/**
+	* @brief Evaluate the over life time functions in tables, the functions are not called for each particle
+	*/
+	void BakeLifeTimeTables();
+
+	/**
+	* @brief Get the value of a table at a life time ratio [0;1] (linear interpolation between the two closest values)
+	*/
+	template<typename T>
+	[[nodiscard]] static T SampleLifeTimeTable(const T* table, float lifeTimeRatio);
+
 	[[nodiscard]] static float DefaultGetScaleOverLifeTime(float lifeTime);
 	[[nodiscard]] static float DefaultGetSpeedOverLifeTime(float lifeTime);
 	[[nodiscard]] static Vector4 DefaultGetColorOverLifeTime(float lifeTime);
@@ -184,14 +282,21 @@ protected:
 	std::shared_ptr<Material> m_material = nullptr;
 	std::shared_ptr<Texture> m_texture = nullptr;
 
-	std::vector<Particle> m_particles;
+	static constexpr size_t s_lifeTimeTableSize = 64;
+
+	ParticleArrays m_particles;
+	size_t m_particleCount = 0;
+	std::unique_ptr<DynamicMesh> m_particlesMesh;
 	EmitterShape m_emitterShape = EmitterShape::Cone;
 	float m_coneAngle = 20;
 	float m_lifeTimeMin = 5;
 	float m_lifeTimeMax = 10;
 	float m_speedMin = 1;
 	float m_speedMax = 2;
-	static std::default_random_engine m_gen;
+	// Each emitter has its own random generator to be simulated on any thread
+	std::default_random_engine m_gen;
+	// Seed of m_gen, 0 to use the unique id of the component
+	int m_randomSeed = 0;
 	std::uniform_real_distribution<float>m_speedDistribution;
 	std::uniform_real_distribution<float>m_lifeTimeDistribution;
 	std::uniform_real_distribution<float>m_boxXDistribution;
@@ -202,11 +307,18 @@ protected:
 	float (*speedMultiplierOverLifeTimeFunction)(float) = nullptr;
 	Vector4(*colorOverLifeTimeFunction)(float) = nullptr;
 
+	float m_scaleOverLifeTimeTable[s_lifeTimeTableSize + 1];
+	float m_speedMultiplierOverLifeTimeTable[s_lifeTimeTableSize + 1];
+	Vector4 m_colorOverLifeTimeTable[s_lifeTimeTableSize + 1];
+
 	Vector3 m_boxSize = Vector3(1);
 	Vector3 m_direction = Vector3(0,1,0);
 	Color m_color = Color::CreateFromRGBAFloat(1, 1, 1, 1);
 	float m_spawnRate = 1;
 	float m_timer = 0;
+	SimulationStep m_simulationStep;
+	// Used to spread the simulation of the particles spawned at the same time over two frames
+	int m_spawnFrame = 0;
 	float m_maxParticles = 10;
 	SimulationRate m_simulationRate = SimulationRate::fps_60;
 	bool m_randomRotation = true;
@@ -22,6 +22,7 @@
 #include <engine/ui/window.h>
 #include <engine/graphics/graphics.h>
 #include <engine/graphics/camera.h>
+#include <engine/graphics/3d_graphics/static_batching.h>
 #include <engine/game_elements/prefab.h>
 #include <engine/physics/physics_manager.h>
 #include <engine/tools/template_utils.h>
@@ -572,6 +573,8 @@ void SceneManager::LoadSceneInternal(const ordered_json& jsonData, const ordered
 //#if !defined(EDITOR)
 	if (GameplayManager::GetGameState() == GameState::Starting)
 	{
+		// Merge the static meshes only when the game runs, the edited scene keeps the original mesh renderers
+		StaticBatching::Build();
 		GameplayManager::SetGameState(GameState::Playing, true);
 	}
 	//#endif
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "job_system.h"
+
+#include <algorithm>
+
+#include <engine/constants.h>
+
+#if defined(ENABLE_JOB_SYSTEM)
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#endif
+
+#include <engine/engine.h>
+#include <engine/assertions/assertions.h>
+
+namespace
+{
+#if defined(ENABLE_JOB_SYSTEM)
+	constexpr unsigned int s_maxWorkerCount = 7;
+
+	/**
+	* @brief Loop of a ParallelFor call, lives on the stack of the main thread during the call
+	*/
+	struct ParallelForJob
+	{
+		const std::function<void(size_t, size_t)>* function = nullptr;
+		size_t count = 0;
+		size_t batchSize = 0;
+		std::atomic<size_t> nextIndex{ 0 };
+		size_t activeWorkerCount = 0; // Protected by jobMutex
+
+		[[nodiscard]] bool HasWork() const
+		{
+			return nextIndex.load() < count;
+		}
+
+		void Run()
+		{
+			while (true)
+			{
+				const size_t begin = nextIndex.fetch_add(batchSize);
+				if (begin >= count)
+					break;
+
+				(*function)(begin, std::min(begin + batchSize, count));
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	std::mutex jobMutex;
+	std::condition_variable jobStartCondition;
+	std::condition_variable jobEndCondition;
+	std::deque<std::function<void()>> queuedJobs;
+	ParallelForJob* parallelForJob = nullptr;
+	bool stopWorkers = false;
+#endif
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& function)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+	XASSERT(batchSize != 0, "[JobSystem::ParallelFor] batchSize is 0");
+
+	if (count == 0)
+		return;
+
+#if defined(ENABLE_JOB_SYSTEM)
+	if (count > batchSize)
+	{
+		StartWorkers();
+		if (!workers.empty())
+		{
+			ParallelForJob job;
+			job.function = &function;
+			job.count = count;
+			job.batchSize = batchSize;
+			{
+				std::lock_guard<std::mutex> lock(jobMutex);
+				parallelForJob = &job;
+			}
+			jobStartCondition.notify_all();
+
+			// The main thread works too while waiting, the workers busy with a background job do not slow down the loop
+			job.Run();
+
+			// No worker can take the job after this, wait for the ones still running a batch
+			std::unique_lock<std::mutex> lock(jobMutex);
+			parallelForJob = nullptr;
+			jobEndCondition.wait(lock, [&job] { return job.activeWorkerCount == 0; });
+			return;
+		}
+	}
+#endif
+
+	function(0, count);
+}
+
+void JobSystem::Submit(std::function<void()> function)
+{
+	XASSERT(Engine::IsCalledFromMainThread(), "Function called from another thread");
+
+#if defined(ENABLE_JOB_SYSTEM)
+	StartWorkers();
+	if (!workers.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			queuedJobs.push_back(std::move(function));
+		}
+		jobStartCondition.notify_one();
+		return;
+	}
+#endif
+
+	function();
+}
+
+size_t JobSystem::GetWorkerCount()
+{
+#if defined(ENABLE_JOB_SYSTEM)
+	return workers.size();
+#else
+	return 0;
+#endif
+}
+
+void JobSystem::Stop()
+{
+#if defined(ENABLE_JOB_SYSTEM)
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		stopWorkers = true;
+		queuedJobs.clear();
+	}
+	jobStartCondition.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+	stopWorkers = false;
+#endif
+}
+
+void JobSystem::StartWorkers()
+{
+#if defined(ENABLE_JOB_SYSTEM)
+	if (!workers.empty())
+		return;
+
+	const unsigned int coreCount = std::thread::hardware_concurrency();
+	const unsigned int workerCount = std::min(coreCount > 1 ? coreCount - 1 : 0, s_maxWorkerCount);
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		workers.push_back(std::thread(&JobSystem::WorkerLoop));
+	}
+#endif
+}
+
+void JobSystem::WorkerLoop()
+{
+#if defined(ENABLE_JOB_SYSTEM)
+	std::unique_lock<std::mutex> lock(jobMutex);
+	while (true)
+	{
+		jobStartCondition.wait(lock, [] { return stopWorkers || (parallelForJob && parallelForJob->HasWork()) || !queuedJobs.empty(); });
+		if (stopWorkers)
+			return;
+
+		if (parallelForJob && parallelForJob->HasWork())
+		{
+			ParallelForJob* job = parallelForJob;
+			job->activeWorkerCount++;
+			lock.unlock();
+			job->Run();
+			lock.lock();
+			job->activeWorkerCount--;
+			if (job->activeWorkerCount == 0)
+			{
+				jobEndCondition.notify_one();
+			}
+			continue;
+		}
+
+		std::function<void()> function = std::move(queuedJobs.front());
+		queuedJobs.pop_front();
+		lock.unlock();
+		function();
+		// Destroy the captured data outside of the lock
+		function = nullptr;
+		lock.lock();
+	}
+#endif
+}
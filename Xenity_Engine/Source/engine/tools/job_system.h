@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#pragma once
+
+/**
+ * [Internal]
+ */
+
+#include <cstddef>
+#include <functional>
+
+#include <engine/api.h>
+
+/**
+* @brief Worker threads shared by the engine systems (Windows and Linux only, see ENABLE_JOB_SYSTEM)
+*
+* ParallelFor splits a loop of the main thread between the workers, the main thread works too and the call returns when the loop is done.
+* Submit runs a function in the background (texture decoding...), the parallel loops are always taken first by the workers.
+* Without ENABLE_JOB_SYSTEM, the functions are called directly on the main thread.
+*/
+class API JobSystem
+{
+public:
+	/**
+	* @brief Call a function on the ranges of a loop, split between the workers and the main thread
+	* @param count Number of elements of the loop
+	* @param batchSize Number of elements given to a thread at a time
+	* @param function Called with the first element and the end (excluded) of each range, from several threads at the same time
+	*/
+	static void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& function);
+
+	/**
+	* @brief Run a function on a worker thread
+	* @param function Must not use the renderer, the function is dropped if the job system is stopped before its start
+	*/
+	static void Submit(std::function<void()> function);
+
+	/**
+	* @brief Get the number of worker threads (0 before the first job or without ENABLE_JOB_SYSTEM)
+	*/
+	[[nodiscard]] static size_t GetWorkerCount();
+
+private:
+	friend class Engine;
+
+	/**
+	* @brief [Internal] Wait for the end of the running jobs, drop the queued jobs and join the worker threads
+	*/
+	static void Stop();
+
+	static void StartWorkers();
+	static void WorkerLoop();
+};
@@ -18,6 +18,7 @@
 #endif
 
 #include <engine/debug/debug.h>
+#include <engine/engine.h>
 #include <engine/graphics/graphics.h>
 #include <engine/graphics/camera.h>
 #include <engine/scene_management/scene_manager.h>
@@ -95,6 +96,21 @@ int Window::Init()
 	STACK_DEBUG_OBJECT(STACK_HIGH_PRIORITY);
 
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	// The null renderer does not need any window, only init inputs and events
+	if (Engine::GetArguments().useNullRenderer)
+	{
+		const bool sdlInitResult = SDL_Init(SDL_INIT_JOYSTICK | SDL_INIT_GAMEPAD | SDL_INIT_EVENTS);
+		if (!sdlInitResult)
+		{
+			std::string sdlError = SDL_GetError();
+			Debug::PrintError("[Window::Init] SDL_Init Error: " + sdlError);
+			return static_cast<int>(WindowError::WND_ERROR_SDL_INIT);
+		}
+		OnResize();
+		Debug::Print("-------- Window initiated (headless) --------", true);
+		return 0;
+	}
+
 	//  Init SDL
 	const bool sdlInitResult = SDL_Init(SDL_INIT_JOYSTICK | SDL_INIT_VIDEO | SDL_INIT_GAMEPAD | SDL_INIT_EVENTS);
 	if (!sdlInitResult)
@@ -151,7 +167,10 @@ void Window::UpdateScreen()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
-	SDL_GL_SwapWindow(s_window);
+	if (s_window)
+	{
+		SDL_GL_SwapWindow(s_window);
+	}
 #endif
 }
 
@@ -159,6 +178,11 @@ void Window::UpdateWindowTitle()
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
+	if (!s_window)
+	{
+		return;
+	}
+
 	std::string newTitle = "";
 	if (ProjectManager::IsProjectLoaded())
 	{
@@ -194,7 +218,10 @@ void Window::SetFullScreenMode(bool enable)
 {
 	STACK_DEBUG_OBJECT(STACK_MEDIUM_PRIORITY);
 #if defined(_WIN32) || defined(_WIN64) || defined(__LINUX__)
-	SDL_SetWindowFullscreen(s_window, enable);
+	if (s_window)
+	{
+		SDL_SetWindowFullscreen(s_window, enable);
+	}
 	//if (enable)
 	//	SDL_SetWindowFullscreen(window, SDL_WINDOW_FULLSCREEN_DESKTOP);
 	//else
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#if defined(EDITOR)
+
+#include "../unit_test_manager.h"
+
+#include <algorithm>
+
+#include <editor/cooker/mesh_optimizer.h>
+
+TestResult MeshOptimizerVertexCacheTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// Grid of 32x32 vertices with the triangles in a scattered order
+	constexpr uint32_t gridSize = 32;
+	constexpr uint32_t vertexCount = gridSize * gridSize;
+	std::vector<uint32_t> gridIndices;
+	for (uint32_t y = 0; y < gridSize - 1; y++)
+	{
+		for (uint32_t x = 0; x < gridSize - 1; x++)
+		{
+			const uint32_t v = y * gridSize + x;
+			gridIndices.insert(gridIndices.end(), { v, v + gridSize, v + 1 });
+			gridIndices.insert(gridIndices.end(), { v + 1, v + gridSize, v + gridSize + 1 });
+		}
+	}
+	const uint32_t triangleCount = static_cast<uint32_t>(gridIndices.size() / 3);
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < triangleCount; i++)
+	{
+		const uint32_t triangle = (i * 97) % triangleCount;
+		indices.insert(indices.end(), gridIndices.begin() + triangle * 3, gridIndices.begin() + triangle * 3 + 3);
+	}
+
+	const float acmrBefore = MeshOptimizer::ComputeAcmr(indices, vertexCount);
+	std::vector<uint32_t> clusters;
+	std::vector<uint32_t> optimizedIndices = indices;
+	MeshOptimizer::OptimizeVertexCache(optimizedIndices, vertexCount, clusters);
+	const float acmrAfter = MeshOptimizer::ComputeAcmr(optimizedIndices, vertexCount);
+
+	EXPECT_EQUALS(optimizedIndices.size(), indices.size(), "Wrong index count after the optimization");
+	EXPECT_TRUE((acmrAfter < acmrBefore * 0.5f), "The ACMR has not been reduced enough");
+	EXPECT_TRUE((!clusters.empty() && clusters[0] == 0), "Wrong first cluster");
+
+	// Same triangles, only the order changes
+	std::vector<uint32_t> sortedBefore = indices;
+	std::vector<uint32_t> sortedAfter = optimizedIndices;
+	std::sort(sortedBefore.begin(), sortedBefore.end());
+	std::sort(sortedAfter.begin(), sortedAfter.end());
+	EXPECT_TRUE((sortedBefore == sortedAfter), "Some vertices have been lost");
+
+	END_TEST();
+}
+
+TestResult MeshOptimizerVertexFetchTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// Vertices 0, 1, 2, 4, 6 and 8 are not used
+	std::vector<uint32_t> indices = { 5, 3, 7, 7, 3, 9 };
+	const std::vector<uint32_t> newToOld = MeshOptimizer::OptimizeVertexFetch(indices, 10);
+
+	EXPECT_TRUE((newToOld == std::vector<uint32_t>({ 5, 3, 7, 9 })), "Wrong vertex order");
+	EXPECT_TRUE((indices == std::vector<uint32_t>({ 0, 1, 2, 2, 1, 3 })), "Wrong indices");
+
+	END_TEST();
+}
+
+TestResult MeshOptimizerDeduplicateTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	const float vertices[] = { 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0 };
+	std::vector<uint32_t> indices = { 0, 1, 3, 2, 4, 3 };
+	const uint32_t duplicateCount = MeshOptimizer::DeduplicateVertices(reinterpret_cast<const unsigned char*>(vertices), 5, sizeof(float[3]), indices);
+
+	EXPECT_EQUALS(duplicateCount, 2, "Wrong duplicate count");
+	EXPECT_TRUE((indices == std::vector<uint32_t>({ 0, 1, 3, 0, 1, 3 })), "Wrong indices");
+
+	END_TEST();
+}
+
+#endif
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#if defined(EDITOR)
+
+#include "../unit_test_manager.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <editor/cooker/texture_encoder.h>
+
+TestResult TextureEncoderBlocksTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	unsigned char pixels[16 * 4];
+	unsigned char block[16];
+	unsigned char decodedPixels[16 * 4];
+
+	// A single color gives two equal endpoints and only zero indices
+	for (int i = 0; i < 16; i++)
+	{
+		pixels[i * 4] = 255;
+		pixels[i * 4 + 1] = 0;
+		pixels[i * 4 + 2] = 0;
+		pixels[i * 4 + 3] = 255;
+	}
+	TextureEncoder::EncodeBC1Block(pixels, block);
+	const unsigned char expectedBlock[8] = { 0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0 };
+	EXPECT_EQUALS(memcmp(block, expectedBlock, 8), 0, "Solid red BC1 block");
+
+	// Black and white pixels are the endpoints, they are decoded without loss
+	for (int i = 0; i < 16; i++)
+	{
+		const unsigned char value = (i % 3 == 0) ? 255 : 0;
+		pixels[i * 4] = value;
+		pixels[i * 4 + 1] = value;
+		pixels[i * 4 + 2] = value;
+		pixels[i * 4 + 3] = 255;
+	}
+	TextureEncoder::EncodeBC1Block(pixels, block);
+	CompressedTexture::DecodeBlock(CompressedTextureFormat::BC1, block, decodedPixels);
+	EXPECT_EQUALS(memcmp(pixels, decodedPixels, sizeof(pixels)), 0, "Black and white BC1 block");
+
+	// Alpha gradient: BC4 has 8 values between the min and the max
+	for (int i = 0; i < 16; i++)
+	{
+		pixels[i * 4 + 3] = static_cast<unsigned char>(40 + i * 10);
+	}
+	TextureEncoder::EncodeBC4Block(pixels, 3, block);
+	TextureEncoder::EncodeBC1Block(pixels, block + 8);
+	CompressedTexture::DecodeBlock(CompressedTextureFormat::BC3, block, decodedPixels);
+	int maxAlphaError = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		maxAlphaError = std::max(maxAlphaError, std::abs(pixels[i * 4 + 3] - decodedPixels[i * 4 + 3]));
+	}
+	EXPECT_TRUE(maxAlphaError <= 11, "BC3 alpha error"); // Half of the 150 / 7 step
+	EXPECT_EQUALS(decodedPixels[3], 40, "BC3 alpha min");
+	EXPECT_EQUALS(decodedPixels[15 * 4 + 3], 190, "BC3 alpha max");
+
+	END_TEST();
+}
+
+TestResult TextureEncoderFileTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// 5x3 image: the last blocks are partly outside of the image
+	constexpr int width = 5;
+	constexpr int height = 3;
+	unsigned char pixels[width * height * 4];
+	for (int i = 0; i < width * height; i++)
+	{
+		pixels[i * 4] = 0;
+		pixels[i * 4 + 1] = 255;
+		pixels[i * 4 + 2] = 0;
+		pixels[i * 4 + 3] = 128;
+	}
+	EXPECT_TRUE(TextureEncoder::HasAlpha(pixels, width, height), "Image with alpha");
+
+	const std::vector<unsigned char> file = TextureEncoder::EncodeTexture(pixels, width, height, CompressedTextureFormat::BC3, true);
+
+	CompressedTextureHeader header;
+	EXPECT_TRUE(CompressedTextureHeader::Read(file.data(), file.size(), header), "Read header");
+	EXPECT_EQUALS(header.width, static_cast<uint32_t>(width), "Header width");
+	EXPECT_EQUALS(header.height, static_cast<uint32_t>(height), "Header height");
+	EXPECT_EQUALS(header.mipCount, static_cast<uint32_t>(3), "5x3, 2x1 and 1x1 levels");
+
+	// Level sizes are written before each level: 2x1 blocks, then 1 block twice
+	const size_t expectedSize = sizeof(CompressedTextureHeader) + 3 * sizeof(uint32_t) + (2 + 1 + 1) * 16;
+	EXPECT_EQUALS(file.size(), expectedSize, "File size");
+	EXPECT_EQUALS(header.GetLevelsSize(0), static_cast<size_t>((2 + 1 + 1) * 16), "Size of all the levels");
+	EXPECT_EQUALS(header.GetLevelsSize(1), static_cast<size_t>(2 * 16), "Size of the levels after the first one");
+	EXPECT_EQUALS(header.GetLevelOffset(1), sizeof(CompressedTextureHeader) + sizeof(uint32_t) + 2 * 16, "Position of the second level");
+	EXPECT_EQUALS(header.GetLevelOffset(header.mipCount), file.size(), "End of the file");
+
+	int decodedWidth = 0;
+	int decodedHeight = 0;
+	unsigned char* decodedPixels = CompressedTexture::DecodeFirstLevel(file.data(), file.size(), decodedWidth, decodedHeight);
+	EXPECT_NOT_NULL(decodedPixels, "Decode the first level");
+	if (decodedPixels)
+	{
+		EXPECT_EQUALS(decodedWidth, width, "Decoded width");
+		EXPECT_EQUALS(decodedHeight, height, "Decoded height");
+		EXPECT_EQUALS(memcmp(decodedPixels, pixels, sizeof(pixels)), 0, "Solid color decoded without loss");
+		free(decodedPixels);
+	}
+
+	// RGBA8 (streamed textures without compression): the pixels are copied
+	const std::vector<unsigned char> rgbaFile = TextureEncoder::EncodeTexture(pixels, width, height, CompressedTextureFormat::RGBA8, true);
+	EXPECT_TRUE(CompressedTextureHeader::Read(rgbaFile.data(), rgbaFile.size(), header), "Read RGBA8 header");
+	EXPECT_EQUALS(rgbaFile.size(), sizeof(CompressedTextureHeader) + 3 * sizeof(uint32_t) + (5 * 3 + 2 * 1 + 1 * 1) * 4, "RGBA8 file size");
+	EXPECT_EQUALS(memcmp(rgbaFile.data() + header.GetLevelOffset(0) + sizeof(uint32_t), pixels, sizeof(pixels)), 0, "RGBA8 first level");
+
+	// A PNG file is not a compressed texture
+	const unsigned char pngSignature[32] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+	EXPECT_FALSE(CompressedTextureHeader::Read(pngSignature, sizeof(pngSignature), header), "PNG file");
+
+	END_TEST();
+}
+
+#endif
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <cmath>
+#include <vector>
+
+#include <engine/graphics/dynamic_resolution.h>
+
+TestResult DynamicResolutionScaleTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	const float target = 15.0f;
+
+	// GPU bound, the scale goes down by one step at most
+	EXPECT_NEAR(DynamicResolution::ComputeScale(1.0f, 5.0f, 30.0f, target, 0.5f, 1.0f), 1.0f - DynamicResolution::s_maxScaleStep, "Bad scale when the GPU is too slow");
+	EXPECT_NEAR(DynamicResolution::ComputeScale(1.0f, 5.0f, 16.0f, target, 0.5f, 1.0f), std::sqrt(target / 16.0f), "Bad scale when the GPU is a bit too slow");
+
+	// CPU bound, a smaller resolution does not help
+	EXPECT_NEAR(DynamicResolution::ComputeScale(1.0f, 30.0f, 30.0f, target, 0.5f, 1.0f), 1.0f, "Scale changed when the CPU is too slow");
+
+	// Inside the band between the upscale threshold and the target, nothing changes
+	EXPECT_NEAR(DynamicResolution::ComputeScale(0.8f, 5.0f, 14.0f, target, 0.5f, 1.0f), 0.8f, "Scale changed inside the band");
+
+	// GPU has time left, the scale goes up
+	EXPECT_NEAR(DynamicResolution::ComputeScale(0.8f, 5.0f, 5.0f, target, 0.5f, 1.0f), 0.8f + DynamicResolution::s_maxScaleStep, "Bad scale when the GPU has time left");
+
+	// Bounds
+	EXPECT_NEAR(DynamicResolution::ComputeScale(0.52f, 5.0f, 30.0f, target, 0.5f, 1.0f), 0.5f, "Scale under the minimum");
+	EXPECT_NEAR(DynamicResolution::ComputeScale(0.98f, 5.0f, 5.0f, target, 0.5f, 1.0f), 1.0f, "Scale over the maximum");
+
+	END_TEST();
+}
+
+TestResult DynamicResolutionUpscaleTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// Frame buffer rendered at a 0.5 scale, the rendered area is white and the unused part is black
+	const int width = 8;
+	const int height = 6;
+	const int renderWidth = 4;
+	const int renderHeight = 3;
+	std::vector<uint8_t> frameBuffer(width * height * 3, 0);
+	for (int y = 0; y < renderHeight; y++)
+	{
+		for (int x = 0; x < renderWidth * 3; x++)
+		{
+			frameBuffer[y * width * 3 + x] = 255;
+		}
+	}
+
+	std::vector<uint8_t> output(width * height * 3, 0);
+	DynamicResolution::UpscaleRenderedArea(frameBuffer.data(), width, height, renderWidth, renderHeight, output.data());
+
+	// The whole image comes from the rendered area, nothing from the unused part
+	bool hasBorder = false;
+	for (const uint8_t value : output)
+	{
+		if (value != 255)
+		{
+			hasBorder = true;
+		}
+	}
+	EXPECT_FALSE(hasBorder, "The upscaled image has pixels from outside of the rendered area");
+
+	END_TEST();
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <vector>
+
+#include <engine/graphics/camera.h>
+#include <engine/graphics/3d_graphics/frustum_culling.h>
+
+TestResult FrustumCullingTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// Box frustum from -10 to 10 on each axis (the normals point inside)
+	Frustum frustum;
+	frustum.planes[0].data = glm::vec4(1, 0, 0, 10);
+	frustum.planes[1].data = glm::vec4(-1, 0, 0, 10);
+	frustum.planes[2].data = glm::vec4(0, 1, 0, 10);
+	frustum.planes[3].data = glm::vec4(0, -1, 0, 10);
+	frustum.planes[4].data = glm::vec4(0, 0, 1, 10);
+	frustum.planes[5].data = glm::vec4(0, 0, -1, 10);
+
+	// Two words of spheres
+	const size_t sphereCount = 128;
+	std::vector<float> centersX(sphereCount, 0.0f);
+	std::vector<float> centersY(sphereCount, 0.0f);
+	std::vector<float> centersZ(sphereCount, 0.0f);
+	std::vector<float> radii(sphereCount, 1.0f);
+	std::vector<uint64_t> activeBits(2, 0xFFFFFFFFFFFFFFFF);
+	std::vector<uint64_t> visibilityBits(2, 0);
+
+	// Out of the frustum
+	centersX[1] = 20;
+	// Intersecting a plane
+	centersY[2] = 10.5f;
+	// Out of the frustum by less than the radius
+	centersZ[3] = -10.9f;
+	// Out of the frustum by more than the radius
+	centersZ[4] = -11.1f;
+	// Inside but inactive
+	activeBits[0] &= ~(1ULL << 5);
+	// Out of the frustum in the second word
+	centersX[70] = -30;
+
+	FrustumCulling::CullSpheres(frustum, centersX.data(), centersY.data(), centersZ.data(), radii.data(), activeBits.data(), visibilityBits.data(), 0, 2);
+
+	EXPECT_TRUE((visibilityBits[0] & 1) != 0, "Sphere inside the frustum culled");
+	EXPECT_TRUE((visibilityBits[0] & (1ULL << 1)) == 0, "Sphere out of the frustum not culled");
+	EXPECT_TRUE((visibilityBits[0] & (1ULL << 2)) != 0, "Sphere intersecting a plane culled");
+	EXPECT_TRUE((visibilityBits[0] & (1ULL << 3)) != 0, "Sphere touching the frustum culled");
+	EXPECT_TRUE((visibilityBits[0] & (1ULL << 4)) == 0, "Sphere out of the frustum not culled");
+	EXPECT_TRUE((visibilityBits[0] & (1ULL << 5)) == 0, "Inactive sphere not culled");
+	EXPECT_EQUALS(visibilityBits[0] >> 6, 0x3FFFFFFFFFFFFFF, "Bad visibility of the other spheres");
+	EXPECT_EQUALS(visibilityBits[1], 0xFFFFFFFFFFFFFFFF & ~(1ULL << (70 - 64)), "Bad visibility in the second word");
+
+	// Only the requested words are updated
+	visibilityBits[0] = 0;
+	activeBits[1] = 0;
+	FrustumCulling::CullSpheres(frustum, centersX.data(), centersY.data(), centersZ.data(), radii.data(), activeBits.data(), visibilityBits.data(), 1, 2);
+	EXPECT_EQUALS(visibilityBits[0], 0, "Word out of the range updated");
+	EXPECT_EQUALS(visibilityBits[1], 0, "Inactive word not culled");
+
+	END_TEST();
+}
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <engine/graphics/3d_graphics/lod_selection.h>
+
+TestResult LodSelectionTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	const float thresholds[LodSelection::s_levelCount] = { 0.5f, 0.25f, 0.05f };
+	const float hysteresis = 0.1f;
+
+	// First selection, no hysteresis
+	EXPECT_EQUALS(LodSelection::SelectLevel(1.0f, LodSelection::s_unknownLevel, thresholds, hysteresis), 0, "Bad first level for a big object");
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.3f, LodSelection::s_unknownLevel, thresholds, hysteresis), 1, "Bad first level for a medium object");
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.1f, LodSelection::s_unknownLevel, thresholds, hysteresis), 2, "Bad first level for a small object");
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.01f, LodSelection::s_unknownLevel, thresholds, hysteresis), LodSelection::s_culledLevel, "Tiny object not culled");
+
+	// Inside the hysteresis band, the level does not change
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.48f, 0, thresholds, hysteresis), 0, "Level 0 left inside the hysteresis band");
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.52f, 1, thresholds, hysteresis), 1, "Level 1 left inside the hysteresis band");
+
+	// Outside of the band, the level changes
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.44f, 0, thresholds, hysteresis), 1, "Level 0 kept outside of the hysteresis band");
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.56f, 1, thresholds, hysteresis), 0, "Level 1 kept outside of the hysteresis band");
+
+	// Several levels at once
+	EXPECT_EQUALS(LodSelection::SelectLevel(0.01f, 0, thresholds, hysteresis), LodSelection::s_culledLevel, "Big jump to the culled level");
+	EXPECT_EQUALS(LodSelection::SelectLevel(1.0f, LodSelection::s_culledLevel, thresholds, hysteresis), 0, "Big jump to the level 0");
+
+	// Conversion of the distances of the old versions
+	EXPECT_NEAR(LodSelection::DistanceToScreenSize(1.0f, 4.0f, 90.0f), 0.25f, "Bad screen size of a distance");
+	EXPECT_TRUE(LodSelection::DistanceToScreenSize(1.0f, 30.0f, 60.0f) < LodSelection::DistanceToScreenSize(1.0f, 15.0f, 60.0f), "Farther distance with a bigger screen size");
+
+	END_TEST();
+}
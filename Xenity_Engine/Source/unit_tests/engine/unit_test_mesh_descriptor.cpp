@@ -6,7 +6,11 @@
 
 #include "../unit_test_manager.h"
 
+#include <cmath>
+
 #include <engine/graphics/3d_graphics/vertex_descriptor.h>
+#include <engine/graphics/3d_graphics/vertex_quantization.h>
+#include <engine/math/math.h>
 
 TestResult VertexDescriptorFloatTest::Start(std::string& errorOut)
 {
@@ -229,5 +233,62 @@ TestResult VertexDescriptorGetVertexElementSizeTest::Start(std::string& errorOut
 	EXPECT_EQUALS(VertexDescriptor::GetVertexElementSize(VertexElement::POSITION_32_BITS), sizeof(float[3]), "Wrong None size");
 	EXPECT_EQUALS(VertexDescriptor::GetVertexElementSize(VertexElement::POSITION_16_BITS), sizeof(int16_t[3]), "Wrong None size");
 	EXPECT_EQUALS(VertexDescriptor::GetVertexElementSize(VertexElement::POSITION_8_BITS), sizeof(int8_t[3]), "Wrong None size");
+	EXPECT_EQUALS(VertexDescriptor::GetVertexElementSize(VertexElement::NORMAL_OCTAHEDRAL_8_BITS), sizeof(int8_t[2]), "Wrong NORMAL_OCTAHEDRAL_8_BITS size");
+	EXPECT_EQUALS(VertexDescriptor::GetVertexElementSize(VertexElement::NORMAL_OCTAHEDRAL_16_BITS), sizeof(int16_t[2]), "Wrong NORMAL_OCTAHEDRAL_16_BITS size");
+	END_TEST();
+}
+
+TestResult VertexQuantizationNormalizedTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	EXPECT_EQUALS(VertexQuantization::QuantizeSnorm16(1.0f), 32767, "Wrong snorm16 max value");
+	EXPECT_EQUALS(VertexQuantization::QuantizeSnorm16(-1.0f), -32767, "Wrong snorm16 min value");
+	EXPECT_EQUALS(VertexQuantization::QuantizeSnorm16(2.0f), 32767, "The snorm16 value is not clamped");
+	EXPECT_EQUALS(VertexQuantization::QuantizeSnorm16(0.0f), 0, "Wrong snorm16 zero value");
+	EXPECT_NEAR(VertexQuantization::DequantizeSnorm16(-32768), -1.0f, "Wrong snorm16 dequantization");
+	EXPECT_EQUALS(VertexQuantization::QuantizeUnorm16(1.0f), 65535, "Wrong unorm16 max value");
+	EXPECT_EQUALS(VertexQuantization::QuantizeUnorm16(-0.5f), 0, "The unorm16 value is not clamped");
+	EXPECT_NEAR(VertexQuantization::DequantizeUnorm16(65535), 1.0f, "Wrong unorm16 dequantization");
+
+	// Half of a quantization step at most
+	const float value = 0.123456f;
+	EXPECT_TRUE((std::abs(VertexQuantization::DequantizeSnorm16(VertexQuantization::QuantizeSnorm16(value)) - value) <= 0.5f / 32767.0f), "Wrong snorm16 precision");
+	EXPECT_TRUE((std::abs(VertexQuantization::DequantizeUnorm16(VertexQuantization::QuantizeUnorm16(value)) - value) <= 0.5f / 65535.0f), "Wrong unorm16 precision");
+
 	END_TEST();
-}
\ No newline at end of file
+}
+
+TestResult VertexQuantizationOctahedralTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// Axes and diagonals of both hemispheres
+	const Vector3 normals[] =
+	{
+		Vector3(0, 0, 1), Vector3(0, 0, -1), Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0),
+		Vector3(0.577350f, 0.577350f, 0.577350f), Vector3(-0.577350f, 0.577350f, -0.577350f), Vector3(0.267261f, -0.534522f, -0.801784f),
+	};
+
+	for (const Vector3& normal : normals)
+	{
+		float x;
+		float y;
+		VertexQuantization::EncodeOctahedral(normal, x, y);
+		EXPECT_TRUE((std::abs(x) <= 1 && std::abs(y) <= 1), "The encoded normal is not between -1 and 1");
+
+		const Vector3 decodedNormal = VertexQuantization::DecodeOctahedral(x, y);
+		const float dot = normal.x * decodedNormal.x + normal.y * decodedNormal.y + normal.z * decodedNormal.z;
+		EXPECT_TRUE((dot > 0.99999f), "Wrong decoded normal");
+
+		// 8 bits encoding stays under one degree of error
+		int8_t quantizedX;
+		int8_t quantizedY;
+		VertexQuantization::QuantizeOctahedral<int8_t>(normal, 127, quantizedX, quantizedY);
+		const Vector3 decodedQuantizedNormal = VertexQuantization::DecodeOctahedral(quantizedX / 127.0f, quantizedY / 127.0f);
+		const float quantizedDot = normal.x * decodedQuantizedNormal.x + normal.y * decodedQuantizedNormal.y + normal.z * decodedQuantizedNormal.z;
+		EXPECT_TRUE((quantizedDot > std::cos(1.0f * Math::PI / 180.0f)), "Wrong decoded quantized normal");
+	}
+
+	END_TEST();
+}
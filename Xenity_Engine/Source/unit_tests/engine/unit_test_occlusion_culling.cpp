@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <engine/graphics/3d_graphics/occlusion_culling.h>
+
+TestResult OcclusionCullingTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// Use the identity matrix, the positions are already in clip space
+	const glm::mat4 viewProjection = glm::mat4(1.0f);
+
+	OcclusionCulling::ClearDepthBuffer(0.1f);
+	OcclusionCulling::BuildHierarchicalDepth();
+	EXPECT_FALSE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, 0.6f), glm::vec3(0.5f, 0.5f, 0.8f)), "Box occluded by an empty depth buffer");
+
+	// Occluder covering the left half of the screen at depth 0.5
+	OcclusionCulling::RasterizeTriangle(glm::vec4(-1, -1, 0.5f, 1), glm::vec4(0, -1, 0.5f, 1), glm::vec4(0, 1, 0.5f, 1));
+	OcclusionCulling::RasterizeTriangle(glm::vec4(-1, -1, 0.5f, 1), glm::vec4(0, 1, 0.5f, 1), glm::vec4(-1, 1, 0.5f, 1));
+	OcclusionCulling::BuildHierarchicalDepth();
+
+	// Behind the occluder
+	EXPECT_TRUE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(-0.8f, -0.5f, 0.6f), glm::vec3(-0.2f, 0.5f, 0.8f)), "Box behind the occluder not occluded");
+	// In front of the occluder
+	EXPECT_FALSE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(-0.8f, -0.5f, 0.2f), glm::vec3(-0.2f, 0.5f, 0.3f)), "Box in front of the occluder occluded");
+	// Crossing the occluder
+	EXPECT_FALSE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(-0.8f, -0.5f, 0.4f), glm::vec3(-0.2f, 0.5f, 0.6f)), "Box crossing the occluder occluded");
+	// Partially outside of the occluder
+	EXPECT_FALSE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, 0.6f), glm::vec3(0.5f, 0.5f, 0.8f)), "Box partially visible occluded");
+	// Out of the screen
+	EXPECT_FALSE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(-3.0f, -0.5f, 0.6f), glm::vec3(-2.0f, 0.5f, 0.8f)), "Box out of the screen occluded");
+
+	// Triangles crossing the near plane are ignored
+	OcclusionCulling::ClearDepthBuffer(0.1f);
+	OcclusionCulling::RasterizeTriangle(glm::vec4(-1, -1, 0.5f, 1), glm::vec4(1, -1, 0.5f, 0.05f), glm::vec4(1, 1, 0.5f, 1));
+	OcclusionCulling::BuildHierarchicalDepth();
+	EXPECT_FALSE(OcclusionCulling::IsBoxOccluded(viewProjection, glm::vec3(0.2f, -0.2f, 0.6f), glm::vec3(0.4f, 0.2f, 0.8f)), "Triangle crossing the near plane rasterized");
+
+	END_TEST();
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <engine/graphics/render_command.h>
+
+TestResult RenderSortKeyDepthTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	// The quantized depth should keep the order of the distances
+	EXPECT_EQUALS(RenderSortKey::QuantizeDepth(0.0f), 0, "Bad depth for 0");
+	EXPECT_EQUALS(RenderSortKey::QuantizeDepth(-1.0f), 0, "Bad depth for a negative value");
+	EXPECT_TRUE(RenderSortKey::QuantizeDepth(1.0f) < RenderSortKey::QuantizeDepth(1.1f), "Bad depth order");
+	EXPECT_TRUE(RenderSortKey::QuantizeDepth(0.01f) < RenderSortKey::QuantizeDepth(1.0f), "Bad depth order");
+	EXPECT_TRUE(RenderSortKey::QuantizeDepth(100.0f) < RenderSortKey::QuantizeDepth(10000.0f), "Bad depth order");
+
+	const RenderCommand command;
+	const uint64_t opaqueKey = RenderSortKey::Make(RenderPass::Opaque, command);
+	const uint64_t transparentKey = RenderSortKey::Make(RenderPass::Transparent, command);
+
+	// The pass has the highest priority
+	EXPECT_TRUE(RenderSortKey::SetDepth(opaqueKey, 0xFFFF) < RenderSortKey::SetDepth(transparentKey, 0xFFFF), "Bad pass order");
+
+	// Opaque commands are drawn front to back, transparent commands back to front
+	const uint16_t near = RenderSortKey::QuantizeDepth(1.0f);
+	const uint16_t far = RenderSortKey::QuantizeDepth(100.0f);
+	EXPECT_TRUE(RenderSortKey::SetDepth(opaqueKey, near) < RenderSortKey::SetDepth(opaqueKey, far), "Bad opaque order");
+	EXPECT_TRUE(RenderSortKey::SetDepth(transparentKey, far) < RenderSortKey::SetDepth(transparentKey, near), "Bad transparent order");
+
+	// Setting the depth again should replace the old one
+	EXPECT_EQUALS(RenderSortKey::SetDepth(RenderSortKey::SetDepth(opaqueKey, far), near), RenderSortKey::SetDepth(opaqueKey, near), "Depth not replaced");
+
+	// UI keys follow the order in layer, including negative values
+	EXPECT_TRUE(RenderSortKey::MakeUI(-5, 10) < RenderSortKey::MakeUI(0, 1), "Bad UI order");
+	EXPECT_TRUE(RenderSortKey::MakeUI(0, 10) < RenderSortKey::MakeUI(3, 1), "Bad UI order");
+	// Then the drawable order
+	EXPECT_TRUE(RenderSortKey::MakeUI(2, 1) < RenderSortKey::MakeUI(2, 2), "Bad UI drawable order");
+
+	// Sprite keys follow the drawable order
+	EXPECT_TRUE(RenderSortKey::MakeSprite(1) < RenderSortKey::MakeSprite(2), "Bad sprite order");
+
+	END_TEST();
+}
+
+TestResult RenderSortKeySortTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	std::vector<RenderSortEntry> entries;
+	std::vector<RenderSortEntry> buffer;
+
+	// Use the slot to store the original index and check the stability
+	const uint64_t keys[] = { 0x8000000000000005, 3, 0x0000010000000000, 3, 0, 0xFFFFFFFFFFFFFFFF, 0x0000010000000000, 42 };
+	const size_t keyCount = sizeof(keys) / sizeof(uint64_t);
+	for (size_t i = 0; i < keyCount; i++)
+	{
+		RenderSortEntry entry;
+		entry.sortKey = keys[i];
+		entry.slot = static_cast<uint32_t>(i);
+		entries.push_back(entry);
+	}
+
+	RenderSortKey::Sort(entries, entries.size(), buffer);
+
+	bool isSorted = true;
+	bool isStable = true;
+	for (size_t i = 1; i < keyCount; i++)
+	{
+		if (entries[i - 1].sortKey > entries[i].sortKey)
+		{
+			isSorted = false;
+		}
+		else if (entries[i - 1].sortKey == entries[i].sortKey && entries[i - 1].slot > entries[i].slot)
+		{
+			isStable = false;
+		}
+	}
+	EXPECT_TRUE(isSorted, "Entries not sorted");
+	EXPECT_TRUE(isStable, "Sort not stable");
+	EXPECT_EQUALS(entries.size(), keyCount, "Bad entry count");
+
+	// Only the first entries should be sorted
+	entries[0].sortKey = 10;
+	entries[1].sortKey = 5;
+	entries[2].sortKey = 1;
+	RenderSortKey::Sort(entries, 2, buffer);
+	EXPECT_EQUALS(entries[0].sortKey, 5, "Bad partial sort");
+	EXPECT_EQUALS(entries[1].sortKey, 10, "Bad partial sort");
+	EXPECT_EQUALS(entries[2].sortKey, 1, "Element outside of the range modified");
+
+	END_TEST();
+}
+
+TestResult RenderQueueTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	RenderQueue queue;
+
+	// The drawable is only used as a marker of used slots
+	RenderCommand command;
+	command.drawable = reinterpret_cast<IDrawable*>(1);
+
+	const uint32_t slot0 = queue.Add(command);
+	const uint32_t slot1 = queue.Add(command);
+	const uint32_t slot2 = queue.Add(command);
+	EXPECT_EQUALS(slot0, 0, "Bad slot");
+	EXPECT_EQUALS(slot1, 1, "Bad slot");
+	EXPECT_EQUALS(slot2, 2, "Bad slot");
+	EXPECT_EQUALS(queue.commandCount, 3, "Bad command count");
+
+	// Removing a command should not move the other commands
+	queue.isDrawOrderDirty = false;
+	queue.Remove(slot1);
+	EXPECT_EQUALS(queue.commandCount, 2, "Bad command count after remove");
+	EXPECT_EQUALS(queue.commands.size(), 3, "Commands moved after remove");
+	EXPECT_TRUE(queue.commands[slot1].drawable == nullptr, "Removed slot not cleared");
+	EXPECT_TRUE(queue.commands[slot2].drawable != nullptr, "Other slot cleared");
+	EXPECT_TRUE(queue.isDrawOrderDirty, "Draw order not dirty after remove");
+
+	// The free slot should be reused
+	EXPECT_EQUALS(queue.Add(command), slot1, "Free slot not reused");
+	EXPECT_EQUALS(queue.Add(command), 3, "Bad slot after reuse");
+	EXPECT_EQUALS(queue.commandCount, 4, "Bad command count after reuse");
+
+	queue.Clear();
+	EXPECT_EQUALS(queue.commandCount, 0, "Bad command count after clear");
+	EXPECT_EQUALS(queue.Add(command), 0, "Bad slot after clear");
+
+	END_TEST();
+}
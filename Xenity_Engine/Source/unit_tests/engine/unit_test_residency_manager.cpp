@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <engine/asset_management/residency_manager.h>
+
+TestResult ResidencyEvictionTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	const uint64_t currentFrame = 1000;
+	const uint64_t oldFrame = currentFrame - ResidencyManager::s_minUnusedFrameCount;
+	const std::vector<ResidencyManager::Candidate> candidates =
+	{
+		{ oldFrame - 10, 100 }, // 0: second oldest
+		{ currentFrame, 500 }, // 1: used this frame
+		{ oldFrame - 20, 50 }, // 2: oldest
+		{ oldFrame, 200 }, // 3: unused for the minimum frame count
+		{ currentFrame - 1, 300 }, // 4: used recently
+	};
+
+	// Under the budget, nothing is evicted
+	EXPECT_EQUALS(ResidencyManager::SelectEvictions(candidates, 1150, 2000, currentFrame).size(), 0, "Evictions under the budget");
+
+	// The least recently used first, until the budget is respected
+	std::vector<size_t> evictions = ResidencyManager::SelectEvictions(candidates, 1150, 1050, currentFrame);
+	EXPECT_EQUALS(evictions.size(), 2, "Bad eviction count");
+	if (evictions.size() == 2)
+	{
+		EXPECT_EQUALS(evictions[0], 2, "The oldest asset is not evicted first");
+		EXPECT_EQUALS(evictions[1], 0, "The second oldest asset is not evicted second");
+	}
+
+	// The recently used assets are kept even if the budget is still exceeded
+	evictions = ResidencyManager::SelectEvictions(candidates, 1150, 0, currentFrame);
+	EXPECT_EQUALS(evictions.size(), 3, "Recently used assets evicted");
+
+	END_TEST();
+}
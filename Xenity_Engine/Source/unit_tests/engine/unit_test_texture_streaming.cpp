@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright (c) 2022-2026 Gregory Machefer (Fewnity)
+//
+// This file is part of Xenity Engine
+
+#include "../unit_test_manager.h"
+
+#include <engine/graphics/texture/texture_streaming.h>
+
+TestResult TextureStreamingLevelTest::Start(std::string& errorOut)
+{
+	BEGIN_TEST();
+
+	EXPECT_EQUALS(TextureStreaming::GetMipCount(1024, 1024), 11, "Mip count of a square texture");
+	EXPECT_EQUALS(TextureStreaming::GetMipCount(1024, 256), 11, "Mip count of a wide texture");
+	EXPECT_EQUALS(TextureStreaming::GetMipCount(1, 1), 1, "Mip count of a 1x1 texture");
+
+	EXPECT_EQUALS(TextureStreaming::GetLevelForSize(1024, 512, 64), 4, "Level with 64 pixels or less");
+	EXPECT_EQUALS(TextureStreaming::GetLevelForSize(32, 32, 64), 0, "Texture already small");
+
+	EXPECT_EQUALS(TextureStreaming::GetLevelsSize(4, 2, 0), static_cast<size_t>((8 + 2 + 1) * 4), "Size of all the levels");
+	EXPECT_EQUALS(TextureStreaming::GetLevelsSize(4, 2, 1), static_cast<size_t>((2 + 1) * 4), "Size without the level 0");
+
+	// One texel per pixel
+	EXPECT_EQUALS(TextureStreaming::ComputeRequestedLevel(1024, 1024, 2000, 4), 0, "Bigger than the texture on the screen");
+	EXPECT_EQUALS(TextureStreaming::ComputeRequestedLevel(1024, 1024, 1024, 4), 0, "Same size on the screen");
+	EXPECT_EQUALS(TextureStreaming::ComputeRequestedLevel(1024, 1024, 512, 4), 1, "Half size on the screen");
+	EXPECT_EQUALS(TextureStreaming::ComputeRequestedLevel(1024, 1024, 300, 4), 1, "Between two levels, the bigger one");
+	EXPECT_EQUALS(TextureStreaming::ComputeRequestedLevel(1024, 1024, 10, 4), 4, "Small objects use the lowest level");
+	EXPECT_EQUALS(TextureStreaming::ComputeRequestedLevel(1024, 1024, 0, 4), 4, "Empty objects use the lowest level");
+
+	END_TEST();
+}
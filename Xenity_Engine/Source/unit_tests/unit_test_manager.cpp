@@ -127,6 +127,56 @@ void UnitTestManager::StartAllTests()
 
 		VertexDescriptorGetVertexElementSizeTest vertexDescriptorGetVertexElementSizeTest = VertexDescriptorGetVertexElementSizeTest("Vertex Descriptor GetVertexElementSizeTest");
 		TryTest(vertexDescriptorGetVertexElementSizeTest);
+
+		VertexQuantizationNormalizedTest vertexQuantizationNormalizedTest = VertexQuantizationNormalizedTest("Vertex Quantization normalized values");
+		TryTest(vertexQuantizationNormalizedTest);
+
+		VertexQuantizationOctahedralTest vertexQuantizationOctahedralTest = VertexQuantizationOctahedralTest("Vertex Quantization octahedral normals");
+		TryTest(vertexQuantizationOctahedralTest);
+	}
+
+	//------------------------------------------------------------------ Render Sort Key
+	{
+		RenderSortKeyDepthTest renderSortKeyDepthTest = RenderSortKeyDepthTest("Render Sort Key depth");
+		TryTest(renderSortKeyDepthTest);
+
+		RenderSortKeySortTest renderSortKeySortTest = RenderSortKeySortTest("Render Sort Key sort");
+		TryTest(renderSortKeySortTest);
+
+		RenderQueueTest renderQueueTest = RenderQueueTest("Render Queue");
+		TryTest(renderQueueTest);
+	}
+
+	//------------------------------------------------------------------ Culling
+	{
+		FrustumCullingTest frustumCullingTest = FrustumCullingTest("Frustum Culling");
+		TryTest(frustumCullingTest);
+
+		OcclusionCullingTest occlusionCullingTest = OcclusionCullingTest("Occlusion Culling");
+		TryTest(occlusionCullingTest);
+
+		LodSelectionTest lodSelectionTest = LodSelectionTest("Lod Selection");
+		TryTest(lodSelectionTest);
+	}
+
+	{
+		DynamicResolutionScaleTest dynamicResolutionScaleTest = DynamicResolutionScaleTest("Dynamic Resolution Scale");
+		TryTest(dynamicResolutionScaleTest);
+	}
+
+	{
+		DynamicResolutionUpscaleTest dynamicResolutionUpscaleTest = DynamicResolutionUpscaleTest("Dynamic Resolution Upscale");
+		TryTest(dynamicResolutionUpscaleTest);
+	}
+
+	{
+		ResidencyEvictionTest residencyEvictionTest = ResidencyEvictionTest("Residency Eviction");
+		TryTest(residencyEvictionTest);
+	}
+
+	{
+		TextureStreamingLevelTest textureStreamingLevelTest = TextureStreamingLevelTest("Texture Streaming Level");
+		TryTest(textureStreamingLevelTest);
 	}
 
 #if defined(EDITOR)
@@ -156,6 +206,24 @@ void UnitTestManager::StartAllTests()
 		ModifyInspectorChangeValueCommandTest modifyInspectorChangeValueCommandTest = ModifyInspectorChangeValueCommandTest("Modify Inspector Change Value Command");
 		TryTest(modifyInspectorChangeValueCommandTest);
 	}
+
+	//------------------------------------------------------------------ Cooker
+	{
+		MeshOptimizerVertexCacheTest meshOptimizerVertexCacheTest = MeshOptimizerVertexCacheTest("Mesh Optimizer Vertex Cache");
+		TryTest(meshOptimizerVertexCacheTest);
+
+		MeshOptimizerVertexFetchTest meshOptimizerVertexFetchTest = MeshOptimizerVertexFetchTest("Mesh Optimizer Vertex Fetch");
+		TryTest(meshOptimizerVertexFetchTest);
+
+		MeshOptimizerDeduplicateTest meshOptimizerDeduplicateTest = MeshOptimizerDeduplicateTest("Mesh Optimizer Deduplicate");
+		TryTest(meshOptimizerDeduplicateTest);
+
+		TextureEncoderBlocksTest textureEncoderBlocksTest = TextureEncoderBlocksTest("Texture Encoder Blocks");
+		TryTest(textureEncoderBlocksTest);
+
+		TextureEncoderFileTest textureEncoderFileTest = TextureEncoderFileTest("Texture Encoder File");
+		TryTest(textureEncoderFileTest);
+	}
 #endif
 
 	Debug::Print("------ Unit Tests finished! ------", true);
@@ -197,6 +197,43 @@ MAKE_TEST(VertexDescriptor16Bits);
 MAKE_TEST(VertexDescriptor8Bits);
 MAKE_TEST(VertexDescriptorWrong);
 MAKE_TEST(VertexDescriptorGetVertexElementSize);
+MAKE_TEST(VertexQuantizationNormalized);
+MAKE_TEST(VertexQuantizationOctahedral);
+
+#pragma endregion
+
+#pragma region Render Sort Key
+
+MAKE_TEST(RenderSortKeyDepth);
+MAKE_TEST(RenderSortKeySort);
+MAKE_TEST(RenderQueue);
+
+#pragma endregion
+
+#pragma region Culling
+
+MAKE_TEST(FrustumCulling);
+MAKE_TEST(OcclusionCulling);
+MAKE_TEST(LodSelection);
+
+#pragma endregion
+
+#pragma region Dynamic Resolution
+
+MAKE_TEST(DynamicResolutionScale);
+MAKE_TEST(DynamicResolutionUpscale);
+
+#pragma endregion
+
+#pragma region Residency
+
+MAKE_TEST(ResidencyEviction);
+
+#pragma endregion
+
+#pragma region Texture Streaming
+
+MAKE_TEST(TextureStreamingLevel);
 
 #pragma endregion
 
@@ -227,5 +264,15 @@ MAKE_TEST(ModifyInspectorChangeValueCommand);
 
 #pragma endregion
 
+#pragma region Cooker
+
+MAKE_TEST(MeshOptimizerVertexCache);
+MAKE_TEST(MeshOptimizerVertexFetch);
+MAKE_TEST(MeshOptimizerDeduplicate);
+MAKE_TEST(TextureEncoderBlocks);
+MAKE_TEST(TextureEncoderFile);
+
+#pragma endregion
+
 
 #pragma endregion // Editor
\ No newline at end of file
@@ -58,6 +58,7 @@
 #include <engine/graphics/2d_graphics/tile_map.h>
 #include <engine/graphics/2d_graphics/line_renderer.h>
 #include <engine/graphics/color/color.h>
+#include <engine/graphics/debug_draw.h>
 #include <engine/graphics/ui/text_mesh.h>
 #include <engine/graphics/ui/font.h>
 #include <engine/graphics/ui/text_renderer.h>
@@ -0,0 +1,86 @@
+//-------------- {pc}
+//-------------- {vertex}
+
+#version 330 core
+
+layout(location = 2) in vec3 a_Position;
+
+out vec3 v_Direction;
+
+uniform mat4 MVP; // View Projection without the camera position
+
+void main()
+{
+	v_Direction = a_Position;
+	gl_Position = MVP * vec4(a_Position, 1);
+}
+
+//-------------- {fragment}
+
+#version 330 core
+
+in vec3 v_Direction;
+
+uniform samplerCube skybox;
+
+void main()
+{
+	gl_FragColor = texture(skybox, v_Direction);
+}
+
+//-------------- {psvita}
+//-------------- {vertex}
+
+attribute vec3 a_Position;
+
+varying vec3 v_Direction;
+
+uniform mat4 MVP;
+
+void main()
+{
+	gl_Position = mul(float4(a_Position, 1.0f), MVP);
+	v_Direction = a_Position;
+}
+
+//-------------- {fragment}
+
+varying vec3 v_Direction;
+
+uniform samplerCUBE skybox;
+
+void main()
+{
+	gl_FragColor = texCUBE(skybox, v_Direction);
+}
+
+//-------------- {ps3}
+//-------------- {vertex}
+
+void main
+(
+	float3 a_Position : POSITION,
+
+	uniform float4x4 MVP,
+
+	out float4 ePosition : POSITION,
+	out float3 v_Direction : TEXCOORD0
+)
+{
+	ePosition = mul(float4(a_Position, 1.0f), MVP);
+	v_Direction = a_Position;
+}
+
+//-------------- {fragment}
+
+void main
+(
+	float3 v_Direction : TEXCOORD0,
+
+	uniform samplerCUBE skybox,
+
+	out float4 oColor
+)
+{
+	oColor = texCUBE(skybox, v_Direction);
+}
\ No newline at end of file
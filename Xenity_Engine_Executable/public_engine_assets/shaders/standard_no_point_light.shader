@@ -4,9 +4,17 @@
 #version 330
 
 layout(location = 0) in vec2 a_TexCoord;
+#ifdef OCTAHEDRAL_NORMALS
+layout(location = 1) in vec2 a_Normal; // Octahedral encoded normal (variant used for the quantized meshes)
+#else
 layout(location = 1) in vec3 a_Normal;
+#endif
 layout(location = 2) in vec3 a_Position;
 layout(location = 3) in vec4 a_Color;
+// Per instance matrices, only used by the instanced draws
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 8) in mat4 a_InstanceMVP;
+layout(location = 12) in mat3 a_InstanceNormalMatrix;
 
 out vec2 v_TexCoord;
 out vec3 v_Normal;
@@ -16,13 +24,40 @@ out vec4 v_Color;
 uniform mat4 model; //Model matrice position, rotation and scale
 uniform mat4 MVP; // Model View Projection
 uniform mat3 normalMatrix;
+uniform int useInstancing; // 1 to use the instance matrices instead of the uniforms
+
+#ifdef OCTAHEDRAL_NORMALS
+// The normal is unfolded from the square to the octahedron, the lower half is folded back without branch
+vec3 DecodeNormal(vec2 encoded)
+{
+	vec3 decoded = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-decoded.z, 0.0);
+	decoded.xy -= fold * vec2(encoded.x >= 0.0 ? 1.0 : -1.0, encoded.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(decoded);
+}
+#else
+vec3 DecodeNormal(vec3 normal)
+{
+	return normal;
+}
+#endif
 
 void main()
 {
-	gl_Position = MVP * vec4(a_Position, 1);
-	v_FragPos = vec3(model * vec4(a_Position, 1));
+	mat4 usedModel = model;
+	mat4 usedMVP = MVP;
+	mat3 usedNormalMatrix = normalMatrix;
+	if (useInstancing != 0)
+	{
+		usedModel = a_InstanceModel;
+		usedMVP = a_InstanceMVP;
+		usedNormalMatrix = a_InstanceNormalMatrix;
+	}
+
+	gl_Position = usedMVP * vec4(a_Position, 1);
+	v_FragPos = vec3(usedModel * vec4(a_Position, 1));
 	v_TexCoord = a_TexCoord;
-	v_Normal = normalMatrix * a_Normal; //TODO Check an object with a bigger scale and with a 	offsetPosition, fix : add to offset * rotation this : * offsetPosition * scale
+	v_Normal = usedNormalMatrix * DecodeNormal(a_Normal); //TODO Check an object with a bigger scale and with a 	offsetPosition, fix : add to offset * rotation this : * offsetPosition * scale
 	v_Color = a_Color;
 }
 
@@ -38,7 +73,6 @@ in vec2 v_TexCoord;
 uniform vec4 color;
 uniform vec2 tiling;
 uniform vec2 offset;
-uniform vec3 ambientLight;
 
 struct DirectionalLight 
 {
@@ -65,11 +99,28 @@ struct SpotLight
 uniform sampler2D diffuse;
 
 #define NR_POINT_LIGHTS 10 
-uniform PointLight pointLights[NR_POINT_LIGHTS];
 #define NR_SPOT_LIGHTS 10
-uniform SpotLight spotLights[NR_SPOT_LIGHTS];
 #define NR_DIRECTIONAL_LIGHTS 10
-uniform DirectionalLight directionalLights[NR_DIRECTIONAL_LIGHTS];
+
+// Shared by all the shaders, updated once per frame
+layout(std140) uniform LightsData
+{
+	PointLight pointLights[NR_POINT_LIGHTS];
+	SpotLight spotLights[NR_SPOT_LIGHTS];
+	DirectionalLight directionalLights[NR_DIRECTIONAL_LIGHTS];
+	vec3 ambientLight;
+} lightsData;
+
+// Shared by all the shaders, updated once per camera
+layout(std140) uniform CameraData
+{
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 fogColor;
+	vec4 fogData; // x = start, y = end, z = 1 if the fog is enabled
+} cameraData;
 
 layout(std140) uniform LightIndices
 {
@@ -135,17 +186,17 @@ void main()
 	vec3 result = vec3(0,0,0); //Set face result
 	// for (int i = 0; i < lightIndices.usedPointLightCount; i++)
 	// {
-	// 	result += CalculatePointLight(pointLights[lightIndices.pointLightsIndices[i].x], norm, v_FragPos);
+	// 	result += CalculatePointLight(lightsData.pointLights[lightIndices.pointLightsIndices[i].x], norm, v_FragPos);
 	// }	
 	// for (int i = 0; i < lightIndices.usedSpotLightCount; i++)
 	// {
-	// 	result += CalculateSpotLight(spotLights[lightIndices.spotLightsIndices[i].x], norm, v_FragPos);
+	// 	result += CalculateSpotLight(lightsData.spotLights[lightIndices.spotLightsIndices[i].x], norm, v_FragPos);
 	// }
 	for (int i = 0; i < lightIndices.usedDirectionalLightCount; i++)
 	{
-		result += CalculateDirectionalLight(directionalLights[lightIndices.directionalLightsIndices[i].x], norm, v_FragPos);
+		result += CalculateDirectionalLight(lightsData.directionalLights[lightIndices.directionalLightsIndices[i].x], norm, v_FragPos);
 	}
-	result += textureFrag.xyz * ambientLight;
+	result += textureFrag.xyz * lightsData.ambientLight;
 
 	float alpha = textureFrag.w * color.w;
 
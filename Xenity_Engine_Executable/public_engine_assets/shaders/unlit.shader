@@ -6,15 +6,21 @@
 layout(location = 0) in vec2 a_TexCoord;
 layout(location = 2) in vec3 a_Position;
 layout(location = 3) in vec4 a_Color;
+// Per instance matrix, only used by the instanced draws
+layout(location = 8) in mat4 a_InstanceMVP;
 
 out vec2 v_TexCoord;
 out vec4 v_Color;
 
 uniform mat4 MVP; // Model View Projection
+uniform int useInstancing; // 1 to use the instance matrix instead of the uniform
 
 void main()
 {
-	gl_Position = MVP * vec4(a_Position, 1);
+	if (useInstancing != 0)
+		gl_Position = a_InstanceMVP * vec4(a_Position, 1);
+	else
+		gl_Position = MVP * vec4(a_Position, 1);
 	v_TexCoord = a_TexCoord;
 	v_Color = a_Color;
 }